@@ -16,12 +16,13 @@ toolchain = generator.toolchain
 extrasources = []
 
 foundation_sources = [
-  'android.c', 'array.c', 'assert.c', 'assetstream.c', 'atomic.c', 'base64.c', 'beacon.c', 'bitbuffer.c', 'blowfish.c',
-  'bucketarray.c', 'bufferstream.c', 'environment.c', 'error.c', 'event.c', 'exception.c', 'foundation.c', 'fs.c',
-  'hash.c', 'hashmap.c', 'hashtable.c', 'json.c', 'library.c', 'log.c', 'main.c', 'md5.c', 'memory.c', 'mutex.c',
-  'objectmap.c', 'path.c', 'pipe.c', 'process.c', 'profile.c', 'radixsort.c', 'random.c', 'regex.c',
-  'ringbuffer.c', 'sha.c', 'semaphore.c', 'stacktrace.c', 'stream.c', 'string.c', 'system.c', 'thread.c', 'time.c',
-  'tizen.c', 'uuid.c', 'uuidmap.c', 'version.c', 'virtualarray.c', 'delegate.m', 'environment.m', 'fs.m', 'system.m' ]
+  'aes.c', 'android.c', 'array.c', 'assert.c', 'assetstream.c', 'atomic.c', 'base64.c', 'beacon.c', 'bitbuffer.c',
+  'blowfish.c', 'bucketarray.c', 'bufferstream.c', 'crc.c', 'environment.c', 'error.c', 'event.c', 'exception.c',
+  'foundation.c', 'fs.c', 'hash.c', 'hashmap.c', 'hashtable.c', 'json.c', 'library.c', 'log.c', 'main.c', 'matcher.c',
+  'md5.c', 'memory.c', 'mutex.c', 'objectmap.c', 'path.c', 'pipe.c', 'process.c', 'profile.c', 'radixsort.c',
+  'random.c', 'regex.c', 'ringbuffer.c', 'semaphore.c', 'sha.c', 'stacktrace.c', 'stream.c', 'string.c', 'system.c',
+  'thread.c', 'time.c', 'tizen.c', 'uuid.c', 'uuidmap.c', 'version.c', 'virtualarray.c', 'delegate.m',
+  'environment.m', 'fs.m', 'system.m' ]
 
 foundation_lib = generator.lib(module = 'foundation', sources = foundation_sources + extrasources)
 #foundation_so = generator.sharedlib( module = 'foundation', sources = foundation_sources + extrasources )
@@ -41,10 +42,10 @@ if generator.skip_tests():
   sys.exit()
 
 test_cases = [
-  'app', 'array', 'atomic', 'base64', 'beacon', 'bitbuffer', 'blowfish', 'bufferstream', 'environment', 'error',
-  'event', 'exception', 'fs', 'hash', 'hashmap', 'hashtable', 'json', 'library', 'math', 'md5', 'mutex', 'objectmap',
-  'path', 'pipe', 'process', 'profile', 'radixsort', 'random', 'regex', 'ringbuffer', 'semaphore', 'sha', 'stacktrace',
-  'stream', 'string', 'system', 'time', 'uuid'
+  'aes', 'app', 'array', 'atomic', 'base64', 'beacon', 'bitbuffer', 'blowfish', 'bufferstream', 'crc', 'environment',
+  'error', 'event', 'exception', 'fs', 'hash', 'hashmap', 'hashtable', 'json', 'library', 'math', 'matcher', 'md5',
+  'mutex', 'objectmap', 'path', 'pipe', 'process', 'profile', 'radixsort', 'random', 'regex', 'ringbuffer',
+  'semaphore', 'sha', 'stacktrace', 'stream', 'string', 'system', 'time', 'uuid'
 ]
 if toolchain.is_monolithic() or target.is_ios() or target.is_android() or target.is_tizen():
   #Build one fat binary with all test cases
@@ -85,3 +86,7 @@ else:
   for test in test_cases:
     variables = None
     generator.bin(module = test, sources = sources, binname = 'test-' + test, basepath = 'test', implicit_deps = [foundation_lib, test_lib, mock_lib], libs = ['test', 'foundation', 'mock'], includepaths = includepaths, variables = variables)
+  #Run the random tests again with the global functions on each explicit state engine
+  for engine in ['xoshiro256', 'pcg64']:
+    variables = {'defines': ['TEST_RANDOM_ENGINE=RANDOM_ENGINE_' + engine.upper()]}
+    generator.bin(module = 'random', sources = sources, binname = 'test-random-' + engine, basepath = 'test', implicit_deps = [foundation_lib, test_lib, mock_lib], libs = ['test', 'foundation', 'mock'], includepaths = includepaths, variables = variables)
@@ -0,0 +1,856 @@
+/* aes.c  -  Foundation library  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#include <foundation/foundation.h>
+#include <foundation/internal.h>
+
+#if FOUNDATION_COMPILER_CLANG
+// Unaligned loads are done with explicit unaligned load intrinsics
+#pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define AES_X86 1
+#else
+#define AES_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define AES_ARM 1
+#else
+#define AES_ARM 0
+#endif
+
+// Number of blocks buffered for the parallel modes of operation
+#define AES_CHUNK_BLOCKS 16
+
+//! Encrypt or decrypt a number of consecutive blocks in place
+typedef void (*aes_blocks_fn)(const aes_t* aes, unsigned char* data, size_t blocks);
+
+static aes_blocks_fn aes_encrypt_blocks;
+static aes_blocks_fn aes_decrypt_blocks;
+
+static const unsigned char aes_rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+#if AES_X86
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <wmmintrin.h>
+#define AES_TARGET(isa)
+#else
+#include <wmmintrin.h>
+#define AES_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif AES_ARM
+#include <arm_neon.h>
+#endif
+
+static FOUNDATION_FORCEINLINE uint64_t
+aes_load64(const unsigned char* src) {
+	uint64_t value;
+	memcpy(&value, src, sizeof(value));
+	return byteorder_littleendian64(value);
+}
+
+static FOUNDATION_FORCEINLINE void
+aes_store64(unsigned char* dest, uint64_t value) {
+	value = byteorder_littleendian64(value);
+	memcpy(dest, &value, sizeof(value));
+}
+
+static FOUNDATION_FORCEINLINE void
+aes_xor_block(unsigned char* dest, const unsigned char* src) {
+	uint64_t dval[2];
+	uint64_t sval[2];
+	memcpy(dval, dest, sizeof(dval));
+	memcpy(sval, src, sizeof(sval));
+	dval[0] ^= sval[0];
+	dval[1] ^= sval[1];
+	memcpy(dest, dval, sizeof(dval));
+}
+
+static FOUNDATION_FORCEINLINE void
+aes_vector_block(unsigned char* block, uint64_t high, uint64_t low) {
+	high = byteorder_bigendian64(high);
+	low = byteorder_bigendian64(low);
+	memcpy(block, &high, sizeof(high));
+	memcpy(block + sizeof(high), &low, sizeof(low));
+}
+
+// Constant time implementation. Four blocks are processed in parallel, bitsliced into eight
+// 64-bit words where bit (16 * block + byte) of word N holds bit N of that byte of the state.
+// Bytes are in FIPS-197 state order, byte (4 * column + row)
+
+//! Transpose an 8x8 bit matrix stored as bytes in a 64-bit word
+static FOUNDATION_FORCEINLINE uint64_t
+aes_transpose8(uint64_t x) {
+	uint64_t t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+	return x;
+}
+
+static void
+aes_bitslice_pack(uint64_t* q, const unsigned char* data) {
+	unsigned int iword, ibit;
+	for (ibit = 0; ibit < 8; ++ibit)
+		q[ibit] = 0;
+	for (iword = 0; iword < 8; ++iword) {
+		uint64_t x = aes_transpose8(aes_load64(data + (iword * 8)));
+		for (ibit = 0; ibit < 8; ++ibit)
+			q[ibit] |= ((x >> (ibit * 8)) & 0xFF) << (iword * 8);
+	}
+}
+
+static void
+aes_bitslice_unpack(unsigned char* data, const uint64_t* q) {
+	unsigned int iword, ibit;
+	for (iword = 0; iword < 8; ++iword) {
+		uint64_t x = 0;
+		for (ibit = 0; ibit < 8; ++ibit)
+			x |= ((q[ibit] >> (iword * 8)) & 0xFF) << (ibit * 8);
+		aes_store64(data + (iword * 8), aes_transpose8(x));
+	}
+}
+
+//! S-box as a boolean circuit (Boyar and Peralta, "A depth-16 circuit for the AES S-box")
+static void
+aes_bitslice_sbox(uint64_t* q) {
+	uint64_t x0, x1, x2, x3, x4, x5, x6, x7;
+	uint64_t y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+	uint64_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+	uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18, t19, t20, t21,
+	    t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32, t33, t34, t35, t36, t37, t38, t39, t40, t41, t42, t43,
+	    t44, t45, t46, t47, t48, t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59, t60, t61, t62, t63, t64, t65,
+	    t66, t67;
+	uint64_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+	x0 = q[7];
+	x1 = q[6];
+	x2 = q[5];
+	x3 = q[4];
+	x4 = q[3];
+	x5 = q[2];
+	x6 = q[1];
+	x7 = q[0];
+
+	// Top linear transformation
+	y14 = x3 ^ x5;
+	y13 = x0 ^ x6;
+	y9 = x0 ^ x3;
+	y8 = x0 ^ x5;
+	t0 = x1 ^ x2;
+	y1 = t0 ^ x7;
+	y4 = y1 ^ x3;
+	y12 = y13 ^ y14;
+	y2 = y1 ^ x0;
+	y5 = y1 ^ x6;
+	y3 = y5 ^ y8;
+	t1 = x4 ^ y12;
+	y15 = t1 ^ x5;
+	y20 = t1 ^ x1;
+	y6 = y15 ^ x7;
+	y10 = y15 ^ t0;
+	y11 = y20 ^ y9;
+	y7 = x7 ^ y11;
+	y17 = y10 ^ y11;
+	y19 = y10 ^ y8;
+	y16 = t0 ^ y11;
+	y21 = y13 ^ y16;
+	y18 = x0 ^ y16;
+
+	// Non-linear section
+	t2 = y12 & y15;
+	t3 = y3 & y6;
+	t4 = t3 ^ t2;
+	t5 = y4 & x7;
+	t6 = t5 ^ t2;
+	t7 = y13 & y16;
+	t8 = y5 & y1;
+	t9 = t8 ^ t7;
+	t10 = y2 & y7;
+	t11 = t10 ^ t7;
+	t12 = y9 & y11;
+	t13 = y14 & y17;
+	t14 = t13 ^ t12;
+	t15 = y8 & y10;
+	t16 = t15 ^ t12;
+	t17 = t4 ^ t14;
+	t18 = t6 ^ t16;
+	t19 = t9 ^ t14;
+	t20 = t11 ^ t16;
+	t21 = t17 ^ y20;
+	t22 = t18 ^ y19;
+	t23 = t19 ^ y21;
+	t24 = t20 ^ y18;
+
+	t25 = t21 ^ t22;
+	t26 = t21 & t23;
+	t27 = t24 ^ t26;
+	t28 = t25 & t27;
+	t29 = t28 ^ t22;
+	t30 = t23 ^ t24;
+	t31 = t22 ^ t26;
+	t32 = t31 & t30;
+	t33 = t32 ^ t24;
+	t34 = t23 ^ t33;
+	t35 = t27 ^ t33;
+	t36 = t24 & t35;
+	t37 = t36 ^ t34;
+	t38 = t27 ^ t36;
+	t39 = t29 & t38;
+	t40 = t25 ^ t39;
+
+	t41 = t40 ^ t37;
+	t42 = t29 ^ t33;
+	t43 = t29 ^ t40;
+	t44 = t33 ^ t37;
+	t45 = t42 ^ t41;
+	z0 = t44 & y15;
+	z1 = t37 & y6;
+	z2 = t33 & x7;
+	z3 = t43 & y16;
+	z4 = t40 & y1;
+	z5 = t29 & y7;
+	z6 = t42 & y11;
+	z7 = t45 & y17;
+	z8 = t41 & y10;
+	z9 = t44 & y12;
+	z10 = t37 & y3;
+	z11 = t33 & y4;
+	z12 = t43 & y13;
+	z13 = t40 & y5;
+	z14 = t29 & y2;
+	z15 = t42 & y9;
+	z16 = t45 & y14;
+	z17 = t41 & y8;
+
+	// Bottom linear transformation
+	t46 = z15 ^ z16;
+	t47 = z10 ^ z11;
+	t48 = z5 ^ z13;
+	t49 = z9 ^ z10;
+	t50 = z2 ^ z12;
+	t51 = z2 ^ z5;
+	t52 = z7 ^ z8;
+	t53 = z0 ^ z3;
+	t54 = z6 ^ z7;
+	t55 = z16 ^ z17;
+	t56 = z12 ^ t48;
+	t57 = t50 ^ t53;
+	t58 = z4 ^ t46;
+	t59 = z3 ^ t54;
+	t60 = t46 ^ t57;
+	t61 = z14 ^ t57;
+	t62 = t52 ^ t58;
+	t63 = t49 ^ t58;
+	t64 = z4 ^ t59;
+	t65 = t61 ^ t62;
+	t66 = z1 ^ t63;
+	s0 = t59 ^ t63;
+	s6 = t56 ^ ~t62;
+	s7 = t48 ^ ~t60;
+	t67 = t64 ^ t65;
+	s3 = t53 ^ t66;
+	s4 = t51 ^ t66;
+	s5 = t47 ^ t65;
+	s1 = t64 ^ ~s3;
+	s2 = t55 ^ ~t67;
+
+	q[7] = s0;
+	q[6] = s1;
+	q[5] = s2;
+	q[4] = s3;
+	q[3] = s4;
+	q[2] = s5;
+	q[1] = s6;
+	q[0] = s7;
+}
+
+//! Inverse of the S-box affine transform including the constant. Since the S-box is the
+//! affine transform of the field inverse, the inverse S-box is this transform applied on
+//! both sides of the forward S-box
+static void
+aes_bitslice_inv_affine(uint64_t* q) {
+	uint64_t y[8];
+	unsigned int ibit;
+	for (ibit = 0; ibit < 8; ++ibit)
+		y[ibit] = q[ibit];
+	for (ibit = 0; ibit < 8; ++ibit)
+		q[ibit] = y[(ibit + 2) & 7] ^ y[(ibit + 5) & 7] ^ y[(ibit + 7) & 7];
+	q[0] = ~q[0];
+	q[2] = ~q[2];
+}
+
+static void
+aes_bitslice_inv_sbox(uint64_t* q) {
+	aes_bitslice_inv_affine(q);
+	aes_bitslice_sbox(q);
+	aes_bitslice_inv_affine(q);
+}
+
+static void
+aes_bitslice_shift_rows(uint64_t* q) {
+	unsigned int ibit;
+	for (ibit = 0; ibit < 8; ++ibit) {
+		uint64_t x = q[ibit];
+		q[ibit] = (x & 0x1111111111111111ULL) | ((x >> 4) & 0x0222022202220222ULL) |
+		          ((x << 12) & 0x2000200020002000ULL) | ((x >> 8) & 0x0044004400440044ULL) |
+		          ((x << 8) & 0x4400440044004400ULL) | ((x >> 12) & 0x0008000800080008ULL) |
+		          ((x << 4) & 0x8880888088808880ULL);
+	}
+}
+
+static void
+aes_bitslice_inv_shift_rows(uint64_t* q) {
+	unsigned int ibit;
+	for (ibit = 0; ibit < 8; ++ibit) {
+		uint64_t x = q[ibit];
+		q[ibit] = (x & 0x1111111111111111ULL) | ((x << 4) & 0x2220222022202220ULL) |
+		          ((x >> 12) & 0x0002000200020002ULL) | ((x << 8) & 0x4400440044004400ULL) |
+		          ((x >> 8) & 0x0044004400440044ULL) | ((x >> 4) & 0x0888088808880888ULL) |
+		          ((x << 12) & 0x8000800080008000ULL);
+	}
+}
+
+//! Rotate rows within each column, row r takes the value of row r + 1
+static FOUNDATION_FORCEINLINE uint64_t
+aes_bitslice_rotate1(uint64_t x) {
+	return ((x >> 1) & 0x7777777777777777ULL) | ((x << 3) & 0x8888888888888888ULL);
+}
+
+//! Rotate rows within each column, row r takes the value of row r + 2
+static FOUNDATION_FORCEINLINE uint64_t
+aes_bitslice_rotate2(uint64_t x) {
+	return ((x >> 2) & 0x3333333333333333ULL) | ((x << 2) & 0xCCCCCCCCCCCCCCCCULL);
+}
+
+//! Multiply by x in GF(2^8) modulo x^8 + x^4 + x^3 + x + 1
+static FOUNDATION_FORCEINLINE void
+aes_bitslice_xtime(uint64_t* q) {
+	uint64_t high = q[7];
+	q[7] = q[6];
+	q[6] = q[5];
+	q[5] = q[4];
+	q[4] = q[3] ^ high;
+	q[3] = q[2] ^ high;
+	q[2] = q[1];
+	q[1] = q[0] ^ high;
+	q[0] = high;
+}
+
+static void
+aes_bitslice_mix_columns(uint64_t* q) {
+	// out[r] = 2 * (a[r] ^ a[r + 1]) ^ a[r + 1] ^ a[r + 2] ^ a[r + 3]
+	uint64_t a1[8];
+	uint64_t t[8];
+	unsigned int ibit;
+	for (ibit = 0; ibit < 8; ++ibit) {
+		a1[ibit] = aes_bitslice_rotate1(q[ibit]);
+		t[ibit] = q[ibit] ^ a1[ibit];
+		q[ibit] = a1[ibit] ^ aes_bitslice_rotate2(t[ibit]);
+	}
+	aes_bitslice_xtime(t);
+	for (ibit = 0; ibit < 8; ++ibit)
+		q[ibit] ^= t[ibit];
+}
+
+static void
+aes_bitslice_inv_mix_columns(uint64_t* q) {
+	// Inverse mix columns is mix columns after adding 4 * (a[r] ^ a[r + 2])
+	uint64_t t[8];
+	unsigned int ibit;
+	for (ibit = 0; ibit < 8; ++ibit)
+		t[ibit] = q[ibit] ^ aes_bitslice_rotate2(q[ibit]);
+	aes_bitslice_xtime(t);
+	aes_bitslice_xtime(t);
+	for (ibit = 0; ibit < 8; ++ibit)
+		q[ibit] ^= t[ibit];
+	aes_bitslice_mix_columns(q);
+}
+
+static FOUNDATION_FORCEINLINE void
+aes_bitslice_add_round_key(uint64_t* q, const uint64_t* key) {
+	unsigned int ibit;
+	for (ibit = 0; ibit < 8; ++ibit)
+		q[ibit] ^= key[ibit];
+}
+
+static void
+aes_bitslice_encrypt(const aes_t* aes, uint64_t* q) {
+	unsigned int round;
+	aes_bitslice_add_round_key(q, aes->bitsliced_key);
+	for (round = 1; round < aes->rounds; ++round) {
+		aes_bitslice_sbox(q);
+		aes_bitslice_shift_rows(q);
+		aes_bitslice_mix_columns(q);
+		aes_bitslice_add_round_key(q, aes->bitsliced_key + (round * 8));
+	}
+	aes_bitslice_sbox(q);
+	aes_bitslice_shift_rows(q);
+	aes_bitslice_add_round_key(q, aes->bitsliced_key + (aes->rounds * 8));
+}
+
+static void
+aes_bitslice_decrypt(const aes_t* aes, uint64_t* q) {
+	unsigned int round;
+	aes_bitslice_add_round_key(q, aes->bitsliced_key + (aes->rounds * 8));
+	for (round = aes->rounds - 1; round > 0; --round) {
+		aes_bitslice_inv_shift_rows(q);
+		aes_bitslice_inv_sbox(q);
+		aes_bitslice_add_round_key(q, aes->bitsliced_key + (round * 8));
+		aes_bitslice_inv_mix_columns(q);
+	}
+	aes_bitslice_inv_shift_rows(q);
+	aes_bitslice_inv_sbox(q);
+	aes_bitslice_add_round_key(q, aes->bitsliced_key);
+}
+
+static void
+aes_crypt_blocks_generic(const aes_t* aes, unsigned char* data, size_t blocks, bool encrypt) {
+	unsigned char buffer[AES_BLOCKSIZE * 4];
+	uint64_t q[8];
+	while (blocks) {
+		size_t count = (blocks < 4) ? blocks : 4;
+		size_t size = count * AES_BLOCKSIZE;
+		unsigned char* block = data;
+		if (count < 4) {
+			memcpy(buffer, data, size);
+			memset(buffer + size, 0, sizeof(buffer) - size);
+			block = buffer;
+		}
+		aes_bitslice_pack(q, block);
+		if (encrypt)
+			aes_bitslice_encrypt(aes, q);
+		else
+			aes_bitslice_decrypt(aes, q);
+		aes_bitslice_unpack(block, q);
+		if (count < 4)
+			memcpy(data, buffer, size);
+		data += size;
+		blocks -= count;
+	}
+}
+
+static void
+aes_encrypt_blocks_generic(const aes_t* aes, unsigned char* data, size_t blocks) {
+	aes_crypt_blocks_generic(aes, data, blocks, true);
+}
+
+static void
+aes_decrypt_blocks_generic(const aes_t* aes, unsigned char* data, size_t blocks) {
+	aes_crypt_blocks_generic(aes, data, blocks, false);
+}
+
+#if AES_X86
+
+#define AES_X86_LOAD8(key)                                                                    \
+	b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 0 * 16)), key); \
+	b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 1 * 16)), key); \
+	b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 2 * 16)), key); \
+	b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 3 * 16)), key); \
+	b4 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 4 * 16)), key); \
+	b5 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 5 * 16)), key); \
+	b6 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 6 * 16)), key); \
+	b7 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(data + 7 * 16)), key)
+
+#define AES_X86_ROUND8(op, key) \
+	b0 = op(b0, key);           \
+	b1 = op(b1, key);           \
+	b2 = op(b2, key);           \
+	b3 = op(b3, key);           \
+	b4 = op(b4, key);           \
+	b5 = op(b5, key);           \
+	b6 = op(b6, key);           \
+	b7 = op(b7, key)
+
+#define AES_X86_STORE8()                                        \
+	_mm_storeu_si128((__m128i*)(void*)(data + 0 * 16), b0); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 1 * 16), b1); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 2 * 16), b2); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 3 * 16), b3); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 4 * 16), b4); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 5 * 16), b5); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 6 * 16), b6); \
+	_mm_storeu_si128((__m128i*)(void*)(data + 7 * 16), b7)
+
+// Eight independent blocks in flight hide the latency of the AES round instructions
+#define AES_X86_CRYPT_BLOCKS(keys, round_op, last_op)                                               \
+	__m128i key[AES_MAXROUNDS + 1];                                                                 \
+	__m128i b0, b1, b2, b3, b4, b5, b6, b7;                                                         \
+	unsigned int round;                                                                             \
+	const unsigned int rounds = aes->rounds;                                                        \
+	for (round = 0; round <= rounds; ++round)                                                       \
+		key[round] = _mm_loadu_si128((const __m128i*)(const void*)(keys + (round * AES_BLOCKSIZE))); \
+	for (; blocks >= 8; blocks -= 8, data += 8 * AES_BLOCKSIZE) {                                   \
+		AES_X86_LOAD8(key[0]);                                                                      \
+		for (round = 1; round < rounds; ++round) {                                                  \
+			AES_X86_ROUND8(round_op, key[round]);                                                   \
+		}                                                                                           \
+		AES_X86_ROUND8(last_op, key[rounds]);                                                       \
+		AES_X86_STORE8();                                                                           \
+	}                                                                                               \
+	for (; blocks; --blocks, data += AES_BLOCKSIZE) {                                               \
+		b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)data), key[0]);             \
+		for (round = 1; round < rounds; ++round)                                                    \
+			b0 = round_op(b0, key[round]);                                                          \
+		b0 = last_op(b0, key[rounds]);                                                              \
+		_mm_storeu_si128((__m128i*)(void*)data, b0);                                                \
+	}
+
+AES_TARGET("aes,sse2")
+static void
+aes_encrypt_blocks_aesni(const aes_t* aes, unsigned char* data, size_t blocks) {
+	AES_X86_CRYPT_BLOCKS(aes->encrypt_key, _mm_aesenc_si128, _mm_aesenclast_si128)
+}
+
+AES_TARGET("aes,sse2")
+static void
+aes_decrypt_blocks_aesni(const aes_t* aes, unsigned char* data, size_t blocks) {
+	AES_X86_CRYPT_BLOCKS(aes->decrypt_key, _mm_aesdec_si128, _mm_aesdeclast_si128)
+}
+
+#elif AES_ARM
+
+// The ARMv8 round instructions add the round key first (AESE/AESD) and do the (inverse) mix
+// columns step separately (AESMC/AESIMC), shifting the key schedule by one round compared to x86
+#define AES_ARM_CRYPT_BLOCKS(keys, round_op, mix_op)                                           \
+	uint8x16_t key[AES_MAXROUNDS + 1];                                                         \
+	uint8x16_t b0, b1, b2, b3;                                                                 \
+	unsigned int round;                                                                        \
+	const unsigned int rounds = aes->rounds;                                                   \
+	for (round = 0; round <= rounds; ++round)                                                  \
+		key[round] = vld1q_u8(keys + (round * AES_BLOCKSIZE));                                 \
+	for (; blocks >= 4; blocks -= 4, data += 4 * AES_BLOCKSIZE) {                              \
+		b0 = vld1q_u8(data + 0 * 16);                                                          \
+		b1 = vld1q_u8(data + 1 * 16);                                                          \
+		b2 = vld1q_u8(data + 2 * 16);                                                          \
+		b3 = vld1q_u8(data + 3 * 16);                                                          \
+		for (round = 0; round < rounds - 1; ++round) {                                         \
+			b0 = mix_op(round_op(b0, key[round]));                                             \
+			b1 = mix_op(round_op(b1, key[round]));                                             \
+			b2 = mix_op(round_op(b2, key[round]));                                             \
+			b3 = mix_op(round_op(b3, key[round]));                                             \
+		}                                                                                      \
+		vst1q_u8(data + 0 * 16, veorq_u8(round_op(b0, key[rounds - 1]), key[rounds]));         \
+		vst1q_u8(data + 1 * 16, veorq_u8(round_op(b1, key[rounds - 1]), key[rounds]));         \
+		vst1q_u8(data + 2 * 16, veorq_u8(round_op(b2, key[rounds - 1]), key[rounds]));         \
+		vst1q_u8(data + 3 * 16, veorq_u8(round_op(b3, key[rounds - 1]), key[rounds]));         \
+	}                                                                                          \
+	for (; blocks; --blocks, data += AES_BLOCKSIZE) {                                          \
+		b0 = vld1q_u8(data);                                                                   \
+		for (round = 0; round < rounds - 1; ++round)                                           \
+			b0 = mix_op(round_op(b0, key[round]));                                             \
+		vst1q_u8(data, veorq_u8(round_op(b0, key[rounds - 1]), key[rounds]));                  \
+	}
+
+static void
+aes_encrypt_blocks_arm(const aes_t* aes, unsigned char* data, size_t blocks) {
+	AES_ARM_CRYPT_BLOCKS(aes->encrypt_key, vaeseq_u8, vaesmcq_u8)
+}
+
+static void
+aes_decrypt_blocks_arm(const aes_t* aes, unsigned char* data, size_t blocks) {
+	AES_ARM_CRYPT_BLOCKS(aes->decrypt_key, vaesdq_u8, vaesimcq_u8)
+}
+
+#endif
+
+//! Select block functions from CPU features detected at runtime. Resolving is
+//! idempotent, concurrent calls store the same function pointers
+void
+internal_aes_resolve(void) {
+	aes_blocks_fn encrypt = aes_encrypt_blocks_generic;
+	aes_blocks_fn decrypt = aes_decrypt_blocks_generic;
+#if AES_X86
+	if (system_cpu_has_feature(CPU_FEATURE_AES | CPU_FEATURE_SSE2)) {
+		encrypt = aes_encrypt_blocks_aesni;
+		decrypt = aes_decrypt_blocks_aesni;
+	}
+#elif AES_ARM
+	if (system_cpu_has_feature(CPU_FEATURE_AES)) {
+		encrypt = aes_encrypt_blocks_arm;
+		decrypt = aes_decrypt_blocks_arm;
+	}
+#endif
+	aes_encrypt_blocks = encrypt;
+	aes_decrypt_blocks = decrypt;
+}
+
+static void
+aes_sub_word(unsigned char* word) {
+	unsigned char buffer[AES_BLOCKSIZE * 4];
+	uint64_t q[8];
+	memset(buffer, 0, sizeof(buffer));
+	memcpy(buffer, word, 4);
+	aes_bitslice_pack(q, buffer);
+	aes_bitslice_sbox(q);
+	aes_bitslice_unpack(buffer, q);
+	memcpy(word, buffer, 4);
+}
+
+static FOUNDATION_FORCEINLINE unsigned char
+aes_xtime(unsigned char value) {
+	return (unsigned char)((value << 1) ^ (0x1B & (0U - (unsigned int)(value >> 7))));
+}
+
+static void
+aes_inv_mix_columns(unsigned char* block) {
+	unsigned int icol, irow;
+	for (icol = 0; icol < 4; ++icol) {
+		unsigned char* column = block + (icol * 4);
+		unsigned char a[4], a2[4], a4[4], a8[4];
+		for (irow = 0; irow < 4; ++irow) {
+			a[irow] = column[irow];
+			a2[irow] = aes_xtime(a[irow]);
+			a4[irow] = aes_xtime(a2[irow]);
+			a8[irow] = aes_xtime(a4[irow]);
+		}
+		// 14 * a[r] ^ 11 * a[r + 1] ^ 13 * a[r + 2] ^ 9 * a[r + 3]
+		for (irow = 0; irow < 4; ++irow) {
+			unsigned int r1 = (irow + 1) & 3;
+			unsigned int r2 = (irow + 2) & 3;
+			unsigned int r3 = (irow + 3) & 3;
+			column[irow] = (unsigned char)((a8[irow] ^ a4[irow] ^ a2[irow]) ^ (a8[r1] ^ a2[r1] ^ a[r1]) ^
+			                               (a8[r2] ^ a4[r2] ^ a[r2]) ^ (a8[r3] ^ a[r3]));
+		}
+	}
+}
+
+aes_t*
+aes_allocate(void) {
+	return memory_allocate(0, sizeof(aes_t), 0U, MEMORY_PERSISTENT);
+}
+
+void
+aes_deallocate(aes_t* aes) {
+	aes_finalize(aes);
+	memory_deallocate(aes);
+}
+
+void
+aes_initialize(aes_t* aes, const void* key, size_t length) {
+	unsigned char keydata[32];
+	unsigned char buffer[AES_BLOCKSIZE * 4];
+	unsigned char temp[4];
+	unsigned char* ekey = aes->encrypt_key;
+	unsigned char* dkey = aes->decrypt_key;
+	size_t words, iword, total, ibyte;
+	unsigned int round;
+
+	memset(aes, 0, sizeof(aes_t));
+	memset(keydata, 0, sizeof(keydata));
+	memcpy(keydata, key, (length < sizeof(keydata)) ? length : sizeof(keydata));
+	words = (length >= 32) ? 8 : ((length >= 24) ? 6 : 4);
+
+	aes->rounds = (unsigned int)words + 6;
+	total = 4 * (aes->rounds + 1);
+
+	// FIPS-197 key expansion
+	memcpy(ekey, keydata, words * 4);
+	for (iword = words; iword < total; ++iword) {
+		memcpy(temp, ekey + ((iword - 1) * 4), 4);
+		if (!(iword % words)) {
+			unsigned char first = temp[0];
+			temp[0] = temp[1];
+			temp[1] = temp[2];
+			temp[2] = temp[3];
+			temp[3] = first;
+			aes_sub_word(temp);
+			temp[0] ^= aes_rcon[(iword / words) - 1];
+		} else if ((words > 6) && ((iword % words) == 4)) {
+			aes_sub_word(temp);
+		}
+		for (ibyte = 0; ibyte < 4; ++ibyte)
+			ekey[(iword * 4) + ibyte] = ekey[((iword - words) * 4) + ibyte] ^ temp[ibyte];
+	}
+
+	// Equivalent inverse cipher keys, reversed with inverse mix columns applied to inner rounds
+	memcpy(dkey, ekey + (aes->rounds * AES_BLOCKSIZE), AES_BLOCKSIZE);
+	memcpy(dkey + (aes->rounds * AES_BLOCKSIZE), ekey, AES_BLOCKSIZE);
+	for (round = 1; round < aes->rounds; ++round) {
+		memcpy(dkey + (round * AES_BLOCKSIZE), ekey + ((aes->rounds - round) * AES_BLOCKSIZE), AES_BLOCKSIZE);
+		aes_inv_mix_columns(dkey + (round * AES_BLOCKSIZE));
+	}
+
+	// Bitsliced keys, replicated in all four block positions
+	for (round = 0; round <= aes->rounds; ++round) {
+		for (ibyte = 0; ibyte < 4; ++ibyte)
+			memcpy(buffer + (ibyte * AES_BLOCKSIZE), ekey + (round * AES_BLOCKSIZE), AES_BLOCKSIZE);
+		aes_bitslice_pack(aes->bitsliced_key + (round * 8), buffer);
+	}
+
+	if (!aes_encrypt_blocks)
+		internal_aes_resolve();
+
+	// Reset memory for paranoids
+	memset(keydata, 0, sizeof(keydata));
+	memset(buffer, 0, sizeof(buffer));
+	memset(temp, 0, sizeof(temp));
+}
+
+void
+aes_finalize(aes_t* aes) {
+	if (aes)
+		memset(aes, 0, sizeof(aes_t));
+}
+
+static void
+aes_crypt_ctr(const aes_t* aes, unsigned char* data, size_t length, uint128_t vec) {
+	unsigned char keystream[AES_BLOCKSIZE * AES_CHUNK_BLOCKS];
+	uint64_t high = vec.word[0];
+	uint64_t low = vec.word[1];
+	size_t iblock, ibyte;
+
+	while (length) {
+		size_t blocks = (length + AES_BLOCKSIZE - 1) / AES_BLOCKSIZE;
+		size_t size;
+		if (blocks > AES_CHUNK_BLOCKS)
+			blocks = AES_CHUNK_BLOCKS;
+		for (iblock = 0; iblock < blocks; ++iblock) {
+			aes_vector_block(keystream + (iblock * AES_BLOCKSIZE), high, low);
+			if (!++low)
+				++high;
+		}
+		aes_encrypt_blocks(aes, keystream, blocks);
+
+		size = (length < (blocks * AES_BLOCKSIZE)) ? length : (blocks * AES_BLOCKSIZE);
+		for (iblock = 0; iblock < (size / AES_BLOCKSIZE); ++iblock)
+			aes_xor_block(data + (iblock * AES_BLOCKSIZE), keystream + (iblock * AES_BLOCKSIZE));
+		for (ibyte = iblock * AES_BLOCKSIZE; ibyte < size; ++ibyte)
+			data[ibyte] ^= keystream[ibyte];
+
+		data += size;
+		length -= size;
+	}
+
+	// Reset memory for paranoids
+	memset(keystream, 0, sizeof(keystream));
+}
+
+void
+aes_encrypt(const aes_t* aes, void* data, size_t length, blockcipher_mode_t mode, uint128_t vec) {
+	unsigned char* cur = data;
+	unsigned char chain[AES_BLOCKSIZE];
+	size_t blocks = length / AES_BLOCKSIZE;
+
+	if (!data || !length)
+		return;
+
+	if (mode == BLOCKCIPHER_CTR) {
+		aes_crypt_ctr(aes, cur, length, vec);
+		return;
+	}
+
+	aes_vector_block(chain, vec.word[0], vec.word[1]);
+
+	switch (mode) {
+		default:
+		case BLOCKCIPHER_ECB:
+			aes_encrypt_blocks(aes, cur, blocks);
+			break;
+
+		case BLOCKCIPHER_CBC:
+			for (; blocks; --blocks, cur += AES_BLOCKSIZE) {
+				aes_xor_block(cur, chain);
+				aes_encrypt_blocks(aes, cur, 1);
+				memcpy(chain, cur, AES_BLOCKSIZE);
+			}
+			break;
+
+		case BLOCKCIPHER_CFB:
+			for (; blocks; --blocks, cur += AES_BLOCKSIZE) {
+				aes_encrypt_blocks(aes, chain, 1);
+				aes_xor_block(cur, chain);
+				memcpy(chain, cur, AES_BLOCKSIZE);
+			}
+			break;
+
+		case BLOCKCIPHER_OFB:
+			for (; blocks; --blocks, cur += AES_BLOCKSIZE) {
+				aes_encrypt_blocks(aes, chain, 1);
+				aes_xor_block(cur, chain);
+			}
+			break;
+	}
+
+	// Reset memory for paranoids
+	memset(chain, 0, sizeof(chain));
+}
+
+void
+aes_decrypt(const aes_t* aes, void* data, size_t length, blockcipher_mode_t mode, uint128_t vec) {
+	unsigned char* cur = data;
+	unsigned char chain[AES_BLOCKSIZE];
+	unsigned char buffer[AES_BLOCKSIZE * AES_CHUNK_BLOCKS];
+	size_t blocks = length / AES_BLOCKSIZE;
+	size_t iblock, count;
+
+	if (!data || !length)
+		return;
+
+	if (mode == BLOCKCIPHER_CTR) {
+		aes_crypt_ctr(aes, cur, length, vec);
+		return;
+	}
+
+	aes_vector_block(chain, vec.word[0], vec.word[1]);
+
+	switch (mode) {
+		default:
+		case BLOCKCIPHER_ECB:
+			aes_decrypt_blocks(aes, cur, blocks);
+			break;
+
+		case BLOCKCIPHER_CBC:
+			// Decryption is parallel, each plaintext block depends on two ciphertext blocks
+			for (; blocks; blocks -= count, cur += count * AES_BLOCKSIZE) {
+				count = (blocks < AES_CHUNK_BLOCKS) ? blocks : AES_CHUNK_BLOCKS;
+				memcpy(buffer, cur, count * AES_BLOCKSIZE);
+				aes_decrypt_blocks(aes, cur, count);
+				aes_xor_block(cur, chain);
+				for (iblock = 1; iblock < count; ++iblock)
+					aes_xor_block(cur + (iblock * AES_BLOCKSIZE), buffer + ((iblock - 1) * AES_BLOCKSIZE));
+				memcpy(chain, buffer + ((count - 1) * AES_BLOCKSIZE), AES_BLOCKSIZE);
+			}
+			break;
+
+		case BLOCKCIPHER_CFB:
+			// Decryption is parallel, the keystream is the encrypted previous ciphertext block
+			for (; blocks; blocks -= count, cur += count * AES_BLOCKSIZE) {
+				count = (blocks < AES_CHUNK_BLOCKS) ? blocks : AES_CHUNK_BLOCKS;
+				memcpy(buffer, chain, AES_BLOCKSIZE);
+				memcpy(buffer + AES_BLOCKSIZE, cur, (count - 1) * AES_BLOCKSIZE);
+				memcpy(chain, cur + ((count - 1) * AES_BLOCKSIZE), AES_BLOCKSIZE);
+				aes_encrypt_blocks(aes, buffer, count);
+				for (iblock = 0; iblock < count; ++iblock)
+					aes_xor_block(cur + (iblock * AES_BLOCKSIZE), buffer + (iblock * AES_BLOCKSIZE));
+			}
+			break;
+
+		case BLOCKCIPHER_OFB:
+			for (; blocks; --blocks, cur += AES_BLOCKSIZE) {
+				aes_encrypt_blocks(aes, chain, 1);
+				aes_xor_block(cur, chain);
+			}
+			break;
+	}
+
+	// Reset memory for paranoids
+	memset(chain, 0, sizeof(chain));
+	memset(buffer, 0, sizeof(buffer));
+}
@@ -0,0 +1,81 @@
+/* aes.h  -  Foundation library  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#pragma once
+
+/*! \file aes.h
+\brief AES encryption and decryption
+
+AES (Rijndael) encryption and decryption with 128, 192 or 256 bit keys as specified in FIPS-197.
+Uses the x86 AES-NI or ARMv8 cryptography extension instructions when available at runtime, and
+falls back to a bitsliced constant time implementation without secret dependent table lookups.
+
+The initialization vector for the block cipher modes is the 16 byte block made from the two
+words of the vector in big endian byte order, word[0] first. In counter mode the block is
+incremented as a 128-bit big endian integer for each block, so data at byte offset N can be
+processed independently by adding N / 16 to the vector.
+
+The AES state is not modified by encryption or decryption and can be shared by multiple threads
+once initialized. */
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+/*! Allocate an AES state object. Does NOT initialize the object, must be done with
+a call to #aes_initialize before using the object for encryption/decryption.
+\return New AES state object */
+FOUNDATION_API aes_t*
+aes_allocate(void);
+
+/*! Deallocate an AES state object and free resources
+\param aes AES state object to deallocate */
+FOUNDATION_API void
+aes_deallocate(aes_t* aes);
+
+/*! Initialize the AES state object with the given key. The key size selects AES-128,
+AES-192 or AES-256. Other key sizes are truncated to the closest smaller valid size, keys
+shorter than 16 bytes are zero padded. After a call to this function the state object can
+be used for encryption/decryption.
+\param aes AES state object
+\param key Key data
+\param length Length of key data in bytes, 16, 24 or 32 */
+FOUNDATION_API void
+aes_initialize(aes_t* aes, const void* key, size_t length);
+
+/*! Finalize an AES state object, clearing the key schedule
+\param aes AES state object to finalize */
+FOUNDATION_API void
+aes_finalize(aes_t* aes);
+
+/*! Encrypt data using the given AES state object. Encryption is done in-place, no memory
+allocation is done internally and the data buffer has no alignment requirement. Length is
+expected to be a multiple of 16 bytes (any extra unaligned data will be ignored), except in
+counter mode which handles any length.
+\param aes AES state object
+\param data Data buffer
+\param length Length of data buffer in bytes
+\param mode Mode of operation (see #blockcipher_mode_t)
+\param vec Initialization vector, or initial counter block in counter mode */
+FOUNDATION_API void
+aes_encrypt(const aes_t* aes, void* data, size_t length, blockcipher_mode_t mode, uint128_t vec);
+
+/*! Decrypt data using the given AES state object. Decryption is done in-place, no memory
+allocation is done internally and the data buffer has no alignment requirement. Length is
+expected to be a multiple of 16 bytes (any extra unaligned data will be ignored), except in
+counter mode which handles any length.
+\param aes AES state object
+\param data Data buffer
+\param length Length of data buffer in bytes
+\param mode Mode of operation (see #blockcipher_mode_t)
+\param vec Initialization vector, or initial counter block in counter mode */
+FOUNDATION_API void
+aes_decrypt(const aes_t* aes, void* data, size_t length, blockcipher_mode_t mode, uint128_t vec);
@@ -11,6 +11,28 @@
  */
 
 #include <foundation/foundation.h>
+#include <foundation/internal.h>
+
+#if FOUNDATION_COMPILER_CLANG
+// Unaligned loads and stores are done with explicit unaligned intrinsics
+#pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define BASE64_X86 1
+#else
+#define BASE64_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && defined(__ARM_NEON)
+#define BASE64_ARM 1
+#else
+#define BASE64_ARM 0
+#endif
+
+// Size of the text buffer used to encode and decode in base64 streams
+#define BASE64_STREAM_CHUNK 4096
 
 /*lint -e{840}  We use null character in string literal deliberately here*/
 static const char base64_decode_table[] =
@@ -18,22 +40,35 @@ static const char base64_decode_table[] =
     "abcdefghijklmnopq";
 static const char base64_encode_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-size_t
-base64_encode(const void* source, size_t size, char* destination, size_t capacity) {
-	char* ptr;
-	const unsigned char* carr;
-	unsigned char bits;
+//! Encode complete groups of three bytes, returning number of source bytes consumed
+typedef size_t (*base64_encode_groups_fn)(const unsigned char* source, size_t size, char* destination);
 
-	if (capacity > 0) {
-		size_t maxsize = ((capacity - 1) / 4) * 3;
-		if (maxsize < size)
-			size = maxsize;
-	} else {
-		return 0;
-	}
+//! Decode complete groups of four valid characters up to the first invalid character, returning
+//! number of groups decoded
+typedef size_t (*base64_decode_groups_fn)(const char* source, size_t size, unsigned char* destination,
+                                          size_t groups);
+
+static base64_encode_groups_fn base64_encode_groups;
+static base64_decode_groups_fn base64_decode_valid_groups;
+
+//! Map character to decoded value plus 62, or zero if not a valid base64 character
+static FOUNDATION_FORCEINLINE char
+base64_decode_value(char c) {
+	return (c < 43 || c > 122) ? 0 : base64_decode_table[c - 43];
+}
+
+static FOUNDATION_FORCEINLINE void
+base64_decode_group(const unsigned char* in, unsigned char* out) {
+	out[0] = (unsigned char)((in[0] << 2) | (in[1] >> 4));
+	out[1] = (unsigned char)((in[1] << 4) | (in[2] >> 2));
+	out[2] = (unsigned char)(((in[2] << 6) & 0xc0) | in[3]);
+}
 
-	carr = (const unsigned char*)source;
-	ptr = destination;
+static size_t
+base64_encode_groups_generic(const unsigned char* source, size_t size, char* destination) {
+	const unsigned char* carr = source;
+	char* ptr = destination;
+	unsigned char bits;
 	while (size > 2) {
 		bits = (*carr >> 2) & 0x3F;
 		*ptr++ = base64_encode_table[bits];
@@ -46,6 +81,344 @@ base64_encode(const void* source, size_t size, char* destination, size_t capacit
 		size -= 3;
 		carr += 3;
 	}
+	return (size_t)pointer_diff(carr, source);
+}
+
+static size_t
+base64_decode_groups_generic(const char* source, size_t size, unsigned char* destination, size_t groups) {
+	size_t igroup;
+	for (igroup = 0; (igroup < groups) && (size >= 4); ++igroup, size -= 4, source += 4, destination += 3) {
+		unsigned char in[4];
+		char v0 = base64_decode_value(source[0]);
+		char v1 = base64_decode_value(source[1]);
+		char v2 = base64_decode_value(source[2]);
+		char v3 = base64_decode_value(source[3]);
+		if (!v0 || !v1 || !v2 || !v3)
+			break;
+		in[0] = (unsigned char)(v0 - 62);
+		in[1] = (unsigned char)(v1 - 62);
+		in[2] = (unsigned char)(v2 - 62);
+		in[3] = (unsigned char)(v3 - 62);
+		base64_decode_group(in, destination);
+	}
+	return igroup;
+}
+
+#if BASE64_X86
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#define BASE64_TARGET(isa)
+#else
+#include <immintrin.h>
+#define BASE64_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Vectorized encoding and decoding as described by Wojciech Mula and Daniel Lemire in
+// "Faster Base64 Encoding and Decoding Using AVX2 Instructions". Encoding splits each group of
+// three bytes into four 6-bit indices with multiplies and translates indices to characters with
+// a per-range offset lookup. Decoding validates and translates characters with nibble lookups,
+// any invalid character in a vector leaves the vector to the scalar path which discards it
+
+BASE64_TARGET("ssse3")
+static FOUNDATION_FORCEINLINE __m128i
+base64_encode_translate_ssse3(__m128i in) {
+	// Split 12 bytes into 16 6-bit indices, one per byte
+	__m128i t0, t1, t2, t3, indices, offset;
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+	t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+	t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+	t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+	indices = _mm_or_si128(t1, t3);
+
+	// Offset from index to character by range: A-Z, a-z, 0-9, +, /
+	offset = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	offset = _mm_sub_epi8(offset, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+	offset = _mm_shuffle_epi8(_mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0), offset);
+	return _mm_add_epi8(indices, offset);
+}
+
+BASE64_TARGET("ssse3")
+static size_t
+base64_encode_groups_ssse3(const unsigned char* source, size_t size, char* destination) {
+	size_t offset = 0;
+	// Loads 16 bytes and encodes the first 12
+	for (; size - offset >= 16; offset += 12, destination += 16) {
+		__m128i in = _mm_loadu_si128((const __m128i*)(const void*)(source + offset));
+		_mm_storeu_si128((__m128i*)(void*)destination, base64_encode_translate_ssse3(in));
+	}
+	return offset + base64_encode_groups_generic(source + offset, size - offset, destination);
+}
+
+BASE64_TARGET("avx2")
+static size_t
+base64_encode_groups_avx2(const unsigned char* source, size_t size, char* destination) {
+	const __m256i shuffle =
+	    _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+	const __m256i lut = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0, 65, 71, -4, -4,
+	                                     -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+	size_t offset = 0;
+	// Loads 12 bytes to each lane and encodes 24 bytes
+	for (; size - offset >= 28; offset += 24, destination += 32) {
+		__m128i lo = _mm_loadu_si128((const __m128i*)(const void*)(source + offset));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(const void*)(source + offset + 12));
+		__m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		__m256i t0, t1, t2, t3, indices, translate;
+		in = _mm256_shuffle_epi8(in, shuffle);
+		t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+		t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+		t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+		t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+		indices = _mm256_or_si256(t1, t3);
+
+		translate = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+		translate = _mm256_sub_epi8(translate, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+		translate = _mm256_shuffle_epi8(lut, translate);
+		_mm256_storeu_si256((__m256i*)(void*)destination, _mm256_add_epi8(indices, translate));
+	}
+	return offset + base64_encode_groups_ssse3(source + offset, size - offset, destination);
+}
+
+BASE64_TARGET("ssse3")
+static size_t
+base64_decode_groups_ssse3(const char* source, size_t size, unsigned char* destination, size_t groups) {
+	const __m128i lut_lo =
+	    _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m128i lut_hi =
+	    _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i mask = _mm_set1_epi8(0x2F);
+	size_t decoded = 0;
+	for (; (size >= 16) && (groups - decoded >= 4); size -= 16, source += 16, destination += 12, decoded += 4) {
+		__m128i in = _mm_loadu_si128((const __m128i*)(const void*)source);
+		__m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask);
+		__m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(in, mask));
+		__m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+		__m128i roll, merged, out;
+		uint32_t tail;
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())))
+			break;
+		roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), hi_nibbles));
+		in = _mm_add_epi8(in, roll);
+
+		// Pack four 6-bit values to three bytes per 32-bit word, then compact the words
+		merged = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+		out = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+		out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		_mm_storel_epi64((__m128i*)(void*)destination, out);
+		tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+		memcpy(destination + 8, &tail, sizeof(tail));
+	}
+	return decoded + base64_decode_groups_generic(source, size, destination, groups - decoded);
+}
+
+BASE64_TARGET("avx2")
+static size_t
+base64_decode_groups_avx2(const char* source, size_t size, unsigned char* destination, size_t groups) {
+	const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+	                                        0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+	                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+	                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+	                                          -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4,
+	                                         10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const __m256i mask = _mm256_set1_epi8(0x2F);
+	size_t decoded = 0;
+	for (; (size >= 32) && (groups - decoded >= 8); size -= 32, source += 32, destination += 24, decoded += 8) {
+		__m256i in = _mm256_loadu_si256((const __m256i*)(const void*)source);
+		__m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask);
+		__m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(in, mask));
+		__m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+		__m256i roll, merged, out;
+		if (!_mm256_testz_si256(lo, hi))
+			break;
+		roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')), hi_nibbles));
+		in = _mm256_add_epi8(in, roll);
+
+		merged = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+		out = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+		out = _mm256_shuffle_epi8(out, shuffle);
+		out = _mm256_permutevar8x32_epi32(out, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+		_mm_storeu_si128((__m128i*)(void*)destination, _mm256_castsi256_si128(out));
+		_mm_storel_epi64((__m128i*)(void*)(destination + 16), _mm256_extracti128_si256(out, 1));
+	}
+	return decoded + base64_decode_groups_ssse3(source, size, destination, groups - decoded);
+}
+
+#elif BASE64_ARM
+#include <arm_neon.h>
+
+static const unsigned char base64_decode_neon_table[128] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+// De-interleaving loads and interleaving stores split groups into separate vectors for each
+// byte or character position, the 64 entry table lookup instruction translates indices
+static size_t
+base64_encode_groups_neon(const unsigned char* source, size_t size, char* destination) {
+	const unsigned char* table = (const unsigned char*)base64_encode_table;
+	const uint8x16_t mask = vdupq_n_u8(0x3F);
+	uint8x16x4_t lut;
+	size_t offset = 0;
+	lut.val[0] = vld1q_u8(table);
+	lut.val[1] = vld1q_u8(table + 16);
+	lut.val[2] = vld1q_u8(table + 32);
+	lut.val[3] = vld1q_u8(table + 48);
+	for (; size - offset >= 48; offset += 48, destination += 64) {
+		uint8x16x3_t in = vld3q_u8(source + offset);
+		uint8x16x4_t out;
+		out.val[0] = vshrq_n_u8(in.val[0], 2);
+		out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+		out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+		out.val[3] = vandq_u8(in.val[2], mask);
+		out.val[0] = vqtbl4q_u8(lut, out.val[0]);
+		out.val[1] = vqtbl4q_u8(lut, out.val[1]);
+		out.val[2] = vqtbl4q_u8(lut, out.val[2]);
+		out.val[3] = vqtbl4q_u8(lut, out.val[3]);
+		vst4q_u8((uint8_t*)destination, out);
+	}
+	return offset + base64_encode_groups_generic(source + offset, size - offset, destination);
+}
+
+static size_t
+base64_decode_groups_neon(const char* source, size_t size, unsigned char* destination, size_t groups) {
+	const uint8x16_t offset = vdupq_n_u8(64);
+	uint8x16x4_t lut_lo, lut_hi;
+	size_t decoded = 0;
+	lut_lo.val[0] = vld1q_u8(base64_decode_neon_table);
+	lut_lo.val[1] = vld1q_u8(base64_decode_neon_table + 16);
+	lut_lo.val[2] = vld1q_u8(base64_decode_neon_table + 32);
+	lut_lo.val[3] = vld1q_u8(base64_decode_neon_table + 48);
+	lut_hi.val[0] = vld1q_u8(base64_decode_neon_table + 64);
+	lut_hi.val[1] = vld1q_u8(base64_decode_neon_table + 80);
+	lut_hi.val[2] = vld1q_u8(base64_decode_neon_table + 96);
+	lut_hi.val[3] = vld1q_u8(base64_decode_neon_table + 112);
+	for (; (size >= 64) && (groups - decoded >= 16); size -= 64, source += 64, destination += 48, decoded += 16) {
+		uint8x16x4_t in = vld4q_u8((const uint8_t*)source);
+		uint8x16x3_t out;
+		uint8x16_t a, b, c, d, error;
+		// Characters 0-63 from first table, 64-127 from second table, any high bit is invalid
+		a = vqtbx4q_u8(vqtbl4q_u8(lut_lo, in.val[0]), lut_hi, vsubq_u8(in.val[0], offset));
+		b = vqtbx4q_u8(vqtbl4q_u8(lut_lo, in.val[1]), lut_hi, vsubq_u8(in.val[1], offset));
+		c = vqtbx4q_u8(vqtbl4q_u8(lut_lo, in.val[2]), lut_hi, vsubq_u8(in.val[2], offset));
+		d = vqtbx4q_u8(vqtbl4q_u8(lut_lo, in.val[3]), lut_hi, vsubq_u8(in.val[3], offset));
+		error = vandq_u8(vorrq_u8(vorrq_u8(in.val[0], in.val[1]), vorrq_u8(in.val[2], in.val[3])), vdupq_n_u8(0x80));
+		error = vorrq_u8(error, vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d)));
+		if (vmaxvq_u8(error) > 0x3F)
+			break;
+		out.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		out.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		out.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+		vst3q_u8(destination, out);
+	}
+	return decoded + base64_decode_groups_generic(source, size, destination, groups - decoded);
+}
+
+#endif
+
+static const cpu_dispatch_t base64_encode_candidates[] = {
+#if BASE64_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)base64_encode_groups_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)base64_encode_groups_ssse3},
+#elif BASE64_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)base64_encode_groups_neon},
+#endif
+    {0, (cpu_dispatch_fn)base64_encode_groups_generic}};
+
+static const cpu_dispatch_t base64_decode_candidates[] = {
+#if BASE64_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)base64_decode_groups_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)base64_decode_groups_ssse3},
+#elif BASE64_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)base64_decode_groups_neon},
+#endif
+    {0, (cpu_dispatch_fn)base64_decode_groups_generic}};
+
+//! Select group functions from CPU features detected at runtime. Resolving is
+//! idempotent, concurrent calls store the same function pointers
+void
+internal_base64_resolve(void) {
+	base64_decode_valid_groups = (base64_decode_groups_fn)system_cpu_dispatch(
+	    base64_decode_candidates, sizeof(base64_decode_candidates) / sizeof(base64_decode_candidates[0]));
+	base64_encode_groups = (base64_encode_groups_fn)system_cpu_dispatch(
+	    base64_encode_candidates, sizeof(base64_encode_candidates) / sizeof(base64_encode_candidates[0]));
+}
+
+/*! Decode complete groups of four valid characters, discarding invalid characters.
+Stops at the given number of groups or before a trailing incomplete group
+\param source Source string
+\param size Size of source string
+\param destination Destination buffer, at least 3 * groups bytes
+\param groups Maximum number of groups to decode
+\param consumed Number of source characters consumed
+\return Number of bytes written */
+static size_t
+base64_decode_groups(const char* source, size_t size, unsigned char* destination, size_t groups, size_t* consumed) {
+	size_t offset = 0;
+	size_t written = 0;
+
+	while (groups) {
+		unsigned char in[4];
+		size_t count = 0;
+		size_t cur;
+		size_t valid = base64_decode_valid_groups(source + offset, size - offset, destination + written, groups);
+		offset += valid * 4;
+		written += valid * 3;
+		groups -= valid;
+		if (!groups)
+			break;
+
+		// Group with invalid characters
+		for (cur = offset; (count < 4) && (cur < size); ++cur) {
+			char v = base64_decode_value(source[cur]);
+			if (v)
+				in[count++] = (unsigned char)(v - 62);
+		}
+		if (count < 4)
+			break;
+		base64_decode_group(in, destination + written);
+		offset = cur;
+		written += 3;
+		--groups;
+	}
+
+	*consumed = offset;
+	return written;
+}
+
+size_t
+base64_encode(const void* source, size_t size, char* destination, size_t capacity) {
+	char* ptr;
+	const unsigned char* carr;
+	unsigned char bits;
+	size_t encoded;
+
+	if (capacity > 0) {
+		size_t maxsize = ((capacity - 1) / 4) * 3;
+		if (maxsize < size)
+			size = maxsize;
+	} else {
+		return 0;
+	}
+
+	if (!base64_encode_groups)
+		internal_base64_resolve();
+
+	encoded = base64_encode_groups(source, size, destination);
+	carr = (const unsigned char*)source + encoded;
+	ptr = destination + ((encoded / 3) * 4);
+	size -= encoded;
+
 	if (size == 2) {
 		bits = (*carr >> 2) & 0x3F;
 		*ptr++ = base64_encode_table[bits];
@@ -70,17 +443,25 @@ base64_encode(const void* source, size_t size, char* destination, size_t capacit
 
 size_t
 base64_decode(const char* source, size_t size, void* destination, size_t capacity) {
-	size_t i, blocksize;
+	size_t i, blocksize, consumed;
 	char* cdst = (char*)destination;
 	char* cdstend = cdst + capacity;
+
+	if (!base64_encode_groups)
+		internal_base64_resolve();
+
+	// Complete groups fitting in destination, then remaining partial data
+	cdst += base64_decode_groups(source, size, destination, capacity / 3, &consumed);
+	source += consumed;
+	size -= consumed;
+
 	while (size && (cdst < cdstend)) {
 		unsigned char in[4] = {0, 0, 0, 0};  // Always build blocks of 4 bytes to decode, pad with 0
 		blocksize = 0;
 		for (i = 0; size && (i < 4); i++) {
 			char v = 0;
 			while (size && !v) {  // Consume one valid byte from input, discarding invalid data
-				v = *source++;
-				v = ((v < 43 || v > 122) ? 0 : base64_decode_table[v - 43]);
+				v = base64_decode_value(*source++);
 				if (v) {
 					in[i] = (unsigned char)(v - 62);
 					blocksize++;
@@ -89,14 +470,238 @@ base64_decode(const char* source, size_t size, void* destination, size_t capacit
 			}
 		}
 		if (blocksize > 1) {
-			char out[3];
-			out[0] = (char)((in[0] << 2) | (in[1] >> 4));
-			out[1] = (char)((in[1] << 4) | (in[2] >> 2));
-			out[2] = (char)(((in[2] << 6) & 0xc0) | in[3]);
+			unsigned char out[3];
+			base64_decode_group(in, out);
 			for (i = 0; (i < blocksize - 1) && (cdst < cdstend); ++i)
-				*cdst++ = out[i];
+				*cdst++ = (char)out[i];
 		}
 	}
 
 	return (size_t)pointer_diff(cdst, destination);
 }
+
+static stream_vtable_t base64_stream_vtable;
+
+stream_t*
+base64_stream_allocate(stream_t* stream, bool own) {
+	stream_base64_t* b64stream = memory_allocate(HASH_STREAM, sizeof(stream_base64_t), 8, MEMORY_PERSISTENT);
+	base64_stream_initialize(b64stream, stream, own);
+	return (stream_t*)b64stream;
+}
+
+void
+base64_stream_initialize(stream_base64_t* stream, stream_t* source, bool own) {
+	memset(stream, 0, sizeof(stream_base64_t));
+	stream_initialize((stream_t*)stream, (byteorder_t)source->byteorder);
+
+	stream->type = STREAMTYPE_BASE64;
+	stream->sequential = 1;
+	stream->reliable = source->reliable;
+	stream->inorder = source->inorder;
+	stream->path = string_allocate_format(STRING_CONST("base64://0x%" PRIfixPTR), (uintptr_t)stream);
+	stream->mode = (source->mode & (STREAM_OUT | STREAM_IN)) | STREAM_BINARY;
+	stream->source = source;
+	stream->own = own;
+
+	stream->vtable = &base64_stream_vtable;
+}
+
+void
+base64_stream_finish(stream_t* stream) {
+	stream_base64_t* b64stream = (stream_base64_t*)stream;
+	char text[5];
+	FOUNDATION_ASSERT(stream->type == STREAMTYPE_BASE64);
+	if (!b64stream->write_count)
+		return;
+	base64_encode(b64stream->write_group, b64stream->write_count, text, sizeof(text));
+	stream_write(b64stream->source, text, 4);
+	b64stream->write_count = 0;
+}
+
+static size_t
+base64_stream_read(stream_t* stream, void* dest, size_t size) {
+	stream_base64_t* b64stream = (stream_base64_t*)stream;
+	unsigned char* out = dest;
+	char text[BASE64_STREAM_CHUNK];
+	size_t total = 0;
+
+	while (total < size) {
+		size_t want, read, pos, consumed;
+
+		if (b64stream->decoded_count) {
+			size_t count = math_min(size - total, (size_t)b64stream->decoded_count);
+			memcpy(out + total, b64stream->decoded + b64stream->decoded_offset, count);
+			b64stream->decoded_offset += (unsigned int)count;
+			b64stream->decoded_count -= (unsigned int)count;
+			total += count;
+			continue;
+		}
+
+		// Read at most the characters needed for the requested size, leaving at most a
+		// partial group pending. Discarded characters only make the decoded size smaller
+		want = (((size - total) + 2) / 3) * 4 - b64stream->read_count;
+		read = stream_read(b64stream->source, text, math_min(want, sizeof(text)));
+		if (!read) {
+			if ((b64stream->read_count > 1) && stream_eos(b64stream->source)) {
+				// Trailing partial group, same as decoding the entire string
+				unsigned int ipad;
+				for (ipad = b64stream->read_count; ipad < 4; ++ipad)
+					b64stream->read_group[ipad] = 0;
+				base64_decode_group(b64stream->read_group, b64stream->decoded);
+				b64stream->decoded_count = b64stream->read_count - 1;
+				b64stream->decoded_offset = 0;
+				b64stream->read_count = 0;
+				continue;
+			}
+			break;
+		}
+
+		pos = 0;
+		if (!b64stream->read_count && (size - total >= 3)) {
+			total += base64_decode_groups(text, read, out + total, (size - total) / 3, &consumed);
+			pos = consumed;
+		}
+
+		for (; pos < read; ++pos) {
+			char v = base64_decode_value(text[pos]);
+			if (!v)
+				continue;
+			b64stream->read_group[b64stream->read_count++] = (unsigned char)(v - 62);
+			if (b64stream->read_count == 4) {
+				size_t count;
+				FOUNDATION_ASSERT(!b64stream->decoded_count);
+				base64_decode_group(b64stream->read_group, b64stream->decoded);
+				b64stream->read_count = 0;
+				count = math_min(size - total, (size_t)3);
+				memcpy(out + total, b64stream->decoded, count);
+				total += count;
+				b64stream->decoded_count = (unsigned int)(3 - count);
+				b64stream->decoded_offset = (unsigned int)count;
+			}
+		}
+	}
+
+	b64stream->offset += total;
+	return total;
+}
+
+static size_t
+base64_stream_write(stream_t* stream, const void* source, size_t size) {
+	stream_base64_t* b64stream = (stream_base64_t*)stream;
+	const unsigned char* data = source;
+	char text[BASE64_STREAM_CHUNK + 1];
+	size_t written = 0;
+
+	while (written < size) {
+		size_t chunk, length;
+
+		// Pending bytes and trailing bytes not making up a complete group are buffered
+		if (b64stream->write_count || (size - written < 3)) {
+			b64stream->write_group[b64stream->write_count++] = data[written++];
+			if (b64stream->write_count == 3) {
+				base64_encode(b64stream->write_group, 3, text, 5);
+				if (stream_write(b64stream->source, text, 4) != 4) {
+					// Keep the group pending without the byte completing it, which is not written
+					--b64stream->write_count;
+					--written;
+					break;
+				}
+				b64stream->write_count = 0;
+			}
+			continue;
+		}
+
+		chunk = math_min(((size - written) / 3) * 3, (size_t)(BASE64_STREAM_CHUNK / 4) * 3);
+		length = (chunk / 3) * 4;
+		base64_encode(data + written, chunk, text, length + 1);
+		if (stream_write(b64stream->source, text, length) != length)
+			break;
+		written += chunk;
+	}
+
+	b64stream->offset += written;
+	return written;
+}
+
+static bool
+base64_stream_eos(stream_t* stream) {
+	stream_base64_t* b64stream = (stream_base64_t*)stream;
+	return !b64stream->decoded_count && (b64stream->read_count < 2) && stream_eos(b64stream->source);
+}
+
+static void
+base64_stream_flush(stream_t* stream) {
+	stream_flush(((stream_base64_t*)stream)->source);
+}
+
+static void
+base64_stream_truncate(stream_t* stream, size_t size) {
+	FOUNDATION_UNUSED(stream);
+	FOUNDATION_UNUSED(size);
+}
+
+static size_t
+base64_stream_size(stream_t* stream) {
+	FOUNDATION_UNUSED(stream);
+	return 0;
+}
+
+static void
+base64_stream_seek(stream_t* stream, ssize_t offset, stream_seek_mode_t direction) {
+	FOUNDATION_UNUSED(stream);
+	FOUNDATION_UNUSED(offset);
+	FOUNDATION_UNUSED(direction);
+}
+
+static size_t
+base64_stream_tell(stream_t* stream) {
+	return ((stream_base64_t*)stream)->offset;
+}
+
+static tick_t
+base64_stream_lastmod(const stream_t* stream) {
+	return stream_last_modified(((const stream_base64_t*)stream)->source);
+}
+
+static void
+base64_stream_buffer_read(stream_t* stream) {
+	stream_buffer_read(((stream_base64_t*)stream)->source);
+}
+
+static size_t
+base64_stream_available_read(stream_t* stream) {
+	stream_base64_t* b64stream = (stream_base64_t*)stream;
+	size_t available = stream_available_read(b64stream->source) + b64stream->read_count;
+	return b64stream->decoded_count + ((available / 4) * 3);
+}
+
+static void
+base64_stream_finalize(stream_t* stream) {
+	stream_base64_t* b64stream = (stream_base64_t*)stream;
+
+	if (!b64stream || (stream->type != STREAMTYPE_BASE64))
+		return;
+
+	if (b64stream->source)
+		base64_stream_finish(stream);
+	if (b64stream->own)
+		stream_deallocate(b64stream->source);
+	b64stream->source = 0;
+}
+
+void
+internal_base64_stream_initialize(void) {
+	// Setup global vtable
+	base64_stream_vtable.read = base64_stream_read;
+	base64_stream_vtable.write = base64_stream_write;
+	base64_stream_vtable.eos = base64_stream_eos;
+	base64_stream_vtable.flush = base64_stream_flush;
+	base64_stream_vtable.truncate = base64_stream_truncate;
+	base64_stream_vtable.size = base64_stream_size;
+	base64_stream_vtable.seek = base64_stream_seek;
+	base64_stream_vtable.tell = base64_stream_tell;
+	base64_stream_vtable.lastmod = base64_stream_lastmod;
+	base64_stream_vtable.buffer_read = base64_stream_buffer_read;
+	base64_stream_vtable.available_read = base64_stream_available_read;
+	base64_stream_vtable.finalize = base64_stream_finalize;
+}
@@ -16,7 +16,13 @@
 \brief Base64 encoding and decoding
 
 Base64 encoding and decoding, using [A-Z][a-z][0-9][+/] as encoding characters. For more
-information, see https://en.wikipedia.org/wiki/Base64 */
+information, see https://en.wikipedia.org/wiki/Base64
+
+Encoding and decoding use SSSE3 or AVX2 instructions on x86 and NEON instructions on ARM64
+when available at runtime, producing exactly the same output as the scalar implementation.
+
+Data can also be encoded and decoded incrementally through a base64 stream wrapping another
+stream, see #base64_stream_allocate. */
 
 #include <foundation/platform.h>
 #include <foundation/types.h>
@@ -57,3 +63,28 @@ decode as much of the source data that fits into the destination buffer (i.e
 \return            Number of bytes written to destination buffer */
 FOUNDATION_API size_t
 base64_decode(const char* source, size_t size, void* destination, size_t capacity);
+
+/*! Allocate a base64 stream wrapping the given stream. Data written to the returned stream
+is encoded and written to the wrapped stream, and data read from the returned stream is read
+from the wrapped stream and decoded, discarding invalid characters like #base64_decode. The
+stream is sequential and cannot seek. Deallocate the stream with a call to #stream_deallocate
+\param stream Wrapped stream
+\param own    Flag if the wrapped stream is owned and deallocated together with the base64 stream
+\return       New base64 stream */
+FOUNDATION_API stream_t*
+base64_stream_allocate(stream_t* stream, bool own);
+
+/*! Initialize a base64 stream wrapping the given stream, see #base64_stream_allocate.
+Finalize the stream with a call to #stream_finalize
+\param stream Base64 stream
+\param source Wrapped stream
+\param own    Flag if the wrapped stream is owned and deallocated together with the base64 stream */
+FOUNDATION_API void
+base64_stream_initialize(stream_base64_t* stream, stream_t* source, bool own);
+
+/*! Encode and write any pending data not making up a complete group of three bytes, padded
+with '=' characters. Any data written after this call starts a new base64 string. Called
+automatically when the stream is finalized.
+\param stream Base64 stream */
+FOUNDATION_API void
+base64_stream_finish(stream_t* stream);
@@ -224,6 +224,90 @@ blowfish_decrypt_words(const blowfish_t* blowfish, uint32_t* lvalres, uint32_t*
 	hval = 0;
 }
 
+//! Number of blocks encrypted or decrypted in parallel to hide the latency of the S-box lookups
+#define BLOWFISH_INTERLEAVE 4
+
+//! Number of blocks buffered for counter mode keystream
+#define BLOWFISH_CHUNK_BLOCKS 32
+
+//! Minimum number of bytes processed by each thread in parallel encryption/decryption
+#define BLOWFISH_PARALLEL_MIN_SIZE (64 * 1024)
+
+#define BLOWFISH_ROUND4(src, dest, subkey)                    \
+	dest##0 ^= FEISTEL(src##0) ^ blowfish->parray[subkey]; \
+	dest##1 ^= FEISTEL(src##1) ^ blowfish->parray[subkey]; \
+	dest##2 ^= FEISTEL(src##2) ^ blowfish->parray[subkey]; \
+	dest##3 ^= FEISTEL(src##3) ^ blowfish->parray[subkey]
+
+static void
+blowfish_encrypt_blocks(const blowfish_t* blowfish, uint32_t* FOUNDATION_RESTRICT words, size_t blocks) {
+	uint32_t lval0, lval1, lval2, lval3;
+	uint32_t hval0, hval1, hval2, hval3;
+	unsigned int isub;
+
+	// Independent blocks interleaved round by round, the dependency chain of each block is
+	// bound by the S-box load latency, leaving execution units idle with a single block
+	for (; blocks >= BLOWFISH_INTERLEAVE; blocks -= BLOWFISH_INTERLEAVE, words += 2 * BLOWFISH_INTERLEAVE) {
+		lval0 = words[0] ^ blowfish->parray[0];
+		hval0 = words[1];
+		lval1 = words[2] ^ blowfish->parray[0];
+		hval1 = words[3];
+		lval2 = words[4] ^ blowfish->parray[0];
+		hval2 = words[5];
+		lval3 = words[6] ^ blowfish->parray[0];
+		hval3 = words[7];
+		for (isub = 1; isub < BLOWFISH_SUBKEYS - 1; isub += 2) {
+			BLOWFISH_ROUND4(lval, hval, isub);
+			BLOWFISH_ROUND4(hval, lval, isub + 1);
+		}
+		words[0] = hval0 ^ blowfish->parray[17];
+		words[1] = lval0;
+		words[2] = hval1 ^ blowfish->parray[17];
+		words[3] = lval1;
+		words[4] = hval2 ^ blowfish->parray[17];
+		words[5] = lval2;
+		words[6] = hval3 ^ blowfish->parray[17];
+		words[7] = lval3;
+	}
+
+	for (; blocks; --blocks, words += 2)
+		blowfish_encrypt_words(blowfish, words, words + 1);
+}
+
+static void
+blowfish_decrypt_blocks(const blowfish_t* blowfish, uint32_t* FOUNDATION_RESTRICT words, size_t blocks) {
+	uint32_t lval0, lval1, lval2, lval3;
+	uint32_t hval0, hval1, hval2, hval3;
+	unsigned int isub;
+
+	for (; blocks >= BLOWFISH_INTERLEAVE; blocks -= BLOWFISH_INTERLEAVE, words += 2 * BLOWFISH_INTERLEAVE) {
+		lval0 = words[0] ^ blowfish->parray[17];
+		hval0 = words[1];
+		lval1 = words[2] ^ blowfish->parray[17];
+		hval1 = words[3];
+		lval2 = words[4] ^ blowfish->parray[17];
+		hval2 = words[5];
+		lval3 = words[6] ^ blowfish->parray[17];
+		hval3 = words[7];
+		for (isub = BLOWFISH_SUBKEYS - 2; isub > 1; isub -= 2) {
+			BLOWFISH_ROUND4(lval, hval, isub);
+			BLOWFISH_ROUND4(hval, lval, isub - 1);
+		}
+		words[0] = hval0 ^ blowfish->parray[0];
+		words[1] = lval0;
+		words[2] = hval1 ^ blowfish->parray[0];
+		words[3] = lval1;
+		words[4] = hval2 ^ blowfish->parray[0];
+		words[5] = lval2;
+		words[6] = hval3 ^ blowfish->parray[0];
+		words[7] = lval3;
+	}
+
+	for (; blocks; --blocks, words += 2)
+		blowfish_decrypt_words(blowfish, words, words + 1);
+}
+
+#undef BLOWFISH_ROUND4
 #undef FEISTEL
 
 blowfish_t*
@@ -287,6 +371,43 @@ blowfish_finalize(blowfish_t* blowfish) {
 	FOUNDATION_UNUSED(blowfish);
 }
 
+static void
+blowfish_crypt_ctr(const blowfish_t* blowfish, void* data, size_t length, uint64_t vec) {
+	uint32_t keystream[2 * BLOWFISH_CHUNK_BLOCKS];
+	unsigned char* cur = data;
+	const unsigned char* key = (const unsigned char*)keystream;
+	size_t iblock, ibyte;
+
+	while (length) {
+		size_t blocks = (length + 7) / 8;
+		size_t size;
+		if (blocks > BLOWFISH_CHUNK_BLOCKS)
+			blocks = BLOWFISH_CHUNK_BLOCKS;
+		for (iblock = 0; iblock < blocks; ++iblock, ++vec) {
+			keystream[iblock * 2] = (uint32_t)((vec >> 32ULL) & 0xFFFFFFFFU);
+			keystream[(iblock * 2) + 1] = (uint32_t)(vec & 0xFFFFFFFFU);
+		}
+		blowfish_encrypt_blocks(blowfish, keystream, blocks);
+
+		size = (length < (blocks * 8)) ? length : (blocks * 8);
+		for (ibyte = 0; ibyte + 8 <= size; ibyte += 8) {
+			uint64_t block, stream;
+			memcpy(&block, cur + ibyte, 8);
+			memcpy(&stream, key + ibyte, 8);
+			block ^= stream;
+			memcpy(cur + ibyte, &block, 8);
+		}
+		for (; ibyte < size; ++ibyte)
+			cur[ibyte] ^= key[ibyte];
+
+		cur += size;
+		length -= size;
+	}
+
+	// Reset memory for paranoids
+	memset(keystream, 0, sizeof(keystream));
+}
+
 void
 blowfish_encrypt(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode, uint64_t vec) {
 	/*lint --e{826} */
@@ -294,6 +415,12 @@ blowfish_encrypt(const blowfish_t* blowfish, void* data, size_t length, blockcip
 	uint32_t* FOUNDATION_RESTRICT end;
 	uint32_t chain[2];
 
+	if (mode == BLOCKCIPHER_CTR) {
+		if (data && length)
+			blowfish_crypt_ctr(blowfish, data, length, vec);
+		return;
+	}
+
 	if (length % 8)
 		length -= (length % 8);
 
@@ -311,8 +438,7 @@ blowfish_encrypt(const blowfish_t* blowfish, void* data, size_t length, blockcip
 	switch (mode) {
 		default:
 		case BLOCKCIPHER_ECB:
-			for (; cur < end; cur += 2)
-				blowfish_encrypt_words(blowfish, cur, cur + 1);
+			blowfish_encrypt_blocks(blowfish, cur, length / 8);
 			break;
 
 		case BLOCKCIPHER_CBC:
@@ -355,8 +481,14 @@ blowfish_decrypt(const blowfish_t* blowfish, void* data, size_t length, blockcip
 	uint32_t* FOUNDATION_RESTRICT cur;
 	uint32_t* FOUNDATION_RESTRICT end;
 	uint32_t chain[2];
-	uint32_t prev_chain[2];
-	uint32_t swap_chain[2];
+	uint32_t buffer[2 * BLOWFISH_CHUNK_BLOCKS];
+	size_t blocks, count, iword;
+
+	if (mode == BLOCKCIPHER_CTR) {
+		if (data && length)
+			blowfish_crypt_ctr(blowfish, data, length, vec);
+		return;
+	}
 
 	if (length % 8)
 		length -= (length % 8);
@@ -367,45 +499,43 @@ blowfish_decrypt(const blowfish_t* blowfish, void* data, size_t length, blockcip
 	/*lint --e{826} */
 	cur = data;
 	end = pointer_offset(data, length);
+	blocks = length / 8;
 	chain[0] = (uint32_t)((vec >> 32ULL) & 0xFFFFFFFFU);
 	chain[1] = (uint32_t)(vec & 0xFFFFFFFFU);
 
 	switch (mode) {
 		default:
 		case BLOCKCIPHER_ECB:
-			for (; cur < end; cur += 2)
-				blowfish_decrypt_words(blowfish, cur, cur + 1);
+			blowfish_decrypt_blocks(blowfish, cur, blocks);
 			break;
 
 		case BLOCKCIPHER_CBC:
-			for (; cur < end; cur += 2) {
-				prev_chain[0] = cur[0];
-				prev_chain[1] = cur[1];
-				blowfish_decrypt_words(blowfish, cur, cur + 1);
-				cur[0] ^= chain[0];
-				cur[1] ^= chain[1];
-				swap_chain[0] = chain[0];
-				swap_chain[1] = chain[1];
-				chain[0] = prev_chain[0];
-				chain[1] = prev_chain[1];
-				prev_chain[0] = swap_chain[0];
-				prev_chain[1] = swap_chain[1];
+			// Each plaintext block only depends on two ciphertext blocks, decrypt in chunks
+			for (; blocks; blocks -= count, cur += 2 * count) {
+				count = (blocks < BLOWFISH_CHUNK_BLOCKS) ? blocks : BLOWFISH_CHUNK_BLOCKS;
+				buffer[0] = chain[0];
+				buffer[1] = chain[1];
+				memcpy(buffer + 2, cur, (count - 1) * 8);
+				chain[0] = cur[(count * 2) - 2];
+				chain[1] = cur[(count * 2) - 1];
+				blowfish_decrypt_blocks(blowfish, cur, count);
+				for (iword = 0; iword < count * 2; ++iword)
+					cur[iword] ^= buffer[iword];
 			}
 			break;
 
 		case BLOCKCIPHER_CFB:
-			for (; cur < end; cur += 2) {
-				prev_chain[0] = cur[0];
-				prev_chain[1] = cur[1];
-				blowfish_encrypt_words(blowfish, chain, chain + 1);
-				cur[0] ^= chain[0];
-				cur[1] ^= chain[1];
-				swap_chain[0] = chain[0];
-				swap_chain[1] = chain[1];
-				chain[0] = prev_chain[0];
-				chain[1] = prev_chain[1];
-				prev_chain[0] = swap_chain[0];
-				prev_chain[1] = swap_chain[1];
+			// Keystream is the encrypted previous ciphertext block, encrypt in chunks
+			for (; blocks; blocks -= count, cur += 2 * count) {
+				count = (blocks < BLOWFISH_CHUNK_BLOCKS) ? blocks : BLOWFISH_CHUNK_BLOCKS;
+				buffer[0] = chain[0];
+				buffer[1] = chain[1];
+				memcpy(buffer + 2, cur, (count - 1) * 8);
+				chain[0] = cur[(count * 2) - 2];
+				chain[1] = cur[(count * 2) - 1];
+				blowfish_encrypt_blocks(blowfish, buffer, count);
+				for (iword = 0; iword < count * 2; ++iword)
+					cur[iword] ^= buffer[iword];
 			}
 			break;
 
@@ -422,8 +552,98 @@ blowfish_decrypt(const blowfish_t* blowfish, void* data, size_t length, blockcip
 	/*lint --e{438} */
 	chain[0] = 0;
 	chain[1] = 0;
-	prev_chain[0] = 0;
-	prev_chain[1] = 0;
-	swap_chain[0] = 0;
-	swap_chain[1] = 0;
+	memset(buffer, 0, sizeof(buffer));
+}
+
+typedef struct blowfish_job_t blowfish_job_t;
+
+struct blowfish_job_t {
+	const blowfish_t* blowfish;
+	void* data;
+	size_t length;
+	blockcipher_mode_t mode;
+	uint64_t vec;
+	bool decrypt;
+};
+
+static void*
+blowfish_worker(void* arg) {
+	blowfish_job_t* job = arg;
+	if (job->decrypt)
+		blowfish_decrypt(job->blowfish, job->data, job->length, job->mode, job->vec);
+	else
+		blowfish_encrypt(job->blowfish, job->data, job->length, job->mode, job->vec);
+	return 0;
+}
+
+static void
+blowfish_crypt_parallel(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode, uint64_t vec,
+                        size_t threads, bool decrypt) {
+	blowfish_job_t* job;
+	thread_t* thread;
+	size_t blocks, segment, ithread;
+	// Block modes chaining on the output of the previous block can not be split
+	bool parallel = (mode == BLOCKCIPHER_ECB) || (mode == BLOCKCIPHER_CTR) ||
+	                (decrypt && ((mode == BLOCKCIPHER_CBC) || (mode == BLOCKCIPHER_CFB)));
+
+	if (!threads)
+		threads = system_hardware_threads();
+	threads = math_min(threads, length / BLOWFISH_PARALLEL_MIN_SIZE);
+	if (!parallel || (threads < 2)) {
+		if (decrypt)
+			blowfish_decrypt(blowfish, data, length, mode, vec);
+		else
+			blowfish_encrypt(blowfish, data, length, mode, vec);
+		return;
+	}
+
+	// Split on block boundaries, the last segment takes any trailing partial block
+	blocks = length / 8;
+	segment = (blocks + threads - 1) / threads;
+	job = memory_allocate(0, sizeof(blowfish_job_t) * threads, 0, MEMORY_PERSISTENT);
+	thread = memory_allocate(0, sizeof(thread_t) * threads, 0, MEMORY_PERSISTENT);
+	for (ithread = 0; ithread < threads; ++ithread) {
+		size_t offset = math_min(ithread * segment, blocks) * 8;
+		job[ithread].blowfish = blowfish;
+		job[ithread].data = pointer_offset(data, offset);
+		job[ithread].length = (ithread + 1 < threads) ? (math_min(segment * 8, length - offset)) : (length - offset);
+		job[ithread].mode = mode;
+		job[ithread].decrypt = decrypt;
+		if (mode == BLOCKCIPHER_CTR) {
+			job[ithread].vec = vec + (offset / 8);
+		} else if (offset && (mode != BLOCKCIPHER_ECB)) {
+			// Chain from last ciphertext block of previous segment, read before any segment is decrypted
+			const uint32_t* prev = pointer_offset_const(data, offset - 8);
+			job[ithread].vec = ((uint64_t)prev[0] << 32ULL) | (uint64_t)prev[1];
+		} else {
+			job[ithread].vec = vec;
+		}
+	}
+
+	// Calling thread processes the first segment
+	for (ithread = 1; ithread < threads; ++ithread) {
+		thread_initialize(thread + ithread, blowfish_worker, job + ithread, STRING_CONST("blowfish"),
+		                  THREAD_PRIORITY_NORMAL, 0);
+		thread_start(thread + ithread);
+	}
+	blowfish_worker(job);
+	for (ithread = 1; ithread < threads; ++ithread) {
+		thread_join(thread + ithread);
+		thread_finalize(thread + ithread);
+	}
+
+	memory_deallocate(thread);
+	memory_deallocate(job);
+}
+
+void
+blowfish_encrypt_parallel(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode,
+                          uint64_t vec, size_t threads) {
+	blowfish_crypt_parallel(blowfish, data, length, mode, vec, threads, false);
+}
+
+void
+blowfish_decrypt_parallel(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode,
+                          uint64_t vec, size_t threads) {
+	blowfish_crypt_parallel(blowfish, data, length, mode, vec, threads, true);
 }
@@ -19,7 +19,14 @@ Blowfish encryption and decryption. Blowfish is a symmetric block cipher with va
 For more information, see https://www.schneier.com/blowfish.html
 
 The blowfish state is not inherently thread safe, synchronization in a multithread use case must
-be done by caller. */
+be done by caller. Once initialized the state is not modified by encryption or decryption, and
+can be used concurrently by multiple threads.
+
+In counter mode (#BLOCKCIPHER_CTR) the 64-bit initialization vector is the counter for the first
+block and is incremented for each 8 byte block, so data at byte offset N can be processed
+independently by adding N / 8 to the vector. Counter mode handles data of any length. Large
+buffers can be split across multiple threads with #blowfish_encrypt_parallel and
+#blowfish_decrypt_parallel in all modes where blocks are independent. */
 
 #include <foundation/platform.h>
 #include <foundation/types.h>
@@ -51,22 +58,56 @@ blowfish_finalize(blowfish_t* blowfish);
 
 /*! Encrypt data using the given blowfish state object. Encryption is done in-place,
 no memory allocation is done internally. Length is expected to be a multiple of 8
-bytes (any extra unaligned data will be ignored).
+bytes (any extra unaligned data will be ignored), except in counter mode which handles
+any length.
 \param blowfish Blowfish state object
 \param data     Data buffer
 \param length   Length of data buffer in bytes
 \param mode     Mode of operation (see #blockcipher_mode_t)
-\param vec      Initialization vector */
+\param vec      Initialization vector, or initial counter in counter mode */
 FOUNDATION_API void
 blowfish_encrypt(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode, uint64_t vec);
 
 /*! Decrypt data using the given blowfish state object. Decryption is done in-place,
 no memory allocation is done internally. Length is expected to be a multiple of 8
-bytes (any extra unaligned data will be ignored).
+bytes (any extra unaligned data will be ignored), except in counter mode which handles
+any length.
 \param blowfish Blowfish state object
 \param data     Data buffer
 \param length   Length of data buffer in bytes
 \param mode     Mode of operation (see #blockcipher_mode_t)
-\param vec      Initialization vector */
+\param vec      Initialization vector, or initial counter in counter mode */
 FOUNDATION_API void
 blowfish_decrypt(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode, uint64_t vec);
+
+/*! Encrypt data using the given blowfish state object, splitting the buffer in segments
+encrypted in parallel on multiple threads. The result is identical to #blowfish_encrypt.
+Only electronic codebook and counter modes can be split, other modes are chained on the
+previous ciphertext block and are encrypted on the calling thread. Small buffers are not
+split, each thread processes at least 64KiB.
+\param blowfish Blowfish state object
+\param data     Data buffer
+\param length   Length of data buffer in bytes
+\param mode     Mode of operation (see #blockcipher_mode_t)
+\param vec      Initialization vector, or initial counter in counter mode
+\param threads  Number of threads to use including the calling thread, 0 for number of
+                 hardware threads */
+FOUNDATION_API void
+blowfish_encrypt_parallel(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode,
+                          uint64_t vec, size_t threads);
+
+/*! Decrypt data using the given blowfish state object, splitting the buffer in segments
+decrypted in parallel on multiple threads. The result is identical to #blowfish_decrypt.
+All modes except output feedback can be split, since cipher block chaining and cipher
+feedback decryption only depend on the ciphertext. Small buffers are not split, each
+thread processes at least 64KiB.
+\param blowfish Blowfish state object
+\param data     Data buffer
+\param length   Length of data buffer in bytes
+\param mode     Mode of operation (see #blockcipher_mode_t)
+\param vec      Initialization vector, or initial counter in counter mode
+\param threads  Number of threads to use including the calling thread, 0 for number of
+                 hardware threads */
+FOUNDATION_API void
+blowfish_decrypt_parallel(const blowfish_t* blowfish, void* data, size_t length, blockcipher_mode_t mode,
+                          uint64_t vec, size_t threads);
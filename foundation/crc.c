@@ -0,0 +1,395 @@
+/* crc.c  -  Foundation library  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#include <foundation/foundation.h>
+#include <foundation/internal.h>
+
+#if FOUNDATION_COMPILER_CLANG
+// Word loads are done on aligned addresses only
+#pragma clang diagnostic ignored "-Wcast-align"
+#endif
+
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define CRC_X86 1
+#else
+#define CRC_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && defined(__ARM_FEATURE_CRC32)
+#define CRC_ARM 1
+#else
+#define CRC_ARM 0
+#endif
+
+// Reflected Castagnoli polynomial
+#define CRC32C_POLY 0x82F63B78U
+
+// Block sizes for the three way interleaved hardware implementation. Three independent
+// streams hide the latency of the CRC32 instruction, and the partial checksums are merged
+// by shifting through precomputed tables
+#define CRC32C_LONG 8192
+#define CRC32C_SHORT 256
+
+//! Update function, operating on the raw (non-inverted) checksum register
+typedef uint32_t (*crc32c_update_fn)(uint32_t crc, const unsigned char* data, size_t size);
+
+static uint32_t crc32c_table[8][256];
+static uint32_t crc32c_long_table[4][256];
+static uint32_t crc32c_short_table[4][256];
+static uint32_t crc32c_x2n_table[32];
+static crc32c_update_fn crc32c_update_impl;
+
+#if CRC_X86
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <nmmintrin.h>
+#define CRC32C_TARGET(isa)
+#else
+#include <nmmintrin.h>
+#define CRC32C_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if FOUNDATION_ARCH_X86_64
+typedef uint64_t crc32c_hw_t;
+#define CRC32C_HW_WORD_SIZE 8
+#define CRC32C_HW_WORD(crc, data) _mm_crc32_u64(crc, *(const uint64_t*)(const void*)(data))
+#else
+typedef uint32_t crc32c_hw_t;
+#define CRC32C_HW_WORD_SIZE 4
+#define CRC32C_HW_WORD(crc, data) _mm_crc32_u32(crc, *(const uint32_t*)(const void*)(data))
+#endif
+#define CRC32C_HW_BYTE(crc, data) _mm_crc32_u8((unsigned int)(crc), *(data))
+
+#elif CRC_ARM
+#include <arm_acle.h>
+
+#define CRC32C_TARGET(isa)
+
+typedef uint32_t crc32c_hw_t;
+#define CRC32C_HW_WORD_SIZE 8
+#define CRC32C_HW_WORD(crc, data) __crc32cd(crc, *(const uint64_t*)(const void*)(data))
+#define CRC32C_HW_BYTE(crc, data) __crc32cb(crc, *(data))
+#endif
+
+//! Multiply a and b modulo the polynomial, in reflected bit order
+static uint32_t
+crc32c_multmodp(uint32_t a, uint32_t b) {
+	uint32_t m = 1U << 31;
+	uint32_t p = 0;
+	while (m) {
+		if (a & m) {
+			p ^= b;
+			if (!(a & (m - 1)))
+				break;
+		}
+		m >>= 1;
+		b = (b & 1) ? ((b >> 1) ^ CRC32C_POLY) : (b >> 1);
+	}
+	return p;
+}
+
+//! Compute x^(n * 2^k) modulo the polynomial
+static uint32_t
+crc32c_x2nmodp(size_t n, unsigned int k) {
+	uint32_t p = 1U << 31;
+	while (n) {
+		if (n & 1)
+			p = crc32c_multmodp(crc32c_x2n_table[k & 31], p);
+		n >>= 1;
+		++k;
+	}
+	return p;
+}
+
+//! Shift the checksum register over a fixed number of zero bytes using a shift table
+static FOUNDATION_FORCEINLINE uint32_t
+crc32c_shift(uint32_t table[4][256], uint32_t crc) {
+	return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+}
+
+static void
+crc32c_shift_table(uint32_t table[4][256], size_t size) {
+	uint32_t op = crc32c_x2nmodp(size, 3);
+	unsigned int ibyte, ivalue;
+	for (ibyte = 0; ibyte < 4; ++ibyte) {
+		for (ivalue = 0; ivalue < 256; ++ivalue)
+			table[ibyte][ivalue] = crc32c_multmodp(op, ivalue << (ibyte * 8));
+	}
+}
+
+static uint32_t
+crc32c_update_generic(uint32_t crc, const unsigned char* data, size_t size) {
+	while (size && ((uintptr_t)data & 7)) {
+		crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *data++) & 0xFF];
+		--size;
+	}
+	// Slicing-by-8, byte loads keep the code independent of byte order
+	while (size >= 8) {
+		crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+		crc = crc32c_table[7][crc & 0xFF] ^ crc32c_table[6][(crc >> 8) & 0xFF] ^
+		      crc32c_table[5][(crc >> 16) & 0xFF] ^ crc32c_table[4][crc >> 24] ^ crc32c_table[3][data[4]] ^
+		      crc32c_table[2][data[5]] ^ crc32c_table[1][data[6]] ^ crc32c_table[0][data[7]];
+		data += 8;
+		size -= 8;
+	}
+	while (size--)
+		crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *data++) & 0xFF];
+	return crc;
+}
+
+#if CRC_X86 || CRC_ARM
+
+CRC32C_TARGET("sse4.2")
+static uint32_t
+crc32c_update_hardware(uint32_t crc, const unsigned char* data, size_t size) {
+	crc32c_hw_t crc0 = crc;
+	const unsigned char* end;
+	while (size && ((uintptr_t)data & (CRC32C_HW_WORD_SIZE - 1))) {
+		crc0 = CRC32C_HW_BYTE((uint32_t)crc0, data);
+		++data;
+		--size;
+	}
+	while (size >= (CRC32C_LONG * 3)) {
+		crc32c_hw_t crc1 = 0;
+		crc32c_hw_t crc2 = 0;
+		end = data + CRC32C_LONG;
+		do {
+			crc0 = CRC32C_HW_WORD(crc0, data);
+			crc1 = CRC32C_HW_WORD(crc1, data + CRC32C_LONG);
+			crc2 = CRC32C_HW_WORD(crc2, data + (CRC32C_LONG * 2));
+			data += CRC32C_HW_WORD_SIZE;
+		} while (data < end);
+		crc0 = crc32c_shift(crc32c_long_table, (uint32_t)crc0) ^ crc1;
+		crc0 = crc32c_shift(crc32c_long_table, (uint32_t)crc0) ^ crc2;
+		data += CRC32C_LONG * 2;
+		size -= CRC32C_LONG * 3;
+	}
+	while (size >= (CRC32C_SHORT * 3)) {
+		crc32c_hw_t crc1 = 0;
+		crc32c_hw_t crc2 = 0;
+		end = data + CRC32C_SHORT;
+		do {
+			crc0 = CRC32C_HW_WORD(crc0, data);
+			crc1 = CRC32C_HW_WORD(crc1, data + CRC32C_SHORT);
+			crc2 = CRC32C_HW_WORD(crc2, data + (CRC32C_SHORT * 2));
+			data += CRC32C_HW_WORD_SIZE;
+		} while (data < end);
+		crc0 = crc32c_shift(crc32c_short_table, (uint32_t)crc0) ^ crc1;
+		crc0 = crc32c_shift(crc32c_short_table, (uint32_t)crc0) ^ crc2;
+		data += CRC32C_SHORT * 2;
+		size -= CRC32C_SHORT * 3;
+	}
+	while (size >= CRC32C_HW_WORD_SIZE) {
+		crc0 = CRC32C_HW_WORD(crc0, data);
+		data += CRC32C_HW_WORD_SIZE;
+		size -= CRC32C_HW_WORD_SIZE;
+	}
+	while (size--) {
+		crc0 = CRC32C_HW_BYTE((uint32_t)crc0, data);
+		++data;
+	}
+	return (uint32_t)crc0;
+}
+
+#endif
+
+//! Build tables and select update function from CPU features detected at runtime. Resolving
+//! is idempotent, concurrent calls store the same values
+void
+internal_crc32c_resolve(void) {
+	crc32c_update_fn update = crc32c_update_generic;
+	uint32_t p;
+	unsigned int n, k;
+
+	for (n = 0; n < 256; ++n) {
+		uint32_t crc = n;
+		for (k = 0; k < 8; ++k)
+			crc = (crc & 1) ? ((crc >> 1) ^ CRC32C_POLY) : (crc >> 1);
+		crc32c_table[0][n] = crc;
+	}
+	for (n = 0; n < 256; ++n) {
+		for (k = 1; k < 8; ++k)
+			crc32c_table[k][n] = (crc32c_table[k - 1][n] >> 8) ^ crc32c_table[0][crc32c_table[k - 1][n] & 0xFF];
+	}
+
+	p = 1U << 30;
+	crc32c_x2n_table[0] = p;
+	for (n = 1; n < 32; ++n)
+		crc32c_x2n_table[n] = p = crc32c_multmodp(p, p);
+
+#if CRC_X86 || CRC_ARM
+	if (system_cpu_has_feature(CPU_FEATURE_CRC32)) {
+		crc32c_shift_table(crc32c_long_table, CRC32C_LONG);
+		crc32c_shift_table(crc32c_short_table, CRC32C_SHORT);
+		update = crc32c_update_hardware;
+	}
+#endif
+
+	crc32c_update_impl = update;
+}
+
+uint32_t
+crc32c(const void* buffer, size_t size) {
+	return crc32c_update(0, buffer, size);
+}
+
+uint32_t
+crc32c_update(uint32_t crc, const void* buffer, size_t size) {
+	if (!crc32c_update_impl)
+		internal_crc32c_resolve();
+	return ~crc32c_update_impl(~crc, buffer, size);
+}
+
+uint32_t
+crc32c_combine(uint32_t crc0, uint32_t crc1, size_t size1) {
+	if (!crc32c_update_impl)
+		internal_crc32c_resolve();
+	return crc32c_multmodp(crc32c_x2nmodp(size1, 3), crc0) ^ crc1;
+}
+
+static stream_vtable_t crc32c_stream_vtable;
+
+stream_t*
+crc32c_stream_allocate(stream_t* stream, bool own) {
+	stream_crc32c_t* crcstream = memory_allocate(HASH_STREAM, sizeof(stream_crc32c_t), 8, MEMORY_PERSISTENT);
+	crc32c_stream_initialize(crcstream, stream, own);
+	return (stream_t*)crcstream;
+}
+
+void
+crc32c_stream_initialize(stream_crc32c_t* stream, stream_t* source, bool own) {
+	memset(stream, 0, sizeof(stream_crc32c_t));
+	stream_initialize((stream_t*)stream, (byteorder_t)source->byteorder);
+
+	stream->type = STREAMTYPE_CRC32C;
+	stream->sequential = source->sequential;
+	stream->reliable = source->reliable;
+	stream->inorder = source->inorder;
+	stream->path = string_allocate_format(STRING_CONST("crc32c://0x%" PRIfixPTR), (uintptr_t)stream);
+	stream->mode = source->mode & (STREAM_OUT | STREAM_IN | STREAM_BINARY);
+	stream->source = source;
+	stream->own = own;
+
+	stream->vtable = &crc32c_stream_vtable;
+}
+
+uint32_t
+crc32c_stream_read_checksum(const stream_t* stream) {
+	FOUNDATION_ASSERT(stream->type == STREAMTYPE_CRC32C);
+	return ((const stream_crc32c_t*)stream)->crc_read;
+}
+
+uint32_t
+crc32c_stream_write_checksum(const stream_t* stream) {
+	FOUNDATION_ASSERT(stream->type == STREAMTYPE_CRC32C);
+	return ((const stream_crc32c_t*)stream)->crc_write;
+}
+
+void
+crc32c_stream_reset(stream_t* stream) {
+	stream_crc32c_t* crcstream = (stream_crc32c_t*)stream;
+	FOUNDATION_ASSERT(stream->type == STREAMTYPE_CRC32C);
+	crcstream->crc_read = 0;
+	crcstream->crc_write = 0;
+}
+
+static size_t
+crc32c_stream_read(stream_t* stream, void* dest, size_t size) {
+	stream_crc32c_t* crcstream = (stream_crc32c_t*)stream;
+	size_t read = stream_read(crcstream->source, dest, size);
+	if (dest)
+		crcstream->crc_read = crc32c_update(crcstream->crc_read, dest, read);
+	return read;
+}
+
+static size_t
+crc32c_stream_write(stream_t* stream, const void* source, size_t size) {
+	stream_crc32c_t* crcstream = (stream_crc32c_t*)stream;
+	size_t written = stream_write(crcstream->source, source, size);
+	crcstream->crc_write = crc32c_update(crcstream->crc_write, source, written);
+	return written;
+}
+
+static bool
+crc32c_stream_eos(stream_t* stream) {
+	return stream_eos(((stream_crc32c_t*)stream)->source);
+}
+
+static void
+crc32c_stream_flush(stream_t* stream) {
+	stream_flush(((stream_crc32c_t*)stream)->source);
+}
+
+static void
+crc32c_stream_truncate(stream_t* stream, size_t size) {
+	stream_truncate(((stream_crc32c_t*)stream)->source, size);
+}
+
+static size_t
+crc32c_stream_size(stream_t* stream) {
+	return stream_size(((stream_crc32c_t*)stream)->source);
+}
+
+static void
+crc32c_stream_seek(stream_t* stream, ssize_t offset, stream_seek_mode_t direction) {
+	stream_seek(((stream_crc32c_t*)stream)->source, offset, direction);
+}
+
+static size_t
+crc32c_stream_tell(stream_t* stream) {
+	return stream_tell(((stream_crc32c_t*)stream)->source);
+}
+
+static tick_t
+crc32c_stream_lastmod(const stream_t* stream) {
+	return stream_last_modified(((const stream_crc32c_t*)stream)->source);
+}
+
+static void
+crc32c_stream_buffer_read(stream_t* stream) {
+	stream_buffer_read(((stream_crc32c_t*)stream)->source);
+}
+
+static size_t
+crc32c_stream_available_read(stream_t* stream) {
+	return stream_available_read(((stream_crc32c_t*)stream)->source);
+}
+
+static void
+crc32c_stream_finalize(stream_t* stream) {
+	stream_crc32c_t* crcstream = (stream_crc32c_t*)stream;
+
+	if (!crcstream || (stream->type != STREAMTYPE_CRC32C))
+		return;
+
+	if (crcstream->own)
+		stream_deallocate(crcstream->source);
+	crcstream->source = 0;
+}
+
+void
+internal_crc32c_stream_initialize(void) {
+	// Setup global vtable
+	crc32c_stream_vtable.read = crc32c_stream_read;
+	crc32c_stream_vtable.write = crc32c_stream_write;
+	crc32c_stream_vtable.eos = crc32c_stream_eos;
+	crc32c_stream_vtable.flush = crc32c_stream_flush;
+	crc32c_stream_vtable.truncate = crc32c_stream_truncate;
+	crc32c_stream_vtable.size = crc32c_stream_size;
+	crc32c_stream_vtable.seek = crc32c_stream_seek;
+	crc32c_stream_vtable.tell = crc32c_stream_tell;
+	crc32c_stream_vtable.lastmod = crc32c_stream_lastmod;
+	crc32c_stream_vtable.buffer_read = crc32c_stream_buffer_read;
+	crc32c_stream_vtable.available_read = crc32c_stream_available_read;
+	crc32c_stream_vtable.finalize = crc32c_stream_finalize;
+}
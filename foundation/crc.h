@@ -0,0 +1,99 @@
+/* crc.h  -  Foundation library  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#pragma once
+
+/*! \file crc.h
+\brief CRC32C checksum
+
+CRC32C (Castagnoli polynomial 0x1EDC6F41, reflected) checksum, as used by iSCSI, SCTP, ext4
+and many storage and network framing formats. The implementation uses the SSE 4.2 or ARMv8
+CRC32 instructions when available at runtime, and falls back to a portable slicing-by-8 table
+implementation.
+
+Checksums are computed incrementally by passing the previous checksum to #crc32c_update,
+starting with zero:
+
+<pre>uint32_t crc = 0;
+crc = crc32c_update(crc, block0, size0);
+crc = crc32c_update(crc, block1, size1);</pre>
+
+Checksums of separately computed blocks can be concatenated with #crc32c_combine.
+
+The CRC32C stream is a pass-through stream wrapping another stream, computing the checksum
+of all data read from and written to the wrapped stream. It can be used as the stream for any
+stream based interface, for example a bit buffer created with #bitbuffer_allocate_stream. */
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+/*! Compute CRC32C checksum of a memory buffer
+\param buffer Data buffer
+\param size Size of data in bytes
+\return Checksum */
+FOUNDATION_API uint32_t
+crc32c(const void* buffer, size_t size);
+
+/*! Update a CRC32C checksum with additional data. The checksum of an empty buffer is zero,
+which is the initial value to pass when starting a new checksum.
+\param crc Checksum of previous data
+\param buffer Data buffer
+\param size Size of data in bytes
+\return Checksum of previous data followed by given data */
+FOUNDATION_API uint32_t
+crc32c_update(uint32_t crc, const void* buffer, size_t size);
+
+/*! Combine two CRC32C checksums into the checksum of the concatenated data, without
+access to the data itself. Runs in time logarithmic to the size of the second block.
+\param crc0 Checksum of first block
+\param crc1 Checksum of second block
+\param size1 Size of second block in bytes
+\return Checksum of first block followed by second block */
+FOUNDATION_API uint32_t
+crc32c_combine(uint32_t crc0, uint32_t crc1, size_t size1);
+
+/*! Allocate a CRC32C stream wrapping the given stream. All data read or written through
+the returned stream is passed to the wrapped stream and included in the read or write
+checksum. Seeking is passed through to the wrapped stream, checksums only include data
+actually transferred. Deallocate the stream with a call to #stream_deallocate
+\param stream Wrapped stream
+\param own Flag if the wrapped stream is owned and deallocated together with the CRC32C stream
+\return New CRC32C stream */
+FOUNDATION_API stream_t*
+crc32c_stream_allocate(stream_t* stream, bool own);
+
+/*! Initialize a CRC32C stream wrapping the given stream, see #crc32c_stream_allocate.
+Finalize the stream with a call to #stream_finalize
+\param stream CRC32C stream
+\param source Wrapped stream
+\param own Flag if the wrapped stream is owned and deallocated together with the CRC32C stream */
+FOUNDATION_API void
+crc32c_stream_initialize(stream_crc32c_t* stream, stream_t* source, bool own);
+
+/*! Get the checksum of all data read through the stream since it was created or
+last reset with #crc32c_stream_reset
+\param stream CRC32C stream
+\return Checksum of data read */
+FOUNDATION_API uint32_t
+crc32c_stream_read_checksum(const stream_t* stream);
+
+/*! Get the checksum of all data written through the stream since it was created or
+last reset with #crc32c_stream_reset
+\param stream CRC32C stream
+\return Checksum of data written */
+FOUNDATION_API uint32_t
+crc32c_stream_write_checksum(const stream_t* stream);
+
+/*! Reset read and write checksums of the stream to zero, for example at a record boundary
+\param stream CRC32C stream */
+FOUNDATION_API void
+crc32c_stream_reset(stream_t* stream);
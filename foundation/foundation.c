@@ -43,6 +43,7 @@ foundation_initialize_config(const foundation_config_t config) {
 	foundation_cfg.thread_stack_size = (config.thread_stack_size ? config.thread_stack_size : 0x10000);
 	foundation_cfg.hash_store_size = config.hash_store_size;
 	foundation_cfg.random_state_prealloc = config.random_state_prealloc;
+	foundation_cfg.random_engine = config.random_engine;
 }
 
 #define SUBSYSTEM_INIT(system) \
@@ -66,6 +67,7 @@ foundation_initialize(const memory_system_t memory, const application_t applicat
 	/*lint -e774 */
 	SUBSYSTEM_INIT(atomic);
 	SUBSYSTEM_INIT_ARGS(memory, memory);
+	SUBSYSTEM_INIT(cpu);
 	SUBSYSTEM_INIT(static_hash);
 	SUBSYSTEM_INIT(assert);
 	SUBSYSTEM_INIT(library);
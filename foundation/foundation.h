@@ -41,6 +41,7 @@ Wrapper for foundation library headers and main entry/exit points */
 #include <foundation/hashstrings.h>
 #include <foundation/base64.h>
 #include <foundation/md5.h>
+#include <foundation/crc.h>
 #include <foundation/array.h>
 #include <foundation/bitbuffer.h>
 #include <foundation/bucketarray.h>
@@ -73,8 +74,10 @@ Wrapper for foundation library headers and main entry/exit points */
 #include <foundation/exception.h>
 #include <foundation/stacktrace.h>
 
+#include <foundation/aes.h>
 #include <foundation/blowfish.h>
 #include <foundation/regex.h>
+#include <foundation/matcher.h>
 #include <foundation/sha.h>
 
 #define FOUNDATION_NO_INTERFACE
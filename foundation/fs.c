@@ -684,6 +684,178 @@ fs_md5(const char* path, size_t length) {
 	return digest;
 }
 
+struct fs_digest_job_t {
+	string_const_t path;
+	fs_digest_t algorithm;
+	size_t size;
+	size_t leaves;
+	uint512_t* node;
+	atomic64_t next;
+	atomic32_t failed;
+};
+
+typedef struct fs_digest_job_t fs_digest_job_t;
+
+static size_t
+fs_digest_words(fs_digest_t algorithm) {
+	if (algorithm == FS_DIGEST_SHA512)
+		return 8;
+	if (algorithm == FS_DIGEST_SHA256)
+		return 4;
+	return 2;
+}
+
+static uint512_t
+fs_digest_node(fs_digest_t algorithm, unsigned char prefix, const void* data, size_t size) {
+	uint512_t node = uint512_null();
+	switch (algorithm) {
+		case FS_DIGEST_MD5: {
+			md5_t md5;
+			md5_initialize(&md5);
+			md5_digest(&md5, &prefix, 1);
+			md5_digest(&md5, data, size);
+			md5_digest_finalize(&md5);
+			uint128_t raw = md5_get_digest_raw(&md5);
+			node.word[0] = raw.word[0];
+			node.word[1] = raw.word[1];
+			md5_finalize(&md5);
+			break;
+		}
+		case FS_DIGEST_SHA256: {
+			sha256_t sha;
+			sha256_initialize(&sha);
+			sha256_digest(&sha, &prefix, 1);
+			sha256_digest(&sha, data, size);
+			sha256_digest_finalize(&sha);
+			uint256_t raw = sha256_get_digest_raw(&sha);
+			memcpy(node.word, raw.word, sizeof(raw.word));
+			sha256_finalize(&sha);
+			break;
+		}
+		case FS_DIGEST_SHA512: {
+			sha512_t sha;
+			sha512_initialize(&sha);
+			sha512_digest(&sha, &prefix, 1);
+			sha512_digest(&sha, data, size);
+			sha512_digest_finalize(&sha);
+			node = sha512_get_digest_raw(&sha);
+			sha512_finalize(&sha);
+			break;
+		}
+		case FS_DIGEST_HASH128: {
+			hash_state_t state;
+			hash_initialize(&state);
+			hash_update(&state, &prefix, 1);
+			hash_update(&state, data, size);
+			uint128_t raw = hash_finalize128(&state);
+			node.word[0] = raw.word[0];
+			node.word[1] = raw.word[1];
+			break;
+		}
+		default:
+			break;
+	}
+	return node;
+}
+
+static void*
+fs_digest_worker(void* arg) {
+	fs_digest_job_t* job = arg;
+	stream_t* file = fs_open_file(STRING_ARGS(job->path), STREAM_IN | STREAM_BINARY);
+	void* buffer = memory_allocate(0, FS_DIGEST_LEAF_SIZE, 0, MEMORY_PERSISTENT);
+	bool complete = false;
+
+	// Each worker reads through its own file handle, claiming leaves in order
+	while (file && !atomic_load32(&job->failed, memory_order_relaxed)) {
+		size_t leaf = (size_t)atomic_exchange_and_add64(&job->next, 1, memory_order_relaxed);
+		if (leaf >= job->leaves) {
+			complete = true;
+			break;
+		}
+
+		size_t offset = leaf * FS_DIGEST_LEAF_SIZE;
+		size_t size = math_min(job->size - offset, (size_t)FS_DIGEST_LEAF_SIZE);
+		stream_seek(file, (ssize_t)offset, STREAM_SEEK_BEGIN);
+		if (stream_read(file, buffer, size) != size)
+			break;
+
+		job->node[leaf] = fs_digest_node(job->algorithm, 0, buffer, size);
+	}
+
+	if (!complete)
+		atomic_store32(&job->failed, 1, memory_order_relaxed);
+
+	memory_deallocate(buffer);
+	stream_deallocate(file);
+
+	return 0;
+}
+
+uint512_t
+fs_digest_parallel(const char* path, size_t length, fs_digest_t algorithm, size_t threads) {
+	uint512_t digest = uint512_null();
+	unsigned char pair[sizeof(uint512_t) * 2];
+	fs_digest_job_t job;
+	thread_t* thread = 0;
+	size_t ithread, inode, iword;
+
+	stream_t* file = fs_open_file(path, length, STREAM_IN | STREAM_BINARY);
+	if (!file)
+		return digest;
+
+	memset(&job, 0, sizeof(job));
+	job.path = string_const(path, length);
+	job.algorithm = algorithm;
+	job.size = stream_size(file);
+	job.leaves = job.size ? ((job.size + (FS_DIGEST_LEAF_SIZE - 1)) / FS_DIGEST_LEAF_SIZE) : 1;
+	job.node = memory_allocate(0, sizeof(uint512_t) * job.leaves, 0, MEMORY_PERSISTENT);
+	stream_deallocate(file);
+
+	if (!threads)
+		threads = system_hardware_threads();
+	threads = math_clamp(threads, 1, job.leaves);
+
+	// Calling thread is one of the workers
+	if (threads > 1) {
+		thread = memory_allocate(0, sizeof(thread_t) * (threads - 1), 0, MEMORY_PERSISTENT);
+		for (ithread = 0; ithread < threads - 1; ++ithread) {
+			thread_initialize(thread + ithread, fs_digest_worker, &job, STRING_CONST("fs_digest"),
+			                  THREAD_PRIORITY_NORMAL, 0);
+			thread_start(thread + ithread);
+		}
+	}
+	fs_digest_worker(&job);
+	for (ithread = 0; ithread + 1 < threads; ++ithread) {
+		thread_join(thread + ithread);
+		thread_finalize(thread + ithread);
+	}
+	memory_deallocate(thread);
+
+	if (!atomic_load32(&job.failed, memory_order_acquire)) {
+		const size_t words = fs_digest_words(algorithm);
+		size_t count = job.leaves;
+		while (count > 1) {
+			for (inode = 0; inode + 1 < count; inode += 2) {
+				for (iword = 0; iword < words; ++iword) {
+					uint64_t left = byteorder_bigendian64(job.node[inode].word[iword]);
+					uint64_t right = byteorder_bigendian64(job.node[inode + 1].word[iword]);
+					memcpy(pair + (iword * 8), &left, 8);
+					memcpy(pair + ((words + iword) * 8), &right, 8);
+				}
+				job.node[inode / 2] = fs_digest_node(algorithm, 1, pair, words * 16);
+			}
+			if (count & 1)
+				job.node[count / 2] = job.node[count - 1];
+			count = (count + 1) / 2;
+		}
+		digest = job.node[0];
+	}
+
+	memory_deallocate(job.node);
+
+	return digest;
+}
+
 void
 fs_touch(const char* path, size_t length) {
 #if FOUNDATION_PLATFORM_WINDOWS
@@ -1668,6 +1840,8 @@ internal_fs_initialize(void) {
 
 	internal_ringbuffer_stream_initialize();
 	internal_buffer_stream_initialize();
+	internal_crc32c_stream_initialize();
+	internal_base64_stream_initialize();
 #if FOUNDATION_PLATFORM_ANDROID
 	internal_asset_stream_initialize();
 #endif
@@ -28,6 +28,9 @@ events on platforms supporting this. */
 #include <foundation/platform.h>
 #include <foundation/types.h>
 
+/*! Leaf size in bytes for tree mode file digests, see #fs_digest_parallel */
+#define FS_DIGEST_LEAF_SIZE (1024 * 1024)
+
 /*! Open a file in the file system
 \param path   File system path
 \param length Length of path
@@ -133,6 +136,23 @@ of this function (slow)
 FOUNDATION_API uint128_t
 fs_md5(const char* path, size_t length);
 
+/*! Get file tree mode digest, reading and digesting the file contents in parallel on
+multiple threads. The file is split in leaves of #FS_DIGEST_LEAF_SIZE bytes (the last leaf
+may be shorter, an empty file is a single empty leaf). Each leaf is digested as H(0x00 || leaf),
+and pairs of nodes are combined as H(0x01 || left || right) level by level until a single root
+remains, an odd node at the end of a level is promoted unchanged. Node digests are serialized
+as the 64-bit words of the raw digest in big endian byte order. The result is not the same as
+the plain digest of the file contents.
+\param path      File path
+\param length    Length of path
+\param algorithm Digest algorithm
+\param threads   Number of threads to use, 0 for number of hardware threads
+\return          Root digest in the leading words (2 words for MD5 and 128-bit hash, 4 for
+                  SHA-256, 8 for SHA-512) with remaining words zero, 0 if not an existing file
+                  or unreadable */
+FOUNDATION_API uint512_t
+fs_digest_parallel(const char* path, size_t length, fs_digest_t algorithm, size_t threads);
+
 /*! Get files matching the given pattern. The pattern should be a regular
 expression supported by the regex parser in the library (see regex.h documentation).
 For example, to find all files with a given extension ".ext", use the regex "^.*\\.ext$"
@@ -187,6 +187,137 @@ hash(const void* key, size_t len) {
 	return h1;
 }
 
+static FOUNDATION_FORCEINLINE uint64_t
+getblock_unaligned(const uint8_t* FOUNDATION_RESTRICT p) {
+	uint64_t ret;
+	memcpy(&ret, p, 8);
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+	return ret;
+#else
+	return byteorder_swap64(ret);
+#endif
+}
+
+static FOUNDATION_FORCEINLINE uint128_t
+hash_state_final(const hash_state_t* state) {
+	uint64_t h1 = state->h1;
+	uint64_t h2 = state->h2;
+	uint64_t c1 = state->c1;
+	uint64_t c2 = state->c2;
+	uint64_t k1 = 0;
+	uint64_t k2 = 0;
+	size_t i;
+
+	// Tail bytes are mixed in the same way as in hash()
+	if (state->current) {
+		for (i = 0; i < state->current; ++i) {
+			if (i < 8)
+				k1 ^= ((uint64_t)state->buffer[i]) << (i * 8);
+			else
+				k2 ^= ((uint64_t)state->buffer[i]) << ((i - 8) * 8);
+		}
+		bmix64(h1, h2, k1, k2, c1, c2);
+	}
+
+	// hash() only mixes the low 32 bits of the length
+	h2 ^= (unsigned int)state->length;
+
+	h1 += h2;
+	h2 += h1;
+
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+
+	h1 += h2;
+	h2 += h1;
+
+	return uint128_make(h1, h2);
+}
+
+void
+hash_initialize(hash_state_t* state) {
+	state->h1 = 0x9368e53c2f6af274ULL ^ HASH_SEED;
+	state->h2 = 0x586dcd208f7cd3fdULL ^ HASH_SEED;
+	state->c1 = 0x87c37b91114253d5ULL;
+	state->c2 = 0x4cf5ad432745937fULL;
+	state->length = 0;
+	state->current = 0;
+}
+
+hash_state_t*
+hash_update(hash_state_t* state, const void* data, size_t len) {
+	const uint8_t* input = data;
+	uint64_t h1, h2, c1, c2, k1, k2;
+
+	if (!len)
+		return state;
+
+	state->length += len;
+
+	if (state->current) {
+		size_t copy = 16 - state->current;
+		if (copy > len)
+			copy = len;
+		memcpy(state->buffer + state->current, input, copy);
+		state->current += copy;
+		input += copy;
+		len -= copy;
+		if (state->current < 16)
+			return state;
+	}
+
+	h1 = state->h1;
+	h2 = state->h2;
+	c1 = state->c1;
+	c2 = state->c2;
+
+	if (state->current == 16) {
+		k1 = getblock_unaligned(state->buffer);
+		k2 = getblock_unaligned(state->buffer + 8);
+		bmix64(h1, h2, k1, k2, c1, c2);
+		state->current = 0;
+	}
+
+	// Full blocks are mixed directly, only a partial tail is buffered
+	while (len >= 16) {
+		k1 = getblock_unaligned(input);
+		k2 = getblock_unaligned(input + 8);
+		bmix64(h1, h2, k1, k2, c1, c2);
+		input += 16;
+		len -= 16;
+	}
+
+	state->h1 = h1;
+	state->h2 = h2;
+	state->c1 = c1;
+	state->c2 = c2;
+
+	if (len) {
+		memcpy(state->buffer, input, len);
+		state->current = len;
+	}
+
+	return state;
+}
+
+hash_t
+hash_finalize(const hash_state_t* state) {
+	return hash_state_final(state).word[0];
+}
+
+uint128_t
+hash_finalize128(const hash_state_t* state) {
+	return hash_state_final(state);
+}
+
+uint128_t
+hash128(const void* key, size_t len) {
+	hash_state_t state;
+	hash_initialize(&state);
+	hash_update(&state, key, len);
+	return hash_state_final(&state);
+}
+
 #if BUILD_ENABLE_STATIC_HASH_DEBUG
 
 static hashtable64_t* hash_lookup;
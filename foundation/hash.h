@@ -35,6 +35,43 @@ creating static hashes */
 FOUNDATION_API FOUNDATION_PURECALL hash_t
 hash(const void* key, size_t len);
 
+/*! Hash data memory blob to a 128-bit value. The first 64 bits of the result are equal to
+the hash computed by #hash for the same data. Pointer does not need to be aligned
+\param key Key to hash
+\param len Length of key in bytes
+\return    128-bit hash of key */
+FOUNDATION_API FOUNDATION_PURECALL uint128_t
+hash128(const void* key, size_t len);
+
+/*! Initialize incremental hash state. Data can then be hashed in any number of
+#hash_update calls, producing the same result as a single call to #hash or #hash128 on
+the concatenated data
+\param state Hash state */
+FOUNDATION_API void
+hash_initialize(hash_state_t* state);
+
+/*! Add data to incremental hash state. Pointer does not need to be aligned
+\param state Hash state
+\param data Data to hash
+\param len Length of data in bytes
+\return Hash state */
+FOUNDATION_API hash_state_t*
+hash_update(hash_state_t* state, const void* data, size_t len);
+
+/*! Get 64-bit hash of all data added to incremental hash state. The state is not modified
+and more data can be added after this call
+\param state Hash state
+\return Hash of data */
+FOUNDATION_API hash_t
+hash_finalize(const hash_state_t* state);
+
+/*! Get 128-bit hash of all data added to incremental hash state. The state is not modified
+and more data can be added after this call
+\param state Hash state
+\return 128-bit hash of data */
+FOUNDATION_API uint128_t
+hash_finalize128(const hash_state_t* state);
+
 /*! Reverse hash lookup. Only available if #BUILD_ENABLE_STATIC_HASH_DEBUG is
 enabled, otherwise if will always return an empty string
 \param value Hash value
@@ -41,6 +41,12 @@ internal_ringbuffer_stream_initialize(void);
 FOUNDATION_API void
 internal_buffer_stream_initialize(void);
 
+FOUNDATION_API void
+internal_crc32c_stream_initialize(void);
+
+FOUNDATION_API void
+internal_base64_stream_initialize(void);
+
 #if FOUNDATION_PLATFORM_ANDROID
 FOUNDATION_API void
 internal_asset_stream_initialize(void);
@@ -91,6 +97,30 @@ internal_system_initialize(void);
 FOUNDATION_API void
 internal_system_finalize(void);
 
+FOUNDATION_API int
+internal_cpu_initialize(void);
+
+FOUNDATION_API void
+internal_aes_resolve(void);
+
+FOUNDATION_API void
+internal_base64_resolve(void);
+
+FOUNDATION_API void
+internal_crc32c_resolve(void);
+
+FOUNDATION_API void
+internal_matcher_resolve(void);
+
+FOUNDATION_API void
+internal_md5_resolve(void);
+
+FOUNDATION_API void
+internal_sha_resolve(void);
+
+FOUNDATION_API void
+internal_string_resolve(void);
+
 FOUNDATION_API int
 internal_stream_initialize(void);
 
@@ -115,6 +115,42 @@ log_make_timestamp(void) {
 static int log_hwthread_width;
 static int log_tid_width;
 
+//! Append value left aligned in a field of the given width, padded with spaces
+static size_t
+log_format_field(char* buffer, size_t offset, size_t size, uint64_t value, bool hex, int width) {
+	size_t length = string_from_uint(buffer + offset, size - offset, value, hex, 0, 0).length;
+	while (((int)length < width) && (offset + length + 1 < size))
+		buffer[offset + length++] = ' ';
+	return offset + length;
+}
+
+//! Format the "[h:mm:ss.mmm] <tid:hwthread> " prefix followed by the given prefix string
+//! without going through snprintf, returning the length
+static int
+log_format_prefix(char* buffer, size_t size, const log_timestamp_t* timestamp, uint64_t tid,
+                  unsigned int hwthreadid, const char* prefix, size_t prefix_length) {
+	size_t offset = 0;
+	buffer[offset++] = '[';
+	offset += string_from_int(buffer + offset, size - offset, timestamp->hours, 0, 0).length;
+	buffer[offset++] = ':';
+	offset += string_from_uint(buffer + offset, size - offset, (uint64_t)timestamp->minutes, false, 2, '0').length;
+	buffer[offset++] = ':';
+	offset += string_from_uint(buffer + offset, size - offset, (uint64_t)timestamp->seconds, false, 2, '0').length;
+	buffer[offset++] = '.';
+	offset +=
+	    string_from_uint(buffer + offset, size - offset, (uint64_t)timestamp->milliseconds, false, 3, '0').length;
+	buffer[offset++] = ']';
+	buffer[offset++] = ' ';
+	buffer[offset++] = '<';
+	offset = log_format_field(buffer, offset, size, tid, true, log_tid_width);
+	buffer[offset++] = ':';
+	offset = log_format_field(buffer, offset, size, hwthreadid, false, log_hwthread_width);
+	buffer[offset++] = '>';
+	buffer[offset++] = ' ';
+	offset += string_copy(buffer + offset, size - offset, prefix, prefix_length).length;
+	return (int)offset;
+}
+
 static void
 FOUNDATION_PRINTFCALL(5, 0)
     log_outputf(hash_t context, error_level_t severity, const char* prefix, size_t prefix_length, const char* format,
@@ -138,11 +174,9 @@ FOUNDATION_PRINTFCALL(5, 0)
 				log_tid_width = math_max(6, log_tid_width);
 			else if (tid >= 0x10000)
 				log_tid_width = math_max(5, log_tid_width);
-			need = snprintf(buffer, (unsigned int)size, "[%d:%02d:%02d.%03d] <%-*" PRIx64 ":%-*u> %.*s",
-			                timestamp.hours, timestamp.minutes, timestamp.seconds, timestamp.milliseconds,
-			                log_tid_width, tid, log_hwthread_width, hwthreadid, (int)prefix_length, prefix);
+			need = log_format_prefix(buffer, (size_t)size, &timestamp, tid, hwthreadid, prefix, prefix_length);
 		} else {
-			need = snprintf(buffer, (unsigned int)size, "%.*s", (int)prefix_length, prefix);
+			need = (int)string_copy(buffer, (size_t)size, prefix, prefix_length).length;
 		}
 
 		remain = size - need;
@@ -0,0 +1,543 @@
+/* matcher.c  -  Foundation library  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#include <foundation/foundation.h>
+#include <foundation/internal.h>
+
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define MATCHER_X86 1
+#else
+#define MATCHER_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && defined(__ARM_NEON)
+#define MATCHER_ARM 1
+#else
+#define MATCHER_ARM 0
+#endif
+
+// Maximum number of patterns for the prefilter. Larger sets fill the buckets with enough first
+// and second bytes to make most text positions candidates, and stepping the automaton is faster
+#define MATCHER_PREFILTER_PATTERNS 32
+
+// Number of prefilter buckets, one bit per bucket in the nibble tables
+#define MATCHER_PREFILTER_BUCKETS 8
+
+// Minimum number of bytes left in the input for calling the prefilter
+#define MATCHER_PREFILTER_THRESHOLD 16
+
+// Size of buffer for reading stream data
+#define MATCHER_STREAM_BUFFER 65536
+
+//! Find first offset in [offset,end) where the byte at the offset and the byte following it
+//! can be the first two bytes of a pattern occurrence
+typedef size_t (*matcher_prefilter_fn)(const uint8_t (*mask)[16], const uint8_t* data, size_t offset, size_t end);
+
+static matcher_prefilter_fn matcher_prefilter;
+
+static size_t
+matcher_prefilter_generic(const uint8_t (*mask)[16], const uint8_t* data, size_t offset, size_t end) {
+	for (; offset < end; ++offset) {
+		const uint8_t first = data[offset];
+		const uint8_t second = data[offset + 1];
+		if (mask[0][first & 0x0F] & mask[1][first >> 4] & mask[2][second & 0x0F] & mask[3][second >> 4])
+			return offset;
+	}
+	return STRING_NPOS;
+}
+
+#if MATCHER_X86
+#if FOUNDATION_COMPILER_CLANG
+// Unaligned loads are done with explicit unaligned intrinsics
+#pragma clang diagnostic ignored "-Wcast-align"
+#endif
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#define MATCHER_TARGET(isa)
+#else
+#include <immintrin.h>
+#define MATCHER_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// The prefilter is the "Teddy" algorithm from the Hyperscan library. Patterns are grouped in
+// eight buckets, and the bucket bits of the first two pattern bytes are stored in nibble tables.
+// Looking up the low and high nibble of each input byte and the byte following it, and and'ing
+// the four results, leaves the bits of all buckets with a pattern whose first two bytes match
+
+static FOUNDATION_FORCEINLINE unsigned int
+matcher_bit_first(uint32_t mask) {
+#if FOUNDATION_COMPILER_MSVC
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (unsigned int)index;
+#else
+	return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+MATCHER_TARGET("ssse3")
+static FOUNDATION_FORCEINLINE __m128i
+matcher_bucket_ssse3(__m128i data, __m128i table_low, __m128i table_high) {
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+	return _mm_and_si128(_mm_shuffle_epi8(table_low, _mm_and_si128(data, nibble)),
+	                     _mm_shuffle_epi8(table_high, _mm_and_si128(_mm_srli_epi16(data, 4), nibble)));
+}
+
+MATCHER_TARGET("ssse3")
+static size_t
+matcher_prefilter_ssse3(const uint8_t (*mask)[16], const uint8_t* data, size_t offset, size_t end) {
+	const __m128i first_low = _mm_loadu_si128((const __m128i*)mask[0]);
+	const __m128i first_high = _mm_loadu_si128((const __m128i*)mask[1]);
+	const __m128i second_low = _mm_loadu_si128((const __m128i*)mask[2]);
+	const __m128i second_high = _mm_loadu_si128((const __m128i*)mask[3]);
+	const __m128i zero = _mm_setzero_si128();
+	for (; offset + 16 <= end; offset += 16) {
+		const __m128i first = _mm_loadu_si128((const __m128i*)(data + offset));
+		const __m128i second = _mm_loadu_si128((const __m128i*)(data + offset + 1));
+		const __m128i bucket = _mm_and_si128(matcher_bucket_ssse3(first, first_low, first_high),
+		                                     matcher_bucket_ssse3(second, second_low, second_high));
+		const uint32_t hit = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bucket, zero)) ^ 0xFFFF;
+		if (hit)
+			return offset + matcher_bit_first(hit);
+	}
+	return matcher_prefilter_generic(mask, data, offset, end);
+}
+
+MATCHER_TARGET("avx2")
+static FOUNDATION_FORCEINLINE __m256i
+matcher_bucket_avx2(__m256i data, __m256i table_low, __m256i table_high) {
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	return _mm256_and_si256(_mm256_shuffle_epi8(table_low, _mm256_and_si256(data, nibble)),
+	                        _mm256_shuffle_epi8(table_high, _mm256_and_si256(_mm256_srli_epi16(data, 4), nibble)));
+}
+
+MATCHER_TARGET("avx2")
+static size_t
+matcher_prefilter_avx2(const uint8_t (*mask)[16], const uint8_t* data, size_t offset, size_t end) {
+	const __m256i first_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mask[0]));
+	const __m256i first_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mask[1]));
+	const __m256i second_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mask[2]));
+	const __m256i second_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mask[3]));
+	const __m256i zero = _mm256_setzero_si256();
+	for (; offset + 32 <= end; offset += 32) {
+		const __m256i first = _mm256_loadu_si256((const __m256i*)(data + offset));
+		const __m256i second = _mm256_loadu_si256((const __m256i*)(data + offset + 1));
+		const __m256i bucket = _mm256_and_si256(matcher_bucket_avx2(first, first_low, first_high),
+		                                        matcher_bucket_avx2(second, second_low, second_high));
+		const uint32_t hit = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bucket, zero));
+		if (hit)
+			return offset + matcher_bit_first(hit);
+	}
+	_mm256_zeroupper();
+	return matcher_prefilter_ssse3(mask, data, offset, end);
+}
+
+#elif MATCHER_ARM
+#include <arm_neon.h>
+
+static FOUNDATION_FORCEINLINE unsigned int
+matcher_bit_first(uint64_t mask) {
+	return (unsigned int)__builtin_ctzll(mask) >> 2;
+}
+
+static FOUNDATION_FORCEINLINE uint8x16_t
+matcher_bucket_neon(uint8x16_t data, uint8x16_t table_low, uint8x16_t table_high) {
+	return vandq_u8(vqtbl1q_u8(table_low, vandq_u8(data, vdupq_n_u8(0x0F))),
+	                vqtbl1q_u8(table_high, vshrq_n_u8(data, 4)));
+}
+
+static size_t
+matcher_prefilter_neon(const uint8_t (*mask)[16], const uint8_t* data, size_t offset, size_t end) {
+	const uint8x16_t first_low = vld1q_u8(mask[0]);
+	const uint8x16_t first_high = vld1q_u8(mask[1]);
+	const uint8x16_t second_low = vld1q_u8(mask[2]);
+	const uint8x16_t second_high = vld1q_u8(mask[3]);
+	for (; offset + 16 <= end; offset += 16) {
+		const uint8x16_t first = vld1q_u8(data + offset);
+		const uint8x16_t second = vld1q_u8(data + offset + 1);
+		const uint8x16_t bucket = vandq_u8(matcher_bucket_neon(first, first_low, first_high),
+		                                   matcher_bucket_neon(second, second_low, second_high));
+		const uint64_t hit =
+		    vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vtstq_u8(bucket, bucket)), 4)), 0);
+		if (hit)
+			return offset + matcher_bit_first(hit);
+	}
+	return matcher_prefilter_generic(mask, data, offset, end);
+}
+
+#endif
+
+static const cpu_dispatch_t matcher_prefilter_candidates[] = {
+#if MATCHER_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)matcher_prefilter_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)matcher_prefilter_ssse3},
+#elif MATCHER_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)matcher_prefilter_neon},
+#endif
+    {0, (cpu_dispatch_fn)matcher_prefilter_generic}};
+
+//! Select prefilter function from CPU features detected at runtime. Resolving is
+//! idempotent, concurrent calls store the same function pointer
+void
+internal_matcher_resolve(void) {
+	matcher_prefilter = (matcher_prefilter_fn)system_cpu_dispatch(
+	    matcher_prefilter_candidates, sizeof(matcher_prefilter_candidates) / sizeof(matcher_prefilter_candidates[0]));
+}
+
+matcher_t*
+matcher_allocate(const string_const_t* patterns, size_t count) {
+	matcher_t* matcher = memory_allocate(0, sizeof(matcher_t), 0, MEMORY_PERSISTENT);
+	matcher_initialize(matcher, patterns, count);
+	return matcher;
+}
+
+void
+matcher_deallocate(matcher_t* matcher) {
+	if (matcher)
+		matcher_finalize(matcher);
+	memory_deallocate(matcher);
+}
+
+static void
+matcher_build_prefilter(matcher_t* matcher, const string_const_t* patterns, size_t count) {
+	uint8_t bucket_of_byte[256];
+	unsigned int next_bucket = 0;
+	size_t used = 0;
+	size_t ipattern;
+
+	for (ipattern = 0; ipattern < count; ++ipattern) {
+		if (patterns[ipattern].length && (++used > MATCHER_PREFILTER_PATTERNS))
+			return;
+	}
+	if (!used)
+		return;
+
+	// Patterns sharing a first byte go in the same bucket, which keeps false candidates from
+	// mixing the first byte of one pattern with the second byte of another at a minimum
+	memset(bucket_of_byte, 0xFF, sizeof(bucket_of_byte));
+	for (ipattern = 0; ipattern < count; ++ipattern) {
+		const string_const_t pattern = patterns[ipattern];
+		uint8_t first, bit;
+		if (!pattern.length)
+			continue;
+		first = (uint8_t)pattern.str[0];
+		if (bucket_of_byte[first] == 0xFF)
+			bucket_of_byte[first] = (uint8_t)(next_bucket++ % MATCHER_PREFILTER_BUCKETS);
+		bit = (uint8_t)(1U << bucket_of_byte[first]);
+		matcher->prefilter_mask[0][first & 0x0F] |= bit;
+		matcher->prefilter_mask[1][first >> 4] |= bit;
+		if (pattern.length > 1) {
+			const uint8_t second = (uint8_t)pattern.str[1];
+			matcher->prefilter_mask[2][second & 0x0F] |= bit;
+			matcher->prefilter_mask[3][second >> 4] |= bit;
+		} else {
+			// Single byte patterns match any following byte
+			for (unsigned int inibble = 0; inibble < 16; ++inibble) {
+				matcher->prefilter_mask[2][inibble] |= bit;
+				matcher->prefilter_mask[3][inibble] |= bit;
+			}
+		}
+	}
+	matcher->prefilter = true;
+}
+
+void
+matcher_initialize(matcher_t* matcher, const string_const_t* patterns, size_t count) {
+	bool used[256];
+	size_t total = 0;
+	size_t ipattern, ichar;
+	size_t capacity, match_total;
+	unsigned int distinct = 0;
+	unsigned int class_count;
+	unsigned int state_count = 1;
+	unsigned int match_first;
+	unsigned int ibyte, iclass, istate;
+	unsigned int head, tail;
+	uint32_t* trie;
+	uint32_t* terminal;
+	uint32_t* chain;
+	uint32_t* fail;
+	uint32_t* queue;
+	uint32_t* remap;
+	uint32_t* match_count;
+
+	memset(matcher, 0, sizeof(matcher_t));
+	matcher->pattern_count = count;
+	matcher->pattern_length = memory_allocate(0, sizeof(uint32_t) * (count ? count : 1), 0, MEMORY_PERSISTENT);
+
+	// Bytes used in patterns get a class each, all other bytes share class zero which
+	// always leads back to the root state
+	memset(used, 0, sizeof(used));
+	for (ipattern = 0; ipattern < count; ++ipattern) {
+		const string_const_t pattern = patterns[ipattern];
+		matcher->pattern_length[ipattern] = (uint32_t)pattern.length;
+		for (ichar = 0; ichar < pattern.length; ++ichar)
+			used[(uint8_t)pattern.str[ichar]] = true;
+		total += pattern.length;
+	}
+	for (ibyte = 0; ibyte < 256; ++ibyte)
+		distinct += used[ibyte] ? 1 : 0;
+	class_count = (distinct < 256) ? 1 : 0;
+	for (ibyte = 0; ibyte < 256; ++ibyte)
+		matcher->byte_class[ibyte] = used[ibyte] ? (uint8_t)class_count++ : 0;
+
+	// Transition table entries are premultiplied 32-bit state indices
+	capacity = total + 1;
+	if (capacity > (size_t)UINT32_MAX / class_count) {
+		log_error(0, ERROR_INVALID_VALUE, STRING_CONST("Pattern set too large for matcher"));
+		capacity = 1;
+		count = 0;
+	}
+
+	// Build the trie in a dense goto table, with at most one state per pattern byte
+	trie = memory_allocate(0, sizeof(uint32_t) * capacity * class_count, 0, MEMORY_TEMPORARY | MEMORY_ZERO_INITIALIZED);
+	terminal = memory_allocate(0, sizeof(uint32_t) * capacity * 5, 0, MEMORY_TEMPORARY);
+	fail = terminal + capacity;
+	queue = fail + capacity;
+	remap = queue + capacity;
+	match_count = remap + capacity;
+	chain = memory_allocate(0, sizeof(uint32_t) * (count ? count : 1), 0, MEMORY_TEMPORARY);
+	memset(terminal, 0xFF, sizeof(uint32_t) * capacity);
+
+	for (ipattern = 0; ipattern < count; ++ipattern) {
+		const string_const_t pattern = patterns[ipattern];
+		uint32_t state = 0;
+		for (ichar = 0; ichar < pattern.length; ++ichar) {
+			uint32_t* next = trie + (state * class_count) + matcher->byte_class[(uint8_t)pattern.str[ichar]];
+			if (!*next)
+				*next = state_count++;
+			state = *next;
+		}
+		chain[ipattern] = state;
+	}
+	// Link patterns ending in each state, in increasing pattern index order
+	ipattern = count;
+	while (ipattern--) {
+		const uint32_t state = chain[ipattern];
+		if (!patterns[ipattern].length)
+			continue;
+		chain[ipattern] = terminal[state];
+		terminal[state] = (uint32_t)ipattern;
+	}
+
+	// Breadth first traversal computing failure links and filling in missing transitions
+	// from the failure state, turning the trie into a deterministic automaton. Rows of
+	// shallower states are complete when a state is visited
+	fail[0] = 0;
+	queue[0] = 0;
+	head = 0;
+	tail = 1;
+	match_total = 0;
+	while (head < tail) {
+		const uint32_t state = queue[head++];
+		uint32_t* row = trie + (state * class_count);
+		const uint32_t* fail_row = trie + (fail[state] * class_count);
+		uint32_t own = 0;
+		for (uint32_t imatch = terminal[state]; imatch != 0xFFFFFFFFU; imatch = chain[imatch])
+			++own;
+		match_count[state] = own + (state ? match_count[fail[state]] : 0);
+		match_total += match_count[state];
+		for (iclass = 0; iclass < class_count; ++iclass) {
+			const uint32_t child = row[iclass];
+			if (child) {
+				fail[child] = state ? fail_row[iclass] : 0;
+				queue[tail++] = child;
+			} else {
+				row[iclass] = state ? fail_row[iclass] : 0;
+			}
+		}
+	}
+
+	// Renumber states in traversal order with all states having matches last, which turns the
+	// match check in the scan loop into a single compare against the first such state
+	match_first = 0;
+	for (istate = 0; istate < state_count; ++istate) {
+		if (!match_count[queue[istate]])
+			remap[queue[istate]] = match_first++;
+	}
+	for (istate = 0, iclass = match_first; istate < state_count; ++istate) {
+		if (match_count[queue[istate]])
+			remap[queue[istate]] = iclass++;
+	}
+
+	matcher->state_count = state_count;
+	matcher->class_count = class_count;
+	matcher->match_state = match_first * class_count;
+	matcher->transition = memory_allocate(0, sizeof(uint32_t) * state_count * class_count, 0, MEMORY_PERSISTENT);
+	matcher->match_offset =
+	    memory_allocate(0, sizeof(uint32_t) * (state_count - match_first + 1), 0, MEMORY_PERSISTENT);
+	matcher->match = memory_allocate(0, sizeof(uint32_t) * (match_total ? match_total : 1), 0, MEMORY_PERSISTENT);
+	matcher->match_offset[0] = 0;
+
+	match_total = 0;
+	for (istate = 0; istate < state_count; ++istate) {
+		const uint32_t state = queue[istate];
+		const uint32_t* row = trie + (state * class_count);
+		uint32_t* transition = matcher->transition + (remap[state] * class_count);
+		uint32_t* match_offset;
+		for (iclass = 0; iclass < class_count; ++iclass)
+			transition[iclass] = remap[row[iclass]] * class_count;
+
+		if (!match_count[state])
+			continue;
+
+		// Match lists are stored in traversal order, the list of the failure state is complete
+		match_offset = matcher->match_offset + (remap[state] - match_first);
+		for (uint32_t imatch = terminal[state]; imatch != 0xFFFFFFFFU; imatch = chain[imatch])
+			matcher->match[match_total++] = imatch;
+		if (match_count[fail[state]]) {
+			const uint32_t* suffix = matcher->match_offset + (remap[fail[state]] - match_first);
+			const size_t suffix_count = suffix[1] - suffix[0];
+			memcpy(matcher->match + match_total, matcher->match + suffix[0], sizeof(uint32_t) * suffix_count);
+			match_total += suffix_count;
+		}
+		match_offset[1] = (uint32_t)match_total;
+	}
+
+	memory_deallocate(chain);
+	memory_deallocate(terminal);
+	memory_deallocate(trie);
+
+	matcher_build_prefilter(matcher, patterns, count);
+}
+
+void
+matcher_finalize(matcher_t* matcher) {
+	memory_deallocate(matcher->match);
+	memory_deallocate(matcher->match_offset);
+	memory_deallocate(matcher->transition);
+	memory_deallocate(matcher->pattern_length);
+	matcher->match = nullptr;
+	matcher->match_offset = nullptr;
+	matcher->transition = nullptr;
+	matcher->pattern_length = nullptr;
+	matcher->state_count = 0;
+	matcher->pattern_count = 0;
+}
+
+//! Report all matches of the given state for an occurrence ending at the given offset,
+//! returns false if the callback stopped the scan
+static bool
+matcher_report(const matcher_t* matcher, uint32_t state, size_t end, matcher_match_fn callback, void* context,
+               size_t* count) {
+	const uint32_t index = (state - matcher->match_state) / matcher->class_count;
+	const uint32_t* match = matcher->match + matcher->match_offset[index];
+	const uint32_t* match_end = matcher->match + matcher->match_offset[index + 1];
+	for (; match != match_end; ++match) {
+		const size_t length = matcher->pattern_length[*match];
+		++(*count);
+		if (callback(*match, end - length, length, context))
+			return false;
+	}
+	return true;
+}
+
+size_t
+matcher_scan_chunk(const matcher_t* matcher, matcher_state_t* state, const void* buffer, size_t size,
+                   matcher_match_fn callback, void* context) {
+	const uint32_t* transition = matcher->transition;
+	const uint8_t* byte_class = matcher->byte_class;
+	const uint32_t match_state = matcher->match_state;
+	const uint8_t* data = buffer;
+	const size_t base = state->offset;
+	uint32_t current = state->state;
+	size_t count = 0;
+	size_t offset = 0;
+
+	if (matcher->state_count <= 1) {
+		state->offset += size;
+		return 0;
+	}
+
+	if (!matcher->prefilter) {
+		while (offset < size) {
+			current = transition[current + byte_class[data[offset++]]];
+			if ((current >= match_state) && !matcher_report(matcher, current, base + offset, callback, context, &count))
+				break;
+		}
+		state->state = current;
+		state->offset = base + offset;
+		return count;
+	}
+
+	if (!matcher_prefilter)
+		internal_matcher_resolve();
+
+	while (offset < size) {
+		// At the root state no occurrence is in progress, skip ahead to the next position that
+		// can start one. The last byte has no following byte for the prefilter to look at and
+		// is stepped through the automaton
+		if (!current && (size - offset > MATCHER_PREFILTER_THRESHOLD)) {
+			offset = matcher_prefilter((const uint8_t(*)[16])matcher->prefilter_mask, data, offset, size - 1);
+			if (offset == STRING_NPOS)
+				offset = size - 1;
+		}
+		do {
+			current = transition[current + byte_class[data[offset++]]];
+			if ((current >= match_state) &&
+			    !matcher_report(matcher, current, base + offset, callback, context, &count)) {
+				state->state = current;
+				state->offset = base + offset;
+				return count;
+			}
+		} while (current && (offset < size));
+	}
+	state->state = current;
+	state->offset = base + offset;
+	return count;
+}
+
+size_t
+matcher_scan(const matcher_t* matcher, const void* buffer, size_t size, matcher_match_fn callback, void* context) {
+	matcher_state_t state;
+	matcher_state_initialize(&state);
+	return matcher_scan_chunk(matcher, &state, buffer, size, callback, context);
+}
+
+void
+matcher_state_initialize(matcher_state_t* state) {
+	state->state = 0;
+	state->offset = 0;
+}
+
+//! Callback forwarding for stream scanning, recording if the scan was stopped
+typedef struct matcher_stream_context_t {
+	matcher_match_fn callback;
+	void* context;
+	bool stopped;
+} matcher_stream_context_t;
+
+static int
+matcher_stream_match(size_t pattern, size_t offset, size_t length, void* context) {
+	matcher_stream_context_t* forward = context;
+	forward->stopped = (forward->callback(pattern, offset, length, forward->context) != 0);
+	return forward->stopped ? 1 : 0;
+}
+
+size_t
+matcher_scan_stream(const matcher_t* matcher, stream_t* stream, matcher_match_fn callback, void* context) {
+	matcher_state_t state;
+	matcher_stream_context_t forward = {callback, context, false};
+	size_t count = 0;
+	void* buffer = memory_allocate(0, MATCHER_STREAM_BUFFER, 0, MEMORY_TEMPORARY);
+	matcher_state_initialize(&state);
+	while (!forward.stopped && !stream_eos(stream)) {
+		const size_t read = stream_read(stream, buffer, MATCHER_STREAM_BUFFER);
+		if (!read)
+			break;
+		count += matcher_scan_chunk(matcher, &state, buffer, read, matcher_stream_match, &forward);
+	}
+	memory_deallocate(buffer);
+	return count;
+}
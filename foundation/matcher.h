@@ -0,0 +1,109 @@
+/* matcher.h  -  Foundation library  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#pragma once
+
+/*! \file matcher.h
+\brief Multi-pattern literal string matcher
+
+Matcher finding all occurrences of a set of literal patterns in a single pass over the
+input, in time linear to the input size regardless of the number of patterns. The patterns
+are compiled once to an Aho-Corasick automaton with a deterministic transition table, and
+the matcher can then be used to scan any number of inputs concurrently from multiple threads.
+
+For small pattern sets the scan uses a vectorized prefilter (SSSE3/AVX2 or NEON) matching
+the first two bytes of all patterns against 16 or 32 input positions at a time, skipping
+input that cannot start a match without stepping the automaton.
+
+Matches are reported through a callback with the pattern index, the offset of the first
+byte of the occurrence and the pattern length. All occurrences are reported, including
+overlapping occurrences and occurrences of patterns that are substrings of other patterns.
+Occurrences are reported in order of their end offset, and in order of decreasing pattern
+length for occurrences ending at the same offset. Empty patterns never match.
+
+Input can be scanned incrementally in chunks with a #matcher_state_t, reporting the same
+matches with the same offsets as a single scan over the concatenated chunks:
+
+<pre>matcher_state_t state;
+matcher_state_initialize(&state);
+matcher_scan_chunk(matcher, &state, chunk0, size0, callback, context);
+matcher_scan_chunk(matcher, &state, chunk1, size1, callback, context);</pre> */
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+/*! Allocate a matcher for the given patterns. Pattern data is not referenced after the call.
+Deallocate the matcher with a call to #matcher_deallocate
+\param patterns Array of patterns, index in array is the pattern index reported in matches
+\param count Number of patterns
+\return New matcher */
+FOUNDATION_API matcher_t*
+matcher_allocate(const string_const_t* patterns, size_t count);
+
+/*! Deallocate a matcher previously allocated with #matcher_allocate
+\param matcher Matcher */
+FOUNDATION_API void
+matcher_deallocate(matcher_t* matcher);
+
+/*! Initialize a matcher for the given patterns, see #matcher_allocate. Finalize the matcher
+with a call to #matcher_finalize
+\param matcher Matcher
+\param patterns Array of patterns, index in array is the pattern index reported in matches
+\param count Number of patterns */
+FOUNDATION_API void
+matcher_initialize(matcher_t* matcher, const string_const_t* patterns, size_t count);
+
+/*! Finalize a matcher previously initialized with #matcher_initialize
+\param matcher Matcher */
+FOUNDATION_API void
+matcher_finalize(matcher_t* matcher);
+
+/*! Scan a buffer and report all pattern occurrences
+\param matcher Matcher
+\param buffer Data buffer
+\param size Size of data in bytes
+\param callback Function called for each match, return non-zero to stop scanning
+\param context User context passed to callback
+\return Number of matches reported */
+FOUNDATION_API size_t
+matcher_scan(const matcher_t* matcher, const void* buffer, size_t size, matcher_match_fn callback,
+             void* context);
+
+/*! Initialize an incremental scanning state to the start of input
+\param state Scanning state */
+FOUNDATION_API void
+matcher_state_initialize(matcher_state_t* state);
+
+/*! Scan the next chunk of input, reporting all pattern occurrences ending in the chunk
+including occurrences starting in previous chunks. Offsets are relative to the start of
+input given at the first chunk. If the callback stops the scan the state is left at the
+end of the stopping match, and the remaining data of the chunk is not scanned
+\param matcher Matcher
+\param state Scanning state
+\param buffer Data buffer
+\param size Size of data in bytes
+\param callback Function called for each match, return non-zero to stop scanning
+\param context User context passed to callback
+\return Number of matches reported */
+FOUNDATION_API size_t
+matcher_scan_chunk(const matcher_t* matcher, matcher_state_t* state, const void* buffer, size_t size,
+                   matcher_match_fn callback, void* context);
+
+/*! Scan all data read from a stream until end of stream, reporting all pattern occurrences.
+Offsets are relative to the stream position at the start of the call
+\param matcher Matcher
+\param stream Stream
+\param callback Function called for each match, return non-zero to stop scanning
+\param context User context passed to callback
+\return Number of matches reported */
+FOUNDATION_API size_t
+matcher_scan_stream(const matcher_t* matcher, stream_t* stream, matcher_match_fn callback, void* context);
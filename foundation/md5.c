@@ -11,6 +11,7 @@
  */
 
 #include <foundation/foundation.h>
+#include <foundation/internal.h>
 
 /*lint -e123 */
 #define MD5_F1(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
@@ -123,6 +124,373 @@ md5_transform(md5_t* digest, const unsigned char* buffer) {
 	digest->state[3] += d;
 }
 
+// Multi-buffer digestion, running independent messages in SIMD lanes. Each lane holds
+// one 32-bit state word per message, blocks are transposed so that word i of all lanes
+// end up in the same register
+
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define MD5_MULTI_X86 1
+#else
+#define MD5_MULTI_X86 0
+#endif
+
+#define MD5_MULTI_MAX_LANES 16
+
+#define MD5_MULTI_F1(op, x, y, z) op##XOR(z, op##AND(x, op##XOR(y, z)))
+#define MD5_MULTI_F2(op, x, y, z) op##XOR(y, op##AND(z, op##XOR(x, y)))
+#define MD5_MULTI_F3(op, x, y, z) op##XOR(op##XOR(x, y), z)
+#define MD5_MULTI_F4(op, x, y, z) op##XOR(y, op##OR(x, op##XOR(z, op##ONES)))
+
+#define MD5_MULTI_STEP(op, f, a, b, c, d, x, t, s)                      \
+	(a) = op##ADD(op##ADD(a, f(op, b, c, d)), op##ADD(x, op##SET1(t))); \
+	(a) = op##ROTL(a, s);                                               \
+	(a) = op##ADD(a, b)
+
+#define MD5_MULTI_ROUNDS(op, a, b, c, d, x)                              \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, a, b, c, d, x[0], 0xd76aa478, 7);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, d, a, b, c, x[1], 0xe8c7b756, 12);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, c, d, a, b, x[2], 0x242070db, 17);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, b, c, d, a, x[3], 0xc1bdceee, 22);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, a, b, c, d, x[4], 0xf57c0faf, 7);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, d, a, b, c, x[5], 0x4787c62a, 12);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, c, d, a, b, x[6], 0xa8304613, 17);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, b, c, d, a, x[7], 0xfd469501, 22);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, a, b, c, d, x[8], 0x698098d8, 7);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, d, a, b, c, x[9], 0x8b44f7af, 12);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, c, d, a, b, x[10], 0xffff5bb1, 17); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, b, c, d, a, x[11], 0x895cd7be, 22); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, a, b, c, d, x[12], 0x6b901122, 7);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, d, a, b, c, x[13], 0xfd987193, 12); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, c, d, a, b, x[14], 0xa679438e, 17); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F1, b, c, d, a, x[15], 0x49b40821, 22); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, a, b, c, d, x[1], 0xf61e2562, 5);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, d, a, b, c, x[6], 0xc040b340, 9);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, c, d, a, b, x[11], 0x265e5a51, 14); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, b, c, d, a, x[0], 0xe9b6c7aa, 20);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, a, b, c, d, x[5], 0xd62f105d, 5);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, d, a, b, c, x[10], 0x02441453, 9);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, c, d, a, b, x[15], 0xd8a1e681, 14); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, b, c, d, a, x[4], 0xe7d3fbc8, 20);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, a, b, c, d, x[9], 0x21e1cde6, 5);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, d, a, b, c, x[14], 0xc33707d6, 9);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, c, d, a, b, x[3], 0xf4d50d87, 14);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, b, c, d, a, x[8], 0x455a14ed, 20);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, a, b, c, d, x[13], 0xa9e3e905, 5);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, d, a, b, c, x[2], 0xfcefa3f8, 9);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, c, d, a, b, x[7], 0x676f02d9, 14);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F2, b, c, d, a, x[12], 0x8d2a4c8a, 20); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, a, b, c, d, x[5], 0xfffa3942, 4);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, d, a, b, c, x[8], 0x8771f681, 11);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, c, d, a, b, x[11], 0x6d9d6122, 16); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, b, c, d, a, x[14], 0xfde5380c, 23); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, a, b, c, d, x[1], 0xa4beea44, 4);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, d, a, b, c, x[4], 0x4bdecfa9, 11);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, c, d, a, b, x[7], 0xf6bb4b60, 16);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, b, c, d, a, x[10], 0xbebfbc70, 23); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, a, b, c, d, x[13], 0x289b7ec6, 4);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, d, a, b, c, x[0], 0xeaa127fa, 11);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, c, d, a, b, x[3], 0xd4ef3085, 16);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, b, c, d, a, x[6], 0x04881d05, 23);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, a, b, c, d, x[9], 0xd9d4d039, 4);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, d, a, b, c, x[12], 0xe6db99e5, 11); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, c, d, a, b, x[15], 0x1fa27cf8, 16); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F3, b, c, d, a, x[2], 0xc4ac5665, 23);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, a, b, c, d, x[0], 0xf4292244, 6);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, d, a, b, c, x[7], 0x432aff97, 10);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, c, d, a, b, x[14], 0xab9423a7, 15); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, b, c, d, a, x[5], 0xfc93a039, 21);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, a, b, c, d, x[12], 0x655b59c3, 6);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, d, a, b, c, x[3], 0x8f0ccc92, 10);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, c, d, a, b, x[10], 0xffeff47d, 15); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, b, c, d, a, x[1], 0x85845dd1, 21);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, a, b, c, d, x[8], 0x6fa87e4f, 6);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, d, a, b, c, x[15], 0xfe2ce6e0, 10); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, c, d, a, b, x[6], 0xa3014314, 15);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, b, c, d, a, x[13], 0x4e0811a1, 21); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, a, b, c, d, x[4], 0xf7537e82, 6);   \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, d, a, b, c, x[11], 0xbd3af235, 10); \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, c, d, a, b, x[2], 0x2ad7d2bb, 15);  \
+	MD5_MULTI_STEP(op, MD5_MULTI_F4, b, c, d, a, x[9], 0xeb86d391, 21)
+
+#if MD5_MULTI_X86
+
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#define MD5_TARGET(isa)
+#else
+#include <immintrin.h>
+#define MD5_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define MD5_SSE_ADD(a, b) _mm_add_epi32(a, b)
+#define MD5_SSE_XOR(a, b) _mm_xor_si128(a, b)
+#define MD5_SSE_AND(a, b) _mm_and_si128(a, b)
+#define MD5_SSE_OR(a, b) _mm_or_si128(a, b)
+#define MD5_SSE_ONES _mm_set1_epi32(-1)
+#define MD5_SSE_SET1(t) _mm_set1_epi32((int)(t))
+#define MD5_SSE_ROTL(a, s) _mm_or_si128(_mm_slli_epi32(a, s), _mm_srli_epi32(a, 32 - (s)))
+
+#define MD5_AVX2_ADD(a, b) _mm256_add_epi32(a, b)
+#define MD5_AVX2_XOR(a, b) _mm256_xor_si256(a, b)
+#define MD5_AVX2_AND(a, b) _mm256_and_si256(a, b)
+#define MD5_AVX2_OR(a, b) _mm256_or_si256(a, b)
+#define MD5_AVX2_ONES _mm256_set1_epi32(-1)
+#define MD5_AVX2_SET1(t) _mm256_set1_epi32((int)(t))
+#define MD5_AVX2_ROTL(a, s) _mm256_or_si256(_mm256_slli_epi32(a, s), _mm256_srli_epi32(a, 32 - (s)))
+
+#define MD5_AVX512_ADD(a, b) _mm512_add_epi32(a, b)
+#define MD5_AVX512_XOR(a, b) _mm512_xor_si512(a, b)
+#define MD5_AVX512_AND(a, b) _mm512_and_si512(a, b)
+#define MD5_AVX512_OR(a, b) _mm512_or_si512(a, b)
+#define MD5_AVX512_ONES _mm512_set1_epi32(-1)
+#define MD5_AVX512_SET1(t) _mm512_set1_epi32((int)(t))
+#define MD5_AVX512_ROTL(a, s) _mm512_rol_epi32(a, s)
+
+MD5_TARGET("sse2")
+static void
+md5_transform_sse(uint32_t* state, const unsigned char** block) {
+	__m128i a = _mm_loadu_si128((const __m128i*)(const void*)state);
+	__m128i b = _mm_loadu_si128((const __m128i*)(const void*)(state + 4));
+	__m128i c = _mm_loadu_si128((const __m128i*)(const void*)(state + 8));
+	__m128i d = _mm_loadu_si128((const __m128i*)(const void*)(state + 12));
+	__m128i a0 = a, b0 = b, c0 = c, d0 = d;
+	__m128i x[16];
+
+	for (size_t i = 0; i < 4; ++i) {
+		__m128i r0 = _mm_loadu_si128((const __m128i*)(const void*)(block[0] + (16 * i)));
+		__m128i r1 = _mm_loadu_si128((const __m128i*)(const void*)(block[1] + (16 * i)));
+		__m128i r2 = _mm_loadu_si128((const __m128i*)(const void*)(block[2] + (16 * i)));
+		__m128i r3 = _mm_loadu_si128((const __m128i*)(const void*)(block[3] + (16 * i)));
+		__m128i t0 = _mm_unpacklo_epi32(r0, r1);
+		__m128i t1 = _mm_unpackhi_epi32(r0, r1);
+		__m128i t2 = _mm_unpacklo_epi32(r2, r3);
+		__m128i t3 = _mm_unpackhi_epi32(r2, r3);
+		x[(4 * i) + 0] = _mm_unpacklo_epi64(t0, t2);
+		x[(4 * i) + 1] = _mm_unpackhi_epi64(t0, t2);
+		x[(4 * i) + 2] = _mm_unpacklo_epi64(t1, t3);
+		x[(4 * i) + 3] = _mm_unpackhi_epi64(t1, t3);
+	}
+
+	MD5_MULTI_ROUNDS(MD5_SSE_, a, b, c, d, x);
+
+	_mm_storeu_si128((__m128i*)(void*)state, _mm_add_epi32(a, a0));
+	_mm_storeu_si128((__m128i*)(void*)(state + 4), _mm_add_epi32(b, b0));
+	_mm_storeu_si128((__m128i*)(void*)(state + 8), _mm_add_epi32(c, c0));
+	_mm_storeu_si128((__m128i*)(void*)(state + 12), _mm_add_epi32(d, d0));
+}
+
+MD5_TARGET("avx2")
+static void
+md5_transform_avx2(uint32_t* state, const unsigned char** block) {
+	__m256i a = _mm256_loadu_si256((const __m256i*)(const void*)state);
+	__m256i b = _mm256_loadu_si256((const __m256i*)(const void*)(state + 8));
+	__m256i c = _mm256_loadu_si256((const __m256i*)(const void*)(state + 16));
+	__m256i d = _mm256_loadu_si256((const __m256i*)(const void*)(state + 24));
+	__m256i a0 = a, b0 = b, c0 = c, d0 = d;
+	__m256i x[16];
+
+	// Lane n in low half and lane n + 4 in high half of each row, transpose per 128-bit half
+	for (size_t i = 0; i < 4; ++i) {
+		__m256i r[4];
+		for (size_t j = 0; j < 4; ++j)
+			r[j] = _mm256_inserti128_si256(
+			    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(const void*)(block[j] + (16 * i)))),
+			    _mm_loadu_si128((const __m128i*)(const void*)(block[j + 4] + (16 * i))), 1);
+		__m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+		__m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+		__m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+		__m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+		x[(4 * i) + 0] = _mm256_unpacklo_epi64(t0, t2);
+		x[(4 * i) + 1] = _mm256_unpackhi_epi64(t0, t2);
+		x[(4 * i) + 2] = _mm256_unpacklo_epi64(t1, t3);
+		x[(4 * i) + 3] = _mm256_unpackhi_epi64(t1, t3);
+	}
+
+	MD5_MULTI_ROUNDS(MD5_AVX2_, a, b, c, d, x);
+
+	_mm256_storeu_si256((__m256i*)(void*)state, _mm256_add_epi32(a, a0));
+	_mm256_storeu_si256((__m256i*)(void*)(state + 8), _mm256_add_epi32(b, b0));
+	_mm256_storeu_si256((__m256i*)(void*)(state + 16), _mm256_add_epi32(c, c0));
+	_mm256_storeu_si256((__m256i*)(void*)(state + 24), _mm256_add_epi32(d, d0));
+}
+
+MD5_TARGET("avx512f")
+static void
+md5_transform_avx512(uint32_t* state, const unsigned char** block) {
+	__m512i a = _mm512_loadu_si512((const void*)state);
+	__m512i b = _mm512_loadu_si512((const void*)(state + 16));
+	__m512i c = _mm512_loadu_si512((const void*)(state + 32));
+	__m512i d = _mm512_loadu_si512((const void*)(state + 48));
+	__m512i a0 = a, b0 = b, c0 = c, d0 = d;
+	__m512i x[16];
+
+	// Lanes n, n + 4, n + 8 and n + 12 in the four 128-bit quarters of each row
+	for (size_t i = 0; i < 4; ++i) {
+		__m512i r[4];
+		for (size_t j = 0; j < 4; ++j) {
+			__m512i row = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(const void*)(block[j] + (16 * i))));
+			row = _mm512_inserti32x4(row, _mm_loadu_si128((const __m128i*)(const void*)(block[j + 4] + (16 * i))), 1);
+			row = _mm512_inserti32x4(row, _mm_loadu_si128((const __m128i*)(const void*)(block[j + 8] + (16 * i))), 2);
+			r[j] = _mm512_inserti32x4(row, _mm_loadu_si128((const __m128i*)(const void*)(block[j + 12] + (16 * i))), 3);
+		}
+		__m512i t0 = _mm512_unpacklo_epi32(r[0], r[1]);
+		__m512i t1 = _mm512_unpackhi_epi32(r[0], r[1]);
+		__m512i t2 = _mm512_unpacklo_epi32(r[2], r[3]);
+		__m512i t3 = _mm512_unpackhi_epi32(r[2], r[3]);
+		x[(4 * i) + 0] = _mm512_unpacklo_epi64(t0, t2);
+		x[(4 * i) + 1] = _mm512_unpackhi_epi64(t0, t2);
+		x[(4 * i) + 2] = _mm512_unpacklo_epi64(t1, t3);
+		x[(4 * i) + 3] = _mm512_unpackhi_epi64(t1, t3);
+	}
+
+	MD5_MULTI_ROUNDS(MD5_AVX512_, a, b, c, d, x);
+
+	_mm512_storeu_si512((void*)state, _mm512_add_epi32(a, a0));
+	_mm512_storeu_si512((void*)(state + 16), _mm512_add_epi32(b, b0));
+	_mm512_storeu_si512((void*)(state + 32), _mm512_add_epi32(c, c0));
+	_mm512_storeu_si512((void*)(state + 48), _mm512_add_epi32(d, d0));
+}
+
+#endif
+
+typedef void (*md5_transform_multi_fn)(uint32_t* state, const unsigned char** block);
+
+static md5_transform_multi_fn md5_transform_multi;
+static size_t md5_transform_lanes;
+
+void
+internal_md5_resolve(void) {
+	md5_transform_multi_fn transform = 0;
+	size_t lanes = 1;
+#if MD5_MULTI_X86
+	if (system_cpu_has_feature(CPU_FEATURE_AVX512F)) {
+		transform = md5_transform_avx512;
+		lanes = 16;
+	} else if (system_cpu_has_feature(CPU_FEATURE_AVX2)) {
+		transform = md5_transform_avx2;
+		lanes = 8;
+	} else if (system_cpu_has_feature(CPU_FEATURE_SSE2)) {
+		// SSE2 is baseline on 64-bit, 32-bit targets check the feature bit
+		transform = md5_transform_sse;
+		lanes = 4;
+	}
+#endif
+	md5_transform_lanes = lanes;
+	md5_transform_multi = transform;
+}
+
+struct md5_multi_lane_t {
+	//! Message data
+	const unsigned char* data;
+	//! Index of message, or count if lane is idle
+	size_t message;
+	//! Next block to digest
+	size_t block;
+	//! Number of blocks read directly from message data
+	size_t direct;
+	//! Total number of blocks including padding
+	size_t blocks;
+	//! Last partial block and padding
+	unsigned char tail[128];
+};
+
+typedef struct md5_multi_lane_t md5_multi_lane_t;
+
+static void
+md5_multi_lane_assign(md5_multi_lane_t* lane, uint32_t* state, size_t lanes, size_t message, const void* buffer,
+                      size_t size) {
+	size_t remain = size & 63;
+	uint64_t bits = (uint64_t)size << 3;
+	size_t ibyte;
+
+	lane->data = buffer;
+	lane->message = message;
+	lane->block = 0;
+	lane->direct = size / 64;
+	lane->blocks = lane->direct + ((remain < 56) ? 1 : 2);
+
+	memcpy(lane->tail, pointer_offset_const(buffer, size - remain), remain);
+	lane->tail[remain] = 0x80;
+	memset(lane->tail + remain + 1, 0, sizeof(lane->tail) - (remain + 1));
+	for (ibyte = 0; ibyte < 8; ++ibyte)
+		lane->tail[((lane->blocks - lane->direct) * 64) - 8 + ibyte] = (unsigned char)(bits >> (ibyte * 8));
+
+	state[0] = 0x67452301U;
+	state[lanes] = 0xefcdab89U;
+	state[2 * lanes] = 0x98badcfeU;
+	state[3 * lanes] = 0x10325476U;
+}
+
+static uint128_t
+md5_digest_raw(const unsigned char* digest) {
+#if FOUNDATION_ARCH_ENDIAN_BIG
+	uint128_t val;
+	memcpy(&val, digest, sizeof(uint128_t));
+#else
+	uint64_t raw[2];
+	memcpy(raw, digest, sizeof(uint64_t) * 2);
+	uint128_t val = {{byteorder_bigendian64(raw[0]), byteorder_bigendian64(raw[1])}};
+#endif
+	return val;
+}
+
+static void
+md5_digest_multi_lanes(const void* const* buffers, const size_t* sizes, size_t count, uint128_t* digests) {
+	static const unsigned char idle_block[64] = {0};
+	const size_t lanes = md5_transform_lanes;
+	md5_multi_lane_t lane[MD5_MULTI_MAX_LANES];
+	uint32_t state[4 * MD5_MULTI_MAX_LANES];
+	const unsigned char* block[MD5_MULTI_MAX_LANES];
+	size_t next = 0;
+	size_t active = 0;
+	size_t ilane;
+
+	for (ilane = 0; ilane < lanes; ++ilane) {
+		lane[ilane].message = count;
+		if (next < count) {
+			md5_multi_lane_assign(lane + ilane, state + ilane, lanes, next, buffers[next], sizes[next]);
+			++next;
+			++active;
+		}
+	}
+
+	while (active) {
+		for (ilane = 0; ilane < lanes; ++ilane) {
+			const md5_multi_lane_t* current = lane + ilane;
+			if (current->message == count)
+				block[ilane] = idle_block;
+			else if (current->block < current->direct)
+				block[ilane] = current->data + (current->block * 64);
+			else
+				block[ilane] = current->tail + ((current->block - current->direct) * 64);
+		}
+
+		md5_transform_multi(state, block);
+
+		for (ilane = 0; ilane < lanes; ++ilane) {
+			md5_multi_lane_t* current = lane + ilane;
+			if ((current->message == count) || (++current->block < current->blocks))
+				continue;
+
+			uint32_t words[4] = {state[ilane], state[lanes + ilane], state[(2 * lanes) + ilane],
+			                     state[(3 * lanes) + ilane]};
+			unsigned char digest[16];
+			md5_encode(digest, words, 16);
+			digests[current->message] = md5_digest_raw(digest);
+
+			if (next < count) {
+				md5_multi_lane_assign(current, state + ilane, lanes, next, buffers[next], sizes[next]);
+				++next;
+			} else {
+				current->message = count;
+				--active;
+			}
+		}
+	}
+}
+
 md5_t*
 md5_allocate(void) {
 	md5_t* digest = memory_allocate(0, sizeof(md5_t), 0, MEMORY_PERSISTENT);
@@ -225,17 +593,8 @@ md5_digest_finalize(md5_t* digest) {
 
 uint128_t
 md5_get_digest_raw(const md5_t* digest) {
-	if (digest) {
-#if FOUNDATION_ARCH_ENDIAN_BIG
-		uint128_t val;
-		memcpy(&val, digest->digest, sizeof(uint128_t));
-#else
-		uint64_t raw[2];
-		memcpy(raw, digest->digest, sizeof(uint64_t) * 2);
-		uint128_t val = {{byteorder_bigendian64(raw[0]), byteorder_bigendian64(raw[1])}};
-#endif
-		return val;
-	}
+	if (digest)
+		return md5_digest_raw(digest->digest);
 	return uint128_null();
 }
 
@@ -244,3 +603,23 @@ md5_get_digest(const md5_t* digest, char* buffer, size_t capacity) {
 	uint128_t raw = md5_get_digest_raw(digest);
 	return string_from_uint128(buffer, capacity, raw);
 }
+
+void
+md5_digest_multi(const void* const* buffers, const size_t* sizes, size_t count, uint128_t* digests) {
+	if (!md5_transform_lanes)
+		internal_md5_resolve();
+
+	if (md5_transform_multi && (count > 1)) {
+		md5_digest_multi_lanes(buffers, sizes, count, digests);
+		return;
+	}
+
+	for (size_t imsg = 0; imsg < count; ++imsg) {
+		md5_t md5;
+		md5_initialize(&md5);
+		md5_digest(&md5, buffers[imsg], sizes[imsg]);
+		md5_digest_finalize(&md5);
+		digests[imsg] = md5_get_digest_raw(&md5);
+		md5_finalize(&md5);
+	}
+}
@@ -39,9 +39,85 @@ static const bool radixsort_data_signed[] = {
     true    // RADIXSORT_FLOAT64
 };
 
+//! Inputs with at most this many elements are sorted with an insertion sort of the index array
+#define RADIXSORT_INSERTION_THRESHOLD 32
+
+//! Digit size in bits for typed sorts of large inputs, 3 passes for 32-bit keys
+#define RADIXSORT_WIDE_DIGIT_BITS 11
+#define RADIXSORT_WIDE_DIGIT_BUCKETS (1 << RADIXSORT_WIDE_DIGIT_BITS)
+
+//! Minimum number of elements for using wide digits, below this the histogram overhead dominates
+#define RADIXSORT_WIDE_DIGIT_THRESHOLD 0x10000
+
+//! String ranges with at most this many elements are sorted with an insertion sort
+#define RADIXSORT_STRING_INSERTION_THRESHOLD 16
+
+//! String ranges with at least this many elements are distributed by byte before partitioning
+#define RADIXSORT_STRING_MSD_THRESHOLD 0x1000
+
 /*lint -e647 -e679 Not truncations since data sizes are 4 or 8 */
 /*lint -e744 We cover all cases */
 
+static radixsort_indextype_t
+radixsort_index_type(size_t count) {
+#if FOUNDATION_SIZE_POINTER == 8
+	if (count > 0xFFFFFFFFULL)
+		return RADIXSORT_INDEX64;
+#endif
+	if (count > 0xFFFF)
+		return RADIXSORT_INDEX32;
+	return RADIXSORT_INDEX16;
+}
+
+static FOUNDATION_FORCEINLINE size_t
+radixsort_wide_pass_count(size_t data_size) {
+	return ((data_size * 8) + (RADIXSORT_WIDE_DIGIT_BITS - 1)) / RADIXSORT_WIDE_DIGIT_BITS;
+}
+
+static size_t
+radixsort_wide_histogram_count(size_t data_size) {
+	// Buffers are shared with the byte digit passes used for smaller inputs
+	const size_t wide_count = RADIXSORT_WIDE_DIGIT_BUCKETS * radixsort_wide_pass_count(data_size);
+	return (wide_count > (256 * data_size)) ? wide_count : (256 * data_size);
+}
+
+#define RADIXSORT_IS_SORTED_INDEX64(type)                            \
+	do {                                                             \
+		const type* input = (const type*)input_raw;                  \
+		type prev_val = *input;                                      \
+		for (size_t ival = 0; ival < count; ++ival) {                \
+			uint64_t curindex = indices[ival];                       \
+			if ((curindex >= count) || (input[curindex] < prev_val)) \
+				return false;                                        \
+			prev_val = input[curindex];                              \
+		}                                                            \
+		return true;                                                 \
+	} while (0)
+
+static bool
+radixsort_is_sorted_index64(radixsort_data_t data_type, const void* input_raw, const uint64_t* indices, size_t count) {
+	switch (data_type) {
+		case RADIXSORT_INT32:
+			RADIXSORT_IS_SORTED_INDEX64(int32_t);
+		case RADIXSORT_UINT32:
+			RADIXSORT_IS_SORTED_INDEX64(uint32_t);
+		case RADIXSORT_INT64:
+			RADIXSORT_IS_SORTED_INDEX64(int64_t);
+		case RADIXSORT_UINT64:
+			RADIXSORT_IS_SORTED_INDEX64(uint64_t);
+		case RADIXSORT_FLOAT32:
+			RADIXSORT_IS_SORTED_INDEX64(float32_t);
+		case RADIXSORT_FLOAT64:
+			RADIXSORT_IS_SORTED_INDEX64(float64_t);
+		case RADIXSORT_CUSTOM:
+		default:
+			break;
+	}
+	return false;
+}
+
+#undef RADIXSORT_IS_SORTED_INDEX64
+
 static bool
 radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t count) {
 	const radixsort_data_t data_type = sort->type;
@@ -53,6 +129,8 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 
 	void* indices_raw = sort->indices[0];
 
+	profile_begin_block(STRING_CONST("radixsort histogram"));
+
 	/*lint -e771 */
 	// Histograms for all passes
 	void* histogram_base[8];
@@ -65,7 +143,7 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 
 	// Read values in previous sorted order and check if already sorted
 	// Don't allow temporal coherence if increasing in size as it might introduce duplicate indices
-	if ((count <= sort->lastused) && (data_type != RADIXSORT_CUSTOM)) {
+	if ((count <= sort->lastused) && (data_type != RADIXSORT_CUSTOM) && (indexsize != RADIXSORT_INDEX64)) {
 		switch (data_type) {
 			case RADIXSORT_INT32: {
 				const int32_t* input = (const int32_t*)input_raw;
@@ -443,10 +521,19 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 			default:
 				break;
 		}
+	} else if ((count <= sort->lastused) && (data_type != RADIXSORT_CUSTOM)) {
+		// Only very large inputs use 64-bit indices, check the previous order separately
+		// and let the histogram loop below process the entire input if not sorted
+		if (radixsort_is_sorted_index64(data_type, input_raw, indices_raw, count)) {
+			profile_end_block();
+			return true;
+		}
 	}
 
-	if (loop == loop_end)
+	if (loop == loop_end) {
+		profile_end_block();
 		return true;
+	}
 
 	if (count != sort->lastused) {
 		if (indexsize == RADIXSORT_INDEX16) {
@@ -455,12 +542,18 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 				indexarr[0][ih] = (uint16_t)ih;
 				indexarr[1][ih] = (uint16_t)ih;
 			}
-		} else {
+		} else if (indexsize == RADIXSORT_INDEX32) {
 			uint32_t* indexarr[2] = {sort->indices[0], sort->indices[1]};
 			for (size_t ih = 0; ih < count; ++ih) {
 				indexarr[0][ih] = (uint32_t)ih;
 				indexarr[1][ih] = (uint32_t)ih;
 			}
+		} else {
+			uint64_t* indexarr[2] = {sort->indices[0], sort->indices[1]};
+			for (size_t ih = 0; ih < count; ++ih) {
+				indexarr[0][ih] = (uint64_t)ih;
+				indexarr[1][ih] = (uint64_t)ih;
+			}
 		}
 	}
 
@@ -482,7 +575,7 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 					++(histogram[0][*loop++]);
 #endif
 				}
-			} else {
+			} else if (indexsize == RADIXSORT_INDEX32) {
 				uint32_t* histogram[4] = {histogram_raw[0], histogram_raw[1], histogram_raw[2], histogram_raw[3]};
 				while (loop != loop_end) {
 #if FOUNDATION_ARCH_ENDIAN_LITTLE
@@ -495,6 +588,21 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 					++(histogram[2][*loop++]);
 					++(histogram[1][*loop++]);
 					++(histogram[0][*loop++]);
+#endif
+				}
+			} else {
+				uint64_t* histogram[4] = {histogram_raw[0], histogram_raw[1], histogram_raw[2], histogram_raw[3]};
+				while (loop != loop_end) {
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+					++(histogram[0][*loop++]);
+					++(histogram[1][*loop++]);
+					++(histogram[2][*loop++]);
+					++(histogram[3][*loop++]);
+#else
+					++(histogram[3][*loop++]);
+					++(histogram[2][*loop++]);
+					++(histogram[1][*loop++]);
+					++(histogram[0][*loop++]);
 #endif
 				}
 			}
@@ -526,7 +634,7 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 					++(histogram[0][*loop++]);
 #endif
 				}
-			} else {
+			} else if (indexsize == RADIXSORT_INDEX32) {
 				uint32_t* histogram[8] = {histogram_raw[0], histogram_raw[1], histogram_raw[2], histogram_raw[3],
 				                          histogram_raw[4], histogram_raw[5], histogram_raw[6], histogram_raw[7]};
 				while (loop != loop_end) {
@@ -548,6 +656,30 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 					++(histogram[2][*loop++]);
 					++(histogram[1][*loop++]);
 					++(histogram[0][*loop++]);
+#endif
+				}
+			} else {
+				uint64_t* histogram[8] = {histogram_raw[0], histogram_raw[1], histogram_raw[2], histogram_raw[3],
+				                          histogram_raw[4], histogram_raw[5], histogram_raw[6], histogram_raw[7]};
+				while (loop != loop_end) {
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+					++(histogram[0][*loop++]);
+					++(histogram[1][*loop++]);
+					++(histogram[2][*loop++]);
+					++(histogram[3][*loop++]);
+					++(histogram[4][*loop++]);
+					++(histogram[5][*loop++]);
+					++(histogram[6][*loop++]);
+					++(histogram[7][*loop++]);
+#else
+					++(histogram[7][*loop++]);
+					++(histogram[6][*loop++]);
+					++(histogram[5][*loop++]);
+					++(histogram[4][*loop++]);
+					++(histogram[3][*loop++]);
+					++(histogram[2][*loop++]);
+					++(histogram[1][*loop++]);
+					++(histogram[0][*loop++]);
 #endif
 				}
 			}
@@ -566,13 +698,24 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 						++(histogram[*loop++]);
 					}
 				}
-			} else {
+			} else if (indexsize == RADIXSORT_INDEX32) {
 				while (loop != loop_end) {
 					for (uint ibyte = 0; ibyte < data_size; ++ibyte) {
 #if FOUNDATION_ARCH_ENDIAN_LITTLE
 						uint32_t* histogram = (uint32_t*)histogram_raw[ibyte];
 #else
 						uint32_t* histogram = (uint32_t*)histogram_raw[data_size - (ibyte + 1)];
+#endif
+						++(histogram[*loop++]);
+					}
+				}
+			} else {
+				while (loop != loop_end) {
+					for (uint ibyte = 0; ibyte < data_size; ++ibyte) {
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+						uint64_t* histogram = (uint64_t*)histogram_raw[ibyte];
+#else
+						uint64_t* histogram = (uint64_t*)histogram_raw[data_size - (ibyte + 1)];
 #endif
 						++(histogram[*loop++]);
 					}
@@ -585,6 +728,8 @@ radixsort_create_histograms(radixsort_t* sort, const void* input_raw, size_t cou
 	if (histogram_raw != histogram_base)
 		memory_deallocate(histogram_raw);
 
+	profile_end_block();
+
 	return false;
 }
 
@@ -626,6 +771,8 @@ radixsort_int_index16(radixsort_t* sort, const void* input, size_t count) {
 		const unsigned char* input_bytes = pointer_offset_const(input, byteofs);
 
 		if (current_count[*input_bytes] != count) {
+			profile_begin_block(STRING_CONST("radixsort pass"));
+
 			if ((ipass != (data_size - 1)) || !data_signed) {
 				// Unsigned data or only positive values
 				uint16_t next = 0, prev = 0;
@@ -687,6 +834,8 @@ radixsort_int_index16(radixsort_t* sort, const void* input, size_t count) {
 				sort->indices[0] = sort->indices[1];
 				sort->indices[1] = swap;
 			}
+
+			profile_end_block();
 		}
 	}
 
@@ -731,6 +880,8 @@ radixsort_int_index32(radixsort_t* sort, const void* input, size_t count) {
 		const unsigned char* input_bytes = pointer_offset_const(input, byteofs);
 
 		if (current_count[*input_bytes] != count) {
+			profile_begin_block(STRING_CONST("radixsort pass"));
+
 			if ((ipass != (data_size - 1)) || !data_signed) {
 				// Unsigned data or only positive values
 				uint32_t next = 0, prev = 0;
@@ -792,6 +943,8 @@ radixsort_int_index32(radixsort_t* sort, const void* input, size_t count) {
 				sort->indices[0] = sort->indices[1];
 				sort->indices[1] = swap;
 			}
+
+			profile_end_block();
 		}
 	}
 
@@ -828,6 +981,8 @@ radixsort_float_index16(radixsort_t* sort, const void* input, size_t count) {
 		uint16_t* current_count = pointer_offset(sort->histogram, indexsize * (ipass << 8));
 		if (ipass != (data_size - 1)) {
 			if (current_count[*input_bytes] != count) {
+				profile_begin_block(STRING_CONST("radixsort pass"));
+
 				// Only positive values
 				uint16_t next = 0, prev = 0;
 				uint16_t* offset = sort->offset;
@@ -857,8 +1012,12 @@ radixsort_float_index16(radixsort_t* sort, const void* input, size_t count) {
 					sort->indices[0] = sort->indices[1];
 					sort->indices[1] = swap;
 				}
+
+				profile_end_block();
 			}
 		} else {
+			profile_begin_block(STRING_CONST("radixsort pass"));
+
 			unsigned char unique_val = *input_bytes;
 
 			if (current_count[unique_val] != count) {
@@ -943,6 +1102,8 @@ radixsort_float_index16(radixsort_t* sort, const void* input, size_t count) {
 					sort->indices[1] = swap;
 				}
 			}
+
+			profile_end_block();
 		}
 	}
 
@@ -979,6 +1140,8 @@ radixsort_float_index32(radixsort_t* sort, const void* input, size_t count) {
 		uint32_t* current_count = pointer_offset(sort->histogram, indexsize * (ipass << 8));
 		if (ipass != (data_size - 1)) {
 			if (current_count[*input_bytes] != count) {
+				profile_begin_block(STRING_CONST("radixsort pass"));
+
 				// Only positive values
 				uint32_t next = 0, prev = 0;
 				uint32_t* offset = sort->offset;
@@ -1008,8 +1171,12 @@ radixsort_float_index32(radixsort_t* sort, const void* input, size_t count) {
 					sort->indices[0] = sort->indices[1];
 					sort->indices[1] = swap;
 				}
+
+				profile_end_block();
 			}
 		} else {
+			profile_begin_block(STRING_CONST("radixsort pass"));
+
 			unsigned char unique_val = *input_bytes;
 
 			if (current_count[unique_val] != count) {
@@ -1094,143 +1261,1384 @@ radixsort_float_index32(radixsort_t* sort, const void* input, size_t count) {
 					sort->indices[1] = swap;
 				}
 			}
+
+			profile_end_block();
 		}
 	}
 
 	return sort->indices[0];
 }
 
-const void*
-radixsort_sort(radixsort_t* sort, const void* input, size_t count) {
+static const void*
+radixsort_int_index64(radixsort_t* sort, const void* input, size_t count) {
 	const radixsort_data_t data_type = sort->type;
 
-	FOUNDATION_ASSERT(count <= sort->size);
-	if (count > sort->size)
-		count = sort->size;
+	const unsigned int data_size =
+	    (data_type != RADIXSORT_CUSTOM) ? radixsort_data_size[data_type] : (uint)sort->custom_data_size;
+	const bool data_signed = (data_type != RADIXSORT_CUSTOM) ? radixsort_data_signed[data_type] : false;
+	const unsigned int data_shift = radixsort_data_shift[data_type];
+	const size_t indexsize = (size_t)sort->indextype;
+	uint64_t negatives = 0;
+	unsigned int ipass, ival;
 
-	const void* result = nullptr;
-	if ((data_type == RADIXSORT_FLOAT32) || (data_type == RADIXSORT_FLOAT64)) {
-		if (sort->indextype == RADIXSORT_INDEX16)
-			result = radixsort_float_index16(sort, input, count);
-		else
-			result = radixsort_float_index32(sort, input, count);
-	} else {
-		if (sort->indextype == RADIXSORT_INDEX16)
-			result = radixsort_int_index16(sort, input, count);
-		else
-			result = radixsort_int_index32(sort, input, count);
+	if (!count || radixsort_create_histograms(sort, input, count)) {
+		// Already sorted
+		return sort->indices[0];
 	}
 
-	sort->lastused = count;
-
-	return result;
-}
-
-radixsort_t*
-radixsort_allocate_custom(size_t data_size, size_t count) {
-	radixsort_t* sort;
-	radixsort_indextype_t indextype = RADIXSORT_INDEX16;
-	if (count > 0xFFFF)
-		indextype = RADIXSORT_INDEX32;
-
-	size_t indexsize = (size_t)indextype;
-	sort = memory_allocate(0,
-	                       sizeof(radixsort_t) +
-	                           /* 2 index tables */ (2 * indexsize * count) +
-	                           /* histograms */ (256 * data_size * indexsize) +
-	                           /* offset table */ (256 * indexsize),
-	                       0, MEMORY_PERSISTENT);
-	sort->custom_data_size = data_size;
-	sort->indices[0] = pointer_offset(sort, sizeof(radixsort_t));
-	sort->indices[1] = pointer_offset(sort->indices[0], indexsize * count);
-	sort->histogram = pointer_offset(sort->indices[1], indexsize * count);
-	sort->offset = pointer_offset(sort->histogram, indexsize * 256 * data_size);
+	if (data_signed) {
+		// Number of negatives is the last 128 values in the MSB histogram
+		//(last, since we deal with sytstem byte ordering in
+		// radixsort_create_histograms)
+		uint64_t* histogram = pointer_offset(sort->histogram, indexsize * ((data_size - 1) << 8));
+		for (ival = 128; ival < 256; ++ival)
+			negatives += histogram[ival];
+	}
 
-	radixsort_initialize_custom(sort, data_size, count);
+	// Radix sort, j is the pass number (LSB is first histogram since
+	// radixsort_create_histograms takes system byte order into account)
+	for (ipass = 0; ipass < data_size; ++ipass) {
+		uint64_t* current_count = pointer_offset(sort->histogram, indexsize * (ipass << 8));
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+		unsigned int byteofs = ipass;
+#else
+		unsigned int byteofs = (data_size - (ipass + 1));
+#endif
+		const unsigned char* input_bytes = pointer_offset_const(input, byteofs);
 
-	return sort;
-}
+		if (current_count[*input_bytes] != count) {
+			profile_begin_block(STRING_CONST("radixsort pass"));
 
-radixsort_t*
-radixsort_allocate(radixsort_data_t type, size_t count) {
-	radixsort_t* sort;
-	radixsort_indextype_t indextype = RADIXSORT_INDEX16;
-	if (count > 0xFFFF)
-		indextype = RADIXSORT_INDEX32;
+			if ((ipass != (data_size - 1)) || !data_signed) {
+				// Unsigned data or only positive values
+				uint64_t next = 0, prev = 0;
+				uint64_t* offset = sort->offset;
+				*offset++ = 0;
+				for (ival = 1; ival < 256; ++ival, ++offset, ++current_count) {
+					next = prev + *current_count;
+					prev = next;
+					*offset = next;
+				}
+			} else {
+				// Signed data, both positive and negative values
+				uint64_t next = 0, prev;
+				uint64_t* offset = sort->offset;
 
-	size_t indexsize = (size_t)indextype;
-	sort = memory_allocate(0,
-	                       sizeof(radixsort_t) +
-	                           /* 2 index tables */ (2 * indexsize * count) +
-	                           /* histograms */ (256 * radixsort_data_size[type] * indexsize) +
-	                           /* offset table */ (256 * indexsize),
-	                       0, MEMORY_PERSISTENT);
-	sort->indices[0] = pointer_offset(sort, sizeof(radixsort_t));
-	sort->indices[1] = pointer_offset(sort->indices[0], indexsize * count);
-	sort->histogram = pointer_offset(sort->indices[1], indexsize * count);
-	sort->offset = pointer_offset(sort->histogram, indexsize * 256 * radixsort_data_size[type]);
+				// First positive data comes after the negative data
+				*offset++ = negatives;
+				prev = negatives;
+				for (ival = 1; ival < 128; ++ival, ++offset, ++current_count) {
+					next = prev + *current_count;
+					prev = next;
+					*offset = next;
+				}
 
-	radixsort_initialize(sort, type, count);
+				// Fix position for negative values
+				++current_count;
+				*offset++ = 0;
+				prev = 0;
+				for (ival = 129; ival < 256; ++ival, ++offset, ++current_count) {
+					next = prev + *current_count;
+					prev = next;
+					*offset = next;
+				}
+			}
 
-	return sort;
-}
+			{
+				uint64_t* indices = sort->indices[0];
+				uint64_t* indices_next = sort->indices[1];
+				uint64_t* indices_end = indices + count;
+				uint64_t* offset = sort->offset;
 
-void
-radixsort_initialize_custom(radixsort_t* sort, size_t data_size, size_t count) {
-	sort->type = RADIXSORT_CUSTOM;
-	sort->size = count;
-	sort->lastused = count;
-	sort->custom_data_size = data_size;
+				if (data_type != RADIXSORT_CUSTOM) {
+					do {
+						uint64_t id = *indices++;
+						indices_next[offset[input_bytes[id << data_shift]]++] = id;
+					} while (indices != indices_end);
+				} else {
+					do {
+						uint64_t id = *indices++;
+						indices_next[offset[input_bytes[id * data_size]]++] = id;
+					} while (indices != indices_end);
+				}
+			}
 
-	FOUNDATION_ASSERT(count <= 0xFFFFFFFF);
-	if (count >= 0xFFFFFFFF)
-		count = 0xFFFFFFFE;
+			// After this swap, the valid indices (most recent) are in
+			// sort->indices[0]
+			{
+				uint64_t* swap = sort->indices[0];
+				sort->indices[0] = sort->indices[1];
+				sort->indices[1] = swap;
+			}
 
-	if (count > 0xFFFF) {
-		uint32_t* indices[2] = {sort->indices[0], sort->indices[1]};
-		sort->indextype = RADIXSORT_INDEX32;
-		for (uint32_t i = 0; i < count; ++i) {
-			indices[0][i] = i;
-			indices[1][i] = i;
-		}
-	} else {
-		uint16_t* indices[2] = {sort->indices[0], sort->indices[1]};
-		sort->indextype = RADIXSORT_INDEX16;
-		for (uint32_t i = 0; i < count; ++i) {
-			indices[0][i] = (uint16_t)i;
-			indices[1][i] = (uint16_t)i;
+			profile_end_block();
 		}
 	}
+
+	return sort->indices[0];
 }
 
-void
-radixsort_initialize(radixsort_t* sort, radixsort_data_t type, size_t count) {
-	sort->type = type;
-	sort->size = count;
-	sort->lastused = count;
-	sort->custom_data_size = radixsort_data_size[type];
+static const void*
+radixsort_float_index64(radixsort_t* sort, const void* input, size_t count) {
+	const radixsort_data_t data_type = sort->type;
+	const unsigned int data_size = radixsort_data_size[data_type];
+	const unsigned int data_shift = radixsort_data_shift[data_type];
+	const size_t indexsize = (size_t)sort->indextype;
 
-	FOUNDATION_ASSERT(count <= 0xFFFFFFFF);
-	if (count >= 0xFFFFFFFF)
-		count = 0xFFFFFFFE;
+	if (!count || radixsort_create_histograms(sort, input, count))
+		return sort->indices[0];  // Already sorted
 
-	if (count > 0xFFFF) {
-		uint32_t* indices[2] = {sort->indices[0], sort->indices[1]};
-		sort->indextype = RADIXSORT_INDEX32;
-		for (uint32_t i = 0; i < count; ++i) {
-			indices[0][i] = i;
-			indices[1][i] = i;
-		}
-	} else {
-		uint16_t* indices[2] = {sort->indices[0], sort->indices[1]};
-		sort->indextype = RADIXSORT_INDEX16;
-		for (uint32_t i = 0; i < count; ++i) {
+	uint64_t negatives = 0;
+
+	// Number of negatives is the last 128 values in the MSB histogram
+	//(last, since we deal with system byte ordering in radixsort_create_histograms)
+	uint64_t* histogram = pointer_offset(sort->histogram, indexsize * ((data_size - 1) << 8));
+	for (unsigned int ihist = 128; ihist < 256; ++ihist)
+		negatives += histogram[ihist];
+
+	// Radix sort, j is the pass number (0 = LSB, 3/7 = MSB)
+	for (unsigned int ipass = 0; ipass < data_size; ++ipass) {
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+		unsigned int byteofs = ipass;
+#else
+		unsigned int byteofs = (data_size - ipass - 1);
+#endif
+		const unsigned char* input_bytes = pointer_offset_const(input, byteofs);
+
+		uint64_t* current_count = pointer_offset(sort->histogram, indexsize * (ipass << 8));
+		if (ipass != (data_size - 1)) {
+			if (current_count[*input_bytes] != count) {
+				profile_begin_block(STRING_CONST("radixsort pass"));
+
+				// Only positive values
+				uint64_t next = 0, prev = 0;
+				uint64_t* offset = sort->offset;
+				*offset++ = 0;
+				for (unsigned int ival = 1; ival < 256; ++ival, ++offset, ++current_count) {
+					next = prev + *current_count;
+					prev = next;
+					*offset = next;
+				}
+
+				{
+					uint64_t* indices = sort->indices[0];
+					uint64_t* indices_next = sort->indices[1];
+					uint64_t* indices_end = indices + count;
+
+					offset = sort->offset;
+					while (indices != indices_end) {
+						uint64_t id = *indices++;
+						indices_next[offset[input_bytes[id << data_shift]]++] = id;
+					}
+				}
+
+				// After this swap, the valid indices (most recent) are in
+				// sort->indices[0]
+				{
+					uint64_t* swap = sort->indices[0];
+					sort->indices[0] = sort->indices[1];
+					sort->indices[1] = swap;
+				}
+
+				profile_end_block();
+			}
+		} else {
+			profile_begin_block(STRING_CONST("radixsort pass"));
+
+			unsigned char unique_val = *input_bytes;
+
+			if (current_count[unique_val] != count) {
+				// Both positive and negative values
+				uint64_t next = 0, prev;
+				uint64_t* offset = sort->offset;
+				uint64_t* count_base = current_count;
+
+				// First positive data comes after the negative data
+				*offset++ = negatives;
+				prev = negatives;
+				for (unsigned int ival = 1; ival < 128; ++ival, ++offset, ++current_count) {
+					next = prev + *current_count;
+					prev = next;
+					*offset = next;
+				}
+
+				// Reverse order for negative values
+				offset = (uint64_t*)sort->offset + 255;
+				current_count = count_base + 255;
+				*offset-- = 0;
+				prev = 0;
+				for (unsigned int ival = 0; ival < 127; ++ival, --offset, --current_count) {
+					next = prev + *current_count;
+					prev = next;
+					*offset = next;
+				}
+
+				// Fix position for negative values
+				offset = (uint64_t*)sort->offset + 128;
+				current_count = count_base + 128;
+				for (unsigned int ival = 128; ival < 256; ++ival, ++offset, ++current_count)
+					*offset += *current_count;
+
+				// Perform Radix Sort
+				uint64_t* indices = sort->indices[0];
+				uint64_t* indices_next = sort->indices[1];
+				offset = sort->offset;
+				if (data_type == RADIXSORT_FLOAT32) {
+					const uint32_t* input_uint = input;
+					for (size_t ival = 0; ival < count; ++ival) {
+						unsigned int radix = input_uint[indices[ival]] >> 24;
+						if (radix < 128) {
+							// Positive
+							indices_next[offset[radix]++] = indices[ival];
+						} else {
+							// Negative, reverse order
+							indices_next[--offset[radix]] = indices[ival];
+						}
+					}
+				} else {  // if( data_type == RADIXSORT_FLOAT64 )
+					const uint64_t* input_uint = input;
+					for (size_t ival = 0; ival < count; ++ival) {
+						unsigned int radix = (unsigned int)(input_uint[indices[ival]] >> 56ULL);
+						if (radix < 128) {
+							// Positive
+							indices_next[offset[radix]++] = indices[ival];
+						} else {
+							// Negative, reverse order
+							indices_next[--offset[radix]] = indices[ival];
+						}
+					}
+				}
+
+				// After this swap, the valid indices (most recent) are in
+				// sort->indices[0]
+				uint64_t* swap = sort->indices[0];
+				sort->indices[0] = sort->indices[1];
+				sort->indices[1] = swap;
+			} else {
+				// Reverse order if all values are negative
+				if (unique_val >= 128) {
+					uint64_t* indices = sort->indices[0];
+					uint64_t* indices_next = sort->indices[1];
+					for (size_t ival = 0; ival < count; ++ival)
+						indices_next[ival] = indices[count - (ival + 1)];
+
+					// After this swap, the valid indices (most recent) are in
+					// sort->indices[0]
+					uint64_t* swap = sort->indices[0];
+					sort->indices[0] = sort->indices[1];
+					sort->indices[1] = swap;
+				}
+			}
+
+			profile_end_block();
+		}
+	}
+
+	return sort->indices[0];
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+radixsort_key_radix(const void* key, const size_t key_size, uint64_t sign_mask, uint64_t float_mask) {
+	uint64_t bits;
+	if (key_size == 4) {
+		uint32_t bits32;
+		memcpy(&bits32, key, 4);
+		bits = bits32;
+	} else {
+		memcpy(&bits, key, 8);
+	}
+	// Map to an unsigned integer with the same ordering by flipping the sign bit of
+	// signed values, and all bits of negative floating point values
+	const uint64_t negative = (uint64_t)0 - (bits >> ((key_size * 8) - 1));
+	return bits ^ (sign_mask | (float_mask & negative));
+}
+
+static FOUNDATION_FORCEINLINE void
+radixsort_keyvalue_scatter(const unsigned char* src_keys, const unsigned char* src_values, unsigned char* dst_keys,
+                           unsigned char* dst_values, size_t* offset, size_t count, const size_t key_size,
+                           const size_t value_size, unsigned int shift, uint64_t digit_mask, uint64_t sign_mask,
+                           uint64_t float_mask) {
+	// Scatter keys and values together, reading both sequentially
+	for (size_t ival = 0; ival < count; ++ival, src_keys += key_size, src_values += value_size) {
+		uint64_t radix = radixsort_key_radix(src_keys, key_size, sign_mask, float_mask);
+		size_t dst = offset[(radix >> shift) & digit_mask]++;
+		memcpy(dst_keys + (dst * key_size), src_keys, key_size);
+		if (value_size)
+			memcpy(dst_values + (dst * value_size), src_values, value_size);
+	}
+}
+
+static FOUNDATION_FORCEINLINE void
+radixsort_keyvalue_typed(radixsort_t* sort, void* keys, void* values, size_t count, const size_t key_size,
+                         const unsigned int digit_bits) {
+	const radixsort_data_t data_type = sort->type;
+	const size_t value_size = sort->value_size;
+	const size_t pass_count = ((key_size * 8) + (digit_bits - 1)) / digit_bits;
+	const size_t bucket_count = (size_t)1 << digit_bits;
+	const uint64_t digit_mask = bucket_count - 1;
+	const uint64_t key_mask = (key_size == 8) ? ~0ULL : 0xFFFFFFFFULL;
+	const uint64_t sign_mask = radixsort_data_signed[data_type] ? (1ULL << ((key_size * 8) - 1)) : 0;
+	const uint64_t float_mask =
+	    ((data_type == RADIXSORT_FLOAT32) || (data_type == RADIXSORT_FLOAT64)) ? key_mask : 0;
+	size_t* histogram = sort->histogram;
+	size_t* offset = sort->offset;
+
+	// Histograms for all passes in a single read, while checking if already sorted
+	profile_begin_block(STRING_CONST("radixsort histogram"));
+	memset(histogram, 0, sizeof(size_t) * bucket_count * pass_count);
+	const unsigned char* key = keys;
+	uint64_t first_radix = radixsort_key_radix(key, key_size, sign_mask, float_mask);
+	uint64_t prev_radix = first_radix;
+	bool sorted = true;
+	for (size_t ival = 0; ival < count; ++ival, key += key_size) {
+		uint64_t radix = radixsort_key_radix(key, key_size, sign_mask, float_mask);
+		if (radix < prev_radix)
+			sorted = false;
+		prev_radix = radix;
+		for (size_t ipass = 0; ipass < pass_count; ++ipass)
+			++histogram[(ipass * bucket_count) + ((radix >> (ipass * digit_bits)) & digit_mask)];
+	}
+	profile_end_block();
+	if (sorted)
+		return;
+
+	unsigned char* src_keys = keys;
+	unsigned char* src_values = values;
+	unsigned char* dst_keys = sort->scratch[0];
+	unsigned char* dst_values = sort->scratch[1];
+	for (size_t ipass = 0; ipass < pass_count; ++ipass) {
+		const size_t* current_count = histogram + (ipass * bucket_count);
+		const unsigned int shift = (unsigned int)(ipass * digit_bits);
+
+		// Skip pass if all keys have the same digit
+		if (current_count[(first_radix >> shift) & digit_mask] == count)
+			continue;
+
+		profile_begin_block(STRING_CONST("radixsort pass"));
+
+		size_t next = 0;
+		for (size_t ival = 0; ival < bucket_count; ++ival) {
+			offset[ival] = next;
+			next += current_count[ival];
+		}
+
+		// Specialize the scatter loop for common payload sizes
+		if (value_size == 4)
+			radixsort_keyvalue_scatter(src_keys, src_values, dst_keys, dst_values, offset, count, key_size, 4, shift,
+			                           digit_mask, sign_mask, float_mask);
+		else if (value_size == 8)
+			radixsort_keyvalue_scatter(src_keys, src_values, dst_keys, dst_values, offset, count, key_size, 8, shift,
+			                           digit_mask, sign_mask, float_mask);
+		else
+			radixsort_keyvalue_scatter(src_keys, src_values, dst_keys, dst_values, offset, count, key_size, value_size,
+			                           shift, digit_mask, sign_mask, float_mask);
+
+		unsigned char* swap = src_keys;
+		src_keys = dst_keys;
+		dst_keys = swap;
+		swap = src_values;
+		src_values = dst_values;
+		dst_values = swap;
+
+		profile_end_block();
+	}
+
+	// Result must be in the caller buffers after an odd number of passes
+	if (src_keys != keys) {
+		memcpy(keys, src_keys, count * key_size);
+		if (value_size)
+			memcpy(values, src_values, count * value_size);
+	}
+}
+
+static void
+radixsort_keyvalue_custom(radixsort_t* sort, void* keys, void* values, size_t count) {
+	const size_t key_size = sort->custom_data_size;
+	const size_t value_size = sort->value_size;
+	size_t* histogram = sort->histogram;
+	size_t* offset = sort->offset;
+
+	profile_begin_block(STRING_CONST("radixsort histogram"));
+	memset(histogram, 0, sizeof(size_t) * 256 * key_size);
+	const unsigned char* key = keys;
+	for (size_t ival = 0; ival < count; ++ival) {
+		for (size_t ibyte = 0; ibyte < key_size; ++ibyte, ++key) {
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+			++histogram[(ibyte << 8) + *key];
+#else
+			++histogram[((key_size - (ibyte + 1)) << 8) + *key];
+#endif
+		}
+	}
+	profile_end_block();
+
+	unsigned char* src_keys = keys;
+	unsigned char* src_values = values;
+	unsigned char* dst_keys = sort->scratch[0];
+	unsigned char* dst_values = sort->scratch[1];
+	for (size_t ipass = 0; ipass < key_size; ++ipass) {
+		const size_t* current_count = histogram + (ipass << 8);
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+		const size_t byteofs = ipass;
+#else
+		const size_t byteofs = key_size - (ipass + 1);
+#endif
+
+		if (current_count[src_keys[byteofs]] == count)
+			continue;
+
+		profile_begin_block(STRING_CONST("radixsort pass"));
+
+		size_t next = 0;
+		for (unsigned int ival = 0; ival < 256; ++ival) {
+			offset[ival] = next;
+			next += current_count[ival];
+		}
+
+		const unsigned char* key_in = src_keys;
+		const unsigned char* value_in = src_values;
+		for (size_t ival = 0; ival < count; ++ival, key_in += key_size, value_in += value_size) {
+			size_t dst = offset[key_in[byteofs]]++;
+			memcpy(dst_keys + (dst * key_size), key_in, key_size);
+			if (value_size)
+				memcpy(dst_values + (dst * value_size), value_in, value_size);
+		}
+
+		unsigned char* swap = src_keys;
+		src_keys = dst_keys;
+		dst_keys = swap;
+		swap = src_values;
+		src_values = dst_values;
+		dst_values = swap;
+
+		profile_end_block();
+	}
+
+	if (src_keys != keys) {
+		memcpy(keys, src_keys, count * key_size);
+		if (value_size)
+			memcpy(values, src_values, count * value_size);
+	}
+}
+
+struct radixsort_string_key_t {
+	//! Next 7 bytes of the string in big endian order, with the remaining length clamped to 8 in
+	//! the lowest byte, so integer comparison matches string ordering
+	uint64_t prefix;
+	//! Index of string in input array
+	size_t index;
+};
+
+typedef struct radixsort_string_key_t radixsort_string_key_t;
+
+static FOUNDATION_FORCEINLINE uint64_t
+radixsort_string_prefix(const string_const_t* str, size_t depth) {
+	const size_t remain = (str->length > depth) ? (str->length - depth) : 0;
+	const unsigned char* data = (const unsigned char*)str->str + depth;
+	uint64_t prefix;
+	if (remain >= 8) {
+		memcpy(&prefix, data, 8);
+		return (byteorder_bigendian64(prefix) & ~0xFFULL) | 8;
+	}
+	// Remaining length below 8 means the cached prefix holds the complete string tail
+	prefix = 0;
+	for (size_t ibyte = 0; ibyte < remain; ++ibyte)
+		prefix |= (uint64_t)data[ibyte] << (56 - (ibyte * 8));
+	return prefix | remain;
+}
+
+static bool
+radixsort_string_less(const string_const_t* lhs, const string_const_t* rhs, size_t depth) {
+	const size_t lhs_remain = lhs->length - depth;
+	const size_t rhs_remain = rhs->length - depth;
+	const size_t common = (lhs_remain < rhs_remain) ? lhs_remain : rhs_remain;
+	int diff = memcmp(lhs->str + depth, rhs->str + depth, common);
+	if (diff)
+		return diff < 0;
+	return lhs_remain < rhs_remain;
+}
+
+static void
+radixsort_string_insertion(const string_const_t* input, radixsort_string_key_t* keys, size_t count, size_t depth) {
+	for (size_t ival = 1; ival < count; ++ival) {
+		radixsort_string_key_t key = keys[ival];
+		size_t ipos = ival;
+		while (ipos) {
+			const radixsort_string_key_t* prev = keys + (ipos - 1);
+			if (key.prefix > prev->prefix)
+				break;
+			// Equal prefix with remaining length below 8 means equal strings
+			if ((key.prefix == prev->prefix) &&
+			    (((key.prefix & 0xFF) < 8) ||
+			     !radixsort_string_less(input + key.index, input + prev->index, depth + 7)))
+				break;
+			keys[ipos] = *prev;
+			--ipos;
+		}
+		keys[ipos] = key;
+	}
+}
+
+static void
+radixsort_string_range(const string_const_t* input, radixsort_string_key_t* keys, radixsort_string_key_t* temp,
+                       size_t count, size_t depth, unsigned int byte) {
+	while (count > RADIXSORT_STRING_INSERTION_THRESHOLD) {
+		if ((count >= RADIXSORT_STRING_MSD_THRESHOLD) && (byte < 7)) {
+			// MSD radix pass distributing the range by one byte of the cached prefix
+			const unsigned int shift = 56 - (byte * 8);
+			size_t histogram[256];
+			memset(histogram, 0, sizeof(histogram));
+			for (size_t ival = 0; ival < count; ++ival)
+				++histogram[(keys[ival].prefix >> shift) & 0xFF];
+
+			++byte;
+			if (histogram[(keys[0].prefix >> shift) & 0xFF] == count)
+				continue;
+
+			size_t offset[256];
+			size_t next = 0;
+			for (unsigned int ibucket = 0; ibucket < 256; ++ibucket) {
+				offset[ibucket] = next;
+				next += histogram[ibucket];
+			}
+			for (size_t ival = 0; ival < count; ++ival)
+				temp[offset[(keys[ival].prefix >> shift) & 0xFF]++] = keys[ival];
+			memcpy(keys, temp, sizeof(radixsort_string_key_t) * count);
+
+			// Recurse into all but the largest bucket and continue with the largest one, so each
+			// recursion at least halves the range and the depth is bounded by log2 of the count
+			unsigned int largest = 0;
+			for (unsigned int ibucket = 1; ibucket < 256; ++ibucket) {
+				if (histogram[ibucket] > histogram[largest])
+					largest = ibucket;
+			}
+			next = 0;
+			for (unsigned int ibucket = 0; ibucket < 256; ++ibucket) {
+				if ((ibucket != largest) && (histogram[ibucket] > 1))
+					radixsort_string_range(input, keys + next, temp + next, histogram[ibucket], depth, byte);
+				next += histogram[ibucket];
+			}
+			next = offset[largest] - histogram[largest];
+			keys += next;
+			temp += next;
+			count = histogram[largest];
+			continue;
+		}
+
+		// Multikey quicksort step, three-way partition on the cached prefix with median of three pivot
+		uint64_t first = keys[0].prefix;
+		uint64_t middle = keys[count / 2].prefix;
+		uint64_t last = keys[count - 1].prefix;
+		uint64_t pivot = (first < middle) ? ((middle < last) ? middle : ((first < last) ? last : first)) :
+		                                    ((first < last) ? first : ((middle < last) ? last : middle));
+
+		size_t less = 0;
+		size_t ival = 0;
+		size_t greater = count;
+		while (ival < greater) {
+			uint64_t prefix = keys[ival].prefix;
+			if (prefix < pivot) {
+				radixsort_string_key_t swap = keys[less];
+				keys[less++] = keys[ival];
+				keys[ival++] = swap;
+			} else if (prefix > pivot) {
+				radixsort_string_key_t swap = keys[--greater];
+				keys[greater] = keys[ival];
+				keys[ival] = swap;
+			} else {
+				++ival;
+			}
+		}
+
+		// Equal range continues with the next prefix unless the strings ended within this prefix
+		size_t equal = greater - less;
+		if ((pivot & 0xFF) < 8) {
+			equal = 0;
+		} else {
+			for (ival = less; ival < greater; ++ival)
+				keys[ival].prefix = radixsort_string_prefix(input + keys[ival].index, depth + 7);
+		}
+
+		// Recurse into the two smaller partitions and continue with the largest one
+		const size_t above = count - greater;
+		if ((equal >= less) && (equal >= above)) {
+			if (less > 1)
+				radixsort_string_range(input, keys, temp, less, depth, byte);
+			if (above > 1)
+				radixsort_string_range(input, keys + greater, temp + greater, above, depth, byte);
+			keys += less;
+			temp += less;
+			count = equal;
+			depth += 7;
+			byte = 0;
+		} else {
+			if (equal > 1)
+				radixsort_string_range(input, keys + less, temp + less, equal, depth + 7, 0);
+			if (less >= above) {
+				if (above > 1)
+					radixsort_string_range(input, keys + greater, temp + greater, above, depth, byte);
+				count = less;
+			} else {
+				if (less > 1)
+					radixsort_string_range(input, keys, temp, less, depth, byte);
+				keys += greater;
+				temp += greater;
+				count = above;
+			}
+		}
+	}
+
+	radixsort_string_insertion(input, keys, count, depth);
+}
+
+static const void*
+radixsort_string(radixsort_t* sort, const string_const_t* input, size_t count) {
+	const radixsort_indextype_t indextype = sort->indextype;
+	radixsort_string_key_t* keys = sort->scratch[0];
+	size_t ival;
+
+	if (!count)
+		return sort->indices[0];
+
+	// Check if previous order is still sorted
+	if (count == sort->lastused) {
+		bool sorted = true;
+		for (ival = 1; sorted && (ival < count); ++ival) {
+			size_t prev, cur;
+			if (indextype == RADIXSORT_INDEX16) {
+				prev = ((const uint16_t*)sort->indices[0])[ival - 1];
+				cur = ((const uint16_t*)sort->indices[0])[ival];
+			} else if (indextype == RADIXSORT_INDEX32) {
+				prev = ((const uint32_t*)sort->indices[0])[ival - 1];
+				cur = ((const uint32_t*)sort->indices[0])[ival];
+			} else {
+				prev = (size_t)((const uint64_t*)sort->indices[0])[ival - 1];
+				cur = (size_t)((const uint64_t*)sort->indices[0])[ival];
+			}
+			if (radixsort_string_less(input + cur, input + prev, 0))
+				sorted = false;
+		}
+		if (sorted)
+			return sort->indices[0];
+	}
+
+	profile_begin_block(STRING_CONST("radixsort prefix"));
+	for (ival = 0; ival < count; ++ival) {
+		keys[ival].prefix = radixsort_string_prefix(input + ival, 0);
+		keys[ival].index = ival;
+	}
+	profile_end_block();
+
+	profile_begin_block(STRING_CONST("radixsort pass"));
+	radixsort_string_range(input, keys, sort->scratch[1], count, 0, 0);
+	profile_end_block();
+
+	if (indextype == RADIXSORT_INDEX16) {
+		uint16_t* indices = sort->indices[0];
+		for (ival = 0; ival < count; ++ival)
+			indices[ival] = (uint16_t)keys[ival].index;
+	} else if (indextype == RADIXSORT_INDEX32) {
+		uint32_t* indices = sort->indices[0];
+		for (ival = 0; ival < count; ++ival)
+			indices[ival] = (uint32_t)keys[ival].index;
+	} else {
+		uint64_t* indices = sort->indices[0];
+		for (ival = 0; ival < count; ++ival)
+			indices[ival] = keys[ival].index;
+	}
+
+	return sort->indices[0];
+}
+
+#define RADIXSORT_INSERTION_SORT(type)                        \
+	do {                                                      \
+		const type* values = (const type*)input;              \
+		for (size_t ival = 1; ival < count; ++ival) {         \
+			size_t id = order[ival];                          \
+			type val = values[id];                            \
+			size_t ipos = ival;                               \
+			while (ipos && (val < values[order[ipos - 1]])) { \
+				order[ipos] = order[ipos - 1];                \
+				--ipos;                                       \
+			}                                                 \
+			order[ipos] = id;                                 \
+		}                                                     \
+	} while (0)
+
+static bool
+radixsort_custom_less(const unsigned char* lhs, const unsigned char* rhs, size_t data_size) {
+	// Compare from most significant byte, in system byte order like the radix passes
+	for (size_t ibyte = 0; ibyte < data_size; ++ibyte) {
+#if FOUNDATION_ARCH_ENDIAN_LITTLE
+		size_t byteofs = data_size - (ibyte + 1);
+#else
+		size_t byteofs = ibyte;
+#endif
+		if (lhs[byteofs] != rhs[byteofs])
+			return lhs[byteofs] < rhs[byteofs];
+	}
+	return false;
+}
+
+static const void*
+radixsort_insertion_sort(radixsort_t* sort, const void* input, size_t count) {
+	const radixsort_indextype_t indextype = sort->indextype;
+	size_t order[RADIXSORT_INSERTION_THRESHOLD];
+	size_t ival;
+
+	// Start from the previous order if valid to take advantage of temporal coherence
+	if (count == sort->lastused) {
+		if (indextype == RADIXSORT_INDEX16) {
+			const uint16_t* indices = sort->indices[0];
+			for (ival = 0; ival < count; ++ival)
+				order[ival] = indices[ival];
+		} else if (indextype == RADIXSORT_INDEX32) {
+			const uint32_t* indices = sort->indices[0];
+			for (ival = 0; ival < count; ++ival)
+				order[ival] = indices[ival];
+		} else {
+			const uint64_t* indices = sort->indices[0];
+			for (ival = 0; ival < count; ++ival)
+				order[ival] = (size_t)indices[ival];
+		}
+	} else {
+		for (ival = 0; ival < count; ++ival)
+			order[ival] = ival;
+	}
+
+	switch (sort->type) {
+		case RADIXSORT_INT32:
+			RADIXSORT_INSERTION_SORT(int32_t);
+			break;
+		case RADIXSORT_UINT32:
+			RADIXSORT_INSERTION_SORT(uint32_t);
+			break;
+		case RADIXSORT_INT64:
+			RADIXSORT_INSERTION_SORT(int64_t);
+			break;
+		case RADIXSORT_UINT64:
+			RADIXSORT_INSERTION_SORT(uint64_t);
+			break;
+		case RADIXSORT_FLOAT32:
+		case RADIXSORT_FLOAT64: {
+			// Compare the order preserving radix keys rather than values, so negative zero sorts
+			// before positive zero just like in the radix passes
+			const size_t data_size = radixsort_data_size[sort->type];
+			const uint64_t sign_mask = 1ULL << ((data_size * 8) - 1);
+			const uint64_t float_mask = (data_size == 8) ? ~0ULL : 0xFFFFFFFFULL;
+			const unsigned char* values = input;
+			for (ival = 1; ival < count; ++ival) {
+				size_t id = order[ival];
+				uint64_t radix = radixsort_key_radix(values + (id * data_size), data_size, sign_mask, float_mask);
+				size_t ipos = ival;
+				while (ipos && (radix < radixsort_key_radix(values + (order[ipos - 1] * data_size), data_size,
+				                                            sign_mask, float_mask))) {
+					order[ipos] = order[ipos - 1];
+					--ipos;
+				}
+				order[ipos] = id;
+			}
+			break;
+		}
+		case RADIXSORT_CUSTOM:
+		default: {
+			const size_t data_size = sort->custom_data_size;
+			const unsigned char* values = input;
+			for (ival = 1; ival < count; ++ival) {
+				size_t id = order[ival];
+				size_t ipos = ival;
+				while (ipos && radixsort_custom_less(values + (id * data_size), values + (order[ipos - 1] * data_size),
+				                                     data_size)) {
+					order[ipos] = order[ipos - 1];
+					--ipos;
+				}
+				order[ipos] = id;
+			}
+			break;
+		}
+	}
+
+	if (indextype == RADIXSORT_INDEX16) {
+		uint16_t* indices = sort->indices[0];
+		for (ival = 0; ival < count; ++ival)
+			indices[ival] = (uint16_t)order[ival];
+	} else if (indextype == RADIXSORT_INDEX32) {
+		uint32_t* indices = sort->indices[0];
+		for (ival = 0; ival < count; ++ival)
+			indices[ival] = (uint32_t)order[ival];
+	} else {
+		uint64_t* indices = sort->indices[0];
+		for (ival = 0; ival < count; ++ival)
+			indices[ival] = order[ival];
+	}
+
+	return sort->indices[0];
+}
+
+#undef RADIXSORT_INSERTION_SORT
+
+static FOUNDATION_FORCEINLINE size_t
+radixsort_index_get(const void* indices, radixsort_indextype_t indextype, size_t pos) {
+	if (indextype == RADIXSORT_INDEX16)
+		return ((const uint16_t*)indices)[pos];
+	if (indextype == RADIXSORT_INDEX32)
+		return ((const uint32_t*)indices)[pos];
+	return (size_t)((const uint64_t*)indices)[pos];
+}
+
+static FOUNDATION_FORCEINLINE void
+radixsort_index_set(void* indices, radixsort_indextype_t indextype, size_t pos, size_t value) {
+	if (indextype == RADIXSORT_INDEX16)
+		((uint16_t*)indices)[pos] = (uint16_t)value;
+	else if (indextype == RADIXSORT_INDEX32)
+		((uint32_t*)indices)[pos] = (uint32_t)value;
+	else
+		((uint64_t*)indices)[pos] = value;
+}
+
+static FOUNDATION_FORCEINLINE const void*
+radixsort_wide_index(radixsort_t* sort, const void* input, size_t count, const radixsort_indextype_t indextype,
+                     const size_t key_size) {
+	const radixsort_data_t data_type = sort->type;
+	const size_t pass_count = radixsort_wide_pass_count(key_size);
+	const uint64_t digit_mask = RADIXSORT_WIDE_DIGIT_BUCKETS - 1;
+	const uint64_t key_mask = (key_size == 8) ? ~0ULL : 0xFFFFFFFFULL;
+	const uint64_t sign_mask = radixsort_data_signed[data_type] ? (1ULL << ((key_size * 8) - 1)) : 0;
+	const uint64_t float_mask =
+	    ((data_type == RADIXSORT_FLOAT32) || (data_type == RADIXSORT_FLOAT64)) ? key_mask : 0;
+	const unsigned char* data = input;
+	void* histogram = sort->histogram;
+	void* offset = sort->offset;
+	size_t ival = 0;
+
+	profile_begin_block(STRING_CONST("radixsort histogram"));
+	memset(histogram, 0, (size_t)indextype * RADIXSORT_WIDE_DIGIT_BUCKETS * pass_count);
+
+	// Read values in previous sorted order and check if already sorted, while building histograms
+	// for all passes from values in input order. Don't allow temporal coherence if increasing in
+	// size as it might introduce duplicate indices
+	if (count <= sort->lastused) {
+		const void* indices = sort->indices[0];
+		uint64_t prev_radix = 0;
+		for (; ival < count; ++ival) {
+			size_t curindex = radixsort_index_get(indices, indextype, ival);
+			if (curindex >= count)
+				break;
+			uint64_t radix = radixsort_key_radix(data + (curindex * key_size), key_size, sign_mask, float_mask);
+			if (radix < prev_radix)
+				break;
+			prev_radix = radix;
+
+			radix = radixsort_key_radix(data + (ival * key_size), key_size, sign_mask, float_mask);
+			for (size_t ipass = 0; ipass < pass_count; ++ipass) {
+				size_t bucket = (ipass * RADIXSORT_WIDE_DIGIT_BUCKETS) +
+				                (size_t)((radix >> (ipass * RADIXSORT_WIDE_DIGIT_BITS)) & digit_mask);
+				radixsort_index_set(histogram, indextype, bucket,
+				                    radixsort_index_get(histogram, indextype, bucket) + 1);
+			}
+		}
+		if (ival == count) {
+			profile_end_block();
+			return sort->indices[0];
+		}
+	}
+
+	if (count != sort->lastused) {
+		for (size_t ih = 0; ih < count; ++ih) {
+			radixsort_index_set(sort->indices[0], indextype, ih, ih);
+			radixsort_index_set(sort->indices[1], indextype, ih, ih);
+		}
+	}
+
+	// Finish calculating the histograms, now without checks
+	for (; ival < count; ++ival) {
+		uint64_t radix = radixsort_key_radix(data + (ival * key_size), key_size, sign_mask, float_mask);
+		for (size_t ipass = 0; ipass < pass_count; ++ipass) {
+			size_t bucket = (ipass * RADIXSORT_WIDE_DIGIT_BUCKETS) +
+			                (size_t)((radix >> (ipass * RADIXSORT_WIDE_DIGIT_BITS)) & digit_mask);
+			radixsort_index_set(histogram, indextype, bucket, radixsort_index_get(histogram, indextype, bucket) + 1);
+		}
+	}
+	profile_end_block();
+
+	const uint64_t first_radix = radixsort_key_radix(data, key_size, sign_mask, float_mask);
+	for (size_t ipass = 0; ipass < pass_count; ++ipass) {
+		const void* current_count =
+		    pointer_offset_const(histogram, (size_t)indextype * ipass * RADIXSORT_WIDE_DIGIT_BUCKETS);
+		const unsigned int shift = (unsigned int)(ipass * RADIXSORT_WIDE_DIGIT_BITS);
+
+		// Skip pass if all keys have the same digit
+		if (radixsort_index_get(current_count, indextype, (size_t)((first_radix >> shift) & digit_mask)) == count)
+			continue;
+
+		profile_begin_block(STRING_CONST("radixsort pass"));
+
+		size_t next = 0;
+		for (size_t ibucket = 0; ibucket < RADIXSORT_WIDE_DIGIT_BUCKETS; ++ibucket) {
+			radixsort_index_set(offset, indextype, ibucket, next);
+			next += radixsort_index_get(current_count, indextype, ibucket);
+		}
+
+		// Unrolled to issue the key reads for several indices before the dependent scatter
+		const void* indices = sort->indices[0];
+		void* indices_next = sort->indices[1];
+		size_t iidx = 0;
+		for (; (iidx + 4) <= count; iidx += 4) {
+			size_t id[4];
+			size_t digit[4];
+			for (size_t iun = 0; iun < 4; ++iun)
+				id[iun] = radixsort_index_get(indices, indextype, iidx + iun);
+			for (size_t iun = 0; iun < 4; ++iun)
+				digit[iun] = (size_t)((radixsort_key_radix(data + (id[iun] * key_size), key_size, sign_mask,
+				                                           float_mask) >> shift) & digit_mask);
+			for (size_t iun = 0; iun < 4; ++iun) {
+				size_t dst = radixsort_index_get(offset, indextype, digit[iun]);
+				radixsort_index_set(offset, indextype, digit[iun], dst + 1);
+				radixsort_index_set(indices_next, indextype, dst, id[iun]);
+			}
+		}
+		for (; iidx < count; ++iidx) {
+			size_t id = radixsort_index_get(indices, indextype, iidx);
+			size_t digit =
+			    (size_t)((radixsort_key_radix(data + (id * key_size), key_size, sign_mask, float_mask) >> shift) &
+			             digit_mask);
+			size_t dst = radixsort_index_get(offset, indextype, digit);
+			radixsort_index_set(offset, indextype, digit, dst + 1);
+			radixsort_index_set(indices_next, indextype, dst, id);
+		}
+
+		// After this swap, the valid indices (most recent) are in sort->indices[0]
+		void* swap = sort->indices[0];
+		sort->indices[0] = sort->indices[1];
+		sort->indices[1] = swap;
+
+		profile_end_block();
+	}
+
+	return sort->indices[0];
+}
+
+static const void*
+radixsort_wide_index32(radixsort_t* sort, const void* input, size_t count) {
+	if (radixsort_data_size[sort->type] == 4)
+		return radixsort_wide_index(sort, input, count, RADIXSORT_INDEX32, 4);
+	return radixsort_wide_index(sort, input, count, RADIXSORT_INDEX32, 8);
+}
+
+static const void*
+radixsort_wide_index64(radixsort_t* sort, const void* input, size_t count) {
+	if (radixsort_data_size[sort->type] == 4)
+		return radixsort_wide_index(sort, input, count, RADIXSORT_INDEX64, 4);
+	return radixsort_wide_index(sort, input, count, RADIXSORT_INDEX64, 8);
+}
+
+static const void*
+radixsort_partial(radixsort_t* sort, const void* input, size_t count, size_t k, bool largest) {
+	const radixsort_data_t data_type = sort->type;
+	const radixsort_indextype_t indextype = sort->indextype;
+	const size_t key_size = radixsort_data_size[data_type];
+	const uint64_t key_mask = (key_size == 8) ? ~0ULL : 0xFFFFFFFFULL;
+	const uint64_t sign_mask = radixsort_data_signed[data_type] ? (1ULL << ((key_size * 8) - 1)) : 0;
+	const uint64_t float_mask =
+	    ((data_type == RADIXSORT_FLOAT32) || (data_type == RADIXSORT_FLOAT64)) ? key_mask : 0;
+	// Selecting the largest elements is selecting the smallest of the inverted keys
+	const uint64_t invert = largest ? key_mask : 0;
+	const unsigned char* keys = input;
+	void* selected = sort->indices[0];
+	void* candidates = sort->indices[1];
+	size_t accepted = 0;
+	size_t candidate_count = count;
+	bool candidates_all = true;
+	size_t ival;
+
+	if (k > count)
+		k = count;
+	if (!k)
+		return selected;
+
+	// Radix select from the most significant byte, only refining the bucket holding the k:th element
+	profile_begin_block(STRING_CONST("radixsort select"));
+	for (size_t ipass = 0; ipass < key_size; ++ipass) {
+		const unsigned int shift = (unsigned int)((key_size - (ipass + 1)) * 8);
+		size_t histogram[256];
+
+		memset(histogram, 0, sizeof(histogram));
+		for (ival = 0; ival < candidate_count; ++ival) {
+			size_t id = candidates_all ? ival : radixsort_index_get(candidates, indextype, ival);
+			uint64_t radix = radixsort_key_radix(keys + (id * key_size), key_size, sign_mask, float_mask) ^ invert;
+			++histogram[(radix >> shift) & 0xFF];
+		}
+
+		const size_t remain = k - accepted;
+		size_t below = 0;
+		unsigned int pivot = 0;
+		while ((below + histogram[pivot]) < remain)
+			below += histogram[pivot++];
+
+		// Accept elements in lower buckets, keep elements in pivot bucket and discard the rest
+		size_t next = 0;
+		for (ival = 0; ival < candidate_count; ++ival) {
+			size_t id = candidates_all ? ival : radixsort_index_get(candidates, indextype, ival);
+			uint64_t radix = radixsort_key_radix(keys + (id * key_size), key_size, sign_mask, float_mask) ^ invert;
+			unsigned int digit = (unsigned int)((radix >> shift) & 0xFF);
+			if (digit < pivot)
+				radixsort_index_set(selected, indextype, accepted++, id);
+			else if (digit == pivot)
+				radixsort_index_set(candidates, indextype, next++, id);
+		}
+		candidates_all = false;
+		candidate_count = next;
+
+		if ((accepted == k) || ((accepted + candidate_count) == k))
+			break;
+	}
+
+	// Remaining candidates are either all needed or have equal keys
+	for (ival = 0; accepted < k; ++ival)
+		radixsort_index_set(selected, indextype, accepted++,
+		                    candidates_all ? ival : radixsort_index_get(candidates, indextype, ival));
+	profile_end_block();
+
+	// Sort the selected elements, least significant byte first
+	profile_begin_block(STRING_CONST("radixsort pass"));
+	size_t histogram[8][256];
+	memset(histogram, 0, sizeof(size_t) * 256 * key_size);
+	for (ival = 0; ival < k; ++ival) {
+		size_t id = radixsort_index_get(selected, indextype, ival);
+		uint64_t radix = radixsort_key_radix(keys + (id * key_size), key_size, sign_mask, float_mask) ^ invert;
+		for (size_t ipass = 0; ipass < key_size; ++ipass)
+			++histogram[ipass][(radix >> (ipass * 8)) & 0xFF];
+	}
+
+	void* src = selected;
+	void* dst = candidates;
+	for (size_t ipass = 0; ipass < key_size; ++ipass) {
+		const unsigned int shift = (unsigned int)(ipass * 8);
+		size_t id = radixsort_index_get(src, indextype, 0);
+		uint64_t radix = radixsort_key_radix(keys + (id * key_size), key_size, sign_mask, float_mask) ^ invert;
+		if (histogram[ipass][(radix >> shift) & 0xFF] == k)
+			continue;
+
+		size_t offset[256];
+		size_t next = 0;
+		for (unsigned int ibucket = 0; ibucket < 256; ++ibucket) {
+			offset[ibucket] = next;
+			next += histogram[ipass][ibucket];
+		}
+		for (ival = 0; ival < k; ++ival) {
+			id = radixsort_index_get(src, indextype, ival);
+			radix = radixsort_key_radix(keys + (id * key_size), key_size, sign_mask, float_mask) ^ invert;
+			radixsort_index_set(dst, indextype, offset[(radix >> shift) & 0xFF]++, id);
+		}
+
+		void* swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != selected)
+		memcpy(selected, src, k * (size_t)indextype);
+	profile_end_block();
+
+	return selected;
+}
+
+const void*
+radixsort_sort(radixsort_t* sort, const void* input, size_t count) {
+	const radixsort_data_t data_type = sort->type;
+
+	FOUNDATION_ASSERT(count <= sort->size);
+	if (count > sort->size)
+		count = sort->size;
+
+	profile_begin_block(STRING_CONST("radixsort"));
+
+	const void* result = nullptr;
+	if (data_type == RADIXSORT_STRING) {
+		result = radixsort_string(sort, input, count);
+	} else if (count <= RADIXSORT_INSERTION_THRESHOLD) {
+		result = radixsort_insertion_sort(sort, input, count);
+	} else if (sort->wide && (count >= RADIXSORT_WIDE_DIGIT_THRESHOLD)) {
+		if (sort->indextype == RADIXSORT_INDEX32)
+			result = radixsort_wide_index32(sort, input, count);
+		else
+			result = radixsort_wide_index64(sort, input, count);
+	} else if ((data_type == RADIXSORT_FLOAT32) || (data_type == RADIXSORT_FLOAT64)) {
+		if (sort->indextype == RADIXSORT_INDEX16)
+			result = radixsort_float_index16(sort, input, count);
+		else if (sort->indextype == RADIXSORT_INDEX32)
+			result = radixsort_float_index32(sort, input, count);
+		else
+			result = radixsort_float_index64(sort, input, count);
+	} else {
+		if (sort->indextype == RADIXSORT_INDEX16)
+			result = radixsort_int_index16(sort, input, count);
+		else if (sort->indextype == RADIXSORT_INDEX32)
+			result = radixsort_int_index32(sort, input, count);
+		else
+			result = radixsort_int_index64(sort, input, count);
+	}
+
+	sort->lastused = count;
+
+	profile_end_block();
+
+	return result;
+}
+
+static const void*
+radixsort_sort_partial(radixsort_t* sort, const void* input, size_t count, size_t k, bool largest) {
+	FOUNDATION_ASSERT(count <= sort->size);
+	if (count > sort->size)
+		count = sort->size;
+
+	if ((sort->type == RADIXSORT_CUSTOM) || (sort->type == RADIXSORT_STRING)) {
+		FOUNDATION_ASSERT_FAIL("Partial radix sort requires integer or floating point data");
+		return radixsort_sort(sort, input, count);
+	}
+
+	profile_begin_block(STRING_CONST("radixsort"));
+	const void* result = radixsort_partial(sort, input, count, k, largest);
+	profile_end_block();
+
+	// Index arrays no longer hold a full permutation, disable temporal coherence in next sort
+	sort->lastused = 0;
+
+	return result;
+}
+
+const void*
+radixsort_sort_smallest(radixsort_t* sort, const void* input, size_t count, size_t k) {
+	return radixsort_sort_partial(sort, input, count, k, false);
+}
+
+const void*
+radixsort_sort_largest(radixsort_t* sort, const void* input, size_t count, size_t k) {
+	return radixsort_sort_partial(sort, input, count, k, true);
+}
+
+void
+radixsort_sort_keyvalue(radixsort_t* sort, void* keys, void* values, size_t count) {
+	FOUNDATION_ASSERT_MSG(sort->scratch[0], "Radix sort object not initialized for key-value sorting");
+	FOUNDATION_ASSERT(count <= sort->size);
+	if (count > sort->size)
+		count = sort->size;
+
+	profile_begin_block(STRING_CONST("radixsort"));
+
+	if (count > 1) {
+		// Wide digits need fewer passes, but larger histograms only pay off for larger inputs
+		const bool wide = sort->wide && (count >= RADIXSORT_WIDE_DIGIT_THRESHOLD);
+		if (sort->type == RADIXSORT_CUSTOM) {
+			radixsort_keyvalue_custom(sort, keys, values, count);
+		} else if (radixsort_data_size[sort->type] == 4) {
+			if (wide)
+				radixsort_keyvalue_typed(sort, keys, values, count, 4, RADIXSORT_WIDE_DIGIT_BITS);
+			else
+				radixsort_keyvalue_typed(sort, keys, values, count, 4, 8);
+		} else {
+			if (wide)
+				radixsort_keyvalue_typed(sort, keys, values, count, 8, RADIXSORT_WIDE_DIGIT_BITS);
+			else
+				radixsort_keyvalue_typed(sort, keys, values, count, 8, 8);
+		}
+	}
+
+	sort->lastused = count;
+
+	profile_end_block();
+}
+
+radixsort_t*
+radixsort_allocate_custom(size_t data_size, size_t count) {
+	radixsort_t* sort;
+	size_t indexsize = (size_t)radixsort_index_type(count);
+	sort = memory_allocate(0,
+	                       sizeof(radixsort_t) +
+	                           /* 2 index tables */ (2 * indexsize * count) +
+	                           /* histograms */ (256 * data_size * indexsize) +
+	                           /* offset table */ (256 * indexsize),
+	                       0, MEMORY_PERSISTENT);
+	sort->custom_data_size = data_size;
+	sort->indices[0] = pointer_offset(sort, sizeof(radixsort_t));
+	sort->indices[1] = pointer_offset(sort->indices[0], indexsize * count);
+	sort->histogram = pointer_offset(sort->indices[1], indexsize * count);
+	sort->offset = pointer_offset(sort->histogram, indexsize * 256 * data_size);
+
+	radixsort_initialize_custom(sort, data_size, count);
+
+	return sort;
+}
+
+size_t
+radixsort_string_scratch_size(size_t count) {
+	return sizeof(radixsort_string_key_t) * count;
+}
+
+static radixsort_t*
+radixsort_allocate_string(size_t count) {
+	radixsort_t* sort;
+	size_t indexsize = (size_t)radixsort_index_type(count);
+	size_t indices_size = ((2 * indexsize * count) + 15) & ~(size_t)15;
+	size_t scratch_size = radixsort_string_scratch_size(count);
+	sort = memory_allocate(0,
+	                       sizeof(radixsort_t) +
+	                           /* 2 index tables */ indices_size +
+	                           /* 2 prefix tables */ (2 * scratch_size),
+	                       0, MEMORY_PERSISTENT);
+	sort->indices[0] = pointer_offset(sort, sizeof(radixsort_t));
+	sort->indices[1] = pointer_offset(sort->indices[0], indexsize * count);
+	sort->histogram = nullptr;
+	sort->offset = nullptr;
+	sort->scratch[0] = pointer_offset(sort->indices[0], indices_size);
+	sort->scratch[1] = pointer_offset(sort->scratch[0], scratch_size);
+
+	radixsort_initialize(sort, RADIXSORT_STRING, count);
+
+	return sort;
+}
+
+radixsort_t*
+radixsort_allocate(radixsort_data_t type, size_t count) {
+	radixsort_t* sort;
+	size_t indexsize = (size_t)radixsort_index_type(count);
+	if (type == RADIXSORT_STRING)
+		return radixsort_allocate_string(count);
+	const bool wide = (count >= RADIXSORT_WIDE_DIGIT_THRESHOLD);
+	const size_t histogram_count = wide ? radixsort_wide_histogram_count(radixsort_data_size[type]) :
+	                                      (256 * radixsort_data_size[type]);
+	const size_t offset_count = wide ? RADIXSORT_WIDE_DIGIT_BUCKETS : 256;
+	sort = memory_allocate(0,
+	                       sizeof(radixsort_t) +
+	                           /* 2 index tables */ (2 * indexsize * count) +
+	                           /* histograms */ (histogram_count * indexsize) +
+	                           /* offset table */ (offset_count * indexsize),
+	                       0, MEMORY_PERSISTENT);
+	sort->indices[0] = pointer_offset(sort, sizeof(radixsort_t));
+	sort->indices[1] = pointer_offset(sort->indices[0], indexsize * count);
+	sort->histogram = pointer_offset(sort->indices[1], indexsize * count);
+	sort->offset = pointer_offset(sort->histogram, indexsize * histogram_count);
+
+	radixsort_initialize(sort, type, count);
+	sort->wide = wide;
+
+	return sort;
+}
+
+static radixsort_t*
+radixsort_allocate_keyvalue_block(size_t data_size, size_t histogram_count, size_t offset_count, size_t value_size,
+                                  size_t count) {
+	radixsort_t* sort;
+	size_t keys_size = ((data_size * count) + 15) & ~(size_t)15;
+	sort = memory_allocate(0,
+	                       sizeof(radixsort_t) +
+	                           /* histograms */ (histogram_count * sizeof(size_t)) +
+	                           /* offset table */ (offset_count * sizeof(size_t)) +
+	                           /* key scratch */ keys_size +
+	                           /* value scratch */ (value_size * count),
+	                       0, MEMORY_PERSISTENT);
+	sort->indices[0] = nullptr;
+	sort->indices[1] = nullptr;
+	sort->histogram = pointer_offset(sort, sizeof(radixsort_t));
+	sort->offset = pointer_offset(sort->histogram, sizeof(size_t) * histogram_count);
+	sort->scratch[0] = pointer_offset(sort->offset, sizeof(size_t) * offset_count);
+	sort->scratch[1] = pointer_offset(sort->scratch[0], keys_size);
+	return sort;
+}
+
+radixsort_t*
+radixsort_allocate_keyvalue(radixsort_data_t type, size_t value_size, size_t count) {
+	const size_t data_size = radixsort_data_size[type];
+	const bool wide = (count >= RADIXSORT_WIDE_DIGIT_THRESHOLD);
+	radixsort_t* sort = radixsort_allocate_keyvalue_block(
+	    data_size, wide ? radixsort_wide_histogram_count(data_size) : (256 * data_size),
+	    wide ? RADIXSORT_WIDE_DIGIT_BUCKETS : 256, value_size, count);
+	radixsort_initialize_keyvalue(sort, type, value_size, count);
+	sort->wide = wide;
+	return sort;
+}
+
+radixsort_t*
+radixsort_allocate_keyvalue_custom(size_t data_size, size_t value_size, size_t count) {
+	radixsort_t* sort = radixsort_allocate_keyvalue_block(data_size, 256 * data_size, 256, value_size, count);
+	radixsort_initialize_keyvalue_custom(sort, data_size, value_size, count);
+	return sort;
+}
+
+static void
+radixsort_initialize_indices(radixsort_t* sort, size_t count) {
+	sort->indextype = radixsort_index_type(count);
+	sort->value_size = 0;
+	if (sort->type != RADIXSORT_STRING) {
+		sort->scratch[0] = nullptr;
+		sort->scratch[1] = nullptr;
+	}
+
+	if (sort->indextype == RADIXSORT_INDEX64) {
+		uint64_t* indices[2] = {sort->indices[0], sort->indices[1]};
+		for (size_t i = 0; i < count; ++i) {
+			indices[0][i] = i;
+			indices[1][i] = i;
+		}
+	} else if (sort->indextype == RADIXSORT_INDEX32) {
+		uint32_t* indices[2] = {sort->indices[0], sort->indices[1]};
+		for (uint32_t i = 0; i < count; ++i) {
+			indices[0][i] = i;
+			indices[1][i] = i;
+		}
+	} else {
+		uint16_t* indices[2] = {sort->indices[0], sort->indices[1]};
+		for (uint32_t i = 0; i < count; ++i) {
 			indices[0][i] = (uint16_t)i;
 			indices[1][i] = (uint16_t)i;
 		}
 	}
 }
 
+void
+radixsort_initialize_custom(radixsort_t* sort, size_t data_size, size_t count) {
+	sort->type = RADIXSORT_CUSTOM;
+	sort->size = count;
+	sort->lastused = count;
+	sort->custom_data_size = data_size;
+	sort->wide = false;
+
+	radixsort_initialize_indices(sort, count);
+}
+
+void
+radixsort_initialize(radixsort_t* sort, radixsort_data_t type, size_t count) {
+	sort->type = type;
+	sort->size = count;
+	sort->lastused = count;
+	sort->custom_data_size = (type != RADIXSORT_STRING) ? radixsort_data_size[type] : sizeof(string_const_t);
+	sort->wide = false;
+
+	radixsort_initialize_indices(sort, count);
+}
+
+void
+radixsort_initialize_keyvalue(radixsort_t* sort, radixsort_data_t type, size_t value_size, size_t count) {
+	FOUNDATION_ASSERT(type != RADIXSORT_CUSTOM);
+	sort->type = type;
+	sort->indextype = radixsort_index_type(count);
+	sort->size = count;
+	sort->lastused = count;
+	sort->custom_data_size = radixsort_data_size[type];
+	sort->wide = false;
+	sort->value_size = value_size;
+}
+
+void
+radixsort_initialize_keyvalue_custom(radixsort_t* sort, size_t data_size, size_t value_size, size_t count) {
+	sort->type = RADIXSORT_CUSTOM;
+	sort->indextype = radixsort_index_type(count);
+	sort->size = count;
+	sort->lastused = count;
+	sort->custom_data_size = data_size;
+	sort->wide = false;
+	sort->value_size = value_size;
+}
+
 void
 radixsort_deallocate(radixsort_t* sort) {
 	radixsort_finalize(sort);
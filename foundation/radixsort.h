@@ -15,14 +15,18 @@
 /*! \file radixsort.h
 \brief Radix sorter
 
-Radix sorter for 32/64-bit integer and floating point values. */
+Radix sorter for 32/64-bit integer and floating point values, custom fixed size data and
+variable length strings. Sorting either produces an
+index permutation of the input (16, 32 or 64-bit indices depending on the maximum number of
+elements), or physically reorders keys together with a fixed size payload (key-value sort). */
 
 #include <foundation/platform.h>
 #include <foundation/types.h>
 
 /*! Allocate a radix sort object. All data is stored in a single continuous memory block,
-including sort buckets and resulting index arrays. Deallocate the sort object with a call to
-#radixsort_deallocate.
+including sort buckets and resulting index arrays. Buckets for integer and floating point data are
+sized for 11-bit digits if count is large enough to benefit from fewer passes. Deallocate the sort
+object with a call to #radixsort_deallocate.
 \param type Data type
 \param count Number of elements to sort
 \return New radix sort object */
@@ -38,12 +42,35 @@ including sort buckets and resulting index arrays. Deallocate the sort object wi
 FOUNDATION_API radixsort_t*
 radixsort_allocate_custom(size_t data_size, size_t count);
 
+/*! Allocate a radix sort object for sorting keys together with a fixed size payload. All data is
+stored in a single continuous memory block, including sort buckets and scratch buffers for keys
+and payloads. Buckets are sized for 11-bit digits if count is large enough to benefit from fewer
+passes. Deallocate the sort object with a call to #radixsort_deallocate.
+\param type Key data type
+\param value_size Size of payload for each key in bytes, can be zero
+\param count Number of elements to sort
+\return New radix sort object */
+FOUNDATION_API radixsort_t*
+radixsort_allocate_keyvalue(radixsort_data_t type, size_t value_size, size_t count);
+
+/*! Allocate a radix sort object for sorting opaque custom keys together with a fixed size payload.
+All data is stored in a single continuous memory block, including sort buckets and scratch buffers
+for keys and payloads. Deallocate the sort object with a call to #radixsort_deallocate.
+\param data_size Size of key data type in bytes
+\param value_size Size of payload for each key in bytes, can be zero
+\param count Number of elements to sort
+\return New radix sort object */
+FOUNDATION_API radixsort_t*
+radixsort_allocate_keyvalue_custom(size_t data_size, size_t value_size, size_t count);
+
 /*! Deallocate a radix sort object previously allocated with a call to #radixsort_allocate.
 \param sort Radix sort object to deallocate */
 FOUNDATION_API void
 radixsort_deallocate(radixsort_t* sort);
 
-/*! Initialize a radix sort object. All data pointers should be set by the caller. Finalize
+/*! Initialize a radix sort object. All data pointers should be set by the caller. For strings
+(RADIXSORT_STRING) no histogram or offset table is used, instead both scratch pointers must be
+set to buffers of the size given by #radixsort_string_scratch_size, aligned to 8 bytes. Finalize
 the sort object with a call to #radixsort_finalize.
 \param sort Radix sort object
 \param type Data type
@@ -51,6 +78,13 @@ the sort object with a call to #radixsort_finalize.
 FOUNDATION_API void
 radixsort_initialize(radixsort_t* sort, radixsort_data_t type, size_t count);
 
+/*! Get the size of each of the two scratch buffers needed to sort strings with a radix sort
+object initialized by the caller with #radixsort_initialize.
+\param count Number of elements to sort
+\return Size of each scratch buffer in bytes */
+FOUNDATION_API size_t
+radixsort_string_scratch_size(size_t count);
+
 /*! Initialize a radix sort object for custom opaque data. All data pointers should be set by the caller. Finalize
 the sort object with a call to #radixsort_finalize.
 \param sort Radix sort object
@@ -59,6 +93,28 @@ the sort object with a call to #radixsort_finalize.
 FOUNDATION_API void
 radixsort_initialize_custom(radixsort_t* sort, size_t data_size, size_t count);
 
+/*! Initialize a radix sort object for sorting keys together with a fixed size payload. The histogram,
+offset and scratch pointers should be set by the caller, where histograms and offsets are stored as
+size_t counters (256 per key byte for histograms and 256 for offsets) and scratch buffers hold one
+key and one payload respectively for each element. Finalize the sort object with a call to
+#radixsort_finalize.
+\param sort Radix sort object
+\param type Key data type
+\param value_size Size of payload for each key in bytes, can be zero
+\param count Number of elements to sort */
+FOUNDATION_API void
+radixsort_initialize_keyvalue(radixsort_t* sort, radixsort_data_t type, size_t value_size, size_t count);
+
+/*! Initialize a radix sort object for sorting opaque custom keys together with a fixed size
+payload. Data pointers should be set by the caller as described in #radixsort_initialize_keyvalue.
+Finalize the sort object with a call to #radixsort_finalize.
+\param sort Radix sort object
+\param data_size Size of key data type in bytes
+\param value_size Size of payload for each key in bytes, can be zero
+\param count Number of elements to sort */
+FOUNDATION_API void
+radixsort_initialize_keyvalue_custom(radixsort_t* sort, size_t data_size, size_t value_size, size_t count);
+
 /*! Finalize a radix sort object previously initialized with a call to #radixsort_initialize.
 \param sort Radix sort object to finalize */
 FOUNDATION_API void
@@ -68,10 +124,50 @@ radixsort_finalize(radixsort_t* sort);
 partially sorted and/or used in a previous sort call on this radix sort object.
 \param sort Radix sort object
 \param input Input data buffer of same type as radix sort object was
-             initialized with
+             initialized with. Strings (RADIXSORT_STRING) are sorted with a most significant
+             digit radix sort on cached string prefixes, switching to multikey quicksort and
+             insertion sort for smaller buckets
 \param count Number of elements to sort, must be less or equal to maximum
              number radix sort object was initialized with
 \return Sorted index array holding num indices into the input array, data type depending
-        on sort index type (16-bit or 32-bit) */
+        on sort index type (16-bit, 32-bit or 64-bit) */
 FOUNDATION_API const void*
 radixsort_sort(radixsort_t* sort, const void* input, size_t count);
+
+/*! Perform partial radix sort, selecting the k smallest elements in ascending order. Elements
+are selected with a most significant digit radix select only refining the bucket holding the k:th
+element, after which only the selected elements are sorted. Only integer and floating point data
+types are supported. Temporal coherence is not used and the next full sort starts from scratch.
+\param sort Radix sort object
+\param input Input data buffer of same type as radix sort object was initialized with
+\param count Number of elements in input, must be less or equal to maximum number radix sort
+             object was initialized with
+\param k Number of elements to select, clamped to count
+\return Index array where the first k indices are valid, data type depending on sort index type */
+FOUNDATION_API const void*
+radixsort_sort_smallest(radixsort_t* sort, const void* input, size_t count, size_t k);
+
+/*! Perform partial radix sort, selecting the k largest elements in descending order.
+See radixsort_sort_smallest for details.
+\param sort Radix sort object
+\param input Input data buffer of same type as radix sort object was initialized with
+\param count Number of elements in input, must be less or equal to maximum number radix sort
+             object was initialized with
+\param k Number of elements to select, clamped to count
+\return Index array where the first k indices are valid, data type depending on sort index type */
+FOUNDATION_API const void*
+radixsort_sort_largest(radixsort_t* sort, const void* input, size_t count, size_t k);
+
+/*! Perform radix sort of keys and payloads in place. Keys and payloads are moved together in
+each pass, reading input sequentially and scattering to the scratch buffers, instead of producing
+an index permutation that must be gathered in a separate pass. Passes where all keys have the same
+byte value are skipped. The radix sort object must have been allocated or initialized for
+key-value sorting.
+\param sort Radix sort object
+\param keys Key buffer of same type as radix sort object was initialized with
+\param values Payload buffer holding one payload of the initialized size per key, can be null
+               if payload size is zero
+\param count Number of elements to sort, must be less or equal to maximum number radix sort
+              object was initialized with */
+FOUNDATION_API void
+radixsort_sort_keyvalue(radixsort_t* sort, void* keys, void* values, size_t count);
@@ -45,6 +45,165 @@ FOUNDATION_DECLARE_THREAD_LOCAL(unsigned int*, state, 0)
 static mutex_t* random_mutex;
 static unsigned int** random_state;
 static unsigned int** random_available_state;
+static random_engine_t random_engine;
+static random_state_t random_engine_seed;
+
+// Explicit state engines. xoshiro256** from http://prng.di.unimi.it/ and
+// PCG64 (XSL-RR 128/64) from http://www.pcg-random.org/, seeded through splitmix64
+
+static uint64_t
+random_splitmix64(uint64_t* seed) {
+	uint64_t z = (*seed += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+random_rotl64(uint64_t val, unsigned int bits) {
+	return (val << bits) | (val >> (64U - bits));
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+random_rotr64(uint64_t val, unsigned int bits) {
+	return (val >> bits) | (val << ((64U - bits) & 63U));
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+random_xoshiro256_next(uint64_t* FOUNDATION_RESTRICT state) {
+	const uint64_t result = random_rotl64(state[1] * 5, 7) * 9;
+	const uint64_t shifted = state[1] << 17;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= shifted;
+	state[3] = random_rotl64(state[3], 45);
+	return result;
+}
+
+static void
+random_xoshiro256_jump(uint64_t* state, const uint64_t* polynomial) {
+	uint64_t jumped[4] = {0, 0, 0, 0};
+	unsigned int iword, ibit;
+	for (iword = 0; iword < 4; ++iword) {
+		for (ibit = 0; ibit < 64; ++ibit) {
+			if (polynomial[iword] & (1ULL << ibit)) {
+				jumped[0] ^= state[0];
+				jumped[1] ^= state[1];
+				jumped[2] ^= state[2];
+				jumped[3] ^= state[3];
+			}
+			random_xoshiro256_next(state);
+		}
+	}
+	memcpy(state, jumped, sizeof(jumped));
+}
+
+#define RANDOM_PCG64_MULTIPLIER_LOW 0x4385df649fccf645ULL
+#define RANDOM_PCG64_MULTIPLIER_HIGH 0x2360ed051fc65da4ULL
+
+//! Full 64x64 to 128 bit multiplication, returning low word and storing high word
+static FOUNDATION_FORCEINLINE uint64_t
+random_mul128(uint64_t a, uint64_t b, uint64_t* high) {
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t product = (__uint128_t)a * b;
+	*high = (uint64_t)(product >> 64);
+	return (uint64_t)product;
+#elif FOUNDATION_COMPILER_MSVC && FOUNDATION_ARCH_X86_64
+	return _umul128(a, b, high);
+#else
+	const uint64_t a_low = a & 0xFFFFFFFFULL, a_high = a >> 32;
+	const uint64_t b_low = b & 0xFFFFFFFFULL, b_high = b >> 32;
+	const uint64_t low_low = a_low * b_low;
+	const uint64_t high_low = a_high * b_low;
+	const uint64_t low_high = a_low * b_high;
+	const uint64_t cross = (low_low >> 32) + (high_low & 0xFFFFFFFFULL) + low_high;
+	*high = (a_high * b_high) + (high_low >> 32) + (cross >> 32);
+	return (cross << 32) | (low_low & 0xFFFFFFFFULL);
+#endif
+}
+
+//! Affine step state = state * mult + add in 128 bit arithmetic, all values as low/high words
+static FOUNDATION_FORCEINLINE void
+random_pcg64_affine(uint64_t* low, uint64_t* high, uint64_t mult_low, uint64_t mult_high, uint64_t add_low,
+                    uint64_t add_high) {
+	uint64_t result_high;
+	uint64_t result_low = random_mul128(*low, mult_low, &result_high);
+	result_high += (*low * mult_high) + (*high * mult_low);
+	*low = result_low + add_low;
+	*high = result_high + add_high + (*low < result_low ? 1 : 0);
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+random_pcg64_next(uint64_t* FOUNDATION_RESTRICT state) {
+	random_pcg64_affine(state, state + 1, RANDOM_PCG64_MULTIPLIER_LOW, RANDOM_PCG64_MULTIPLIER_HIGH, state[2],
+	                    state[3]);
+	return random_rotr64(state[1] ^ state[0], (unsigned int)(state[1] >> 58));
+}
+
+//! Advance the generator by 2^bits steps in logarithmic time, see
+//! "Random Number Generation with Arbitrary Strides" by F. Brown
+static void
+random_pcg64_advance(uint64_t* state, unsigned int bits) {
+	uint64_t mult_low = RANDOM_PCG64_MULTIPLIER_LOW, mult_high = RANDOM_PCG64_MULTIPLIER_HIGH;
+	uint64_t add_low = state[2], add_high = state[3];
+	unsigned int ibit;
+	for (ibit = 0; ibit < bits; ++ibit) {
+		// add = (mult + 1) * add, mult = mult * mult
+		uint64_t next_low = mult_low + 1;
+		uint64_t next_high = mult_high + (next_low < mult_low ? 1 : 0);
+		uint64_t square_low = mult_low, square_high = mult_high;
+		random_pcg64_affine(&add_low, &add_high, next_low, next_high, 0, 0);
+		random_pcg64_affine(&square_low, &square_high, mult_low, mult_high, 0, 0);
+		mult_low = square_low;
+		mult_high = square_high;
+	}
+	random_pcg64_affine(state, state + 1, mult_low, mult_high, add_low, add_high);
+}
+
+// Ziggurat tables with 256 layers for the normal and exponential distributions, from
+// "The Ziggurat Method for Generating Random Variables" by G. Marsaglia and W. W. Tsang, using
+// independent bits for layer index and position as in "An Improved Ziggurat Method to Generate
+// Normal Random Samples" by J. A. Doornik. Layer 0 is the base strip with the tail.
+// Tables hold the layer edge x coordinates and the unscaled density at each edge
+#define RANDOM_ZIGGURAT_LAYERS 256
+#define RANDOM_ZIGGURAT_NORMAL_R 3.654152885361008796
+#define RANDOM_ZIGGURAT_NORMAL_V 0.00492867323399
+#define RANDOM_ZIGGURAT_EXPONENTIAL_R 7.69711747013104972
+#define RANDOM_ZIGGURAT_EXPONENTIAL_V 0.0039496598225815571993
+
+static real random_normal_x[RANDOM_ZIGGURAT_LAYERS + 1];
+static real random_normal_f[RANDOM_ZIGGURAT_LAYERS + 1];
+static real random_exponential_x[RANDOM_ZIGGURAT_LAYERS + 1];
+static real random_exponential_f[RANDOM_ZIGGURAT_LAYERS + 1];
+
+static void
+random_ziggurat_initialize(void) {
+	// Compute in double precision regardless of real size, each edge depends on the previous
+	double normal_x = RANDOM_ZIGGURAT_NORMAL_R;
+	double exponential_x = RANDOM_ZIGGURAT_EXPONENTIAL_R;
+	unsigned int ilayer;
+
+	random_normal_x[0] = (real)(RANDOM_ZIGGURAT_NORMAL_V / exp(-0.5 * normal_x * normal_x));
+	random_normal_f[0] = 0;
+	random_exponential_x[0] = (real)(RANDOM_ZIGGURAT_EXPONENTIAL_V / exp(-exponential_x));
+	random_exponential_f[0] = 0;
+	for (ilayer = 1; ilayer < RANDOM_ZIGGURAT_LAYERS; ++ilayer) {
+		const double normal_f = exp(-0.5 * normal_x * normal_x);
+		const double exponential_f = exp(-exponential_x);
+		random_normal_x[ilayer] = (real)normal_x;
+		random_normal_f[ilayer] = (real)normal_f;
+		random_exponential_x[ilayer] = (real)exponential_x;
+		random_exponential_f[ilayer] = (real)exponential_f;
+		normal_x = sqrt(-2.0 * log((RANDOM_ZIGGURAT_NORMAL_V / normal_x) + normal_f));
+		exponential_x = -log((RANDOM_ZIGGURAT_EXPONENTIAL_V / exponential_x) + exponential_f);
+	}
+	random_normal_x[RANDOM_ZIGGURAT_LAYERS] = 0;
+	random_normal_f[RANDOM_ZIGGURAT_LAYERS] = REAL_C(1.0);
+	random_exponential_x[RANDOM_ZIGGURAT_LAYERS] = 0;
+	random_exponential_f[RANDOM_ZIGGURAT_LAYERS] = REAL_C(1.0);
+}
 
 static void
 random_seed_buffer(unsigned int* buffer) {
@@ -56,11 +215,24 @@ random_seed_buffer(unsigned int* buffer) {
 		    0xFFFFFFFF;
 }
 
+static FOUNDATION_FORCEINLINE random_state_t*
+random_engine_state(unsigned int* buffer) {
+	return (random_state_t*)((void*)buffer);
+}
+
 static unsigned int*
 random_allocate_buffer(void) {
-	unsigned int* buffer = memory_allocate(0, sizeof(unsigned int) * (RANDOM_STATE_SIZE + 1), 0, MEMORY_PERSISTENT);
-	random_seed_buffer(buffer);
-	buffer[RANDOM_STATE_SIZE] = 0;
+	unsigned int* buffer;
+	if (random_engine == RANDOM_ENGINE_WELL) {
+		buffer = memory_allocate(0, sizeof(unsigned int) * (RANDOM_STATE_SIZE + 1), 0, MEMORY_PERSISTENT);
+		random_seed_buffer(buffer);
+		buffer[RANDOM_STATE_SIZE] = 0;
+	} else {
+		// Give each thread state a non-overlapping subsequence of the seed state
+		buffer = memory_allocate(0, sizeof(random_state_t), 0, MEMORY_PERSISTENT);
+		memcpy(buffer, &random_engine_seed, sizeof(random_state_t));
+		random_state_jump(&random_engine_seed);
+	}
 	array_push(random_state, buffer);
 	return buffer;
 }
@@ -71,6 +243,13 @@ internal_random_initialize(void) {
 		size_t prealloc, capacity;
 		size_t i;
 		random_mutex = mutex_allocate(STRING_CONST("random"));
+		random_ziggurat_initialize();
+
+		random_engine = foundation_config().random_engine;
+		if (random_engine != RANDOM_ENGINE_WELL)
+			random_state_initialize(&random_engine_seed, random_engine,
+			                        (uint64_t)time_system() ^ (uint64_t)time_current() ^
+			                            (uint64_t)((uintptr_t)&random_engine_seed));
 
 		// Allocate and seed a number of state buffers
 		prealloc = foundation_config().random_state_prealloc;
@@ -214,12 +393,77 @@ random_from_state(unsigned int* FOUNDATION_RESTRICT state) {
 	}
 }
 
-uint32_t
-random32(void) {
+// Same as RANDOM_TRANSFORM with the key selected by a mask instead of a data dependent branch,
+// test bit given as bit index
+#define RANDOM_TRANSFORM_BRANCHFREE(bits, key, mask, testbit, val)                   \
+	((((((val) << (bits)) ^ ((val) >> (RANDOM_BITS - (bits)))) & (mask))) ^ \
+	 ((key) & (0U - (((val) >> (testbit)) & 1U))))
+
+// Generator step for 2 <= state_index <= RANDOM_STATE_SIZE - RANDOM_HIGH_LIMIT - 1 where no
+// state index wraps around, identical to the last case in random_from_state. The value stored
+// at the new state index is carried in a register to the next step instead of reloaded
+#define RANDOM_STEP_UNWRAPPED(state, state_index, current, out)                                                      \
+	do {                                                                                                             \
+		unsigned int bits0_, bits1_, bits2_, high_;                                                                  \
+		high_ = state[state_index + RANDOM_HIGH_LIMIT];                                                              \
+		bits0_ = (state[state_index - 1] & RANDOM_MASK_LOWER) | (state[state_index - 2] & RANDOM_MASK_UPPER);        \
+		bits1_ = RANDOM_XOR_AND_LEFTSHIFT(24, current) ^                                                             \
+		         RANDOM_XOR_AND_RIGHTSHIFT(30, state[state_index + RANDOM_LOW_LIMIT]);                               \
+		bits2_ = RANDOM_XOR_AND_LEFTSHIFT(10, high_) ^ (26U << state[state_index + RANDOM_MID_LIMIT]);               \
+		state[state_index] = bits1_ ^ bits2_;                                                                        \
+		current = bits0_ ^ RANDOM_XOR_AND_RIGHTSHIFT(20, bits1_) ^                                                   \
+		          RANDOM_TRANSFORM_BRANCHFREE(9, 0xb729fcecU, 0xfbffffffU, 17, bits2_) ^ (bits1_ ^ bits2_);          \
+		state[--state_index] = current;                                                                              \
+		out = current ^ (high_ & RANDOM_BITMASK);                                                                    \
+	} while (0)
+
+//! Generate a sequence of numbers, identical to repeated calls to random_from_state
+static void
+random_fill_from_state(unsigned int* FOUNDATION_RESTRICT state, uint32_t* FOUNDATION_RESTRICT dest, size_t count) {
+	while (count) {
+		unsigned int state_index = state[RANDOM_STATE_SIZE];
+		if ((state_index >= 2) && (state_index + RANDOM_HIGH_LIMIT < RANDOM_STATE_SIZE)) {
+			// Run the branch free step until the index reaches the wrapping cases
+			size_t steps = math_min(count, (size_t)(state_index - 1));
+			size_t istep = 0;
+			unsigned int current = state[state_index];
+			count -= steps;
+			for (; istep < steps; ++istep)
+				RANDOM_STEP_UNWRAPPED(state, state_index, current, dest[istep]);
+			state[RANDOM_STATE_SIZE] = state_index;
+			dest += steps;
+		} else {
+			*dest++ = random_from_state(state);
+			--count;
+		}
+	}
+}
+
+static unsigned int*
+random_state_current(void) {
 	unsigned int* state = get_thread_state();
 	if (!state)
 		state = random_thread_initialize();
+	return state;
+}
 
+void
+random_thread_seed(uint64_t seed) {
+	unsigned int* state = random_state_current();
+	if (random_engine != RANDOM_ENGINE_WELL) {
+		random_state_initialize(random_engine_state(state), random_engine, seed);
+	} else {
+		for (unsigned int i = 0; i < RANDOM_STATE_SIZE; ++i)
+			state[i] = (unsigned int)random_splitmix64(&seed);
+		state[RANDOM_STATE_SIZE] = 0;
+	}
+}
+
+uint32_t
+random32(void) {
+	unsigned int* state = random_state_current();
+	if (random_engine != RANDOM_ENGINE_WELL)
+		return random_state32(random_engine_state(state));
 	return random_from_state(state);
 }
 
@@ -235,12 +479,11 @@ random32_range(uint32_t low, uint32_t high) {
 	return low + (random32() % (high - low));
 }
 
-uint64_t
-random64(void) {
+static FOUNDATION_FORCEINLINE uint64_t
+random64_from_buffer(unsigned int* state) {
 	uint32_t low, high;
-	unsigned int* state = get_thread_state();
-	if (!state)
-		state = random_thread_initialize();
+	if (random_engine != RANDOM_ENGINE_WELL)
+		return random_state64(random_engine_state(state));
 
 	low = random_from_state(state);
 	high = random_from_state(state);
@@ -248,6 +491,11 @@ random64(void) {
 	return ((uint64_t)high << 32ULL) | low;
 }
 
+uint64_t
+random64(void) {
+	return random64_from_buffer(random_state_current());
+}
+
 uint64_t
 random64_range(uint64_t low, uint64_t high) {
 	if (low > high) {
@@ -290,6 +538,91 @@ random_range(real low, real high) {
 	return math_max(result, low);
 }
 
+// Number of 32-bit values generated per batch when filling arrays of other types
+#define RANDOM_FILL_BATCH 256
+
+static void
+random_fill_buffer32(unsigned int* state, uint32_t* dest, size_t count) {
+	if (random_engine != RANDOM_ENGINE_WELL)
+		random_state_fill32(random_engine_state(state), dest, count);
+	else
+		random_fill_from_state(state, dest, count);
+}
+
+static void
+random_fill_buffer64(unsigned int* state, uint64_t* dest, size_t count) {
+	uint32_t batch[RANDOM_FILL_BATCH];
+	if (random_engine != RANDOM_ENGINE_WELL) {
+		random_state_fill64(random_engine_state(state), dest, count);
+		return;
+	}
+	while (count) {
+		size_t values = math_min(count, (size_t)(RANDOM_FILL_BATCH / 2));
+		size_t ivalue;
+		random_fill_from_state(state, batch, values * 2);
+		for (ivalue = 0; ivalue < values; ++ivalue)
+			dest[ivalue] = ((uint64_t)batch[(ivalue * 2) + 1] << 32ULL) | batch[ivalue * 2];
+		dest += values;
+		count -= values;
+	}
+}
+
+void
+random_fill32(uint32_t* dest, size_t count) {
+	random_fill_buffer32(random_state_current(), dest, count);
+}
+
+void
+random_fill64(uint64_t* dest, size_t count) {
+	random_fill_buffer64(random_state_current(), dest, count);
+}
+
+void
+random_fill_normalized(real* dest, size_t count) {
+	random_fill_range(dest, count, 0, REAL_C(1.0));
+}
+
+void
+random_fill_range(real* dest, size_t count, real low, real high) {
+#if FOUNDATION_SIZE_REAL == 8
+	uint64_t batch[RANDOM_FILL_BATCH / 2];
+#else
+	uint32_t batch[RANDOM_FILL_BATCH];
+#endif
+	unsigned int* state = random_state_current();
+	if (low > high) {
+		real tmp = low;
+		low = high;
+		high = tmp;
+	}
+	while (count) {
+		size_t values = math_min(count, sizeof(batch) / sizeof(batch[0]));
+		size_t ivalue;
+#if FOUNDATION_SIZE_REAL == 8
+		random_fill_buffer64(state, batch, values);
+#else
+		random_fill_buffer32(state, batch, values);
+#endif
+		for (ivalue = 0; ivalue < values; ++ivalue) {
+			// Same operations as random_normalized and random_range
+#if FOUNDATION_SIZE_REAL == 8
+			real result = (real)batch[ivalue] * (REAL_C(1.0) / REAL_C(18446744073709551616.0));
+#else
+			real result = (real)batch[ivalue] * (REAL_C(1.0) / REAL_C(4294967296.0));
+#endif
+			if (result >= REAL_C(1.0))
+				result = math_real_dec(REAL_C(1.0), 1);
+			result = math_max(result, 0);
+			result = low + ((high - low) * result);
+			if (result >= high)
+				result = math_real_dec(high, 1);
+			dest[ivalue] = math_max(result, low);
+		}
+		dest += values;
+		count -= values;
+	}
+}
+
 int32_t
 random32_gaussian_range(int32_t low, int32_t high) {
 	const uint64_t cubic =
@@ -373,3 +706,307 @@ random32_weighted(uint32_t limit, const real* weights) {
 	// Deal with floating point roundoff issues
 	return limit - 1;
 }
+
+void
+random_state_initialize(random_state_t* state, random_engine_t engine, uint64_t seed) {
+	uint64_t* words = state->state;
+	if (engine == RANDOM_ENGINE_PCG64) {
+		const uint64_t initial_low = random_splitmix64(&seed);
+		const uint64_t initial_high = random_splitmix64(&seed);
+		const uint64_t stream_low = random_splitmix64(&seed);
+		const uint64_t stream_high = random_splitmix64(&seed);
+		// Increment must be odd, stream selector shifted up one bit
+		words[0] = 0;
+		words[1] = 0;
+		words[2] = (stream_low << 1) | 1;
+		words[3] = (stream_high << 1) | (stream_low >> 63);
+		random_pcg64_next(words);
+		words[0] += initial_low;
+		words[1] += initial_high + (words[0] < initial_low ? 1 : 0);
+		random_pcg64_next(words);
+	} else {
+		engine = RANDOM_ENGINE_XOSHIRO256;
+		words[0] = random_splitmix64(&seed);
+		words[1] = random_splitmix64(&seed);
+		words[2] = random_splitmix64(&seed);
+		words[3] = random_splitmix64(&seed);
+		// All zero state is a fixed point of the generator
+		if (!(words[0] | words[1] | words[2] | words[3]))
+			words[0] = 1;
+	}
+	state->engine = engine;
+}
+
+void
+random_state_jump(random_state_t* state) {
+	static const uint64_t jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL,
+	                                 0x39abdc4529b1661cULL};
+	if (state->engine == RANDOM_ENGINE_PCG64)
+		random_pcg64_advance(state->state, 64);
+	else
+		random_xoshiro256_jump(state->state, jump);
+}
+
+void
+random_state_long_jump(random_state_t* state) {
+	static const uint64_t long_jump[4] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL,
+	                                      0x39109bb02acbe635ULL};
+	if (state->engine == RANDOM_ENGINE_PCG64)
+		random_pcg64_advance(state->state, 96);
+	else
+		random_xoshiro256_jump(state->state, long_jump);
+}
+
+uint64_t
+random_state64(random_state_t* state) {
+	if (state->engine == RANDOM_ENGINE_PCG64)
+		return random_pcg64_next(state->state);
+	return random_xoshiro256_next(state->state);
+}
+
+uint32_t
+random_state32(random_state_t* state) {
+	// Upper bits have the best statistical quality for both engines
+	return (uint32_t)(random_state64(state) >> 32ULL);
+}
+
+uint32_t
+random_state32_range(random_state_t* state, uint32_t low, uint32_t high) {
+	if (low > high) {
+		uint32_t tmp = low;
+		low = high;
+		high = tmp;
+	}
+	if (high <= low + 1)
+		return low;
+	return low + (random_state32(state) % (high - low));
+}
+
+uint64_t
+random_state64_range(random_state_t* state, uint64_t low, uint64_t high) {
+	if (low > high) {
+		uint64_t tmp = low;
+		low = high;
+		high = tmp;
+	}
+	if (high <= low + 1)
+		return low;
+	return low + (random_state64(state) % (high - low));
+}
+
+// Top 53 (or 24) bits scaled to [0,1) are exactly representable, no roundoff clamp needed.
+// The open variant maps to (0,1] for use as logarithm argument
+#if FOUNDATION_SIZE_REAL == 8
+#define RANDOM_NORMALIZED_FROM_BITS(bits) ((real)((bits) >> 11ULL) * (REAL_C(1.0) / REAL_C(9007199254740992.0)))
+#define RANDOM_NORMALIZED_OPEN_FROM_BITS(bits) \
+	((real)(((bits) >> 11ULL) + 1) * (REAL_C(1.0) / REAL_C(9007199254740992.0)))
+#else
+#define RANDOM_NORMALIZED_FROM_BITS(bits) ((real)((bits) >> 40ULL) * (REAL_C(1.0) / REAL_C(16777216.0)))
+#define RANDOM_NORMALIZED_OPEN_FROM_BITS(bits) \
+	((real)(((bits) >> 40ULL) + 1) * (REAL_C(1.0) / REAL_C(16777216.0)))
+#endif
+
+real
+random_state_normalized(random_state_t* state) {
+	return RANDOM_NORMALIZED_FROM_BITS(random_state64(state));
+}
+
+real
+random_state_range(random_state_t* state, real low, real high) {
+	real result;
+	if (low > high) {
+		real tmp = low;
+		low = high;
+		high = tmp;
+	}
+	result = low + ((high - low) * random_state_normalized(state));
+	if (result >= high)
+		return math_real_dec(high, 1);
+	return math_max(result, low);
+}
+
+void
+random_state_fill32(random_state_t* state, uint32_t* dest, size_t count) {
+	uint64_t words[4];
+	size_t ivalue;
+	memcpy(words, state->state, sizeof(words));
+	if (state->engine == RANDOM_ENGINE_PCG64) {
+		for (ivalue = 0; ivalue < count; ++ivalue)
+			dest[ivalue] = (uint32_t)(random_pcg64_next(words) >> 32ULL);
+	} else {
+		for (ivalue = 0; ivalue < count; ++ivalue)
+			dest[ivalue] = (uint32_t)(random_xoshiro256_next(words) >> 32ULL);
+	}
+	memcpy(state->state, words, sizeof(words));
+}
+
+void
+random_state_fill64(random_state_t* state, uint64_t* dest, size_t count) {
+	uint64_t words[4];
+	size_t ivalue;
+	memcpy(words, state->state, sizeof(words));
+	if (state->engine == RANDOM_ENGINE_PCG64) {
+		for (ivalue = 0; ivalue < count; ++ivalue)
+			dest[ivalue] = random_pcg64_next(words);
+	} else {
+		for (ivalue = 0; ivalue < count; ++ivalue)
+			dest[ivalue] = random_xoshiro256_next(words);
+	}
+	memcpy(state->state, words, sizeof(words));
+}
+
+// Ziggurat sampling from a generic source of 64-bit values. The layer index is taken from the
+// low bits and the position within the layer from the high bits of the same value, only the
+// rare rejection tests and tail samples consume additional values
+typedef uint64_t (*random_source_fn)(void* source);
+
+static FOUNDATION_NOINLINE real
+random_normal_tail(random_source_fn next, void* source, bool negative) {
+	const real tail = (real)RANDOM_ZIGGURAT_NORMAL_R;
+	real x, y;
+	do {
+		x = math_logn(RANDOM_NORMALIZED_OPEN_FROM_BITS(next(source))) / tail;
+		y = math_logn(RANDOM_NORMALIZED_OPEN_FROM_BITS(next(source)));
+	} while (-(y + y) < x * x);
+	return negative ? (x - tail) : (tail - x);
+}
+
+static FOUNDATION_FORCEINLINE real
+random_normal_from_source(random_source_fn next, void* source) {
+	while (true) {
+		const uint64_t bits = next(source);
+		const unsigned int layer = (unsigned int)(bits & 0xFF);
+		const real u = (REAL_C(2.0) * RANDOM_NORMALIZED_FROM_BITS(bits)) - REAL_C(1.0);
+		const real x = u * random_normal_x[layer];
+		if (math_abs(x) < random_normal_x[layer + 1])
+			return x;
+		if (!layer)
+			return random_normal_tail(next, source, u < 0);
+		if (random_normal_f[layer + 1] + ((random_normal_f[layer] - random_normal_f[layer + 1]) *
+		                                  RANDOM_NORMALIZED_FROM_BITS(next(source))) <
+		    math_exp(REAL_C(-0.5) * x * x))
+			return x;
+	}
+}
+
+static FOUNDATION_FORCEINLINE real
+random_exponential_from_source(random_source_fn next, void* source) {
+	while (true) {
+		const uint64_t bits = next(source);
+		const unsigned int layer = (unsigned int)(bits & 0xFF);
+		const real x = RANDOM_NORMALIZED_FROM_BITS(bits) * random_exponential_x[layer];
+		if (x < random_exponential_x[layer + 1])
+			return x;
+		if (!layer)
+			return (real)RANDOM_ZIGGURAT_EXPONENTIAL_R - math_logn(RANDOM_NORMALIZED_OPEN_FROM_BITS(next(source)));
+		if (random_exponential_f[layer + 1] + ((random_exponential_f[layer] - random_exponential_f[layer + 1]) *
+		                                       RANDOM_NORMALIZED_FROM_BITS(next(source))) <
+		    math_exp(-x))
+			return x;
+	}
+}
+
+static uint64_t
+random_source_thread(void* source) {
+	return random64_from_buffer(source);
+}
+
+static uint64_t
+random_source_state(void* source) {
+	return random_state64(source);
+}
+
+//! Source buffering values from the thread local generator or an explicit state, consuming
+//! whole batches which means fills do not generate the same sequence as repeated single calls
+typedef struct {
+	unsigned int* buffer;
+	random_state_t* state;
+	size_t next;
+	uint64_t value[RANDOM_FILL_BATCH / 2];
+} random_source_batch_t;
+
+static FOUNDATION_NOINLINE void
+random_source_batch_refill(random_source_batch_t* batch) {
+	if (batch->state)
+		random_state_fill64(batch->state, batch->value, RANDOM_FILL_BATCH / 2);
+	else
+		random_fill_buffer64(batch->buffer, batch->value, RANDOM_FILL_BATCH / 2);
+	batch->next = 0;
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+random_source_batch(void* source) {
+	random_source_batch_t* batch = source;
+	if (batch->next >= (RANDOM_FILL_BATCH / 2))
+		random_source_batch_refill(batch);
+	return batch->value[batch->next++];
+}
+
+static void
+random_fill_normal_from_batch(random_source_batch_t* batch, real* dest, size_t count, real mean, real stddev) {
+	size_t ivalue;
+	batch->next = RANDOM_FILL_BATCH / 2;
+	for (ivalue = 0; ivalue < count; ++ivalue)
+		dest[ivalue] = mean + (stddev * random_normal_from_source(random_source_batch, batch));
+}
+
+static void
+random_fill_exponential_from_batch(random_source_batch_t* batch, real* dest, size_t count, real lambda) {
+	const real scale = REAL_C(1.0) / lambda;
+	size_t ivalue;
+	batch->next = RANDOM_FILL_BATCH / 2;
+	for (ivalue = 0; ivalue < count; ++ivalue)
+		dest[ivalue] = scale * random_exponential_from_source(random_source_batch, batch);
+}
+
+real
+random_normal(real mean, real stddev) {
+	return mean + (stddev * random_normal_from_source(random_source_thread, random_state_current()));
+}
+
+real
+random_exponential(real lambda) {
+	return random_exponential_from_source(random_source_thread, random_state_current()) / lambda;
+}
+
+void
+random_fill_normal(real* dest, size_t count, real mean, real stddev) {
+	random_source_batch_t batch;
+	batch.buffer = random_state_current();
+	batch.state = nullptr;
+	random_fill_normal_from_batch(&batch, dest, count, mean, stddev);
+}
+
+void
+random_fill_exponential(real* dest, size_t count, real lambda) {
+	random_source_batch_t batch;
+	batch.buffer = random_state_current();
+	batch.state = nullptr;
+	random_fill_exponential_from_batch(&batch, dest, count, lambda);
+}
+
+real
+random_state_normal(random_state_t* state, real mean, real stddev) {
+	return mean + (stddev * random_normal_from_source(random_source_state, state));
+}
+
+real
+random_state_exponential(random_state_t* state, real lambda) {
+	return random_exponential_from_source(random_source_state, state) / lambda;
+}
+
+void
+random_state_fill_normal(random_state_t* state, real* dest, size_t count, real mean, real stddev) {
+	random_source_batch_t batch;
+	batch.buffer = nullptr;
+	batch.state = state;
+	random_fill_normal_from_batch(&batch, dest, count, mean, stddev);
+}
+
+void
+random_state_fill_exponential(random_state_t* state, real* dest, size_t count, real lambda) {
+	random_source_batch_t batch;
+	batch.buffer = nullptr;
+	batch.state = state;
+	random_fill_exponential_from_batch(&batch, dest, count, lambda);
+}
@@ -22,7 +22,14 @@ thread has exited and released ownership of such buffers.
 
 All random functions generate values in ranges where low limit of the range is included
 in the set of value, while the high limit is excluded. This is denoted [low,high) in the
-documentation for each function, as per https://en.wikipedia.org/wiki/ISO_31-11 notation. */
+documentation for each function, as per https://en.wikipedia.org/wiki/ISO_31-11 notation.
+
+The global random functions use a thread-local generator with the engine selected by
+the random_engine field in #foundation_config_t. Explicit generator states can be created with
+#random_state_initialize using the xoshiro256** or PCG64 engines, giving deterministic sequences
+for a given seed. Explicit states are not thread-safe, use one state per thread and use
+#random_state_jump or #random_state_long_jump to give each thread an independent
+non-overlapping subsequence. */
 
 #include <foundation/platform.h>
 #include <foundation/types.h>
@@ -65,6 +72,37 @@ random_normalized(void);
 FOUNDATION_API real
 random_range(real low, real high);
 
+/*! Fill an array with 32 bit random numbers in full [0,2^32) range. Generates the same
+sequence as the equivalent number of calls to #random32 but without the per call overhead.
+\param dest Destination array
+\param count Number of values to generate */
+FOUNDATION_API void
+random_fill32(uint32_t* dest, size_t count);
+
+/*! Fill an array with 64 bit random numbers in full [0,2^64) range. Generates the same
+sequence as the equivalent number of calls to #random64 but without the per call overhead.
+\param dest Destination array
+\param count Number of values to generate */
+FOUNDATION_API void
+random_fill64(uint64_t* dest, size_t count);
+
+/*! Fill an array with normalized floating point random numbers in [0,1) range. Generates the
+same sequence as the equivalent number of calls to #random_normalized but without the per call
+overhead.
+\param dest Destination array
+\param count Number of values to generate */
+FOUNDATION_API void
+random_fill_normalized(real* dest, size_t count);
+
+/*! Fill an array with floating point random numbers in [low,high) range. Generates the same
+sequence as the equivalent number of calls to #random_range but without the per call overhead.
+\param dest Destination array
+\param count Number of values to generate
+\param low Lower limit of range
+\param high Upper limit of range */
+FOUNDATION_API void
+random_fill_range(real* dest, size_t count, real low, real high);
+
 /*! Generate 32 bit normal distribution random number in the [low, high) range.
 \param low Lower limit of range
 \param high Upper limit of range
@@ -79,6 +117,41 @@ random32_gaussian_range(int32_t low, int32_t high);
 FOUNDATION_API real
 random_gaussian_range(real low, real high);
 
+/*! Generate floating point random number with a normal distribution with the given mean and
+standard deviation, using the Ziggurat method. Unlike #random_gaussian_range this is a true
+normal distribution with unbounded range.
+\param mean Mean
+\param stddev Standard deviation
+\return Floating point value with a normal distribution */
+FOUNDATION_API real
+random_normal(real mean, real stddev);
+
+/*! Generate floating point random number with an exponential distribution with the given
+rate, using the Ziggurat method. The mean of the distribution is 1/lambda.
+\param lambda Rate parameter, must be positive
+\return Floating point value with an exponential distribution in [0,inf) range */
+FOUNDATION_API real
+random_exponential(real lambda);
+
+/*! Fill an array with floating point random numbers with a normal distribution, see
+#random_normal. Values are generated in batches from the thread-local generator which means
+the sequence is not the same as from repeated calls to #random_normal.
+\param dest Destination array
+\param count Number of values to generate
+\param mean Mean
+\param stddev Standard deviation */
+FOUNDATION_API void
+random_fill_normal(real* dest, size_t count, real mean, real stddev);
+
+/*! Fill an array with floating point random numbers with an exponential distribution, see
+#random_exponential. Values are generated in batches from the thread-local generator which
+means the sequence is not the same as from repeated calls to #random_exponential.
+\param dest Destination array
+\param count Number of values to generate
+\param lambda Rate parameter, must be positive */
+FOUNDATION_API void
+random_fill_exponential(real* dest, size_t count, real lambda);
+
 /*! Generate 32 bit triangular distribution random number in the [low, high) range.
 \param low Lower limit of range
 \param high Upper limit of range
@@ -102,6 +175,133 @@ array must have "limit" number of elements.
 FOUNDATION_API uint32_t
 random32_weighted(uint32_t limit, const real* weights);
 
+/*! Initialize an explicit generator state with the given engine, expanding the seed to the
+full engine state. The same engine and seed always produce the same sequence. The WELL engine is
+not available for explicit states and will select xoshiro256** instead.
+\param state State to initialize
+\param engine Engine
+\param seed Seed */
+FOUNDATION_API void
+random_state_initialize(random_state_t* state, random_engine_t engine, uint64_t seed);
+
+/*! Advance the state as if 2^128 (xoshiro256**) or 2^64 (PCG64) values had been generated.
+Copying a state and jumping the original once per copy gives subsequences that will not
+overlap, suitable for parallel workers.
+\param state State */
+FOUNDATION_API void
+random_state_jump(random_state_t* state);
+
+/*! Advance the state as if 2^192 (xoshiro256**) or 2^96 (PCG64) values had been generated.
+Can be used to generate independent starting points for groups of states which are in turn
+split with #random_state_jump.
+\param state State */
+FOUNDATION_API void
+random_state_long_jump(random_state_t* state);
+
+/*! Generate 32 bit random number in full [0,2^32) range from an explicit state
+\param state State
+\return 32-bit pseudorandom number in [0,2^32) range */
+FOUNDATION_API uint32_t
+random_state32(random_state_t* state);
+
+/*! Generate 32 bit random number in [low,high) range from an explicit state
+\param state State
+\param low Lower limit of range
+\param high Upper limit of range
+\return 32-bit pseudorandom number in [low,high) range */
+FOUNDATION_API uint32_t
+random_state32_range(random_state_t* state, uint32_t low, uint32_t high);
+
+/*! Generate 64 bit random number in full [0,2^64) range from an explicit state
+\param state State
+\return 64-bit pseudorandom number in [0,2^64) range */
+FOUNDATION_API uint64_t
+random_state64(random_state_t* state);
+
+/*! Generate 64 bit random number in [low,high) range from an explicit state
+\param state State
+\param low Lower limit of range
+\param high Upper limit of range
+\return 64-bit pseudorandom number in [low,high) range */
+FOUNDATION_API uint64_t
+random_state64_range(random_state_t* state, uint64_t low, uint64_t high);
+
+/*! Generate normalized floating point random number in [0,1) range from an explicit state,
+with 53 bits (or 24 bits for 32-bit reals) of precision
+\param state State
+\return Floating point pseudorandom number in [0,1) range */
+FOUNDATION_API real
+random_state_normalized(random_state_t* state);
+
+/*! Generate floating point random number in [low,high) range from an explicit state
+\param state State
+\param low Lower limit of range
+\param high Upper limit of range
+\return Floating point pseudorandom number in [low,high) range */
+FOUNDATION_API real
+random_state_range(random_state_t* state, real low, real high);
+
+/*! Fill an array with 32 bit random numbers from an explicit state. Generates the same
+sequence as the equivalent number of calls to #random_state32.
+\param state State
+\param dest Destination array
+\param count Number of values to generate */
+FOUNDATION_API void
+random_state_fill32(random_state_t* state, uint32_t* dest, size_t count);
+
+/*! Fill an array with 64 bit random numbers from an explicit state. Generates the same
+sequence as the equivalent number of calls to #random_state64.
+\param state State
+\param dest Destination array
+\param count Number of values to generate */
+FOUNDATION_API void
+random_state_fill64(random_state_t* state, uint64_t* dest, size_t count);
+
+/*! Generate floating point random number with a normal distribution from an explicit state,
+see #random_normal
+\param state State
+\param mean Mean
+\param stddev Standard deviation
+\return Floating point value with a normal distribution */
+FOUNDATION_API real
+random_state_normal(random_state_t* state, real mean, real stddev);
+
+/*! Generate floating point random number with an exponential distribution from an explicit
+state, see #random_exponential
+\param state State
+\param lambda Rate parameter, must be positive
+\return Floating point value with an exponential distribution in [0,inf) range */
+FOUNDATION_API real
+random_state_exponential(random_state_t* state, real lambda);
+
+/*! Fill an array with floating point random numbers with a normal distribution from an
+explicit state. The sequence is deterministic for a given state but not the same as from
+repeated calls to #random_state_normal, and the state is advanced in batches.
+\param state State
+\param dest Destination array
+\param count Number of values to generate
+\param mean Mean
+\param stddev Standard deviation */
+FOUNDATION_API void
+random_state_fill_normal(random_state_t* state, real* dest, size_t count, real mean, real stddev);
+
+/*! Fill an array with floating point random numbers with an exponential distribution from an
+explicit state. The sequence is deterministic for a given state but not the same as from
+repeated calls to #random_state_exponential, and the state is advanced in batches.
+\param state State
+\param dest Destination array
+\param count Number of values to generate
+\param lambda Rate parameter, must be positive */
+FOUNDATION_API void
+random_state_fill_exponential(random_state_t* state, real* dest, size_t count, real lambda);
+
+/*! Seed the pseudorandom number generator state of the calling thread used by the global
+random functions, expanding the seed to the full state. The same seed always produces the same
+sequence on the same engine, for reproducible results.
+\param seed Seed */
+FOUNDATION_API void
+random_thread_seed(uint64_t seed);
+
 /*! Free thread memory used by pseudorandom number generator. Will be called automatically
 on thread exit for foundation threads. */
 FOUNDATION_API void
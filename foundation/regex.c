@@ -237,7 +237,7 @@ regex_compile_quantifier(regex_t** target, bool allow_grow, size_t last_code_len
 		return REGEXERR_OK;
 	}
 
-	move_size = 1 + (*target)->code_length - last_code_length;
+	move_size = (*target)->code_length - last_code_length;
 
 	if ((ret = regex_emit(target, allow_grow, 1, 0)))  // Make sure we have buffer space
 		return ret;
@@ -725,6 +725,519 @@ regex_execute(regex_t* regex, size_t op, const char* input, size_t inoffset, siz
 	return context;
 }
 
+// Lazy DFA matching. The compiled code is converted to a position automaton where each
+// consuming position is a single byte of an exact match or a single character matching op,
+// with the set of bytes it accepts and the node to continue at after consuming a byte.
+// Nodes are code offsets times two, with the low bit selecting the repeat node of a
+// one-or-more quantifier. The epsilon closure of a node follows the ops exactly like the
+// backtracking engine, so both engines agree on whether an input matches. DFA states are
+// sets of positions built on demand when first reached, kept in a bounded cache which is
+// flushed when full
+
+#define REGEX_DFA_STATE_LIMIT 256
+#define REGEX_DFA_POOL_SIZE 4096
+
+#define REGEX_DFA_NONE 0xFFFFFFFFU
+#define REGEX_DFA_UNKNOWN 0xFFFFFFFFU
+#define REGEX_DFA_ACCEPT 0xFFFFFFFEU
+#define REGEX_DFA_DEAD 0xFFFFFFFDU
+
+typedef struct regex_dfa_t regex_dfa_t;
+typedef struct regex_dfa_cache_t regex_dfa_cache_t;
+
+struct regex_dfa_t {
+	// Set while the cache is in use by a thread
+	atomic32_t lock;
+	// Matching is only attempted from the start of input
+	bool anchored;
+	uint32_t node_count;
+	uint32_t position_count;
+	uint32_t class_count;
+	// Position at each code offset, REGEX_DFA_NONE if not a consuming position
+	uint32_t* position;
+	// Node following each position
+	uint32_t* successor;
+	// 256 bit set of bytes accepted by each position
+	uint32_t* byteset;
+	regex_dfa_cache_t* cache;
+	uint8_t byte_class[256];
+};
+
+struct regex_dfa_cache_t {
+	uint32_t state_count;
+	uint32_t start;
+	uint32_t generation;
+	uint32_t stamp;
+	size_t pool_used;
+	size_t pool_capacity;
+	size_t set_count;
+	// Premultiplied state transitions indexed by byte class
+	uint32_t* transition;
+	uint32_t* state_offset;
+	uint32_t* state_size;
+	uint32_t* table;
+	uint32_t* pool;
+	// Scratch data for building states
+	uint32_t* set;
+	uint32_t* mark;
+	uint32_t* stack;
+	uint64_t* bits;
+};
+
+static size_t
+regex_dfa_element_end(const uint8_t* code, size_t op) {
+	switch (code[op]) {
+		case REGEXOP_EXACT_MATCH:
+		case REGEXOP_ANY_OF:
+		case REGEXOP_ANY_BUT:
+			return op + 2 + code[op + 1];
+		case REGEXOP_META_MATCH:
+			return op + (code[op + 1] ? 2 : 3);
+		default:
+			break;
+	}
+	return op + 1;
+}
+
+static regex_dfa_t*
+regex_dfa_allocate(regex_t* regex) {
+	regex_dfa_t* dfa;
+	const uint8_t* code = regex->code;
+	size_t code_length = regex->code_length;
+	size_t op, element, end, next, ibyte, iclass;
+	uint32_t position = 0;
+	uint32_t iposition;
+	uint8_t* boundary;
+	uint16_t remap[512];
+	unsigned int class_count;
+	char cin;
+
+	if (!code_length || (code_length >= 0x10000000))
+		return 0;
+
+	dfa = memory_allocate(HASH_STRING,
+	                      sizeof(regex_dfa_t) + (sizeof(uint32_t) * (2 + 8) * code_length) + code_length, 0,
+	                      MEMORY_PERSISTENT | MEMORY_ZERO_INITIALIZED);
+	dfa->anchored = (code[0] == REGEXOP_BEGINNING_OF_LINE);
+	dfa->node_count = (uint32_t)((code_length + 1) * 2);
+	dfa->position = pointer_offset(dfa, sizeof(regex_dfa_t));
+	dfa->successor = dfa->position + code_length;
+	dfa->byteset = dfa->successor + code_length;
+	boundary = (uint8_t*)(dfa->byteset + (8 * code_length));
+	memset(dfa->position, 0xFF, sizeof(uint32_t) * code_length);
+
+	// Walk the code the same way the backtracking engine steps through it, rejecting code
+	// the conversion does not handle
+	for (op = 0; op < code_length; op = end) {
+		uint8_t opcode = code[op];
+		bool quantified = ((opcode >= REGEXOP_ZERO_OR_MORE) && (opcode <= REGEXOP_ZERO_OR_ONE));
+
+		boundary[op] = 1;
+		element = quantified ? op + 1 : op;
+		if (element >= code_length)
+			goto failure;
+		if (quantified && ((code[element] < REGEXOP_EXACT_MATCH) || (code[element] > REGEXOP_ANY_BUT)))
+			goto failure;
+
+		switch (code[element]) {
+			case REGEXOP_BEGIN_CAPTURE:
+			case REGEXOP_END_CAPTURE:
+			case REGEXOP_BRANCH:
+			case REGEXOP_BRANCH_END:
+				end = op + 2;
+				break;
+
+			case REGEXOP_BEGINNING_OF_LINE:
+			case REGEXOP_END_OF_LINE:
+				end = op + 1;
+				break;
+
+			case REGEXOP_EXACT_MATCH:
+			case REGEXOP_META_MATCH:
+			case REGEXOP_ANY_OF:
+			case REGEXOP_ANY_BUT:
+				if (element + 1 >= code_length)
+					goto failure;
+				end = regex_dfa_element_end(code, element);
+				break;
+
+			case REGEXOP_ANY:
+				end = element + 1;
+				break;
+
+			default:
+				goto failure;
+		}
+		if (end > code_length)
+			goto failure;
+		if ((code[element] == REGEXOP_ANY_OF) || (code[element] == REGEXOP_ANY_BUT)) {
+			// An escape code must not extend past the group
+			for (ibyte = element + 2; ibyte < end; ++ibyte) {
+				if (!code[ibyte] && (++ibyte == end))
+					goto failure;
+			}
+		}
+
+		// Node to continue at after the element, looping back to the quantifier if repeated
+		if (!quantified || (opcode == REGEXOP_ZERO_OR_ONE))
+			next = end * 2;
+		else if ((opcode == REGEXOP_ONE_OR_MORE) || (opcode == REGEXOP_ONE_OR_MORE_SHORTEST))
+			next = (op * 2) + 1;
+		else
+			next = op * 2;
+
+		if (code[element] == REGEXOP_EXACT_MATCH) {
+			size_t matchlen = code[element + 1];
+			if (quantified && !matchlen)
+				goto failure;
+			for (ibyte = 0; ibyte < matchlen; ++ibyte, ++position) {
+				size_t offset = element + 2 + ibyte;
+				uint8_t byte = code[offset];
+				dfa->position[offset] = position;
+				dfa->successor[position] = (uint32_t)((ibyte + 1 < matchlen) ? (offset + 1) * 2 : next);
+				dfa->byteset[(position * 8) + (byte >> 5)] |= (1U << (byte & 31));
+			}
+		} else if ((code[element] >= REGEXOP_META_MATCH) && (code[element] <= REGEXOP_ANY_BUT)) {
+			dfa->position[element] = position;
+			dfa->successor[position] = (uint32_t)next;
+			// Evaluate the op for every byte value, reusing the backtracking engine
+			// guarantees the accepted set is identical
+			for (ibyte = 0; ibyte < 256; ++ibyte) {
+				cin = (char)ibyte;
+				if (regex_execute_single(regex, element, &cin, 0, 1, 0, 0).inoffset == 1)
+					dfa->byteset[(position * 8) + (ibyte >> 5)] |= (1U << (ibyte & 31));
+			}
+			++position;
+		}
+	}
+
+	// Branches must jump to the start of an op, or past the end of code
+	for (op = 0; op < code_length; ++op) {
+		if (boundary[op] && ((code[op] == REGEXOP_BRANCH) || (code[op] == REGEXOP_BRANCH_END))) {
+			end = op + 2 + code[op + 1];
+			if ((end < code_length) && !boundary[end])
+				goto failure;
+		}
+	}
+
+	// Partition bytes into classes of bytes accepted by the same positions
+	class_count = 1;
+	for (iposition = 0; iposition < position; ++iposition) {
+		const uint32_t* byteset = dfa->byteset + (iposition * 8);
+		memset(remap, 0xFF, sizeof(remap));
+		iclass = 0;
+		for (ibyte = 0; ibyte < 256; ++ibyte) {
+			size_t key = ((size_t)dfa->byte_class[ibyte] * 2) + ((byteset[ibyte >> 5] >> (ibyte & 31)) & 1);
+			if (remap[key] == 0xFFFF)
+				remap[key] = (uint16_t)iclass++;
+			dfa->byte_class[ibyte] = (uint8_t)remap[key];
+		}
+		class_count = (unsigned int)iclass;
+	}
+
+	dfa->position_count = position;
+	dfa->class_count = class_count;
+	return dfa;
+
+failure:
+	memory_deallocate(dfa);
+	return 0;
+}
+
+static void
+regex_dfa_deallocate(regex_dfa_t* dfa) {
+	if (dfa)
+		memory_deallocate(dfa->cache);
+	memory_deallocate(dfa);
+}
+
+static void
+regex_dfa_cache_flush(regex_dfa_cache_t* cache) {
+	cache->state_count = 0;
+	cache->start = REGEX_DFA_UNKNOWN;
+	cache->pool_used = 0;
+	++cache->generation;
+	memset(cache->table, 0, sizeof(uint32_t) * REGEX_DFA_STATE_LIMIT * 2);
+}
+
+static regex_dfa_cache_t*
+regex_dfa_cache_allocate(const regex_dfa_t* dfa) {
+	regex_dfa_cache_t* cache;
+	size_t words = (dfa->position_count + 63) / 64;
+	size_t pool_capacity = dfa->position_count + REGEX_DFA_POOL_SIZE;
+	size_t count = (REGEX_DFA_STATE_LIMIT * (dfa->class_count + 4)) + pool_capacity + dfa->position_count +
+	               (2 * (size_t)dfa->node_count);
+
+	cache = memory_allocate(HASH_STRING,
+	                        sizeof(regex_dfa_cache_t) + (sizeof(uint64_t) * words) + (sizeof(uint32_t) * count), 0,
+	                        MEMORY_PERSISTENT | MEMORY_ZERO_INITIALIZED);
+	cache->pool_capacity = pool_capacity;
+	cache->bits = pointer_offset(cache, sizeof(regex_dfa_cache_t));
+	cache->transition = (uint32_t*)(cache->bits + words);
+	cache->state_offset = cache->transition + (REGEX_DFA_STATE_LIMIT * dfa->class_count);
+	cache->state_size = cache->state_offset + REGEX_DFA_STATE_LIMIT;
+	cache->table = cache->state_size + REGEX_DFA_STATE_LIMIT;
+	cache->pool = cache->table + (REGEX_DFA_STATE_LIMIT * 2);
+	cache->set = cache->pool + pool_capacity;
+	cache->mark = cache->set + dfa->position_count;
+	cache->stack = cache->mark + dfa->node_count;
+	regex_dfa_cache_flush(cache);
+	return cache;
+}
+
+static FOUNDATION_FORCEINLINE void
+regex_dfa_push(regex_dfa_cache_t* cache, uint32_t node, size_t* depth) {
+	if (cache->mark[node] != cache->stamp) {
+		cache->mark[node] = cache->stamp;
+		cache->stack[(*depth)++] = node;
+	}
+}
+
+static FOUNDATION_FORCEINLINE uint32_t
+regex_dfa_node(const regex_t* regex, size_t op) {
+	return (uint32_t)(((op < regex->code_length) ? op : regex->code_length) * 2);
+}
+
+// Add the positions reachable from the given node without consuming input to the set being
+// built, returns true if the end of code is reachable (a match)
+static bool
+regex_dfa_closure(const regex_t* regex, const regex_dfa_t* dfa, regex_dfa_cache_t* cache, uint32_t node,
+                  bool at_start, bool at_end) {
+	const uint8_t* code = regex->code;
+	size_t depth = 0;
+	size_t op, element, entry;
+	uint32_t position;
+
+	regex_dfa_push(cache, node, &depth);
+	while (depth) {
+		node = cache->stack[--depth];
+		op = node >> 1;
+		if (op >= regex->code_length)
+			return true;
+
+		position = dfa->position[op];
+		if (!(node & 1) && (position != REGEX_DFA_NONE)) {
+			cache->set[cache->set_count++] = position;
+			continue;
+		}
+
+		switch (code[op]) {
+			case REGEXOP_BEGIN_CAPTURE:
+			case REGEXOP_END_CAPTURE:
+				regex_dfa_push(cache, regex_dfa_node(regex, op + 2), &depth);
+				break;
+
+			case REGEXOP_BEGINNING_OF_LINE:
+				if (at_start)
+					regex_dfa_push(cache, regex_dfa_node(regex, op + 1), &depth);
+				break;
+
+			case REGEXOP_END_OF_LINE:
+				if (at_end)
+					regex_dfa_push(cache, regex_dfa_node(regex, op + 1), &depth);
+				break;
+
+			case REGEXOP_EXACT_MATCH:
+				// First byte position, or next op if empty
+				regex_dfa_push(cache, regex_dfa_node(regex, op + 2), &depth);
+				break;
+
+			case REGEXOP_ZERO_OR_MORE:
+			case REGEXOP_ZERO_OR_MORE_SHORTEST:
+			case REGEXOP_ZERO_OR_ONE:
+			case REGEXOP_ONE_OR_MORE:
+			case REGEXOP_ONE_OR_MORE_SHORTEST:
+				element = op + 1;
+				entry = (code[element] == REGEXOP_EXACT_MATCH) ? element + 2 : element;
+				regex_dfa_push(cache, regex_dfa_node(regex, entry), &depth);
+				if (((code[op] != REGEXOP_ONE_OR_MORE) && (code[op] != REGEXOP_ONE_OR_MORE_SHORTEST)) || (node & 1))
+					regex_dfa_push(cache, regex_dfa_node(regex, regex_dfa_element_end(code, element)), &depth);
+				break;
+
+			case REGEXOP_BRANCH:
+				regex_dfa_push(cache, regex_dfa_node(regex, op + 2), &depth);
+				regex_dfa_push(cache, regex_dfa_node(regex, op + 2 + code[op + 1]), &depth);
+				break;
+
+			case REGEXOP_BRANCH_END:
+				regex_dfa_push(cache, regex_dfa_node(regex, op + 2 + code[op + 1]), &depth);
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	return false;
+}
+
+static void
+regex_dfa_stamp(const regex_dfa_t* dfa, regex_dfa_cache_t* cache) {
+	if (!++cache->stamp) {
+		memset(cache->mark, 0, sizeof(uint32_t) * dfa->node_count);
+		cache->stamp = 1;
+	}
+	cache->set_count = 0;
+}
+
+// Build the set of positions reached by consuming the given byte from a set of positions,
+// optionally starting a new match at the following input offset. Returns true if a match
+// is reached, otherwise the sorted set is left in the cache scratch buffer
+static bool
+regex_dfa_step(const regex_t* regex, const regex_dfa_t* dfa, regex_dfa_cache_t* cache, const uint32_t* set,
+               size_t count, uint8_t byte, bool restart, bool at_end) {
+	size_t iset, iword;
+	uint32_t position;
+
+	regex_dfa_stamp(dfa, cache);
+	for (iset = 0; iset < count; ++iset) {
+		position = set[iset];
+		if ((dfa->byteset[(position * 8) + (byte >> 5)] >> (byte & 31)) & 1) {
+			if (regex_dfa_closure(regex, dfa, cache, dfa->successor[position], false, at_end))
+				return true;
+		}
+	}
+	if (restart && regex_dfa_closure(regex, dfa, cache, 0, false, at_end))
+		return true;
+
+	// Sort the set to get a unique representation of each state
+	count = cache->set_count;
+	if (count <= 16) {
+		for (iset = 1; iset < count; ++iset) {
+			size_t islot = iset;
+			position = cache->set[iset];
+			for (; islot && (cache->set[islot - 1] > position); --islot)
+				cache->set[islot] = cache->set[islot - 1];
+			cache->set[islot] = position;
+		}
+	} else {
+		for (iset = 0; iset < count; ++iset)
+			cache->bits[cache->set[iset] >> 6] |= (1ULL << (cache->set[iset] & 63));
+		count = 0;
+		for (iword = 0; iword < (dfa->position_count + 63) / 64; ++iword) {
+			uint64_t word = cache->bits[iword];
+			cache->bits[iword] = 0;
+			for (position = (uint32_t)(iword * 64); word; ++position, word >>= 1) {
+				if (word & 1)
+					cache->set[count++] = position;
+			}
+		}
+	}
+	return false;
+}
+
+// Find or add the state for the set in the cache scratch buffer, flushing the cache if full.
+// Returns the premultiplied state index
+static uint32_t
+regex_dfa_state(const regex_dfa_t* dfa, regex_dfa_cache_t* cache) {
+	const size_t mask = (REGEX_DFA_STATE_LIMIT * 2) - 1;
+	size_t count = cache->set_count;
+	size_t slot = (size_t)hash(cache->set, sizeof(uint32_t) * count) & mask;
+	uint32_t index;
+
+	while ((index = cache->table[slot]) != 0) {
+		--index;
+		if ((cache->state_size[index] == count) &&
+		    !memcmp(cache->pool + cache->state_offset[index], cache->set, sizeof(uint32_t) * count))
+			return index * dfa->class_count;
+		slot = (slot + 1) & mask;
+	}
+
+	if ((cache->state_count == REGEX_DFA_STATE_LIMIT) || (cache->pool_used + count > cache->pool_capacity)) {
+		regex_dfa_cache_flush(cache);
+		slot = (size_t)hash(cache->set, sizeof(uint32_t) * count) & mask;
+	}
+
+	index = cache->state_count++;
+	cache->table[slot] = index + 1;
+	cache->state_offset[index] = (uint32_t)cache->pool_used;
+	cache->state_size[index] = (uint32_t)count;
+	memcpy(cache->pool + cache->pool_used, cache->set, sizeof(uint32_t) * count);
+	cache->pool_used += count;
+	memset(cache->transition + (index * dfa->class_count), 0xFF, sizeof(uint32_t) * dfa->class_count);
+	return index * dfa->class_count;
+}
+
+static uint32_t
+regex_dfa_transition(const regex_t* regex, const regex_dfa_t* dfa, regex_dfa_cache_t* cache, uint32_t state,
+                     uint8_t byte) {
+	uint32_t index = state / dfa->class_count;
+	uint32_t generation = cache->generation;
+	uint32_t next;
+
+	if (regex_dfa_step(regex, dfa, cache, cache->pool + cache->state_offset[index], cache->state_size[index], byte,
+	                   !dfa->anchored, false))
+		next = REGEX_DFA_ACCEPT;
+	else if (!cache->set_count)
+		next = REGEX_DFA_DEAD;
+	else
+		next = regex_dfa_state(dfa, cache);
+
+	// Source state is gone if the cache was flushed
+	if (generation == cache->generation)
+		cache->transition[state + dfa->byte_class[byte]] = next;
+	return next;
+}
+
+static bool
+regex_dfa_execute(const regex_t* regex, const regex_dfa_t* dfa, regex_dfa_cache_t* cache, const uint8_t* input,
+                  size_t inlength) {
+	const uint8_t* byte_class = dfa->byte_class;
+	size_t iin, last;
+	uint32_t state, next;
+
+	// Like the backtracking engine a non-anchored expression is only tried at offsets
+	// inside the input, and an empty input can only match an anchored expression
+	if (!inlength) {
+		if (!dfa->anchored)
+			return false;
+		regex_dfa_stamp(dfa, cache);
+		return regex_dfa_closure(regex, dfa, cache, 0, true, true);
+	}
+
+	state = cache->start;
+	if (state == REGEX_DFA_UNKNOWN) {
+		regex_dfa_stamp(dfa, cache);
+		if (regex_dfa_closure(regex, dfa, cache, 0, true, false))
+			state = REGEX_DFA_ACCEPT;
+		else if (!cache->set_count)
+			state = REGEX_DFA_DEAD;
+		else
+			state = regex_dfa_state(dfa, cache);
+		cache->start = state;
+	}
+
+	last = inlength - 1;
+	for (iin = 0; (iin < last) && (state < REGEX_DFA_DEAD); ++iin) {
+		next = cache->transition[state + byte_class[input[iin]]];
+		if (next == REGEX_DFA_UNKNOWN)
+			next = regex_dfa_transition(regex, dfa, cache, state, input[iin]);
+		state = next;
+	}
+	if (state >= REGEX_DFA_DEAD)
+		return (state == REGEX_DFA_ACCEPT);
+
+	// Last byte, no new match is started at the end of input and end of line matches
+	state /= dfa->class_count;
+	return regex_dfa_step(regex, dfa, cache, cache->pool + cache->state_offset[state], cache->state_size[state],
+	                      input[last], false, true);
+}
+
+//! Match with the DFA, returning false without a result if the cache is in use by another thread
+static bool
+regex_dfa_match(const regex_t* regex, const char* input, size_t inlength, bool* matched) {
+	regex_dfa_t* dfa = regex->dfa;
+
+	if (!atomic_cas32(&dfa->lock, 1, 0, memory_order_acquire, memory_order_relaxed))
+		return false;
+
+	if (!dfa->cache)
+		dfa->cache = regex_dfa_cache_allocate(dfa);
+	*matched = regex_dfa_execute(regex, dfa, dfa->cache, (const uint8_t*)input, inlength);
+	atomic_store32(&dfa->lock, 0, memory_order_release);
+	return true;
+}
+
 regex_t*
 regex_compile(const char* pattern, size_t pattern_length) {
 	regex_t* compiled;
@@ -732,9 +1245,12 @@ regex_compile(const char* pattern, size_t pattern_length) {
 	compiled->capture_count = 0;
 	compiled->code_length = 0;
 	compiled->code_allocated = pattern_length + 16;
+	compiled->dfa = 0;
 
-	if (regex_parser(&compiled, pattern, 0, pattern_length, true, 0) == pattern_length)
+	if (regex_parser(&compiled, pattern, 0, pattern_length, true, 0) == pattern_length) {
+		compiled->dfa = regex_dfa_allocate(compiled);
 		return compiled;
+	}
 
 	memory_deallocate(compiled);
 	return 0;
@@ -743,6 +1259,7 @@ regex_compile(const char* pattern, size_t pattern_length) {
 bool
 regex_parse(regex_t* regex, const char* pattern, size_t pattern_length) {
 	regex_t* result = regex;
+	regex->dfa = 0;
 	return (regex_parser(&result, pattern, 0, pattern_length, false, 0) == pattern_length);
 }
 
@@ -753,6 +1270,16 @@ regex_match(regex_t* regex, const char* input, size_t inlength, string_const_t*
 	if (!regex || !regex->code_length)
 		return true;
 
+	if (regex->dfa) {
+		// Without captures the DFA result is final, otherwise it rejects non-matching input
+		// before the backtracking engine is run to extract the captures. If another thread
+		// is using the state cache the backtracking engine is used directly
+		bool matched;
+		if (regex_dfa_match(regex, input, inlength, &matched) &&
+		    (!matched || !captures || !maxcaptures || !regex->capture_count))
+			return matched;
+	}
+
 	if (regex->code[0] == REGEXOP_BEGINNING_OF_LINE) {
 		regex_context_t context = regex_execute(regex, 0, input, 0, inlength, captures, maxcaptures);
 		if (context.inoffset <= inlength)
@@ -772,5 +1299,7 @@ regex_match(regex_t* regex, const char* input, size_t inlength, string_const_t*
 
 void
 regex_deallocate(regex_t* regex) {
+	if (regex)
+		regex_dfa_deallocate(regex->dfa);
 	memory_deallocate(regex);
 }
@@ -35,7 +35,12 @@ Small regular expression implementation matching a subset of Perl regular expres
     ?        Match zero or once
     \\XX      Match byte with hex value 0xXX (must be two hex digits)
     \\meta    Match one of the meta characters ^$()[].*+?|\
-</pre> */
+</pre>
+
+Compiled expressions are matched by a lazy DFA, building deterministic states on demand in a
+bounded cache, in time linear to the input length. Captures are extracted by a backtracking
+engine, which is only run once the DFA has found the input to match. Expressions parsed into
+a predefined buffer with #regex_parse are always matched by the backtracking engine. */
 
 #include <foundation/platform.h>
 
@@ -46,7 +51,8 @@ Small regular expression implementation matching a subset of Perl regular expres
 FOUNDATION_API regex_t*
 regex_compile(const char* pattern, size_t length);
 
-/*! Compile (parse) a regular expression into a predefined expression buffer
+/*! Compile (parse) a regular expression into a predefined expression buffer. The expression
+is matched by the backtracking engine only, see #regex_compile
 \param regex Predefined expression buffer
 \param pattern Pattern string
 \param length Length of pattern string
@@ -56,7 +62,9 @@ regex_parse(regex_t* regex, const char* pattern, size_t length);
 
 /*! Match input string with regular expression with optional captures. Note that captures array
 might be modified and contain invalid data even if regex fails. If the regex matches, the
-captures array will contain valid data.
+captures array will contain valid data. The state cache of a compiled expression is used by
+one thread at a time, other threads matching the same expression concurrently use the
+backtracking engine.
 \param regex Compiled expression
 \param input Input string
 \param inlength Length of input string
@@ -11,12 +11,47 @@
  */
 
 #include <foundation/foundation.h>
+#include <foundation/internal.h>
 
 #if FOUNDATION_COMPILER_CLANG
 // We have separate unaligned loads on platforms which requires it
 #pragma clang diagnostic ignored "-Wcast-align"
 #endif
 
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define SHA_X86 1
+#else
+#define SHA_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#define SHA_ARM 1
+#if defined(__ARM_FEATURE_SHA512)
+#define SHA_ARM_SHA512 1
+#else
+#define SHA_ARM_SHA512 0
+#endif
+#else
+#define SHA_ARM 0
+#define SHA_ARM_SHA512 0
+#endif
+
+#if SHA_X86
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#define SHA_TARGET(isa)
+#else
+#include <immintrin.h>
+#define SHA_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+#if SHA_ARM
+#include <arm_neon.h>
+#endif
+
 static const uint32_t K256[64] = {
     0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
     0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
@@ -188,77 +223,726 @@ sha_store64(unsigned char* buffer, uint64_t val) {
 }
 
 static void
-sha256_compress(sha256_t* digest, const unsigned char* buffer) {
+sha256_compress_generic(uint32_t* state, const unsigned char* buffer, size_t blocks) {
 	uint32_t sbox[8];
 	uint32_t wbox[64];
 	uint32_t i;
 
-	for (i = 0; i < 8; i++)
-		sbox[i] = digest->state[i];
+	for (; blocks; --blocks, buffer += 64) {
+		for (i = 0; i < 8; i++)
+			sbox[i] = state[i];
 
-	for (i = 0; i < 16; ++i)
-		wbox[i] = sha_load32(buffer + (4 * i));
+		for (i = 0; i < 16; ++i)
+			wbox[i] = sha_load32(buffer + (4 * i));
 
-	for (i = 16; i < 64; ++i)
-		wbox[i] = gamma1_32(wbox[i - 2]) + wbox[i - 7] + gamma0_32(wbox[i - 15]) + wbox[i - 16];
+		for (i = 16; i < 64; ++i)
+			wbox[i] = gamma1_32(wbox[i - 2]) + wbox[i - 7] + gamma0_32(wbox[i - 15]) + wbox[i - 16];
 
-	for (i = 0; i < 64;) {
-		compress32(wbox, sbox[0], sbox[1], sbox[2], sbox + 3, sbox[4], sbox[5], sbox[6], sbox + 7, i++);
+		for (i = 0; i < 64;) {
+			compress32(wbox, sbox[0], sbox[1], sbox[2], sbox + 3, sbox[4], sbox[5], sbox[6], sbox + 7, i++);
 
-		compress32(wbox, sbox[7], sbox[0], sbox[1], sbox + 2, sbox[3], sbox[4], sbox[5], sbox + 6, i++);
+			compress32(wbox, sbox[7], sbox[0], sbox[1], sbox + 2, sbox[3], sbox[4], sbox[5], sbox + 6, i++);
 
-		compress32(wbox, sbox[6], sbox[7], sbox[0], sbox + 1, sbox[2], sbox[3], sbox[4], sbox + 5, i++);
+			compress32(wbox, sbox[6], sbox[7], sbox[0], sbox + 1, sbox[2], sbox[3], sbox[4], sbox + 5, i++);
 
-		compress32(wbox, sbox[5], sbox[6], sbox[7], sbox + 0, sbox[1], sbox[2], sbox[3], sbox + 4, i++);
+			compress32(wbox, sbox[5], sbox[6], sbox[7], sbox + 0, sbox[1], sbox[2], sbox[3], sbox + 4, i++);
 
-		compress32(wbox, sbox[4], sbox[5], sbox[6], sbox + 7, sbox[0], sbox[1], sbox[2], sbox + 3, i++);
+			compress32(wbox, sbox[4], sbox[5], sbox[6], sbox + 7, sbox[0], sbox[1], sbox[2], sbox + 3, i++);
 
-		compress32(wbox, sbox[3], sbox[4], sbox[5], sbox + 6, sbox[7], sbox[0], sbox[1], sbox + 2, i++);
+			compress32(wbox, sbox[3], sbox[4], sbox[5], sbox + 6, sbox[7], sbox[0], sbox[1], sbox + 2, i++);
 
-		compress32(wbox, sbox[2], sbox[3], sbox[4], sbox + 5, sbox[6], sbox[7], sbox[0], sbox + 1, i++);
+			compress32(wbox, sbox[2], sbox[3], sbox[4], sbox + 5, sbox[6], sbox[7], sbox[0], sbox + 1, i++);
 
-		compress32(wbox, sbox[1], sbox[2], sbox[3], sbox + 4, sbox[5], sbox[6], sbox[7], sbox + 0, i++);
-	}
+			compress32(wbox, sbox[1], sbox[2], sbox[3], sbox + 4, sbox[5], sbox[6], sbox[7], sbox + 0, i++);
+		}
 
-	for (i = 0; i < 8; ++i)
-		digest->state[i] = digest->state[i] + sbox[i];
+		for (i = 0; i < 8; ++i)
+			state[i] = state[i] + sbox[i];
+	}
 }
 
 static void
-sha512_compress(sha512_t* digest, const unsigned char* buffer) {
+sha512_compress_generic(uint64_t* state, const unsigned char* buffer, size_t blocks) {
 	uint64_t sbox[8];
 	uint64_t wbox[80];
 	uint32_t i;
 
-	for (i = 0; i < 8; i++)
-		sbox[i] = digest->state[i];
+	for (; blocks; --blocks, buffer += 128) {
+		for (i = 0; i < 8; i++)
+			sbox[i] = state[i];
+
+		for (i = 0; i < 16; ++i)
+			wbox[i] = sha_load64(buffer + (8 * i));
+
+		for (i = 16; i < 80; ++i)
+			wbox[i] = gamma1_64(wbox[i - 2]) + wbox[i - 7] + gamma0_64(wbox[i - 15]) + wbox[i - 16];
+
+		for (i = 0; i < 80;) {
+			compress64(wbox, sbox[0], sbox[1], sbox[2], sbox + 3, sbox[4], sbox[5], sbox[6], sbox + 7, i++);
+
+			compress64(wbox, sbox[7], sbox[0], sbox[1], sbox + 2, sbox[3], sbox[4], sbox[5], sbox + 6, i++);
+
+			compress64(wbox, sbox[6], sbox[7], sbox[0], sbox + 1, sbox[2], sbox[3], sbox[4], sbox + 5, i++);
+
+			compress64(wbox, sbox[5], sbox[6], sbox[7], sbox + 0, sbox[1], sbox[2], sbox[3], sbox + 4, i++);
+
+			compress64(wbox, sbox[4], sbox[5], sbox[6], sbox + 7, sbox[0], sbox[1], sbox[2], sbox + 3, i++);
+
+			compress64(wbox, sbox[3], sbox[4], sbox[5], sbox + 6, sbox[7], sbox[0], sbox[1], sbox + 2, i++);
+
+			compress64(wbox, sbox[2], sbox[3], sbox[4], sbox + 5, sbox[6], sbox[7], sbox[0], sbox + 1, i++);
+
+			compress64(wbox, sbox[1], sbox[2], sbox[3], sbox + 4, sbox[5], sbox[6], sbox[7], sbox + 0, i++);
+		}
+
+		for (i = 0; i < 8; ++i)
+			state[i] = state[i] + sbox[i];
+	}
+}
+
+#if SHA_X86
+
+// SHA extensions (SHA-NI) process two rounds per sha256rnds2 instruction with the state
+// held as ABEF/CDGH register pairs
+
+#define SHA256_NI_ROUNDS(msg, k)                                                       \
+	tmp = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i*)(const void*)(K256 + k))); \
+	state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);                                 \
+	tmp = _mm_shuffle_epi32(tmp, 0x0E);                                                  \
+	state0 = _mm_sha256rnds2_epu32(state0, state1, tmp)
+
+#define SHA256_NI_SCHEDULE1(prev, cur) prev = _mm_sha256msg1_epu32(prev, cur)
+
+#define SHA256_NI_SCHEDULE2(next, cur, prev) \
+	next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4)), cur)
+
+SHA_TARGET("sha,sse4.1")
+static void
+sha256_compress_shani(uint32_t* state, const unsigned char* buffer, size_t blocks) {
+	const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+	__m128i state0, state1, tmp;
+	__m128i msg0, msg1, msg2, msg3;
+	__m128i abef, cdgh;
+
+	tmp = _mm_loadu_si128((const __m128i*)(const void*)state);
+	state1 = _mm_loadu_si128((const __m128i*)(const void*)(state + 4));
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);
+	state1 = _mm_shuffle_epi32(state1, 0x1B);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+	for (; blocks; --blocks, buffer += 64) {
+		abef = state0;
+		cdgh = state1;
+
+		msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)buffer), byteswap);
+		msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(buffer + 16)), byteswap);
+		msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(buffer + 32)), byteswap);
+		msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(buffer + 48)), byteswap);
+
+		SHA256_NI_ROUNDS(msg0, 0);
+		SHA256_NI_ROUNDS(msg1, 4);
+		SHA256_NI_SCHEDULE1(msg0, msg1);
+		SHA256_NI_ROUNDS(msg2, 8);
+		SHA256_NI_SCHEDULE1(msg1, msg2);
+		SHA256_NI_ROUNDS(msg3, 12);
+		SHA256_NI_SCHEDULE2(msg0, msg3, msg2);
+		SHA256_NI_SCHEDULE1(msg2, msg3);
+		SHA256_NI_ROUNDS(msg0, 16);
+		SHA256_NI_SCHEDULE2(msg1, msg0, msg3);
+		SHA256_NI_SCHEDULE1(msg3, msg0);
+		SHA256_NI_ROUNDS(msg1, 20);
+		SHA256_NI_SCHEDULE2(msg2, msg1, msg0);
+		SHA256_NI_SCHEDULE1(msg0, msg1);
+		SHA256_NI_ROUNDS(msg2, 24);
+		SHA256_NI_SCHEDULE2(msg3, msg2, msg1);
+		SHA256_NI_SCHEDULE1(msg1, msg2);
+		SHA256_NI_ROUNDS(msg3, 28);
+		SHA256_NI_SCHEDULE2(msg0, msg3, msg2);
+		SHA256_NI_SCHEDULE1(msg2, msg3);
+		SHA256_NI_ROUNDS(msg0, 32);
+		SHA256_NI_SCHEDULE2(msg1, msg0, msg3);
+		SHA256_NI_SCHEDULE1(msg3, msg0);
+		SHA256_NI_ROUNDS(msg1, 36);
+		SHA256_NI_SCHEDULE2(msg2, msg1, msg0);
+		SHA256_NI_SCHEDULE1(msg0, msg1);
+		SHA256_NI_ROUNDS(msg2, 40);
+		SHA256_NI_SCHEDULE2(msg3, msg2, msg1);
+		SHA256_NI_SCHEDULE1(msg1, msg2);
+		SHA256_NI_ROUNDS(msg3, 44);
+		SHA256_NI_SCHEDULE2(msg0, msg3, msg2);
+		SHA256_NI_SCHEDULE1(msg2, msg3);
+		SHA256_NI_ROUNDS(msg0, 48);
+		SHA256_NI_SCHEDULE2(msg1, msg0, msg3);
+		SHA256_NI_SCHEDULE1(msg3, msg0);
+		SHA256_NI_ROUNDS(msg1, 52);
+		SHA256_NI_SCHEDULE2(msg2, msg1, msg0);
+		SHA256_NI_ROUNDS(msg2, 56);
+		SHA256_NI_SCHEDULE2(msg3, msg2, msg1);
+		SHA256_NI_ROUNDS(msg3, 60);
+
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+	_mm_storeu_si128((__m128i*)(void*)state, state0);
+	_mm_storeu_si128((__m128i*)(void*)(state + 4), state1);
+}
+
+#undef SHA256_NI_ROUNDS
+#undef SHA256_NI_SCHEDULE1
+#undef SHA256_NI_SCHEDULE2
+
+SHA_TARGET("avx2")
+static FOUNDATION_FORCEINLINE __m256i
+sha512_avx2_rotr(__m256i x, int bits) {
+	return _mm256_or_si256(_mm256_srli_epi64(x, bits), _mm256_slli_epi64(x, 64 - bits));
+}
+
+SHA_TARGET("avx2")
+static FOUNDATION_FORCEINLINE __m128i
+sha512_avx2_gamma1(__m128i x) {
+	__m128i r19 = _mm_or_si128(_mm_srli_epi64(x, 19), _mm_slli_epi64(x, 45));
+	__m128i r61 = _mm_or_si128(_mm_srli_epi64(x, 61), _mm_slli_epi64(x, 3));
+	return _mm_xor_si128(_mm_xor_si128(r19, r61), _mm_srli_epi64(x, 6));
+}
+
+// The message schedule is computed four words at a time in 256-bit registers, only the
+// gamma1 term depends on the two previous words and is computed in two 128-bit halves.
+// Rounds are scalar, reading the precomputed schedule with round constants added.
+SHA_TARGET("avx2")
+static void
+sha512_compress_avx2(uint64_t* state, const unsigned char* buffer, size_t blocks) {
+	const __m256i byteswap = _mm256_set_epi64x(0x08090a0b0c0d0e0fLL, 0x0001020304050607LL, 0x08090a0b0c0d0e0fLL,
+	                                           0x0001020304050607LL);
+	FOUNDATION_ALIGN(32) uint64_t wkbox[80];
+	__m256i wbox[4];
+	uint64_t sbox[8];
+	uint64_t t0, t1;
+	uint32_t i;
+
+	for (; blocks; --blocks, buffer += 128) {
+		for (i = 0; i < 4; ++i) {
+			wbox[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(const void*)(buffer + (32 * i))),
+			                              byteswap);
+			_mm256_store_si256((__m256i*)(void*)(wkbox + (4 * i)),
+			                   _mm256_add_epi64(wbox[i], _mm256_loadu_si256((const __m256i*)(const void*)(K512 + (4 * i)))));
+		}
 
-	for (i = 0; i < 16; ++i)
-		wbox[i] = sha_load64(buffer + (8 * i));
+		for (i = 16; i < 80; i += 4) {
+			// w[i-15..i-12] and w[i-7..i-4] straddle two registers
+			__m256i w15 = _mm256_alignr_epi8(_mm256_permute2x128_si256(wbox[0], wbox[1], 0x21), wbox[0], 8);
+			__m256i w7 = _mm256_alignr_epi8(_mm256_permute2x128_si256(wbox[2], wbox[3], 0x21), wbox[2], 8);
+			__m256i gamma0 = _mm256_xor_si256(_mm256_xor_si256(sha512_avx2_rotr(w15, 1), sha512_avx2_rotr(w15, 8)),
+			                                  _mm256_srli_epi64(w15, 7));
+			__m256i partial = _mm256_add_epi64(_mm256_add_epi64(wbox[0], w7), gamma0);
+			__m128i lo = _mm_add_epi64(_mm256_castsi256_si128(partial),
+			                           sha512_avx2_gamma1(_mm256_extracti128_si256(wbox[3], 1)));
+			__m128i hi = _mm_add_epi64(_mm256_extracti128_si256(partial, 1), sha512_avx2_gamma1(lo));
+			wbox[0] = wbox[1];
+			wbox[1] = wbox[2];
+			wbox[2] = wbox[3];
+			wbox[3] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+			_mm256_store_si256((__m256i*)(void*)(wkbox + i),
+			                   _mm256_add_epi64(wbox[3], _mm256_loadu_si256((const __m256i*)(const void*)(K512 + i))));
+		}
 
-	for (i = 16; i < 80; ++i)
-		wbox[i] = gamma1_64(wbox[i - 2]) + wbox[i - 7] + gamma0_64(wbox[i - 15]) + wbox[i - 16];
+		for (i = 0; i < 8; i++)
+			sbox[i] = state[i];
+
+		for (i = 0; i < 80; ++i) {
+			t0 = sbox[7] + sigma1_64(sbox[4]) + choise64(sbox[4], sbox[5], sbox[6]) + wkbox[i];
+			t1 = sigma0_64(sbox[0]) + majority64(sbox[0], sbox[1], sbox[2]);
+			sbox[7] = sbox[6];
+			sbox[6] = sbox[5];
+			sbox[5] = sbox[4];
+			sbox[4] = sbox[3] + t0;
+			sbox[3] = sbox[2];
+			sbox[2] = sbox[1];
+			sbox[1] = sbox[0];
+			sbox[0] = t0 + t1;
+		}
 
-	for (i = 0; i < 80;) {
-		compress64(wbox, sbox[0], sbox[1], sbox[2], sbox + 3, sbox[4], sbox[5], sbox[6], sbox + 7, i++);
+		for (i = 0; i < 8; ++i)
+			state[i] = state[i] + sbox[i];
+	}
+}
 
-		compress64(wbox, sbox[7], sbox[0], sbox[1], sbox + 2, sbox[3], sbox[4], sbox[5], sbox + 6, i++);
+#endif
 
-		compress64(wbox, sbox[6], sbox[7], sbox[0], sbox + 1, sbox[2], sbox[3], sbox[4], sbox + 5, i++);
+#if SHA_ARM
 
-		compress64(wbox, sbox[5], sbox[6], sbox[7], sbox + 0, sbox[1], sbox[2], sbox[3], sbox + 4, i++);
+// ARMv8 cryptography extensions, four rounds per sha256h/sha256h2 pair
 
-		compress64(wbox, sbox[4], sbox[5], sbox[6], sbox + 7, sbox[0], sbox[1], sbox[2], sbox + 3, i++);
+#define SHA256_ARM_ROUNDS(msg, k)                  \
+	tmp = vaddq_u32(msg, vld1q_u32(K256 + k));     \
+	prev = state0;                                 \
+	state0 = vsha256hq_u32(state0, state1, tmp);   \
+	state1 = vsha256h2q_u32(state1, prev, tmp)
 
-		compress64(wbox, sbox[3], sbox[4], sbox[5], sbox + 6, sbox[7], sbox[0], sbox[1], sbox + 2, i++);
+#define SHA256_ARM_SCHEDULE(msg, next0, next1, next2) msg = vsha256su1q_u32(vsha256su0q_u32(msg, next0), next1, next2)
 
-		compress64(wbox, sbox[2], sbox[3], sbox[4], sbox + 5, sbox[6], sbox[7], sbox[0], sbox + 1, i++);
+static void
+sha256_compress_arm(uint32_t* state, const unsigned char* buffer, size_t blocks) {
+	uint32x4_t state0 = vld1q_u32(state);
+	uint32x4_t state1 = vld1q_u32(state + 4);
+	uint32x4_t msg0, msg1, msg2, msg3;
+	uint32x4_t save0, save1, prev, tmp;
+
+	for (; blocks; --blocks, buffer += 64) {
+		save0 = state0;
+		save1 = state1;
+
+		msg0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buffer)));
+		msg1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buffer + 16)));
+		msg2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buffer + 32)));
+		msg3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buffer + 48)));
+
+		for (uint32_t k = 0; k < 48; k += 16) {
+			SHA256_ARM_ROUNDS(msg0, k);
+			SHA256_ARM_SCHEDULE(msg0, msg1, msg2, msg3);
+			SHA256_ARM_ROUNDS(msg1, k + 4);
+			SHA256_ARM_SCHEDULE(msg1, msg2, msg3, msg0);
+			SHA256_ARM_ROUNDS(msg2, k + 8);
+			SHA256_ARM_SCHEDULE(msg2, msg3, msg0, msg1);
+			SHA256_ARM_ROUNDS(msg3, k + 12);
+			SHA256_ARM_SCHEDULE(msg3, msg0, msg1, msg2);
+		}
+		SHA256_ARM_ROUNDS(msg0, 48);
+		SHA256_ARM_ROUNDS(msg1, 52);
+		SHA256_ARM_ROUNDS(msg2, 56);
+		SHA256_ARM_ROUNDS(msg3, 60);
 
-		compress64(wbox, sbox[1], sbox[2], sbox[3], sbox + 4, sbox[5], sbox[6], sbox[7], sbox + 0, i++);
+		state0 = vaddq_u32(state0, save0);
+		state1 = vaddq_u32(state1, save1);
 	}
 
+	vst1q_u32(state, state0);
+	vst1q_u32(state + 4, state1);
+}
+
+#undef SHA256_ARM_ROUNDS
+#undef SHA256_ARM_SCHEDULE
+
+#if SHA_ARM_SHA512
+
+// ARMv8.2 SHA-512 extensions, two rounds per sha512h/sha512h2 pair. The state register
+// roles rotate every two rounds, see sha512_compress_arm for the call sequence
+
+#define SHA512_ARM_ROUNDS(msg, k, ab, cd, ef, gh)                                              \
+	sum = vaddq_u64(msg, vld1q_u64(K512 + k));                                                 \
+	sum = vaddq_u64(vextq_u64(sum, sum, 1), gh);                                               \
+	intermed = vsha512hq_u64(sum, vextq_u64(ef, gh, 1), vextq_u64(cd, ef, 1));                 \
+	gh = vsha512h2q_u64(intermed, cd, ab);                                                     \
+	cd = vaddq_u64(cd, intermed)
+
+#define SHA512_ARM_SCHEDULE(msg, next, prev, far0, far1) \
+	msg = vsha512su1q_u64(vsha512su0q_u64(msg, next), prev, vextq_u64(far0, far1, 1))
+
+static void
+sha512_compress_arm(uint64_t* state, const unsigned char* buffer, size_t blocks) {
+	uint64x2_t ab = vld1q_u64(state);
+	uint64x2_t cd = vld1q_u64(state + 2);
+	uint64x2_t ef = vld1q_u64(state + 4);
+	uint64x2_t gh = vld1q_u64(state + 6);
+	uint64x2_t save_ab, save_cd, save_ef, save_gh;
+	uint64x2_t s0, s1, s2, s3, s4, s5, s6, s7;
+	uint64x2_t sum, intermed;
+
+	for (; blocks; --blocks, buffer += 128) {
+		save_ab = ab;
+		save_cd = cd;
+		save_ef = ef;
+		save_gh = gh;
+
+		s0 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer)));
+		s1 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 16)));
+		s2 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 32)));
+		s3 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 48)));
+		s4 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 64)));
+		s5 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 80)));
+		s6 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 96)));
+		s7 = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buffer + 112)));
+
+		SHA512_ARM_ROUNDS(s0, 0, ab, cd, ef, gh);
+		SHA512_ARM_ROUNDS(s1, 2, gh, ab, cd, ef);
+		SHA512_ARM_ROUNDS(s2, 4, ef, gh, ab, cd);
+		SHA512_ARM_ROUNDS(s3, 6, cd, ef, gh, ab);
+		SHA512_ARM_ROUNDS(s4, 8, ab, cd, ef, gh);
+		SHA512_ARM_ROUNDS(s5, 10, gh, ab, cd, ef);
+		SHA512_ARM_ROUNDS(s6, 12, ef, gh, ab, cd);
+		SHA512_ARM_ROUNDS(s7, 14, cd, ef, gh, ab);
+
+		for (uint32_t k = 16; k < 80; k += 16) {
+			SHA512_ARM_SCHEDULE(s0, s1, s7, s4, s5);
+			SHA512_ARM_ROUNDS(s0, k, ab, cd, ef, gh);
+			SHA512_ARM_SCHEDULE(s1, s2, s0, s5, s6);
+			SHA512_ARM_ROUNDS(s1, k + 2, gh, ab, cd, ef);
+			SHA512_ARM_SCHEDULE(s2, s3, s1, s6, s7);
+			SHA512_ARM_ROUNDS(s2, k + 4, ef, gh, ab, cd);
+			SHA512_ARM_SCHEDULE(s3, s4, s2, s7, s0);
+			SHA512_ARM_ROUNDS(s3, k + 6, cd, ef, gh, ab);
+			SHA512_ARM_SCHEDULE(s4, s5, s3, s0, s1);
+			SHA512_ARM_ROUNDS(s4, k + 8, ab, cd, ef, gh);
+			SHA512_ARM_SCHEDULE(s5, s6, s4, s1, s2);
+			SHA512_ARM_ROUNDS(s5, k + 10, gh, ab, cd, ef);
+			SHA512_ARM_SCHEDULE(s6, s7, s5, s2, s3);
+			SHA512_ARM_ROUNDS(s6, k + 12, ef, gh, ab, cd);
+			SHA512_ARM_SCHEDULE(s7, s0, s6, s3, s4);
+			SHA512_ARM_ROUNDS(s7, k + 14, cd, ef, gh, ab);
+		}
+
+		ab = vaddq_u64(ab, save_ab);
+		cd = vaddq_u64(cd, save_cd);
+		ef = vaddq_u64(ef, save_ef);
+		gh = vaddq_u64(gh, save_gh);
+	}
+
+	vst1q_u64(state, ab);
+	vst1q_u64(state + 2, cd);
+	vst1q_u64(state + 4, ef);
+	vst1q_u64(state + 6, gh);
+}
+
+#undef SHA512_ARM_ROUNDS
+#undef SHA512_ARM_SCHEDULE
+
+#endif
+
+#endif
+
+// Multi-buffer SHA-256, running independent messages in SIMD lanes. Each register holds the
+// same state or message word for all lanes, blocks are transposed on load
+
+#define SHA256_MULTI_MAX_LANES 16
+
+#define SHA256_MULTI_ROTR(op, x, n) op##ROTR(x, n)
+#define SHA256_MULTI_SIGMA0(op, x) \
+	op##XOR3(SHA256_MULTI_ROTR(op, x, 2), SHA256_MULTI_ROTR(op, x, 13), SHA256_MULTI_ROTR(op, x, 22))
+#define SHA256_MULTI_SIGMA1(op, x) \
+	op##XOR3(SHA256_MULTI_ROTR(op, x, 6), SHA256_MULTI_ROTR(op, x, 11), SHA256_MULTI_ROTR(op, x, 25))
+#define SHA256_MULTI_GAMMA0(op, x) op##XOR3(SHA256_MULTI_ROTR(op, x, 7), SHA256_MULTI_ROTR(op, x, 18), op##SRL(x, 3))
+#define SHA256_MULTI_GAMMA1(op, x) \
+	op##XOR3(SHA256_MULTI_ROTR(op, x, 17), SHA256_MULTI_ROTR(op, x, 19), op##SRL(x, 10))
+
+#define SHA256_MULTI_SCHEDULE(op, w, i)                                                           \
+	(w)[(i)&15] = op##ADD(op##ADD(SHA256_MULTI_GAMMA1(op, (w)[((i)-2) & 15]), (w)[((i)-7) & 15]), \
+	                      op##ADD(SHA256_MULTI_GAMMA0(op, (w)[((i)-15) & 15]), (w)[(i)&15]))
+
+#define SHA256_MULTI_ROUND(op, w, a, b, c, d, e, f, g, h, i)                             \
+	t0 = op##ADD(op##ADD(h, SHA256_MULTI_SIGMA1(op, e)),                                 \
+	             op##ADD(op##CHOISE(e, f, g), op##ADD(op##SET1(K256[i]), (w)[(i)&15]))); \
+	t1 = op##ADD(SHA256_MULTI_SIGMA0(op, a), op##MAJORITY(a, b, c));                     \
+	(d) = op##ADD(d, t0);                                                                \
+	(h) = op##ADD(t0, t1)
+
+#define SHA256_MULTI_ROUNDS(op, w, s)                                                     \
+	for (i = 0; i < 64; i += 8) {                                                         \
+		if (i >= 16) {                                                                    \
+			for (j = 0; j < 8; ++j)                                                       \
+				SHA256_MULTI_SCHEDULE(op, w, i + j);                                      \
+		}                                                                                 \
+		SHA256_MULTI_ROUND(op, w, s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], i);     \
+		SHA256_MULTI_ROUND(op, w, s[7], s[0], s[1], s[2], s[3], s[4], s[5], s[6], i + 1); \
+		SHA256_MULTI_ROUND(op, w, s[6], s[7], s[0], s[1], s[2], s[3], s[4], s[5], i + 2); \
+		SHA256_MULTI_ROUND(op, w, s[5], s[6], s[7], s[0], s[1], s[2], s[3], s[4], i + 3); \
+		SHA256_MULTI_ROUND(op, w, s[4], s[5], s[6], s[7], s[0], s[1], s[2], s[3], i + 4); \
+		SHA256_MULTI_ROUND(op, w, s[3], s[4], s[5], s[6], s[7], s[0], s[1], s[2], i + 5); \
+		SHA256_MULTI_ROUND(op, w, s[2], s[3], s[4], s[5], s[6], s[7], s[0], s[1], i + 6); \
+		SHA256_MULTI_ROUND(op, w, s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[0], i + 7); \
+	}
+
+#if SHA_X86
+
+#define SHA256_SSE_ADD(a, b) _mm_add_epi32(a, b)
+#define SHA256_SSE_SET1(t) _mm_set1_epi32((int)(t))
+#define SHA256_SSE_SRL(a, n) _mm_srli_epi32(a, n)
+#define SHA256_SSE_ROTR(a, n) _mm_or_si128(_mm_srli_epi32(a, n), _mm_slli_epi32(a, 32 - (n)))
+#define SHA256_SSE_XOR3(a, b, c) _mm_xor_si128(_mm_xor_si128(a, b), c)
+#define SHA256_SSE_CHOISE(x, y, z) _mm_xor_si128(_mm_and_si128(x, y), _mm_andnot_si128(x, z))
+#define SHA256_SSE_MAJORITY(x, y, z) _mm_or_si128(_mm_and_si128(x, y), _mm_and_si128(z, _mm_or_si128(x, y)))
+
+#define SHA256_AVX2_ADD(a, b) _mm256_add_epi32(a, b)
+#define SHA256_AVX2_SET1(t) _mm256_set1_epi32((int)(t))
+#define SHA256_AVX2_SRL(a, n) _mm256_srli_epi32(a, n)
+#define SHA256_AVX2_ROTR(a, n) _mm256_or_si256(_mm256_srli_epi32(a, n), _mm256_slli_epi32(a, 32 - (n)))
+#define SHA256_AVX2_XOR3(a, b, c) _mm256_xor_si256(_mm256_xor_si256(a, b), c)
+#define SHA256_AVX2_CHOISE(x, y, z) _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
+#define SHA256_AVX2_MAJORITY(x, y, z) \
+	_mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)))
+
+// AVX-512 has native rotates and three-input logic (truth tables for xor, select and majority)
+#define SHA256_AVX512_ADD(a, b) _mm512_add_epi32(a, b)
+#define SHA256_AVX512_SET1(t) _mm512_set1_epi32((int)(t))
+#define SHA256_AVX512_SRL(a, n) _mm512_srli_epi32(a, n)
+#define SHA256_AVX512_ROTR(a, n) _mm512_ror_epi32(a, n)
+#define SHA256_AVX512_XOR3(a, b, c) _mm512_ternarylogic_epi32(a, b, c, 0x96)
+#define SHA256_AVX512_CHOISE(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0xCA)
+#define SHA256_AVX512_MAJORITY(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0xE8)
+
+SHA_TARGET("ssse3")
+static void
+sha256_transform_multi_sse(uint32_t* state, const unsigned char** block) {
+	const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+	__m128i s[8], w[16];
+	__m128i t0, t1;
+	size_t i, j;
+
+	for (i = 0; i < 8; ++i)
+		s[i] = _mm_loadu_si128((const __m128i*)(const void*)(state + (4 * i)));
+
+	for (i = 0; i < 4; ++i) {
+		__m128i r[4];
+		for (j = 0; j < 4; ++j)
+			r[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(block[j] + (16 * i))), byteswap);
+		t0 = _mm_unpacklo_epi32(r[0], r[1]);
+		t1 = _mm_unpackhi_epi32(r[0], r[1]);
+		__m128i t2 = _mm_unpacklo_epi32(r[2], r[3]);
+		__m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+		w[(4 * i) + 0] = _mm_unpacklo_epi64(t0, t2);
+		w[(4 * i) + 1] = _mm_unpackhi_epi64(t0, t2);
+		w[(4 * i) + 2] = _mm_unpacklo_epi64(t1, t3);
+		w[(4 * i) + 3] = _mm_unpackhi_epi64(t1, t3);
+	}
+
+	SHA256_MULTI_ROUNDS(SHA256_SSE_, w, s);
+
+	for (i = 0; i < 8; ++i) {
+		__m128i* dst = (__m128i*)(void*)(state + (4 * i));
+		_mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), s[i]));
+	}
+}
+
+SHA_TARGET("avx2")
+static void
+sha256_transform_multi_avx2(uint32_t* state, const unsigned char** block) {
+	const __m256i byteswap = _mm256_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL, 0x0c0d0e0f08090a0bLL,
+	                                           0x0405060700010203LL);
+	__m256i s[8], w[16];
+	__m256i t0, t1;
+	size_t i, j;
+
+	for (i = 0; i < 8; ++i)
+		s[i] = _mm256_loadu_si256((const __m256i*)(const void*)(state + (8 * i)));
+
+	// Lane n in low half and lane n + 4 in high half of each row, transpose per 128-bit half
+	for (i = 0; i < 4; ++i) {
+		__m256i r[4];
+		for (j = 0; j < 4; ++j) {
+			__m256i row = _mm256_inserti128_si256(
+			    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(const void*)(block[j] + (16 * i)))),
+			    _mm_loadu_si128((const __m128i*)(const void*)(block[j + 4] + (16 * i))), 1);
+			r[j] = _mm256_shuffle_epi8(row, byteswap);
+		}
+		t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+		t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+		__m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+		__m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+		w[(4 * i) + 0] = _mm256_unpacklo_epi64(t0, t2);
+		w[(4 * i) + 1] = _mm256_unpackhi_epi64(t0, t2);
+		w[(4 * i) + 2] = _mm256_unpacklo_epi64(t1, t3);
+		w[(4 * i) + 3] = _mm256_unpackhi_epi64(t1, t3);
+	}
+
+	SHA256_MULTI_ROUNDS(SHA256_AVX2_, w, s);
+
+	for (i = 0; i < 8; ++i) {
+		__m256i* dst = (__m256i*)(void*)(state + (8 * i));
+		_mm256_storeu_si256(dst, _mm256_add_epi32(_mm256_loadu_si256(dst), s[i]));
+	}
+}
+
+SHA_TARGET("avx512f,avx512bw")
+static void
+sha256_transform_multi_avx512(uint32_t* state, const unsigned char** block) {
+	const __m512i byteswap = _mm512_broadcast_i32x4(_mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL));
+	__m512i s[8], w[16];
+	__m512i t0, t1;
+	size_t i, j;
+
 	for (i = 0; i < 8; ++i)
-		digest->state[i] = digest->state[i] + sbox[i];
+		s[i] = _mm512_loadu_si512((const void*)(state + (16 * i)));
+
+	// Lanes n, n + 4, n + 8 and n + 12 in the four 128-bit quarters of each row
+	for (i = 0; i < 4; ++i) {
+		__m512i r[4];
+		for (j = 0; j < 4; ++j) {
+			__m512i row = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(const void*)(block[j] + (16 * i))));
+			row = _mm512_inserti32x4(row, _mm_loadu_si128((const __m128i*)(const void*)(block[j + 4] + (16 * i))), 1);
+			row = _mm512_inserti32x4(row, _mm_loadu_si128((const __m128i*)(const void*)(block[j + 8] + (16 * i))), 2);
+			row = _mm512_inserti32x4(row, _mm_loadu_si128((const __m128i*)(const void*)(block[j + 12] + (16 * i))), 3);
+			r[j] = _mm512_shuffle_epi8(row, byteswap);
+		}
+		t0 = _mm512_unpacklo_epi32(r[0], r[1]);
+		t1 = _mm512_unpackhi_epi32(r[0], r[1]);
+		__m512i t2 = _mm512_unpacklo_epi32(r[2], r[3]);
+		__m512i t3 = _mm512_unpackhi_epi32(r[2], r[3]);
+		w[(4 * i) + 0] = _mm512_unpacklo_epi64(t0, t2);
+		w[(4 * i) + 1] = _mm512_unpackhi_epi64(t0, t2);
+		w[(4 * i) + 2] = _mm512_unpacklo_epi64(t1, t3);
+		w[(4 * i) + 3] = _mm512_unpackhi_epi64(t1, t3);
+	}
+
+	SHA256_MULTI_ROUNDS(SHA256_AVX512_, w, s);
+
+	for (i = 0; i < 8; ++i) {
+		void* dst = state + (16 * i);
+		_mm512_storeu_si512(dst, _mm512_add_epi32(_mm512_loadu_si512(dst), s[i]));
+	}
+}
+
+#endif
+
+typedef void (*sha256_transform_multi_fn)(uint32_t* state, const unsigned char** block);
+
+static sha256_transform_multi_fn sha256_transform_multi;
+static size_t sha256_transform_lanes;
+
+struct sha256_multi_lane_t {
+	//! Message data
+	const unsigned char* data;
+	//! Index of message, or count if lane is idle
+	size_t message;
+	//! Next block to digest
+	size_t block;
+	//! Number of blocks read directly from message data
+	size_t direct;
+	//! Total number of blocks including padding
+	size_t blocks;
+	//! Last partial block and padding
+	unsigned char tail[128];
+};
+
+typedef struct sha256_multi_lane_t sha256_multi_lane_t;
+
+static void
+sha256_multi_lane_assign(sha256_multi_lane_t* lane, uint32_t* state, size_t lanes, size_t message,
+                         const void* buffer, size_t size) {
+	static const uint32_t initial[8] = {0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+	                                    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL};
+	size_t remain = size & 63;
+	size_t iword;
+
+	lane->data = buffer;
+	lane->message = message;
+	lane->block = 0;
+	lane->direct = size / 64;
+	lane->blocks = lane->direct + ((remain < 56) ? 1 : 2);
+
+	memcpy(lane->tail, pointer_offset_const(buffer, size - remain), remain);
+	lane->tail[remain] = 0x80;
+	memset(lane->tail + remain + 1, 0, sizeof(lane->tail) - (remain + 1));
+	sha_store64(lane->tail + ((lane->blocks - lane->direct) * 64) - 8, (uint64_t)size * 8);
+
+	for (iword = 0; iword < 8; ++iword)
+		state[iword * lanes] = initial[iword];
+}
+
+static void
+sha256_digest_multi_lanes(const void* const* buffers, const size_t* sizes, size_t count, uint256_t* digests) {
+	static const unsigned char idle_block[64] = {0};
+	const size_t lanes = sha256_transform_lanes;
+	sha256_multi_lane_t lane[SHA256_MULTI_MAX_LANES];
+	uint32_t state[8 * SHA256_MULTI_MAX_LANES];
+	const unsigned char* block[SHA256_MULTI_MAX_LANES];
+	size_t next = 0;
+	size_t active = 0;
+	size_t ilane;
+
+	for (ilane = 0; ilane < lanes; ++ilane) {
+		lane[ilane].message = count;
+		if (next < count) {
+			sha256_multi_lane_assign(lane + ilane, state + ilane, lanes, next, buffers[next], sizes[next]);
+			++next;
+			++active;
+		}
+	}
+
+	while (active) {
+		for (ilane = 0; ilane < lanes; ++ilane) {
+			const sha256_multi_lane_t* current = lane + ilane;
+			if (current->message == count)
+				block[ilane] = idle_block;
+			else if (current->block < current->direct)
+				block[ilane] = current->data + (current->block * 64);
+			else
+				block[ilane] = current->tail + ((current->block - current->direct) * 64);
+		}
+
+		sha256_transform_multi(state, block);
+
+		for (ilane = 0; ilane < lanes; ++ilane) {
+			sha256_multi_lane_t* current = lane + ilane;
+			if ((current->message == count) || (++current->block < current->blocks))
+				continue;
+
+			uint256_t* digest = digests + current->message;
+			for (size_t iword = 0; iword < 4; ++iword)
+				digest->word[iword] = ((uint64_t)state[(2 * iword * lanes) + ilane] << 32ULL) |
+				                      (uint64_t)state[(((2 * iword) + 1) * lanes) + ilane];
+
+			if (next < count) {
+				sha256_multi_lane_assign(current, state + ilane, lanes, next, buffers[next], sizes[next]);
+				++next;
+			} else {
+				current->message = count;
+				--active;
+			}
+		}
+	}
+}
+
+typedef void (*sha256_compress_fn)(uint32_t* state, const unsigned char* buffer, size_t blocks);
+typedef void (*sha512_compress_fn)(uint64_t* state, const unsigned char* buffer, size_t blocks);
+
+static sha256_compress_fn sha256_compress;
+static sha512_compress_fn sha512_compress;
+
+//! Select compression functions from CPU features detected at runtime. Resolving is
+//! idempotent, concurrent calls store the same function pointers
+void
+internal_sha_resolve(void) {
+	sha256_compress_fn compress256 = sha256_compress_generic;
+	sha512_compress_fn compress512 = sha512_compress_generic;
+	sha256_transform_multi_fn transform_multi = 0;
+	size_t lanes = 1;
+#if SHA_X86
+	if (system_cpu_has_feature(CPU_FEATURE_SHA | CPU_FEATURE_SSE41))
+		compress256 = sha256_compress_shani;
+	if (system_cpu_has_feature(CPU_FEATURE_AVX2))
+		compress512 = sha512_compress_avx2;
+	if (system_cpu_has_feature(CPU_FEATURE_AVX512F | CPU_FEATURE_AVX512BW)) {
+		transform_multi = sha256_transform_multi_avx512;
+		lanes = 16;
+	} else if (system_cpu_has_feature(CPU_FEATURE_AVX2)) {
+		transform_multi = sha256_transform_multi_avx2;
+		lanes = 8;
+	} else if (system_cpu_has_feature(CPU_FEATURE_SSSE3)) {
+		transform_multi = sha256_transform_multi_sse;
+		lanes = 4;
+	}
+	// Single stream SHA extensions outperform all but the 16 lane implementation
+	if ((compress256 == sha256_compress_shani) && (lanes < 16)) {
+		transform_multi = 0;
+		lanes = 1;
+	}
+#elif SHA_ARM
+	if (system_cpu_has_feature(CPU_FEATURE_SHA))
+		compress256 = sha256_compress_arm;
+#if SHA_ARM_SHA512
+	if (system_cpu_has_feature(CPU_FEATURE_SHA512))
+		compress512 = sha512_compress_arm;
+#endif
+#endif
+	sha256_transform_multi = transform_multi;
+	sha256_transform_lanes = lanes;
+	sha512_compress = compress512;
+	sha256_compress = compress256;
 }
 
 sha256_t*
@@ -276,6 +960,8 @@ sha256_deallocate(sha256_t* digest) {
 
 void
 sha256_initialize(sha256_t* digest) {
+	if (!sha256_compress)
+		internal_sha_resolve();
 	digest->init = false;
 	digest->current = 0;
 	digest->length = 0;
@@ -310,17 +996,18 @@ sha256_digest(sha256_t* digest, const void* buffer, size_t size) {
 		size -= this_block;
 
 		if (digest->current == block_size) {
-			sha256_compress(digest, digest->buffer);
+			sha256_compress(digest->state, digest->buffer, 1);
 			digest->length += block_size * 8;
 			digest->current = 0;
 		}
 	}
 
-	while (size >= block_size) {
-		sha256_compress(digest, buffer);
-		digest->length += block_size * 8;
-		buffer = pointer_offset_const(buffer, block_size);
-		size -= block_size;
+	if (size >= block_size) {
+		size_t blocks = size / block_size;
+		sha256_compress(digest->state, buffer, blocks);
+		digest->length += blocks * block_size * 8;
+		buffer = pointer_offset_const(buffer, blocks * block_size);
+		size -= blocks * block_size;
 	}
 
 	if (size) {
@@ -340,7 +1027,7 @@ sha256_digest_finalize(sha256_t* digest) {
 	if (digest->current > 56) {
 		while (digest->current < 64)
 			digest->buffer[digest->current++] = 0;
-		sha256_compress(digest, digest->buffer);
+		sha256_compress(digest->state, digest->buffer, 1);
 		digest->current = 0;
 	}
 
@@ -348,7 +1035,7 @@ sha256_digest_finalize(sha256_t* digest) {
 		memset(digest->buffer + digest->current, 0, 56 - digest->current);
 
 	sha_store64(digest->buffer + 56, digest->length);
-	sha256_compress(digest, digest->buffer);
+	sha256_compress(digest->state, digest->buffer, 1);
 
 	digest->init = true;
 }
@@ -368,6 +1055,26 @@ sha256_get_digest(const sha256_t* digest, char* str, size_t length) {
 	return string_from_uint256(str, length, raw);
 }
 
+void
+sha256_digest_multi(const void* const* buffers, const size_t* sizes, size_t count, uint256_t* digests) {
+	if (!sha256_compress)
+		internal_sha_resolve();
+
+	if (sha256_transform_multi && (count > 1)) {
+		sha256_digest_multi_lanes(buffers, sizes, count, digests);
+		return;
+	}
+
+	for (size_t imsg = 0; imsg < count; ++imsg) {
+		sha256_t sha;
+		sha256_initialize(&sha);
+		sha256_digest(&sha, buffers[imsg], sizes[imsg]);
+		sha256_digest_finalize(&sha);
+		digests[imsg] = sha256_get_digest_raw(&sha);
+		sha256_finalize(&sha);
+	}
+}
+
 sha512_t*
 sha512_allocate(void) {
 	sha512_t* digest = memory_allocate(0, sizeof(sha512_t), 0, MEMORY_PERSISTENT);
@@ -383,6 +1090,8 @@ sha512_deallocate(sha512_t* digest) {
 
 void
 sha512_initialize(sha512_t* digest) {
+	if (!sha512_compress)
+		internal_sha_resolve();
 	digest->init = false;
 	digest->current = 0;
 	digest->length = 0;
@@ -417,17 +1126,18 @@ sha512_digest(sha512_t* digest, const void* buffer, size_t size) {
 		size -= this_block;
 
 		if (digest->current == block_size) {
-			sha512_compress(digest, digest->buffer);
+			sha512_compress(digest->state, digest->buffer, 1);
 			digest->length += block_size * 8;
 			digest->current = 0;
 		}
 	}
 
-	while (size >= block_size) {
-		sha512_compress(digest, buffer);
-		digest->length += block_size * 8;
-		buffer = pointer_offset_const(buffer, block_size);
-		size -= block_size;
+	if (size >= block_size) {
+		size_t blocks = size / block_size;
+		sha512_compress(digest->state, buffer, blocks);
+		digest->length += blocks * block_size * 8;
+		buffer = pointer_offset_const(buffer, blocks * block_size);
+		size -= blocks * block_size;
 	}
 
 	if (size) {
@@ -447,7 +1157,7 @@ sha512_digest_finalize(sha512_t* digest) {
 	if (digest->current > 112) {
 		while (digest->current < 128)
 			digest->buffer[digest->current++] = 0;
-		sha512_compress(digest, digest->buffer);
+		sha512_compress(digest->state, digest->buffer, 1);
 		digest->current = 0;
 	}
 
@@ -455,7 +1165,7 @@ sha512_digest_finalize(sha512_t* digest) {
 		memset(digest->buffer + digest->current, 0, 120 - digest->current);
 
 	sha_store64(digest->buffer + 120, digest->length);
-	sha512_compress(digest, digest->buffer);
+	sha512_compress(digest->state, digest->buffer, 1);
 
 	digest->init = true;
 }
@@ -18,6 +18,12 @@
 SHA-2 secure hash algorithm. Inspired by Daniel Andersson's public domain implementation
 available at https://github.com/kalven/sha-2
 
+The block compression function is selected at runtime from the CPU features, using the SHA
+extensions on x86 (SHA-256) and the ARMv8 cryptography extensions (SHA-256, and SHA-512 on
+ARMv8.2 if enabled at compile time). SHA-512 on x86 uses an AVX2 message schedule if available.
+The portable implementation is used on other hardware. Buffers passed to the digest functions
+are compressed in place, without copying full blocks to the internal buffer.
+
 Normal use case is to first allocate/initialize the sha block, then do any number of
 initialize-digest-finalize call sequences:
 
@@ -87,6 +93,17 @@ finalized with a call to #sha256_digest_finalize.
 FOUNDATION_API uint256_t
 sha256_get_digest_raw(const sha256_t* digest);
 
+/*! Digest multiple independent buffers, producing the same digests as digesting each buffer
+separately with #sha256_digest and getting the result with #sha256_get_digest_raw. Buffers are
+digested in parallel in SIMD lanes (4, 8 or 16 depending on CPU features) which is
+considerably faster for large numbers of small buffers.
+\param buffers Array of buffer pointers
+\param sizes Array of buffer sizes
+\param count Number of buffers
+\param digests Array receiving the message digest of each buffer */
+FOUNDATION_API void
+sha256_digest_multi(const void* const* buffers, const size_t* sizes, size_t count, uint256_t* digests);
+
 /*! Allocate a new SHA-512 block and initialize for digestion.
 \return New SHA-512 block */
 FOUNDATION_API sha512_t*
@@ -938,6 +938,10 @@ static void* stream_sha512_digest(void* digest, const void* buffer, size_t size)
     return sha512_digest(digest, buffer, size);
 }
 
+static void* stream_hash_digest(void* digest, const void* buffer, size_t size) {
+    return hash_update(digest, buffer, size);
+}
+
 uint128_t
 stream_md5(stream_t* stream) {
 	md5_t md5;
@@ -992,6 +996,28 @@ stream_sha512(stream_t* stream) {
 	return ret;
 }
 
+hash_t
+stream_hash(stream_t* stream) {
+	hash_state_t state;
+
+	hash_initialize(&state);
+	if (stream_digest(stream, stream_hash_digest, &state))
+		return hash_finalize(&state);
+
+	return 0;
+}
+
+uint128_t
+stream_hash128(stream_t* stream) {
+	hash_state_t state;
+
+	hash_initialize(&state);
+	if (stream_digest(stream, stream_hash_digest, &state))
+		return hash_finalize128(&state);
+
+	return uint128_null();
+}
+
 size_t
 stream_write(stream_t* stream, const void* buffer, size_t size) {
 	if (!(stream->mode & STREAM_OUT))
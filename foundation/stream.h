@@ -454,6 +454,20 @@ UNIX style LF if the stream is in ascii mode.
 FOUNDATION_API uint512_t
 stream_sha512(stream_t* stream);
 
+/*! Read stream hash, same as #hash of the stream content. Line ending will be unified and
+hashed as a UNIX style LF if the stream is in ascii mode.
+\param stream Stream
+\return Hash, 0 if not available for stream type or invalid stream */
+FOUNDATION_API hash_t
+stream_hash(stream_t* stream);
+
+/*! Read stream 128-bit hash, same as #hash128 of the stream content. Line ending will be
+unified and hashed as a UNIX style LF if the stream is in ascii mode.
+\param stream Stream
+\return 128-bit hash, 0 if not available for stream type or invalid stream */
+FOUNDATION_API uint128_t
+stream_hash128(stream_t* stream);
+
 /*! Truncate stream to given size if it is larger, do nothing if smaller or equal in size.
 \param stream Stream
 \param length New length of stream */
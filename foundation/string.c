@@ -11,6 +11,7 @@
  */
 
 #include <foundation/foundation.h>
+#include <foundation/internal.h>
 
 #include <stdio.h>
 #include <stdarg.h>
@@ -22,11 +23,8 @@
 #define vsnprintf(s, n, format, arg) _vsnprintf_s(s, n, _TRUNCATE, format, arg)
 #define sscanf sscanf_s
 #elif FOUNDATION_COMPILER_GCC
-_CRTIMP int __cdecl __MINGW_NOTHROW
-_strnicmp(const char*, const char*, size_t);
 #include <sys/types.h>
 #endif
-#define strncasecmp _strnicmp
 #endif
 
 #include <time.h>
@@ -610,6 +608,1564 @@ string_substr(const char* str, size_t length, size_t offset, size_t sub_length)
 	return string_null();
 }
 
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define STRING_X86 1
+#else
+#define STRING_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && defined(__ARM_NEON)
+#define STRING_ARM 1
+#else
+#define STRING_ARM 0
+#endif
+
+// Minimum number of bytes to scan before the token set is converted to a byte class
+// for the vectorized scanning kernels, shorter scans loop over tokens directly
+#define STRING_SCAN_THRESHOLD 16
+
+static void
+string_class_initialize(string_class_t* byteclass, const char* tokens, size_t token_length) {
+	size_t itoken;
+	memset(byteclass, 0, sizeof(string_class_t));
+	for (itoken = 0; itoken < token_length; ++itoken) {
+		const uint8_t token = (uint8_t)tokens[itoken];
+		const uint8_t bit = (uint8_t)(1U << ((token >> 4) & 7));
+		if (token & 0x80)
+			byteclass->high[token & 0x0F] |= bit;
+		else
+			byteclass->low[token & 0x0F] |= bit;
+	}
+}
+
+static FOUNDATION_FORCEINLINE bool
+string_class_contains(const string_class_t* byteclass, char c) {
+	const uint8_t value = (uint8_t)c;
+	const uint8_t row = (value & 0x80) ? byteclass->high[value & 0x0F] : byteclass->low[value & 0x0F];
+	return (row & (1U << ((value >> 4) & 7))) != 0;
+}
+
+//! Find first offset in [offset,end) with a byte in the class, or not in the class if invert is set
+typedef size_t (*string_find_class_fn)(const char* str, size_t offset, size_t end, const string_class_t* byteclass,
+                                       bool invert);
+
+//! Find last offset in [offset,end) with a byte in the class, or not in the class if invert is set
+typedef size_t (*string_rfind_class_fn)(const char* str, size_t offset, size_t end,
+                                        const string_class_t* byteclass, bool invert);
+
+//! Find last offset in [0,end) with the given character
+typedef size_t (*string_rfind_char_fn)(const char* str, size_t end, char c);
+
+//! Find first offset in [offset,last] where the key matches, key length at least two
+typedef size_t (*string_find_key_fn)(const char* str, size_t offset, size_t last, const char* key,
+                                     size_t key_length);
+
+//! Find last offset in [0,offset] where the key matches, key length at least two
+typedef size_t (*string_rfind_key_fn)(const char* str, size_t offset, const char* key, size_t key_length);
+
+static string_find_class_fn string_find_class;
+static string_rfind_class_fn string_rfind_class;
+static string_rfind_char_fn string_rfind_char;
+static string_find_key_fn string_find_key;
+static string_rfind_key_fn string_rfind_key;
+
+static size_t
+string_find_class_generic(const char* str, size_t offset, size_t end, const string_class_t* byteclass,
+                          bool invert) {
+	for (; offset < end; ++offset) {
+		if (string_class_contains(byteclass, str[offset]) != invert)
+			return offset;
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+string_rfind_class_generic(const char* str, size_t offset, size_t end, const string_class_t* byteclass,
+                           bool invert) {
+	while (end > offset) {
+		--end;
+		if (string_class_contains(byteclass, str[end]) != invert)
+			return end;
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+string_rfind_char_generic(const char* str, size_t end, char c) {
+	while (end) {
+		--end;
+		if (str[end] == c)
+			return end;
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+string_find_key_generic(const char* str, size_t offset, size_t last, const char* key, size_t key_length) {
+	const char* found;
+	do {
+		found = memchr(str + offset, *key, 1 + last - offset);
+		if (!found)
+			break;
+		if (memcmp(found, key, key_length) == 0)
+			return (size_t)pointer_diff(found, str);
+		offset = 1 + (size_t)pointer_diff(found, str);
+	} while (offset <= last);
+	return STRING_NPOS;
+}
+
+static size_t
+string_rfind_key_generic(const char* str, size_t offset, const char* key, size_t key_length) {
+	// Wrap-around terminates
+	while (offset != STRING_NPOS) {
+		if (memcmp(str + offset, key, key_length) == 0)
+			return offset;
+		--offset;
+	}
+	return STRING_NPOS;
+}
+
+#if STRING_X86
+#if FOUNDATION_COMPILER_CLANG
+// Unaligned loads are done with explicit unaligned intrinsics
+#pragma clang diagnostic ignored "-Wcast-align"
+#endif
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#define STRING_TARGET(isa)
+#else
+#include <immintrin.h>
+#define STRING_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Vectorized scanning produces a bitmask with one bit per byte position. Byte classes are
+// matched with two nibble table lookups, indices with the high bit set select zero which
+// separates bytes below and above 128, and a third lookup maps the high nibble to the bit to
+// test in the row. Substring search compares first and last key characters at each candidate
+// position and only verifies the full key at positions where both match, see "SIMD-friendly
+// algorithms for substring searching" by Wojciech Mula. AVX2 kernels hand short ranges to the
+// SSSE3 kernels and clear the upper register state first to avoid AVX to SSE transition penalties
+
+static FOUNDATION_FORCEINLINE unsigned int
+string_bit_first(uint32_t mask) {
+#if FOUNDATION_COMPILER_MSVC
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (unsigned int)index;
+#else
+	return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+static FOUNDATION_FORCEINLINE unsigned int
+string_bit_last(uint32_t mask) {
+#if FOUNDATION_COMPILER_MSVC
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return (unsigned int)index;
+#else
+	return 31U - (unsigned int)__builtin_clz(mask);
+#endif
+}
+
+STRING_TARGET("ssse3")
+static FOUNDATION_FORCEINLINE uint32_t
+string_class_mask_ssse3(__m128i data, __m128i table_low, __m128i table_high, __m128i bits) {
+	const __m128i index_mask = _mm_set1_epi8((char)0x8F);
+	const __m128i index_low = _mm_and_si128(data, index_mask);
+	const __m128i index_high = _mm_and_si128(_mm_xor_si128(data, _mm_set1_epi8((char)0x80)), index_mask);
+	const __m128i row =
+	    _mm_or_si128(_mm_shuffle_epi8(table_low, index_low), _mm_shuffle_epi8(table_high, index_high));
+	const __m128i bit = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(data, 4), _mm_set1_epi8(7)));
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), bit));
+}
+
+STRING_TARGET("ssse3")
+static size_t
+string_find_class_ssse3(const char* str, size_t offset, size_t end, const string_class_t* byteclass, bool invert) {
+	const __m128i table_low = _mm_loadu_si128((const __m128i*)byteclass->low);
+	const __m128i table_high = _mm_loadu_si128((const __m128i*)byteclass->high);
+	const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)0x80, 1, 2, 4, 8, 16, 32, 64, (char)0x80);
+	const uint32_t flip = invert ? 0xFFFF : 0;
+	uint32_t mask;
+	if (end - offset < 16)
+		return string_find_class_generic(str, offset, end, byteclass, invert);
+	for (; offset + 16 <= end; offset += 16) {
+		mask = string_class_mask_ssse3(_mm_loadu_si128((const __m128i*)(str + offset)), table_low, table_high,
+		                               bits) ^
+		       flip;
+		if (mask)
+			return offset + string_bit_first(mask);
+	}
+	if (offset < end) {
+		// Overlapping load of the last full vector, discarding already scanned positions
+		const size_t base = end - 16;
+		mask = string_class_mask_ssse3(_mm_loadu_si128((const __m128i*)(str + base)), table_low, table_high, bits) ^
+		       flip;
+		mask >>= (offset - base);
+		if (mask)
+			return offset + string_bit_first(mask);
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("ssse3")
+static size_t
+string_rfind_class_ssse3(const char* str, size_t offset, size_t end, const string_class_t* byteclass, bool invert) {
+	const __m128i table_low = _mm_loadu_si128((const __m128i*)byteclass->low);
+	const __m128i table_high = _mm_loadu_si128((const __m128i*)byteclass->high);
+	const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)0x80, 1, 2, 4, 8, 16, 32, 64, (char)0x80);
+	const uint32_t flip = invert ? 0xFFFF : 0;
+	uint32_t mask;
+	if (end - offset < 16)
+		return string_rfind_class_generic(str, offset, end, byteclass, invert);
+	for (; end >= offset + 16; end -= 16) {
+		mask = string_class_mask_ssse3(_mm_loadu_si128((const __m128i*)(str + end - 16)), table_low, table_high,
+		                               bits) ^
+		       flip;
+		if (mask)
+			return (end - 16) + string_bit_last(mask);
+	}
+	if (end > offset) {
+		mask = string_class_mask_ssse3(_mm_loadu_si128((const __m128i*)(str + offset)), table_low, table_high,
+		                               bits) ^
+		       flip;
+		mask &= (1U << (end - offset)) - 1;
+		if (mask)
+			return offset + string_bit_last(mask);
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("ssse3")
+static size_t
+string_rfind_char_ssse3(const char* str, size_t end, char c) {
+	const __m128i value = _mm_set1_epi8(c);
+	uint32_t mask;
+	if (end < 16)
+		return string_rfind_char_generic(str, end, c);
+	for (; end >= 16; end -= 16) {
+		mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + end - 16)), value));
+		if (mask)
+			return (end - 16) + string_bit_last(mask);
+	}
+	if (end) {
+		mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)str), value));
+		mask &= (1U << end) - 1;
+		if (mask)
+			return string_bit_last(mask);
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("ssse3")
+static FOUNDATION_FORCEINLINE uint32_t
+string_key_mask_ssse3(const char* str, size_t key_length, __m128i first, __m128i last) {
+	const __m128i block_first = _mm_loadu_si128((const __m128i*)str);
+	const __m128i block_last = _mm_loadu_si128((const __m128i*)(str + key_length - 1));
+	return (uint32_t)_mm_movemask_epi8(
+	    _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+}
+
+STRING_TARGET("ssse3")
+static size_t
+string_find_key_ssse3(const char* str, size_t offset, size_t last, const char* key, size_t key_length) {
+	const __m128i first_char = _mm_set1_epi8(key[0]);
+	const __m128i last_char = _mm_set1_epi8(key[key_length - 1]);
+	uint32_t mask;
+	if (last - offset < 15)
+		return string_find_key_generic(str, offset, last, key, key_length);
+	for (; offset + 15 <= last; offset += 16) {
+		mask = string_key_mask_ssse3(str + offset, key_length, first_char, last_char);
+		while (mask) {
+			const unsigned int bit = string_bit_first(mask);
+			if (memcmp(str + offset + bit + 1, key + 1, key_length - 2) == 0)
+				return offset + bit;
+			mask &= mask - 1;
+		}
+	}
+	if (offset <= last) {
+		const size_t base = last - 15;
+		mask = string_key_mask_ssse3(str + base, key_length, first_char, last_char) >> (offset - base);
+		while (mask) {
+			const unsigned int bit = string_bit_first(mask);
+			if (memcmp(str + offset + bit + 1, key + 1, key_length - 2) == 0)
+				return offset + bit;
+			mask &= mask - 1;
+		}
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("ssse3")
+static size_t
+string_rfind_key_ssse3(const char* str, size_t offset, const char* key, size_t key_length) {
+	const __m128i first_char = _mm_set1_epi8(key[0]);
+	const __m128i last_char = _mm_set1_epi8(key[key_length - 1]);
+	size_t end = offset + 1;
+	uint32_t mask;
+	if (end < 16)
+		return string_rfind_key_generic(str, offset, key, key_length);
+	for (; end >= 16; end -= 16) {
+		mask = string_key_mask_ssse3(str + end - 16, key_length, first_char, last_char);
+		while (mask) {
+			const unsigned int bit = string_bit_last(mask);
+			if (memcmp(str + (end - 16) + bit + 1, key + 1, key_length - 2) == 0)
+				return (end - 16) + bit;
+			mask &= ~(1U << bit);
+		}
+	}
+	if (end) {
+		mask = string_key_mask_ssse3(str, key_length, first_char, last_char) & ((1U << end) - 1);
+		while (mask) {
+			const unsigned int bit = string_bit_last(mask);
+			if (memcmp(str + bit + 1, key + 1, key_length - 2) == 0)
+				return bit;
+			mask &= ~(1U << bit);
+		}
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("avx2")
+static FOUNDATION_FORCEINLINE uint32_t
+string_class_mask_avx2(__m256i data, __m256i table_low, __m256i table_high, __m256i bits) {
+	const __m256i index_mask = _mm256_set1_epi8((char)0x8F);
+	const __m256i index_low = _mm256_and_si256(data, index_mask);
+	const __m256i index_high = _mm256_and_si256(_mm256_xor_si256(data, _mm256_set1_epi8((char)0x80)), index_mask);
+	const __m256i row =
+	    _mm256_or_si256(_mm256_shuffle_epi8(table_low, index_low), _mm256_shuffle_epi8(table_high, index_high));
+	const __m256i bit =
+	    _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(data, 4), _mm256_set1_epi8(7)));
+	return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+}
+
+STRING_TARGET("avx2")
+static size_t
+string_find_class_avx2(const char* str, size_t offset, size_t end, const string_class_t* byteclass, bool invert) {
+	const __m256i table_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)byteclass->low));
+	const __m256i table_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)byteclass->high));
+	const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)0x80, 1, 2, 4, 8, 16, 32, 64, (char)0x80, 1,
+	                                      2, 4, 8, 16, 32, 64, (char)0x80, 1, 2, 4, 8, 16, 32, 64, (char)0x80);
+	const uint32_t flip = invert ? 0xFFFFFFFFU : 0;
+	uint32_t mask;
+	if (end - offset < 32) {
+		_mm256_zeroupper();
+		return string_find_class_ssse3(str, offset, end, byteclass, invert);
+	}
+	for (; offset + 32 <= end; offset += 32) {
+		mask = string_class_mask_avx2(_mm256_loadu_si256((const __m256i*)(str + offset)), table_low, table_high,
+		                              bits) ^
+		       flip;
+		if (mask)
+			return offset + string_bit_first(mask);
+	}
+	if (offset < end) {
+		const size_t base = end - 32;
+		mask = string_class_mask_avx2(_mm256_loadu_si256((const __m256i*)(str + base)), table_low, table_high,
+		                              bits) ^
+		       flip;
+		mask >>= (offset - base);
+		if (mask)
+			return offset + string_bit_first(mask);
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("avx2")
+static size_t
+string_rfind_class_avx2(const char* str, size_t offset, size_t end, const string_class_t* byteclass, bool invert) {
+	const __m256i table_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)byteclass->low));
+	const __m256i table_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)byteclass->high));
+	const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)0x80, 1, 2, 4, 8, 16, 32, 64, (char)0x80, 1,
+	                                      2, 4, 8, 16, 32, 64, (char)0x80, 1, 2, 4, 8, 16, 32, 64, (char)0x80);
+	const uint32_t flip = invert ? 0xFFFFFFFFU : 0;
+	uint32_t mask;
+	if (end - offset < 32) {
+		_mm256_zeroupper();
+		return string_rfind_class_ssse3(str, offset, end, byteclass, invert);
+	}
+	for (; end >= offset + 32; end -= 32) {
+		mask = string_class_mask_avx2(_mm256_loadu_si256((const __m256i*)(str + end - 32)), table_low, table_high,
+		                              bits) ^
+		       flip;
+		if (mask)
+			return (end - 32) + string_bit_last(mask);
+	}
+	if (end > offset) {
+		mask = string_class_mask_avx2(_mm256_loadu_si256((const __m256i*)(str + offset)), table_low, table_high,
+		                              bits) ^
+		       flip;
+		mask &= (1U << (end - offset)) - 1;
+		if (mask)
+			return offset + string_bit_last(mask);
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("avx2")
+static size_t
+string_rfind_char_avx2(const char* str, size_t end, char c) {
+	const __m256i value = _mm256_set1_epi8(c);
+	uint32_t mask;
+	if (end < 32) {
+		_mm256_zeroupper();
+		return string_rfind_char_ssse3(str, end, c);
+	}
+	for (; end >= 32; end -= 32) {
+		mask = (uint32_t)_mm256_movemask_epi8(
+		    _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + end - 32)), value));
+		if (mask)
+			return (end - 32) + string_bit_last(mask);
+	}
+	if (end) {
+		mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)str), value));
+		mask &= (1U << end) - 1;
+		if (mask)
+			return string_bit_last(mask);
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("avx2")
+static FOUNDATION_FORCEINLINE uint32_t
+string_key_mask_avx2(const char* str, size_t key_length, __m256i first, __m256i last) {
+	const __m256i block_first = _mm256_loadu_si256((const __m256i*)str);
+	const __m256i block_last = _mm256_loadu_si256((const __m256i*)(str + key_length - 1));
+	return (uint32_t)_mm256_movemask_epi8(
+	    _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+}
+
+STRING_TARGET("avx2")
+static size_t
+string_find_key_avx2(const char* str, size_t offset, size_t last, const char* key, size_t key_length) {
+	const __m256i first_char = _mm256_set1_epi8(key[0]);
+	const __m256i last_char = _mm256_set1_epi8(key[key_length - 1]);
+	uint32_t mask;
+	if (last - offset < 31) {
+		_mm256_zeroupper();
+		return string_find_key_ssse3(str, offset, last, key, key_length);
+	}
+	for (; offset + 31 <= last; offset += 32) {
+		mask = string_key_mask_avx2(str + offset, key_length, first_char, last_char);
+		while (mask) {
+			const unsigned int bit = string_bit_first(mask);
+			if (memcmp(str + offset + bit + 1, key + 1, key_length - 2) == 0)
+				return offset + bit;
+			mask &= mask - 1;
+		}
+	}
+	if (offset <= last) {
+		const size_t base = last - 31;
+		mask = string_key_mask_avx2(str + base, key_length, first_char, last_char) >> (offset - base);
+		while (mask) {
+			const unsigned int bit = string_bit_first(mask);
+			if (memcmp(str + offset + bit + 1, key + 1, key_length - 2) == 0)
+				return offset + bit;
+			mask &= mask - 1;
+		}
+	}
+	return STRING_NPOS;
+}
+
+STRING_TARGET("avx2")
+static size_t
+string_rfind_key_avx2(const char* str, size_t offset, const char* key, size_t key_length) {
+	const __m256i first_char = _mm256_set1_epi8(key[0]);
+	const __m256i last_char = _mm256_set1_epi8(key[key_length - 1]);
+	size_t end = offset + 1;
+	uint32_t mask;
+	if (end < 32) {
+		_mm256_zeroupper();
+		return string_rfind_key_ssse3(str, offset, key, key_length);
+	}
+	for (; end >= 32; end -= 32) {
+		mask = string_key_mask_avx2(str + end - 32, key_length, first_char, last_char);
+		while (mask) {
+			const unsigned int bit = string_bit_last(mask);
+			if (memcmp(str + (end - 32) + bit + 1, key + 1, key_length - 2) == 0)
+				return (end - 32) + bit;
+			mask &= ~(1U << bit);
+		}
+	}
+	if (end) {
+		mask = string_key_mask_avx2(str, key_length, first_char, last_char) & ((1U << end) - 1);
+		while (mask) {
+			const unsigned int bit = string_bit_last(mask);
+			if (memcmp(str + bit + 1, key + 1, key_length - 2) == 0)
+				return bit;
+			mask &= ~(1U << bit);
+		}
+	}
+	return STRING_NPOS;
+}
+
+#elif STRING_ARM
+#include <arm_neon.h>
+
+// Same algorithms as the x86 kernels. NEON has no byte movemask, comparison results are
+// narrowed to a 64-bit mask with four bits per byte position
+
+static FOUNDATION_FORCEINLINE unsigned int
+string_bit_first(uint64_t mask) {
+#if FOUNDATION_COMPILER_MSVC
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return (unsigned int)index >> 2;
+#else
+	return (unsigned int)__builtin_ctzll(mask) >> 2;
+#endif
+}
+
+static FOUNDATION_FORCEINLINE unsigned int
+string_bit_last(uint64_t mask) {
+#if FOUNDATION_COMPILER_MSVC
+	unsigned long index;
+	_BitScanReverse64(&index, mask);
+	return (unsigned int)index >> 2;
+#else
+	return (63U - (unsigned int)__builtin_clzll(mask)) >> 2;
+#endif
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+string_mask_neon(uint8x16_t match) {
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+}
+
+//! Mask with the bits for the given number of lowest byte positions set, count less than 16
+static FOUNDATION_FORCEINLINE uint64_t
+string_mask_low_neon(size_t count) {
+	return (1ULL << (count * 4)) - 1;
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+string_class_mask_neon(uint8x16_t data, uint8x16_t table_low, uint8x16_t table_high, uint8x16_t bits) {
+	const uint8x16_t index_mask = vdupq_n_u8(0x8F);
+	const uint8x16_t index_low = vandq_u8(data, index_mask);
+	const uint8x16_t index_high = vandq_u8(veorq_u8(data, vdupq_n_u8(0x80)), index_mask);
+	const uint8x16_t row = vorrq_u8(vqtbl1q_u8(table_low, index_low), vqtbl1q_u8(table_high, index_high));
+	const uint8x16_t bit = vqtbl1q_u8(bits, vandq_u8(vshrq_n_u8(data, 4), vdupq_n_u8(7)));
+	return string_mask_neon(vtstq_u8(row, bit));
+}
+
+static const uint8_t string_class_bits_neon[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+static size_t
+string_find_class_neon(const char* str, size_t offset, size_t end, const string_class_t* byteclass, bool invert) {
+	const uint8x16_t table_low = vld1q_u8(byteclass->low);
+	const uint8x16_t table_high = vld1q_u8(byteclass->high);
+	const uint8x16_t bits = vld1q_u8(string_class_bits_neon);
+	const uint64_t flip = invert ? ~0ULL : 0;
+	uint64_t mask;
+	if (end - offset < 16)
+		return string_find_class_generic(str, offset, end, byteclass, invert);
+	for (; offset + 16 <= end; offset += 16) {
+		mask = string_class_mask_neon(vld1q_u8((const uint8_t*)str + offset), table_low, table_high, bits) ^ flip;
+		if (mask)
+			return offset + string_bit_first(mask);
+	}
+	if (offset < end) {
+		const size_t base = end - 16;
+		mask = string_class_mask_neon(vld1q_u8((const uint8_t*)str + base), table_low, table_high, bits) ^ flip;
+		mask >>= (offset - base) * 4;
+		if (mask)
+			return offset + string_bit_first(mask);
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+string_rfind_class_neon(const char* str, size_t offset, size_t end, const string_class_t* byteclass, bool invert) {
+	const uint8x16_t table_low = vld1q_u8(byteclass->low);
+	const uint8x16_t table_high = vld1q_u8(byteclass->high);
+	const uint8x16_t bits = vld1q_u8(string_class_bits_neon);
+	const uint64_t flip = invert ? ~0ULL : 0;
+	uint64_t mask;
+	if (end - offset < 16)
+		return string_rfind_class_generic(str, offset, end, byteclass, invert);
+	for (; end >= offset + 16; end -= 16) {
+		mask =
+		    string_class_mask_neon(vld1q_u8((const uint8_t*)str + end - 16), table_low, table_high, bits) ^ flip;
+		if (mask)
+			return (end - 16) + string_bit_last(mask);
+	}
+	if (end > offset) {
+		mask = string_class_mask_neon(vld1q_u8((const uint8_t*)str + offset), table_low, table_high, bits) ^ flip;
+		mask &= string_mask_low_neon(end - offset);
+		if (mask)
+			return offset + string_bit_last(mask);
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+string_rfind_char_neon(const char* str, size_t end, char c) {
+	const uint8x16_t value = vdupq_n_u8((uint8_t)c);
+	uint64_t mask;
+	if (end < 16)
+		return string_rfind_char_generic(str, end, c);
+	for (; end >= 16; end -= 16) {
+		mask = string_mask_neon(vceqq_u8(vld1q_u8((const uint8_t*)str + end - 16), value));
+		if (mask)
+			return (end - 16) + string_bit_last(mask);
+	}
+	if (end) {
+		mask = string_mask_neon(vceqq_u8(vld1q_u8((const uint8_t*)str), value)) & string_mask_low_neon(end);
+		if (mask)
+			return string_bit_last(mask);
+	}
+	return STRING_NPOS;
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+string_key_mask_neon(const char* str, size_t key_length, uint8x16_t first, uint8x16_t last) {
+	const uint8x16_t block_first = vld1q_u8((const uint8_t*)str);
+	const uint8x16_t block_last = vld1q_u8((const uint8_t*)str + key_length - 1);
+	return string_mask_neon(vandq_u8(vceqq_u8(block_first, first), vceqq_u8(block_last, last)));
+}
+
+static size_t
+string_find_key_neon(const char* str, size_t offset, size_t last, const char* key, size_t key_length) {
+	const uint8x16_t first_char = vdupq_n_u8((uint8_t)key[0]);
+	const uint8x16_t last_char = vdupq_n_u8((uint8_t)key[key_length - 1]);
+	uint64_t mask;
+	if (last - offset < 15)
+		return string_find_key_generic(str, offset, last, key, key_length);
+	for (; offset + 15 <= last; offset += 16) {
+		mask = string_key_mask_neon(str + offset, key_length, first_char, last_char);
+		while (mask) {
+			const unsigned int bit = string_bit_first(mask);
+			if (memcmp(str + offset + bit + 1, key + 1, key_length - 2) == 0)
+				return offset + bit;
+			mask &= ~(0xFULL << (bit * 4));
+		}
+	}
+	if (offset <= last) {
+		const size_t base = last - 15;
+		mask = string_key_mask_neon(str + base, key_length, first_char, last_char) >> ((offset - base) * 4);
+		while (mask) {
+			const unsigned int bit = string_bit_first(mask);
+			if (memcmp(str + offset + bit + 1, key + 1, key_length - 2) == 0)
+				return offset + bit;
+			mask &= ~(0xFULL << (bit * 4));
+		}
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+string_rfind_key_neon(const char* str, size_t offset, const char* key, size_t key_length) {
+	const uint8x16_t first_char = vdupq_n_u8((uint8_t)key[0]);
+	const uint8x16_t last_char = vdupq_n_u8((uint8_t)key[key_length - 1]);
+	size_t end = offset + 1;
+	uint64_t mask;
+	if (end < 16)
+		return string_rfind_key_generic(str, offset, key, key_length);
+	for (; end >= 16; end -= 16) {
+		mask = string_key_mask_neon(str + end - 16, key_length, first_char, last_char);
+		while (mask) {
+			const unsigned int bit = string_bit_last(mask);
+			if (memcmp(str + (end - 16) + bit + 1, key + 1, key_length - 2) == 0)
+				return (end - 16) + bit;
+			mask &= ~(0xFULL << (bit * 4));
+		}
+	}
+	if (end) {
+		mask = string_key_mask_neon(str, key_length, first_char, last_char) & string_mask_low_neon(end);
+		while (mask) {
+			const unsigned int bit = string_bit_last(mask);
+			if (memcmp(str + bit + 1, key + 1, key_length - 2) == 0)
+				return bit;
+			mask &= ~(0xFULL << (bit * 4));
+		}
+	}
+	return STRING_NPOS;
+}
+
+#endif
+
+// UTF-8 validation, counting and transcoding kernels. Validation follows "Validating UTF-8 In
+// Less Than One Instruction Per Byte" by John Keiser and Daniel Lemire: three nibble table
+// lookups on each byte and its predecessor classify every two byte sequence error, and the
+// bytes two and three positions after three and four byte leads must be continuation bytes.
+// Blocks of ASCII skip the lookups and only check for a sequence left incomplete by the
+// previous block. The final partial block is zero padded which also flags truncated sequences
+
+//! Check if the range is strictly valid UTF-8 (no overlong forms, surrogates or glyphs above 0x10FFFF)
+typedef bool (*string_utf8_validate_fn)(const char* str, size_t length);
+
+//! Count glyphs in valid UTF-8, or UTF-16 code units needed to encode them if utf16 is set
+typedef size_t (*string_utf8_count_fn)(const char* str, size_t length, bool utf16);
+
+//! Widen leading ASCII bytes in whole blocks to UTF-16, returning the number of bytes converted
+typedef size_t (*string_utf8_widen16_fn)(uint16_t* dst, const char* src, size_t count);
+
+//! Widen leading ASCII bytes in whole blocks to UTF-32, returning the number of bytes converted
+typedef size_t (*string_utf8_widen32_fn)(uint32_t* dst, const char* src, size_t count);
+
+//! Narrow leading ASCII UTF-16 code units in whole blocks, returning the number of units converted
+typedef size_t (*string_utf16_narrow_fn)(char* dst, const uint16_t* src, size_t count);
+
+//! Narrow leading ASCII UTF-32 code units in whole blocks, returning the number of units converted
+typedef size_t (*string_utf32_narrow_fn)(char* dst, const uint32_t* src, size_t count);
+
+static string_utf8_validate_fn string_utf8_validate;
+static string_utf8_count_fn string_utf8_count;
+static string_utf8_widen16_fn string_utf8_widen16;
+static string_utf8_widen32_fn string_utf8_widen32;
+static string_utf16_narrow_fn string_utf16_narrow;
+static string_utf32_narrow_fn string_utf32_narrow;
+
+#define STRING_ASCII_MASK64 0x8080808080808080ULL
+
+static bool
+string_utf8_validate_generic(const char* str, size_t length) {
+	const uint8_t* cur = (const uint8_t*)str;
+	const uint8_t* end = cur + length;
+	while (cur < end) {
+		uint64_t word;
+		while (((size_t)(end - cur) >= sizeof(word))) {
+			memcpy(&word, cur, sizeof(word));
+			if (word & STRING_ASCII_MASK64)
+				break;
+			cur += sizeof(word);
+		}
+		if (cur >= end)
+			break;
+		const uint8_t lead = *cur;
+		if (lead < 0x80) {
+			++cur;
+			continue;
+		}
+		size_t extra;
+		uint8_t low = 0x80;
+		uint8_t high = 0xBF;
+		if (lead < 0xC2) {
+			return false;
+		} else if (lead < 0xE0) {
+			extra = 1;
+		} else if (lead < 0xF0) {
+			extra = 2;
+			if (lead == 0xE0)
+				low = 0xA0;
+			else if (lead == 0xED)
+				high = 0x9F;
+		} else if (lead < 0xF5) {
+			extra = 3;
+			if (lead == 0xF0)
+				low = 0x90;
+			else if (lead == 0xF4)
+				high = 0x8F;
+		} else {
+			return false;
+		}
+		if ((size_t)(end - cur) <= extra)
+			return false;
+		if ((cur[1] < low) || (cur[1] > high))
+			return false;
+		for (size_t ibyte = 2; ibyte <= extra; ++ibyte) {
+			if ((cur[ibyte] & 0xC0) != 0x80)
+				return false;
+		}
+		cur += extra + 1;
+	}
+	return true;
+}
+
+static size_t
+string_utf8_count_generic(const char* str, size_t length, bool utf16) {
+	size_t count = 0;
+	for (size_t offset = 0; offset < length; ++offset) {
+		const int8_t value = (int8_t)str[offset];
+		// Continuation bytes are 0x80-0xBF, four byte leads need a surrogate pair in UTF-16
+		count += (value > -65) ? 1 : 0;
+		if (utf16)
+			count += (value > -17) ? 1 : 0;
+	}
+	return count;
+}
+
+static size_t
+string_utf8_widen16_generic(uint16_t* dst, const char* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 8 <= count; offset += 8) {
+		uint64_t word;
+		memcpy(&word, src + offset, sizeof(word));
+		if (word & STRING_ASCII_MASK64)
+			break;
+		for (unsigned int ibyte = 0; ibyte < 8; ++ibyte)
+			dst[offset + ibyte] = (uint8_t)src[offset + ibyte];
+	}
+	return offset;
+}
+
+static size_t
+string_utf8_widen32_generic(uint32_t* dst, const char* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 8 <= count; offset += 8) {
+		uint64_t word;
+		memcpy(&word, src + offset, sizeof(word));
+		if (word & STRING_ASCII_MASK64)
+			break;
+		for (unsigned int ibyte = 0; ibyte < 8; ++ibyte)
+			dst[offset + ibyte] = (uint8_t)src[offset + ibyte];
+	}
+	return offset;
+}
+
+static size_t
+string_utf16_narrow_generic(char* dst, const uint16_t* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 4 <= count; offset += 4) {
+		if ((src[offset] | src[offset + 1] | src[offset + 2] | src[offset + 3]) & 0xFF80)
+			break;
+		for (unsigned int iunit = 0; iunit < 4; ++iunit)
+			dst[offset + iunit] = (char)src[offset + iunit];
+	}
+	return offset;
+}
+
+static size_t
+string_utf32_narrow_generic(char* dst, const uint32_t* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 4 <= count; offset += 4) {
+		if ((src[offset] | src[offset + 1] | src[offset + 2] | src[offset + 3]) & 0xFFFFFF80U)
+			break;
+		for (unsigned int iunit = 0; iunit < 4; ++iunit)
+			dst[offset + iunit] = (char)src[offset + iunit];
+	}
+	return offset;
+}
+
+//! Error bits for two byte sequences, set in all three lookup tables when the sequence
+//! of (previous byte high nibble, previous byte low nibble, byte high nibble) is invalid
+#define UTF8_TOO_SHORT (1 << 0)
+#define UTF8_TOO_LONG (1 << 1)
+#define UTF8_OVERLONG_3 (1 << 2)
+#define UTF8_TOO_LARGE (1 << 3)
+#define UTF8_SURROGATE (1 << 4)
+#define UTF8_OVERLONG_2 (1 << 5)
+#define UTF8_TOO_LARGE_1000 (1 << 6)
+#define UTF8_OVERLONG_4 (1 << 6)
+#define UTF8_TWO_CONTS (1 << 7)
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#define UTF8_BYTE_1_HIGH                                                                                            \
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,        \
+	    UTF8_TOO_LONG, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS,      \
+	    UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,       \
+	    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+
+#define UTF8_BYTE_1_LOW                                                                                             \
+	(char)(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4), (char)(UTF8_CARRY | UTF8_OVERLONG_2),  \
+	    (char)UTF8_CARRY, (char)UTF8_CARRY, (char)(UTF8_CARRY | UTF8_TOO_LARGE),                                   \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),                                \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),                                                 \
+	    (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000)
+
+#define UTF8_BYTE_2_HIGH                                                                                            \
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+	    UTF8_TOO_SHORT,                                                                                            \
+	    (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 |           \
+	           UTF8_OVERLONG_4),                                                                                   \
+	    (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),               \
+	    (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),                \
+	    (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),                \
+	    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+
+//! Maximum value of the last three bytes of a block not starting an incomplete sequence
+#define UTF8_INCOMPLETE_MAX (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1)
+
+#if STRING_X86
+
+STRING_TARGET("ssse3")
+static FOUNDATION_FORCEINLINE __m128i
+string_utf8_check_ssse3(__m128i input, __m128i previous) {
+	const __m128i byte_1_high_table = _mm_setr_epi8(UTF8_BYTE_1_HIGH);
+	const __m128i byte_1_low_table = _mm_setr_epi8(UTF8_BYTE_1_LOW);
+	const __m128i byte_2_high_table = _mm_setr_epi8(UTF8_BYTE_2_HIGH);
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+	const __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+	const __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+	const __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+	const __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+	const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, nibble));
+	const __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+	const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+	const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+	const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+	const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+	return _mm_xor_si128(must23, special);
+}
+
+STRING_TARGET("ssse3")
+static bool
+string_utf8_validate_ssse3(const char* str, size_t length) {
+	const __m128i incomplete_max = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, UTF8_INCOMPLETE_MAX);
+	__m128i error = _mm_setzero_si128();
+	__m128i previous = _mm_setzero_si128();
+	__m128i incomplete = _mm_setzero_si128();
+	__m128i input;
+	char tail[16];
+	size_t offset = 0;
+	for (; offset + 16 <= length; offset += 16) {
+		input = _mm_loadu_si128((const __m128i*)(str + offset));
+		if (!_mm_movemask_epi8(input)) {
+			error = _mm_or_si128(error, incomplete);
+			incomplete = _mm_setzero_si128();
+		} else {
+			error = _mm_or_si128(error, string_utf8_check_ssse3(input, previous));
+			incomplete = _mm_subs_epu8(input, incomplete_max);
+		}
+		previous = input;
+	}
+	memset(tail, 0, sizeof(tail));
+	memcpy(tail, str + offset, length - offset);
+	input = _mm_loadu_si128((const __m128i*)tail);
+	error = _mm_or_si128(error, string_utf8_check_ssse3(input, previous));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+STRING_TARGET("sse2")
+static size_t
+string_utf8_count_sse2(const char* str, size_t length, bool utf16) {
+	const __m128i continuation = _mm_set1_epi8(-65);
+	const __m128i four_byte = _mm_set1_epi8(-17);
+	size_t count = 0;
+	size_t offset = 0;
+	// Byte lanes accumulate at most two per block, flush to 64-bit sums before overflow
+	while (offset + 16 <= length) {
+		__m128i sum = _mm_setzero_si128();
+		for (unsigned int iblock = 0; (iblock < 127) && (offset + 16 <= length); ++iblock, offset += 16) {
+			const __m128i input = _mm_loadu_si128((const __m128i*)(str + offset));
+			sum = _mm_sub_epi8(sum, _mm_cmpgt_epi8(input, continuation));
+			if (utf16)
+				sum = _mm_sub_epi8(sum, _mm_cmpgt_epi8(input, four_byte));
+		}
+		sum = _mm_sad_epu8(sum, _mm_setzero_si128());
+		count += (size_t)_mm_cvtsi128_si32(sum) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+	}
+	return count + string_utf8_count_generic(str + offset, length - offset, utf16);
+}
+
+STRING_TARGET("sse2")
+static size_t
+string_utf8_widen16_sse2(uint16_t* dst, const char* src, size_t count) {
+	const __m128i zero = _mm_setzero_si128();
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const __m128i input = _mm_loadu_si128((const __m128i*)(src + offset));
+		if (_mm_movemask_epi8(input))
+			break;
+		_mm_storeu_si128((__m128i*)(dst + offset), _mm_unpacklo_epi8(input, zero));
+		_mm_storeu_si128((__m128i*)(dst + offset + 8), _mm_unpackhi_epi8(input, zero));
+	}
+	return offset;
+}
+
+STRING_TARGET("sse2")
+static size_t
+string_utf8_widen32_sse2(uint32_t* dst, const char* src, size_t count) {
+	const __m128i zero = _mm_setzero_si128();
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const __m128i input = _mm_loadu_si128((const __m128i*)(src + offset));
+		if (_mm_movemask_epi8(input))
+			break;
+		const __m128i low = _mm_unpacklo_epi8(input, zero);
+		const __m128i high = _mm_unpackhi_epi8(input, zero);
+		_mm_storeu_si128((__m128i*)(dst + offset), _mm_unpacklo_epi16(low, zero));
+		_mm_storeu_si128((__m128i*)(dst + offset + 4), _mm_unpackhi_epi16(low, zero));
+		_mm_storeu_si128((__m128i*)(dst + offset + 8), _mm_unpacklo_epi16(high, zero));
+		_mm_storeu_si128((__m128i*)(dst + offset + 12), _mm_unpackhi_epi16(high, zero));
+	}
+	return offset;
+}
+
+STRING_TARGET("sse2")
+static size_t
+string_utf16_narrow_sse2(char* dst, const uint16_t* src, size_t count) {
+	const __m128i non_ascii = _mm_set1_epi16((short)0xFF80);
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const __m128i low = _mm_loadu_si128((const __m128i*)(src + offset));
+		const __m128i high = _mm_loadu_si128((const __m128i*)(src + offset + 8));
+		const __m128i test = _mm_and_si128(_mm_or_si128(low, high), non_ascii);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(test, _mm_setzero_si128())) != 0xFFFF)
+			break;
+		_mm_storeu_si128((__m128i*)(dst + offset), _mm_packus_epi16(low, high));
+	}
+	return offset;
+}
+
+STRING_TARGET("sse2")
+static size_t
+string_utf32_narrow_sse2(char* dst, const uint32_t* src, size_t count) {
+	const __m128i non_ascii = _mm_set1_epi32((int)0xFFFFFF80U);
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const __m128i in0 = _mm_loadu_si128((const __m128i*)(src + offset));
+		const __m128i in1 = _mm_loadu_si128((const __m128i*)(src + offset + 4));
+		const __m128i in2 = _mm_loadu_si128((const __m128i*)(src + offset + 8));
+		const __m128i in3 = _mm_loadu_si128((const __m128i*)(src + offset + 12));
+		const __m128i test = _mm_and_si128(_mm_or_si128(_mm_or_si128(in0, in1), _mm_or_si128(in2, in3)), non_ascii);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(test, _mm_setzero_si128())) != 0xFFFF)
+			break;
+		_mm_storeu_si128((__m128i*)(dst + offset),
+		                 _mm_packus_epi16(_mm_packs_epi32(in0, in1), _mm_packs_epi32(in2, in3)));
+	}
+	return offset;
+}
+
+STRING_TARGET("avx2")
+static FOUNDATION_FORCEINLINE __m256i
+string_utf8_check_avx2(__m256i input, __m256i previous) {
+	const __m256i byte_1_high_table = _mm256_setr_epi8(UTF8_BYTE_1_HIGH, UTF8_BYTE_1_HIGH);
+	const __m256i byte_1_low_table = _mm256_setr_epi8(UTF8_BYTE_1_LOW, UTF8_BYTE_1_LOW);
+	const __m256i byte_2_high_table = _mm256_setr_epi8(UTF8_BYTE_2_HIGH, UTF8_BYTE_2_HIGH);
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	// Bytes preceding each lane come from the upper lane of the previous block or the lower lane
+	const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+	const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+	const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+	const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+	const __m256i byte_1_high =
+	    _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+	const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, nibble));
+	const __m256i byte_2_high =
+	    _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+	const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+	const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+	const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+	const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+	return _mm256_xor_si256(must23, special);
+}
+
+STRING_TARGET("avx2")
+static bool
+string_utf8_validate_avx2(const char* str, size_t length) {
+	const __m256i incomplete_max =
+	    _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	                     -1, -1, -1, -1, -1, -1, UTF8_INCOMPLETE_MAX);
+	__m256i error = _mm256_setzero_si256();
+	__m256i previous = _mm256_setzero_si256();
+	__m256i incomplete = _mm256_setzero_si256();
+	__m256i input;
+	char tail[32];
+	size_t offset = 0;
+	bool valid;
+	for (; offset + 32 <= length; offset += 32) {
+		input = _mm256_loadu_si256((const __m256i*)(str + offset));
+		if (!_mm256_movemask_epi8(input)) {
+			error = _mm256_or_si256(error, incomplete);
+			incomplete = _mm256_setzero_si256();
+		} else {
+			error = _mm256_or_si256(error, string_utf8_check_avx2(input, previous));
+			incomplete = _mm256_subs_epu8(input, incomplete_max);
+		}
+		previous = input;
+	}
+	memset(tail, 0, sizeof(tail));
+	memcpy(tail, str + offset, length - offset);
+	input = _mm256_loadu_si256((const __m256i*)tail);
+	error = _mm256_or_si256(error, string_utf8_check_avx2(input, previous));
+	valid = _mm256_testz_si256(error, error) != 0;
+	_mm256_zeroupper();
+	return valid;
+}
+
+STRING_TARGET("avx2")
+static size_t
+string_utf8_count_avx2(const char* str, size_t length, bool utf16) {
+	const __m256i continuation = _mm256_set1_epi8(-65);
+	const __m256i four_byte = _mm256_set1_epi8(-17);
+	size_t count = 0;
+	size_t offset = 0;
+	while (offset + 32 <= length) {
+		__m256i sum = _mm256_setzero_si256();
+		for (unsigned int iblock = 0; (iblock < 127) && (offset + 32 <= length); ++iblock, offset += 32) {
+			const __m256i input = _mm256_loadu_si256((const __m256i*)(str + offset));
+			sum = _mm256_sub_epi8(sum, _mm256_cmpgt_epi8(input, continuation));
+			if (utf16)
+				sum = _mm256_sub_epi8(sum, _mm256_cmpgt_epi8(input, four_byte));
+		}
+		sum = _mm256_sad_epu8(sum, _mm256_setzero_si256());
+		const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		count += (size_t)_mm_cvtsi128_si32(half) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(half, 8));
+	}
+	_mm256_zeroupper();
+	return count + string_utf8_count_generic(str + offset, length - offset, utf16);
+}
+
+#elif STRING_ARM
+
+static FOUNDATION_FORCEINLINE uint8x16_t
+string_utf8_check_neon(uint8x16_t input, uint8x16_t previous) {
+	static const uint8_t byte_1_high_data[16] = {UTF8_BYTE_1_HIGH};
+	static const uint8_t byte_1_low_data[16] = {UTF8_BYTE_1_LOW};
+	static const uint8_t byte_2_high_data[16] = {UTF8_BYTE_2_HIGH};
+	const uint8x16_t prev1 = vextq_u8(previous, input, 15);
+	const uint8x16_t prev2 = vextq_u8(previous, input, 14);
+	const uint8x16_t prev3 = vextq_u8(previous, input, 13);
+	const uint8x16_t byte_1_high = vqtbl1q_u8(vld1q_u8(byte_1_high_data), vshrq_n_u8(prev1, 4));
+	const uint8x16_t byte_1_low = vqtbl1q_u8(vld1q_u8(byte_1_low_data), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+	const uint8x16_t byte_2_high = vqtbl1q_u8(vld1q_u8(byte_2_high_data), vshrq_n_u8(input, 4));
+	const uint8x16_t special = vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+	const uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+	const uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+	const uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+	return veorq_u8(must23, special);
+}
+
+static bool
+string_utf8_validate_neon(const char* str, size_t length) {
+	static const uint8_t incomplete_data[16] = {255, 255, 255, 255, 255, 255, 255,        255,
+	                                            255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+	const uint8x16_t incomplete_max = vld1q_u8(incomplete_data);
+	uint8x16_t error = vdupq_n_u8(0);
+	uint8x16_t previous = vdupq_n_u8(0);
+	uint8x16_t incomplete = vdupq_n_u8(0);
+	uint8x16_t input;
+	uint8_t tail[16];
+	size_t offset = 0;
+	for (; offset + 16 <= length; offset += 16) {
+		input = vld1q_u8((const uint8_t*)str + offset);
+		if (vmaxvq_u8(input) < 0x80) {
+			error = vorrq_u8(error, incomplete);
+			incomplete = vdupq_n_u8(0);
+		} else {
+			error = vorrq_u8(error, string_utf8_check_neon(input, previous));
+			incomplete = vqsubq_u8(input, incomplete_max);
+		}
+		previous = input;
+	}
+	memset(tail, 0, sizeof(tail));
+	memcpy(tail, str + offset, length - offset);
+	input = vld1q_u8(tail);
+	error = vorrq_u8(error, string_utf8_check_neon(input, previous));
+	return vmaxvq_u8(error) == 0;
+}
+
+static size_t
+string_utf8_count_neon(const char* str, size_t length, bool utf16) {
+	const int8x16_t continuation = vdupq_n_s8(-65);
+	const int8x16_t four_byte = vdupq_n_s8(-17);
+	size_t count = 0;
+	size_t offset = 0;
+	while (offset + 16 <= length) {
+		uint8x16_t sum = vdupq_n_u8(0);
+		for (unsigned int iblock = 0; (iblock < 127) && (offset + 16 <= length); ++iblock, offset += 16) {
+			const int8x16_t input = vld1q_s8((const int8_t*)str + offset);
+			sum = vsubq_u8(sum, vcgtq_s8(input, continuation));
+			if (utf16)
+				sum = vsubq_u8(sum, vcgtq_s8(input, four_byte));
+		}
+		count += vaddlvq_u8(sum);
+	}
+	return count + string_utf8_count_generic(str + offset, length - offset, utf16);
+}
+
+static size_t
+string_utf8_widen16_neon(uint16_t* dst, const char* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const uint8x16_t input = vld1q_u8((const uint8_t*)src + offset);
+		if (vmaxvq_u8(input) >= 0x80)
+			break;
+		vst1q_u16(dst + offset, vmovl_u8(vget_low_u8(input)));
+		vst1q_u16(dst + offset + 8, vmovl_u8(vget_high_u8(input)));
+	}
+	return offset;
+}
+
+static size_t
+string_utf8_widen32_neon(uint32_t* dst, const char* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const uint8x16_t input = vld1q_u8((const uint8_t*)src + offset);
+		if (vmaxvq_u8(input) >= 0x80)
+			break;
+		const uint16x8_t low = vmovl_u8(vget_low_u8(input));
+		const uint16x8_t high = vmovl_u8(vget_high_u8(input));
+		vst1q_u32(dst + offset, vmovl_u16(vget_low_u16(low)));
+		vst1q_u32(dst + offset + 4, vmovl_u16(vget_high_u16(low)));
+		vst1q_u32(dst + offset + 8, vmovl_u16(vget_low_u16(high)));
+		vst1q_u32(dst + offset + 12, vmovl_u16(vget_high_u16(high)));
+	}
+	return offset;
+}
+
+static size_t
+string_utf16_narrow_neon(char* dst, const uint16_t* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const uint16x8_t low = vld1q_u16(src + offset);
+		const uint16x8_t high = vld1q_u16(src + offset + 8);
+		if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80)
+			break;
+		vst1q_u8((uint8_t*)dst + offset, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+	}
+	return offset;
+}
+
+static size_t
+string_utf32_narrow_neon(char* dst, const uint32_t* src, size_t count) {
+	size_t offset = 0;
+	for (; offset + 16 <= count; offset += 16) {
+		const uint32x4_t in0 = vld1q_u32(src + offset);
+		const uint32x4_t in1 = vld1q_u32(src + offset + 4);
+		const uint32x4_t in2 = vld1q_u32(src + offset + 8);
+		const uint32x4_t in3 = vld1q_u32(src + offset + 12);
+		if (vmaxvq_u32(vorrq_u32(vorrq_u32(in0, in1), vorrq_u32(in2, in3))) >= 0x80)
+			break;
+		const uint16x8_t low = vcombine_u16(vmovn_u32(in0), vmovn_u32(in1));
+		const uint16x8_t high = vcombine_u16(vmovn_u32(in2), vmovn_u32(in3));
+		vst1q_u8((uint8_t*)dst + offset, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+	}
+	return offset;
+}
+
+#endif
+
+// ASCII case folding kernels. Upper case letters 'A'-'Z' get bit 5 set, mapping them to 'a'-'z'
+// and leaving all other bytes including UTF-8 sequences untouched. The portable version folds
+// eight bytes at a time in a 64-bit word: adding to the low seven bits of each byte sets the
+// high bit at and above 'A' and above 'Z' without carries between bytes, and the difference
+// of the two, for bytes below 128, is shifted down to bit 5
+
+//! Check if ranges are equal after ASCII case folding
+typedef bool (*string_equal_fold_fn)(const char* lhs, const char* rhs, size_t length);
+
+//! Copy range with ASCII case folding
+typedef void (*string_fold_fn)(char* dst, const char* src, size_t length);
+
+// Size of blocks folded on the stack for case insensitive hashing
+#define STRING_FOLD_BLOCK 256
+
+static string_equal_fold_fn string_equal_fold;
+static string_fold_fn string_fold;
+
+static FOUNDATION_FORCEINLINE uint64_t
+string_fold_word(uint64_t word) {
+	const uint64_t low = word & 0x7F7F7F7F7F7F7F7FULL;
+	const uint64_t at_least_a = low + 0x3F3F3F3F3F3F3F3FULL;
+	const uint64_t above_z = low + 0x2525252525252525ULL;
+	return word | (((at_least_a ^ above_z) & ~word & STRING_ASCII_MASK64) >> 2);
+}
+
+static FOUNDATION_FORCEINLINE char
+string_fold_char(char c) {
+	return (char)((uint8_t)c | ((uint8_t)((uint8_t)c - 'A') < 26 ? 0x20 : 0));
+}
+
+static bool
+string_equal_fold_generic(const char* lhs, const char* rhs, size_t length) {
+	size_t offset = 0;
+	for (; offset + 8 <= length; offset += 8) {
+		uint64_t lhs_word, rhs_word;
+		memcpy(&lhs_word, lhs + offset, 8);
+		memcpy(&rhs_word, rhs + offset, 8);
+		if ((lhs_word != rhs_word) && (string_fold_word(lhs_word) != string_fold_word(rhs_word)))
+			return false;
+	}
+	for (; offset < length; ++offset) {
+		if (string_fold_char(lhs[offset]) != string_fold_char(rhs[offset]))
+			return false;
+	}
+	return true;
+}
+
+static void
+string_fold_generic(char* dst, const char* src, size_t length) {
+	size_t offset = 0;
+	for (; offset + 8 <= length; offset += 8) {
+		uint64_t word;
+		memcpy(&word, src + offset, 8);
+		word = string_fold_word(word);
+		memcpy(dst + offset, &word, 8);
+	}
+	for (; offset < length; ++offset)
+		dst[offset] = string_fold_char(src[offset]);
+}
+
+#if STRING_X86
+
+STRING_TARGET("sse2")
+static FOUNDATION_FORCEINLINE __m128i
+string_fold_sse2(__m128i input) {
+	// Offset 'A'-'Z' to the lowest signed values, a single signed compare then finds them
+	const __m128i shifted = _mm_add_epi8(input, _mm_set1_epi8((char)(0x80 - 'A')));
+	const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8((char)(0x80 - 'A' + 'Z' + 1 - 0x100)), shifted);
+	return _mm_or_si128(input, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+STRING_TARGET("sse2")
+static bool
+string_equal_fold_sse2(const char* lhs, const char* rhs, size_t length) {
+	size_t offset = 0;
+	if (length < 16)
+		return string_equal_fold_generic(lhs, rhs, length);
+	for (; offset + 16 <= length; offset += 16) {
+		const __m128i lhs_input = string_fold_sse2(_mm_loadu_si128((const __m128i*)(lhs + offset)));
+		const __m128i rhs_input = string_fold_sse2(_mm_loadu_si128((const __m128i*)(rhs + offset)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(lhs_input, rhs_input)) != 0xFFFF)
+			return false;
+	}
+	if (offset < length) {
+		// Overlapping compare of the last full vector
+		const __m128i lhs_input = string_fold_sse2(_mm_loadu_si128((const __m128i*)(lhs + length - 16)));
+		const __m128i rhs_input = string_fold_sse2(_mm_loadu_si128((const __m128i*)(rhs + length - 16)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(lhs_input, rhs_input)) != 0xFFFF)
+			return false;
+	}
+	return true;
+}
+
+STRING_TARGET("sse2")
+static void
+string_fold_sse2_copy(char* dst, const char* src, size_t length) {
+	size_t offset = 0;
+	for (; offset + 16 <= length; offset += 16)
+		_mm_storeu_si128((__m128i*)(dst + offset), string_fold_sse2(_mm_loadu_si128((const __m128i*)(src + offset))));
+	string_fold_generic(dst + offset, src + offset, length - offset);
+}
+
+STRING_TARGET("avx2")
+static FOUNDATION_FORCEINLINE __m256i
+string_fold_avx2(__m256i input) {
+	const __m256i shifted = _mm256_add_epi8(input, _mm256_set1_epi8((char)(0x80 - 'A')));
+	const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 - 'A' + 'Z' + 1 - 0x100)), shifted);
+	return _mm256_or_si256(input, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+STRING_TARGET("avx2")
+static bool
+string_equal_fold_avx2(const char* lhs, const char* rhs, size_t length) {
+	size_t offset = 0;
+	if (length < 32) {
+		_mm256_zeroupper();
+		return string_equal_fold_sse2(lhs, rhs, length);
+	}
+	// Two vectors per iteration with a single mask test
+	for (; offset + 64 <= length; offset += 64) {
+		const __m256i lhs0 = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(lhs + offset)));
+		const __m256i rhs0 = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(rhs + offset)));
+		const __m256i lhs1 = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(lhs + offset + 32)));
+		const __m256i rhs1 = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(rhs + offset + 32)));
+		const __m256i same = _mm256_and_si256(_mm256_cmpeq_epi8(lhs0, rhs0), _mm256_cmpeq_epi8(lhs1, rhs1));
+		if ((uint32_t)_mm256_movemask_epi8(same) != 0xFFFFFFFFU)
+			return false;
+	}
+	for (; offset + 32 <= length; offset += 32) {
+		const __m256i lhs_input = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(lhs + offset)));
+		const __m256i rhs_input = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(rhs + offset)));
+		if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs_input, rhs_input)) != 0xFFFFFFFFU)
+			return false;
+	}
+	if (offset < length) {
+		const __m256i lhs_input = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(lhs + length - 32)));
+		const __m256i rhs_input = string_fold_avx2(_mm256_loadu_si256((const __m256i*)(rhs + length - 32)));
+		if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs_input, rhs_input)) != 0xFFFFFFFFU)
+			return false;
+	}
+	return true;
+}
+
+STRING_TARGET("avx2")
+static void
+string_fold_avx2_copy(char* dst, const char* src, size_t length) {
+	size_t offset = 0;
+	for (; offset + 32 <= length; offset += 32) {
+		const __m256i input = _mm256_loadu_si256((const __m256i*)(src + offset));
+		_mm256_storeu_si256((__m256i*)(dst + offset), string_fold_avx2(input));
+	}
+	_mm256_zeroupper();
+	string_fold_sse2_copy(dst + offset, src + offset, length - offset);
+}
+
+#elif STRING_ARM
+
+static FOUNDATION_FORCEINLINE uint8x16_t
+string_fold_neon(uint8x16_t input) {
+	const uint8x16_t upper = vcltq_u8(vsubq_u8(input, vdupq_n_u8('A')), vdupq_n_u8(26));
+	return vorrq_u8(input, vandq_u8(upper, vdupq_n_u8(0x20)));
+}
+
+static bool
+string_equal_fold_neon(const char* lhs, const char* rhs, size_t length) {
+	size_t offset = 0;
+	if (length < 16)
+		return string_equal_fold_generic(lhs, rhs, length);
+	for (; offset + 16 <= length; offset += 16) {
+		const uint8x16_t lhs_input = string_fold_neon(vld1q_u8((const uint8_t*)lhs + offset));
+		const uint8x16_t rhs_input = string_fold_neon(vld1q_u8((const uint8_t*)rhs + offset));
+		if (vminvq_u8(vceqq_u8(lhs_input, rhs_input)) != 0xFF)
+			return false;
+	}
+	if (offset < length) {
+		const uint8x16_t lhs_input = string_fold_neon(vld1q_u8((const uint8_t*)lhs + length - 16));
+		const uint8x16_t rhs_input = string_fold_neon(vld1q_u8((const uint8_t*)rhs + length - 16));
+		if (vminvq_u8(vceqq_u8(lhs_input, rhs_input)) != 0xFF)
+			return false;
+	}
+	return true;
+}
+
+static void
+string_fold_neon_copy(char* dst, const char* src, size_t length) {
+	size_t offset = 0;
+	for (; offset + 16 <= length; offset += 16)
+		vst1q_u8((uint8_t*)dst + offset, string_fold_neon(vld1q_u8((const uint8_t*)src + offset)));
+	string_fold_generic(dst + offset, src + offset, length - offset);
+}
+
+#endif
+
+static const cpu_dispatch_t string_find_class_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_find_class_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)string_find_class_ssse3},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_find_class_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_find_class_generic}};
+
+static const cpu_dispatch_t string_rfind_class_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_rfind_class_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)string_rfind_class_ssse3},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_rfind_class_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_rfind_class_generic}};
+
+static const cpu_dispatch_t string_rfind_char_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_rfind_char_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)string_rfind_char_ssse3},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_rfind_char_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_rfind_char_generic}};
+
+static const cpu_dispatch_t string_find_key_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_find_key_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)string_find_key_ssse3},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_find_key_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_find_key_generic}};
+
+static const cpu_dispatch_t string_rfind_key_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_rfind_key_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)string_rfind_key_ssse3},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_rfind_key_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_rfind_key_generic}};
+
+static const cpu_dispatch_t string_utf8_validate_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_utf8_validate_avx2},
+    {CPU_FEATURE_SSSE3, (cpu_dispatch_fn)string_utf8_validate_ssse3},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_utf8_validate_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_utf8_validate_generic}};
+
+static const cpu_dispatch_t string_utf8_count_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_utf8_count_avx2},
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_utf8_count_sse2},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_utf8_count_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_utf8_count_generic}};
+
+static const cpu_dispatch_t string_utf8_widen16_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_utf8_widen16_sse2},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_utf8_widen16_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_utf8_widen16_generic}};
+
+static const cpu_dispatch_t string_utf8_widen32_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_utf8_widen32_sse2},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_utf8_widen32_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_utf8_widen32_generic}};
+
+static const cpu_dispatch_t string_utf16_narrow_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_utf16_narrow_sse2},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_utf16_narrow_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_utf16_narrow_generic}};
+
+static const cpu_dispatch_t string_utf32_narrow_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_utf32_narrow_sse2},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_utf32_narrow_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_utf32_narrow_generic}};
+
+static const cpu_dispatch_t string_equal_fold_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_equal_fold_avx2},
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_equal_fold_sse2},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_equal_fold_neon},
+#endif
+    {0, (cpu_dispatch_fn)string_equal_fold_generic}};
+
+static const cpu_dispatch_t string_fold_candidates[] = {
+#if STRING_X86
+    {CPU_FEATURE_AVX2, (cpu_dispatch_fn)string_fold_avx2_copy},
+    {CPU_FEATURE_SSE2, (cpu_dispatch_fn)string_fold_sse2_copy},
+#elif STRING_ARM
+    {CPU_FEATURE_NEON, (cpu_dispatch_fn)string_fold_neon_copy},
+#endif
+    {0, (cpu_dispatch_fn)string_fold_generic}};
+
+#define STRING_DISPATCH(candidates) system_cpu_dispatch(candidates, sizeof(candidates) / sizeof(candidates[0]))
+
+//! Select scanning, UTF-8 and case folding functions from CPU features detected at runtime. Resolving is
+//! idempotent, concurrent calls store the same function pointers
+void
+internal_string_resolve(void) {
+	string_find_class = (string_find_class_fn)STRING_DISPATCH(string_find_class_candidates);
+	string_rfind_class = (string_rfind_class_fn)STRING_DISPATCH(string_rfind_class_candidates);
+	string_rfind_char = (string_rfind_char_fn)STRING_DISPATCH(string_rfind_char_candidates);
+	string_find_key = (string_find_key_fn)STRING_DISPATCH(string_find_key_candidates);
+	string_rfind_key = (string_rfind_key_fn)STRING_DISPATCH(string_rfind_key_candidates);
+	string_utf8_validate = (string_utf8_validate_fn)STRING_DISPATCH(string_utf8_validate_candidates);
+	string_utf8_count = (string_utf8_count_fn)STRING_DISPATCH(string_utf8_count_candidates);
+	string_utf8_widen16 = (string_utf8_widen16_fn)STRING_DISPATCH(string_utf8_widen16_candidates);
+	string_utf8_widen32 = (string_utf8_widen32_fn)STRING_DISPATCH(string_utf8_widen32_candidates);
+	string_utf16_narrow = (string_utf16_narrow_fn)STRING_DISPATCH(string_utf16_narrow_candidates);
+	string_utf32_narrow = (string_utf32_narrow_fn)STRING_DISPATCH(string_utf32_narrow_candidates);
+	string_equal_fold = (string_equal_fold_fn)STRING_DISPATCH(string_equal_fold_candidates);
+	string_fold = (string_fold_fn)STRING_DISPATCH(string_fold_candidates);
+}
+
 size_t
 string_find(const char* str, size_t length, char c, size_t offset) {
 	const void* found;
@@ -623,45 +2179,32 @@ string_find(const char* str, size_t length, char c, size_t offset) {
 
 size_t
 string_find_string(const char* str, size_t length, const char* key, size_t key_length, size_t offset) {
-	const char* found;
-	char keychar;
-	size_t last_offset;
 	if (!key_length)
 		return offset;
 	if ((key_length > length) || (offset > (length - key_length)))
 		return STRING_NPOS;
+	if (key_length == 1)
+		return string_find(str, length, *key, offset);
 
-	last_offset = length - key_length;
-
-	do {
-		keychar = *key;
-		found = memchr(str + offset, keychar, 1 + last_offset - offset);
-		if (!found)
-			break;
-
-		if (memcmp(found, key, key_length) == 0)
-			return (size_t)pointer_diff(found, str);
-
-		offset = 1 + (size_t)pointer_diff(found, str);
-
-	} while (offset <= last_offset);
+	// Short scans are faster with the memchr based generic search
+	if ((length - key_length) - offset < STRING_SCAN_THRESHOLD * 2)
+		return string_find_key_generic(str, offset, length - key_length, key, key_length);
 
-	return STRING_NPOS;
+	if (!string_find_key)
+		internal_string_resolve();
+	return string_find_key(str, offset, length - key_length, key, key_length);
 }
 
 size_t
 string_rfind(const char* str, size_t length, char c, size_t offset) {
+	if (!length)
+		return STRING_NPOS;
 	if (offset >= length)
-		offset = length - 1;  // zero length will wrap around
-
-	// Wrap-around terminates
-	while (offset != STRING_NPOS) {
-		if (c == str[offset])
-			return offset;
-		--offset;
-	}
+		offset = length - 1;
 
-	return STRING_NPOS;
+	if (!string_rfind_char)
+		internal_string_resolve();
+	return string_rfind_char(str, offset + 1, c);
 }
 
 size_t
@@ -673,20 +2216,28 @@ string_rfind_string(const char* str, size_t length, const char* key, size_t key_
 
 	if (offset >= length - key_length)
 		offset = length - key_length;
+	if (key_length == 1)
+		return string_rfind(str, length, *key, offset);
 
-	// Wrap-around terminates
-	while (offset != STRING_NPOS) {
-		if (memcmp(str + offset, key, key_length) == 0)
-			return offset;
-		--offset;
-	}
-	return STRING_NPOS;
+	if (!string_rfind_key)
+		internal_string_resolve();
+	return string_rfind_key(str, offset, key, key_length);
 }
 
 size_t
 string_find_first_of(const char* str, size_t length, const char* tokens, size_t token_length, size_t offset) {
 	if (!token_length)
 		return STRING_NPOS;
+	if (token_length == 1)
+		return string_find(str, length, *tokens, offset);
+
+	if ((offset < length) && (length - offset >= STRING_SCAN_THRESHOLD)) {
+		string_class_t byteclass;
+		string_class_initialize(&byteclass, tokens, token_length);
+		if (!string_find_class)
+			internal_string_resolve();
+		return string_find_class(str, offset, length, &byteclass, false);
+	}
 
 	while (offset < length) {
 		if (string_find(tokens, token_length, str[offset], 0) != STRING_NPOS)
@@ -700,9 +2251,19 @@ size_t
 string_find_last_of(const char* str, size_t length, const char* tokens, size_t token_length, size_t offset) {
 	if (!token_length)
 		return STRING_NPOS;
+	if (token_length == 1)
+		return string_rfind(str, length, *tokens, offset);
 	if (offset >= length)
 		offset = length - 1;
 
+	if ((offset != STRING_NPOS) && (offset + 1 >= STRING_SCAN_THRESHOLD)) {
+		string_class_t byteclass;
+		string_class_initialize(&byteclass, tokens, token_length);
+		if (!string_rfind_class)
+			internal_string_resolve();
+		return string_rfind_class(str, 0, offset + 1, &byteclass, false);
+	}
+
 	// Wrap-around terminates
 	while (offset != STRING_NPOS) {
 		if (string_find(tokens, token_length, str[offset], 0) != STRING_NPOS)
@@ -720,6 +2281,14 @@ string_find_first_not_of(const char* str, size_t length, const char* tokens, siz
 	if (!token_length)
 		return offset;
 
+	if (length - offset >= STRING_SCAN_THRESHOLD) {
+		string_class_t byteclass;
+		string_class_initialize(&byteclass, tokens, token_length);
+		if (!string_find_class)
+			internal_string_resolve();
+		return string_find_class(str, offset, length, &byteclass, true);
+	}
+
 	while (offset < length) {
 		if (string_find(tokens, token_length, str[offset], 0) == STRING_NPOS)
 			return offset;
@@ -735,6 +2304,14 @@ string_find_last_not_of(const char* str, size_t length, const char* tokens, size
 	if (!token_length)
 		return offset;
 
+	if ((offset != STRING_NPOS) && (offset + 1 >= STRING_SCAN_THRESHOLD)) {
+		string_class_t byteclass;
+		string_class_initialize(&byteclass, tokens, token_length);
+		if (!string_rfind_class)
+			internal_string_resolve();
+		return string_rfind_class(str, 0, offset + 1, &byteclass, true);
+	}
+
 	// Wrap-around terminates
 	while (offset != STRING_NPOS) {
 		if (string_find(tokens, token_length, str[offset], 0) == STRING_NPOS)
@@ -764,10 +2341,39 @@ string_equal(const char* rhs, size_t rhs_length, const char* lhs, size_t lhs_len
 
 bool
 string_equal_nocase(const char* rhs, size_t rhs_length, const char* lhs, size_t lhs_length) {
-	if (rhs_length && lhs_length) {
-		return (rhs_length == lhs_length) && (strncasecmp(rhs, lhs, rhs_length) == 0);
+	if (rhs_length != lhs_length)
+		return false;
+	// Short strings are faster with the word at a time generic compare
+	if (rhs_length < STRING_SCAN_THRESHOLD)
+		return string_equal_fold_generic(rhs, lhs, rhs_length);
+	if (!string_equal_fold)
+		internal_string_resolve();
+	return string_equal_fold(rhs, lhs, rhs_length);
+}
+
+hash_t
+string_hash_nocase(const char* str, size_t length) {
+	FOUNDATION_ALIGN(16) char buffer[STRING_FOLD_BLOCK];
+	hash_state_t state;
+	if (!length)
+		return HASH_EMPTY_STRING;
+	if (!string_fold)
+		internal_string_resolve();
+	if (length <= sizeof(buffer)) {
+		string_fold(buffer, str, length);
+		return hash(buffer, length);
 	}
-	return (!rhs_length && !lhs_length);
+	// Longer strings are folded in blocks through the incremental hash, which produces
+	// the same hash as a single call over the folded string
+	hash_initialize(&state);
+	while (length) {
+		const size_t block = (length < sizeof(buffer)) ? length : sizeof(buffer);
+		string_fold(buffer, str, block);
+		hash_update(&state, buffer, block);
+		str += block;
+		length -= block;
+	}
+	return hash_finalize(&state);
 }
 
 bool
@@ -812,33 +2418,85 @@ string_match_pattern(const char* element, size_t element_length, const char* pat
 size_t
 string_explode(const char* str, size_t length, const char* delimiters, size_t delim_length, string_const_t* arr,
                size_t arrsize, bool allow_empty) {
-	size_t token;
-	size_t end;
+	string_tokenizer_t tokenizer;
 	size_t count = 0;
 
 	if (!length || !arrsize)
 		return 0;
 
-	if (!delim_length) {
-		arr[count++] = string_const(str, length);
-		return count;
-	}
+	string_tokenizer_initialize(&tokenizer, str, length, delimiters, delim_length,
+	                            allow_empty ? 0 : STRING_TOKENIZE_SKIP_EMPTY);
+	while ((count < arrsize) && string_tokenizer_next(&tokenizer, arr + count))
+		++count;
+
+	return count;
+}
 
-	token = 0;
-	end = 0;
+void
+string_tokenizer_initialize(string_tokenizer_t* tokenizer, const char* str, size_t length, const char* delimiters,
+                            size_t delim_length, unsigned int flags) {
+	tokenizer->str = str;
+	tokenizer->length = length;
+	// An empty string has no tokens, not a single empty token
+	tokenizer->offset = length ? 0 : 1;
+	tokenizer->flags = flags;
+	string_class_initialize(&tokenizer->delimiters, delimiters, delim_length);
+}
+
+//! Find first delimiter, or first non-delimiter if invert is set, from the given offset
+static FOUNDATION_FORCEINLINE size_t
+string_tokenizer_scan(const string_tokenizer_t* tokenizer, size_t offset, bool invert) {
+	if (tokenizer->length - offset < STRING_SCAN_THRESHOLD)
+		return string_find_class_generic(tokenizer->str, offset, tokenizer->length, &tokenizer->delimiters, invert);
+	if (!string_find_class)
+		internal_string_resolve();
+	return string_find_class(tokenizer->str, offset, tokenizer->length, &tokenizer->delimiters, invert);
+}
 
-	while ((end < length) && (count < arrsize)) {
-		if (!allow_empty)
-			token = string_find_first_not_of(str, length, delimiters, delim_length, end);
-		end = string_find_first_of(str, length, delimiters, delim_length, token);
+bool
+string_tokenizer_next(string_tokenizer_t* tokenizer, string_const_t* token) {
+	const char* str = tokenizer->str;
+	const size_t length = tokenizer->length;
+	size_t offset = tokenizer->offset;
+	size_t end;
+
+	if (offset > length)
+		return false;
 
-		if (token != STRING_NPOS)
-			arr[count++] = string_const(str + token, (end != STRING_NPOS) ? (end - token) : (length - token));
-		if (allow_empty)
-			token = end + 1;
+	if (tokenizer->flags & STRING_TOKENIZE_SKIP_EMPTY) {
+		offset = string_tokenizer_scan(tokenizer, offset, true);
+		if (offset == STRING_NPOS) {
+			tokenizer->offset = length + 1;
+			return false;
+		}
 	}
 
-	return count;
+	if ((tokenizer->flags & STRING_TOKENIZE_QUOTES) && (offset < length) && (str[offset] == '"')) {
+		// Closing quote is the first quote not followed by another quote, anything between the
+		// closing quote and the next delimiter is discarded
+		size_t close = offset + 1;
+		while (close < length) {
+			const char* quote = memchr(str + close, '"', length - close);
+			if (!quote) {
+				close = length;
+				break;
+			}
+			close = (size_t)pointer_diff(quote, str);
+			if ((close + 1 >= length) || (str[close + 1] != '"'))
+				break;
+			close += 2;
+		}
+		if (close > length)
+			close = length;
+		*token = string_const(str + offset + 1, close - (offset + 1));
+		end = (close < length) ? string_tokenizer_scan(tokenizer, close + 1, false) : STRING_NPOS;
+	} else {
+		end = string_tokenizer_scan(tokenizer, offset, false);
+		*token = string_const(str + offset, ((end != STRING_NPOS) ? end : length) - offset);
+	}
+
+	tokenizer->offset = (end != STRING_NPOS) ? end + 1 : length + 1;
+	return true;
 }
 
 string_t
@@ -1035,8 +2693,9 @@ encode_utf8(char* str, uint32_t val) {
 	return num + 1;
 }
 
-uint32_t
-string_glyph(const char* str, size_t length, size_t offset, size_t* consumed) {
+//! Decode the glyph at the given offset, storing the number of bytes consumed
+static FOUNDATION_FORCEINLINE uint32_t
+string_glyph_decode(const char* str, size_t length, size_t offset, size_t* consumed) {
 	uint32_t glyph;
 	unsigned char ext;
 	size_t num, j;
@@ -1071,16 +2730,125 @@ string_glyph(const char* str, size_t length, size_t offset, size_t* consumed) {
 	return glyph;
 }
 
+uint32_t
+string_glyph(const char* str, size_t length, size_t offset, size_t* consumed) {
+	return string_glyph_decode(str, length, offset, consumed);
+}
+
+//! Count glyphs by stepping the decoder, which emits stray continuation bytes as glyphs of their own
+static size_t
+string_glyphs_decoded(const char* str, size_t length) {
+	size_t offset = 0;
+	size_t count = 0;
+	size_t consumed;
+	while (offset < length) {
+		string_glyph_decode(str, length, offset, &consumed);
+		offset += consumed;
+		++count;
+	}
+	return count;
+}
+
 size_t
 string_glyphs(const char* str, size_t length) {
-	const char* end = pointer_offset_const(str, length);
-	size_t num = 0;
-	while (str && (str < end)) {
-		++num;
-		// Will catch invalid utf-8 sequences by overflowing str < end terminator
-		str += get_utf8_bytes_count((uint8_t)*str);
+	if (!str || !length)
+		return 0;
+	if (!string_utf8_count)
+		internal_string_resolve();
+	// The fast count skips continuation bytes and only matches the decoder for valid UTF-8
+	if (string_utf8_validate(str, length))
+		return string_utf8_count(str, length, false);
+	return string_glyphs_decoded(str, length);
+}
+
+bool
+string_validate_utf8(const char* str, size_t length) {
+	if (!length)
+		return true;
+	if (!string_utf8_validate)
+		internal_string_resolve();
+	return string_utf8_validate(str, length);
+}
+
+size_t
+string_encode_utf16(uint16_t* dst, size_t capacity, const char* src, size_t length) {
+	size_t offset = 0;
+	size_t count = 0;
+	size_t consumed;
+	size_t last;
+	uint32_t glyph;
+
+	if (!capacity)
+		return 0;
+	if (!string_utf8_widen16)
+		internal_string_resolve();
+
+	last = capacity - 1;
+	while ((offset < length) && (count < last)) {
+		if (!(src[offset] & 0x80)) {
+			// Vectorized widening of whole blocks once per run of ASCII, then the remainder
+			const size_t limit = math_min(length - offset, last - count);
+			size_t ascii = (limit >= 16) ? string_utf8_widen16(dst + count, src + offset, limit) : 0;
+			while ((ascii < limit) && !(src[offset + ascii] & 0x80)) {
+				dst[count + ascii] = (uint8_t)src[offset + ascii];
+				++ascii;
+			}
+			offset += ascii;
+			count += ascii;
+			continue;
+		}
+		glyph = string_glyph_decode(src, length, offset, &consumed);
+		offset += consumed;
+		// Surrogate code points and glyphs outside the unicode range cannot be represented
+		if ((glyph >= 0xD800) && (glyph <= 0xDFFF))
+			continue;
+		if (glyph <= 0xFFFF) {
+			dst[count++] = (uint16_t)glyph;
+		} else if (glyph <= 0x10FFFF) {
+			if (count + 1 >= last)
+				break;
+			glyph -= 0x10000;
+			dst[count++] = (uint16_t)(0xD800 | ((glyph >> 10) & 0x3FF));
+			dst[count++] = (uint16_t)(0xDC00 | (glyph & 0x3FF));
+		}
+	}
+
+	dst[count] = 0;
+	return count;
+}
+
+size_t
+string_encode_utf32(uint32_t* dst, size_t capacity, const char* src, size_t length) {
+	size_t offset = 0;
+	size_t count = 0;
+	size_t consumed;
+	size_t last;
+
+	if (!capacity)
+		return 0;
+	if (!string_utf8_widen32)
+		internal_string_resolve();
+
+	last = capacity - 1;
+	while ((offset < length) && (count < last)) {
+		if (!(src[offset] & 0x80)) {
+			// Vectorized widening of whole blocks once per run of ASCII, then the remainder
+			const size_t limit = math_min(length - offset, last - count);
+			size_t ascii = (limit >= 16) ? string_utf8_widen32(dst + count, src + offset, limit) : 0;
+			while ((ascii < limit) && !(src[offset + ascii] & 0x80)) {
+				dst[count + ascii] = (uint8_t)src[offset + ascii];
+				++ascii;
+			}
+			offset += ascii;
+			count += ascii;
+			continue;
+		}
+		dst[count++] = string_glyph_decode(src, length, offset, &consumed);
+		offset += consumed;
 	}
-	return num;
+
+	dst[count] = 0;
+	return count;
 }
 
 int
@@ -1098,130 +2866,63 @@ string_glyph_length(const char* str, size_t length) {
 	return (int)byte_count;
 }
 
+//! Count wchar_t needed for a string the fast glyph count does not apply to, following the decoder rules
+static size_t
+wstring_count_decoded(const char* cstr, size_t length) {
+#if FOUNDATION_SIZE_WCHAR == 2
+	size_t offset = 0;
+	size_t count = 0;
+	size_t consumed;
+	while (offset < length) {
+		const uint32_t glyph = string_glyph_decode(cstr, length, offset, &consumed);
+		offset += consumed;
+		// Surrogate code points and glyphs outside the unicode range are dropped by the encoder
+		if ((glyph >= 0xD800) && (glyph <= 0xDFFF))
+			continue;
+		if (glyph <= 0xFFFF)
+			++count;
+		else if (glyph <= 0x10FFFF)
+			count += 2;
+	}
+	return count;
+#else
+	return string_glyphs_decoded(cstr, length);
+#endif
+}
+
 wchar_t*
 wstring_allocate_from_string(const char* cstr, size_t length) {
 	wchar_t* buffer;
-	wchar_t* dest;
-	size_t chars_count, bytes_count, i, j;
-	uint32_t glyph;
-	unsigned char ext;
-	const char* cur;
-	const char* end;
+	size_t chars_count;
 
 	if (!length) {
 		buffer = memory_allocate(HASH_STRING, sizeof(wchar_t), 0, MEMORY_PERSISTENT | MEMORY_ZERO_INITIALIZED);
 		return buffer;
 	}
 
-	// Count number of wchar_t needed to represent string
-	chars_count = 0;
-	cur = cstr;
-	end = cstr + length;
-	for (i = 0; (i < length) && (cur < end);) {
-		bytes_count = get_utf8_bytes_count((uint8_t)(*cur));
-#if FOUNDATION_SIZE_WCHAR == 2
-		if (bytes_count >= 4)
-			chars_count += 2;  // final glyph > 0xFFFF
-		else
-			++chars_count;
-#else
-		++chars_count;  // wchar_t == UTF-32
-#endif
-		cur += bytes_count;
-		i += bytes_count;
-	}
+	// Count number of wchar_t needed to represent string. The fast count only matches the decoder
+	// for valid UTF-8, stray continuation bytes are decoded as separate glyphs
+	if (!string_utf8_count)
+		internal_string_resolve();
+	if (string_utf8_validate(cstr, length))
+		chars_count = string_utf8_count(cstr, length, FOUNDATION_SIZE_WCHAR == 2);
+	else
+		chars_count = wstring_count_decoded(cstr, length);
 
 	buffer = memory_allocate(HASH_STRING, sizeof(wchar_t) * (chars_count + 1), 0,
 	                         MEMORY_PERSISTENT | MEMORY_ZERO_INITIALIZED);
-
-	dest = buffer;
-	cur = cstr;
-	for (i = 0; (i < length) && (cur < end);) {
-		if (!(*cur & 0x80))
-			*dest++ = (unsigned char)*cur++;
-		else {
-			// Convert through UTF-32
-			ext = (unsigned char)*cur;
-			bytes_count = get_utf8_bytes_count(ext) - 1;  // Subtract one to get number of _extra_ bytes
-			glyph = ((uint32_t)ext & get_bit_mask(6 - bytes_count)) << (6 * bytes_count);
-			++cur;
-			for (j = 1; (j <= bytes_count) && (cur < end); ++j, ++cur) {
-				ext = (unsigned char)*cur;
-				glyph |= ((uint32_t)ext & 0x3F) << (6 * (bytes_count - j));
-			}
-#if FOUNDATION_SIZE_WCHAR == 2
-			FOUNDATION_ASSERT((glyph < 0xD800) || (glyph > 0xDFFF));
-			// FOUNDATION_ASSERT(glyph <= 0x10FFFF);
-			if ((glyph < 0xD800) || (glyph > 0xDFFF)) {
-				if (glyph <= 0xFFFF)
-					*dest++ = (wchar_t)glyph;
-				else if (glyph <= 0x10FFFF) {
-					uint32_t val = glyph - 0x10000;
-					*dest++ = (wchar_t)(0xD800 | ((val >> 10) & 0x3FF));
-					*dest++ = (wchar_t)(0xDC00 | (val & 0x3FF));
-				}
-			}
-#else
-			*dest++ = (wchar_t)glyph;
-#endif
-			i += bytes_count;
-		}
-	}
-
-	*dest = 0;
+	wstring_from_string(buffer, chars_count + 1, cstr, length);
 
 	return buffer;
 }
 
 void
 wstring_from_string(wchar_t* dest, size_t capacity, const char* source, size_t length) {
-	size_t i, j, num;
-	uint32_t glyph;
-	unsigned char ext;
-	wchar_t* last = dest + (capacity - 1);
-	const char* cur = source;
-	const char* end = source + length;
-
-	if (!capacity)
-		return;
-
-	/*lint -e{850} */
-	for (i = 0; (i < length) && (cur < end) && (dest < last); ++i) {
-		if (!(*cur & 0x80))
-			*dest++ = (unsigned char)*cur++;
-		else {
-			// Convert through UTF-32
-			ext = (unsigned char)(*cur);
-			num = get_utf8_bytes_count(ext) - 1;  // Subtract one to get number of _extra_ bytes
-			glyph = ((uint32_t)ext & get_bit_mask(6 - num)) << (6 * num);
-			++cur;
-			for (j = 1; (j <= num) && (cur < end); ++j, ++cur) {
-				ext = (unsigned char)(*cur);
-				glyph |= ((uint32_t)ext & 0x3F) << (6 * (num - j));
-			}
 #if FOUNDATION_SIZE_WCHAR == 2
-			FOUNDATION_ASSERT((glyph < 0xD800) || (glyph > 0xDFFF));
-			FOUNDATION_ASSERT(glyph <= 0x10FFFF);
-			if ((glyph < 0xD800) || (glyph > 0xDFFF)) {
-				if (glyph <= 0xFFFF)
-					*dest++ = (wchar_t)glyph;
-				else if (glyph <= 0x10FFFF) {
-					uint32_t val = glyph - 0x10000;
-					if (dest < (last - 1)) {
-						*dest++ = (wchar_t)(0xD800 | ((val >> 10) & 0x3FF));
-						*dest++ = (wchar_t)(0xDC00 | (val & 0x3FF));
-					} else
-						break;
-				}
-			}
+	string_encode_utf16((uint16_t*)dest, capacity, source, length);
 #else
-			*dest++ = (wchar_t)glyph;
+	string_encode_utf32((uint32_t*)dest, capacity, source, length);
 #endif
-			i += num;
-		}
-	}
-
-	*dest = 0;
 }
 
 void
@@ -1261,6 +2962,11 @@ string_allocate_from_utf16(const uint16_t* str, size_t length) {
 	/*lint -e{850} */
 	for (i = 0; i < length; ++i) {
 		glyph = str[i];
+		if (!swap && (i + 4 <= length) && !((glyph | str[i + 1] | str[i + 2] | str[i + 3]) & 0xFF80)) {
+			curlen += 4;
+			i += 3;
+			continue;
+		}
 		if ((glyph == 0xFFFE) || (glyph == 0xFEFF)) {
 			swap = (glyph != 0xFEFF);
 			continue;  // BOM
@@ -1298,6 +3004,11 @@ string_allocate_from_utf32(const uint32_t* str, size_t length) {
 	/*lint -e{850} */
 	for (i = 0; i < length; ++i) {
 		glyph = str[i];
+		if (!swap && (i + 2 <= length) && !((glyph | str[i + 1]) & 0xFFFFFF80U)) {
+			curlen += 2;
+			++i;
+			continue;
+		}
 		if ((glyph == 0x0000FEFF) || (glyph == 0xFFFE0000)) {
 			swap = (glyph != 0x0000FEFF);
 			continue;  // BOM
@@ -1321,10 +3032,27 @@ string_convert_utf16(char* dst, size_t capacity, const uint16_t* src, size_t len
 	size_t curlen = 0, numbytes = 0;
 	size_t i;
 
+	if (!string_utf16_narrow)
+		internal_string_resolve();
+
 	/*lint -e{850} */
 	for (i = 0; (i < length) && (curlen < capacity); ++i) {
 		// Convert through full UTF-32
 		glyph = src[i];
+		if ((glyph < 0x80) && !swap) {
+			// Vectorized narrowing of whole blocks once per run of ASCII, then the remainder
+			const size_t limit = math_min(length - i, capacity - curlen - 1);
+			size_t ascii = (limit >= 16) ? string_utf16_narrow(dst + curlen, src + i, limit) : 0;
+			while ((ascii < limit) && (src[i + ascii] < 0x80)) {
+				dst[curlen + ascii] = (char)src[i + ascii];
+				++ascii;
+			}
+			if (!ascii)
+				break;
+			curlen += ascii;
+			i += ascii - 1;
+			continue;
+		}
 		if ((glyph == 0xFFFE) || (glyph == 0xFEFF)) {
 			swap = (glyph != 0xFEFF);
 			continue;  // BOM
@@ -1358,9 +3086,25 @@ string_convert_utf32(char* dst, size_t capacity, const uint32_t* src, size_t len
 	size_t i;
 
 	swap = false;
+	if (!string_utf32_narrow)
+		internal_string_resolve();
 
 	for (i = 0; (i < length) && (curlen < capacity); ++i) {
 		glyph = src[i];
+		if ((glyph < 0x80) && !swap) {
+			// Vectorized narrowing of whole blocks once per run of ASCII, then the remainder
+			const size_t limit = math_min(length - i, capacity - curlen - 1);
+			size_t ascii = (limit >= 16) ? string_utf32_narrow(dst + curlen, src + i, limit) : 0;
+			while ((ascii < limit) && (src[i + ascii] < 0x80)) {
+				dst[curlen + ascii] = (char)src[i + ascii];
+				++ascii;
+			}
+			if (!ascii)
+				break;
+			curlen += ascii;
+			i += ascii - 1;
+			continue;
+		}
 		if ((glyph == 0x0000FEFF) || (glyph == 0xFFFE0000)) {
 			swap = (glyph != 0x0000FEFF);
 			continue;  // BOM
@@ -1373,125 +3117,1641 @@ string_convert_utf32(char* dst, size_t capacity, const uint32_t* src, size_t len
 			curlen += encode_utf8(dst + curlen, glyph);
 	}
 
-	dst[curlen] = 0;
-	return (string_t){dst, curlen};
+	dst[curlen] = 0;
+	return (string_t){dst, curlen};
+}
+
+#if BUILD_MAX_PATHLEN > 132
+#define THREAD_BUFFER_SIZE BUILD_MAX_PATHLEN
+#else
+#define THREAD_BUFFER_SIZE 132
+#endif
+FOUNDATION_DECLARE_THREAD_LOCAL_ARRAY(char, convert_buffer, THREAD_BUFFER_SIZE)
+
+//! Decimal digit pairs 00 to 99
+static const char string_digit_pairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9', '1', '0', '1',
+    '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2', '2',
+    '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9', '3', '0', '3', '1', '3', '2', '3', '3', '3',
+    '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5',
+    '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5',
+    '7', '5', '8', '5', '9', '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8',
+    '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8',
+    '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9', '9', '0', '9', '1',
+    '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'};
+
+//! Hexadecimal digit pairs 00 to ff
+static const char string_hex_pairs[512] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9', '0', 'a', '0',
+    'b', '0', 'c', '0', 'd', '0', 'e', '0', 'f', '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6',
+    '1', '7', '1', '8', '1', '9', '1', 'a', '1', 'b', '1', 'c', '1', 'd', '1', 'e', '1', 'f', '2', '0', '2', '1', '2',
+    '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9', '2', 'a', '2', 'b', '2', 'c', '2', 'd',
+    '2', 'e', '2', 'f', '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3',
+    '9', '3', 'a', '3', 'b', '3', 'c', '3', 'd', '3', 'e', '3', 'f', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '4', 'a', '4', 'b', '4', 'c', '4', 'd', '4', 'e', '4', 'f', '5',
+    '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9', '5', 'a', '5', 'b',
+    '5', 'c', '5', 'd', '5', 'e', '5', 'f', '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',
+    '7', '6', '8', '6', '9', '6', 'a', '6', 'b', '6', 'c', '6', 'd', '6', 'e', '6', 'f', '7', '0', '7', '1', '7', '2',
+    '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '7', 'a', '7', 'b', '7', 'c', '7', 'd', '7',
+    'e', '7', 'f', '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '8', 'a', '8', 'b', '8', 'c', '8', 'd', '8', 'e', '8', 'f', '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9',
+    '5', '9', '6', '9', '7', '9', '8', '9', '9', '9', 'a', '9', 'b', '9', 'c', '9', 'd', '9', 'e', '9', 'f', 'a', '0',
+    'a', '1', 'a', '2', 'a', '3', 'a', '4', 'a', '5', 'a', '6', 'a', '7', 'a', '8', 'a', '9', 'a', 'a', 'a', 'b', 'a',
+    'c', 'a', 'd', 'a', 'e', 'a', 'f', 'b', '0', 'b', '1', 'b', '2', 'b', '3', 'b', '4', 'b', '5', 'b', '6', 'b', '7',
+    'b', '8', 'b', '9', 'b', 'a', 'b', 'b', 'b', 'c', 'b', 'd', 'b', 'e', 'b', 'f', 'c', '0', 'c', '1', 'c', '2', 'c',
+    '3', 'c', '4', 'c', '5', 'c', '6', 'c', '7', 'c', '8', 'c', '9', 'c', 'a', 'c', 'b', 'c', 'c', 'c', 'd', 'c', 'e',
+    'c', 'f', 'd', '0', 'd', '1', 'd', '2', 'd', '3', 'd', '4', 'd', '5', 'd', '6', 'd', '7', 'd', '8', 'd', '9', 'd',
+    'a', 'd', 'b', 'd', 'c', 'd', 'd', 'd', 'e', 'd', 'f', 'e', '0', 'e', '1', 'e', '2', 'e', '3', 'e', '4', 'e', '5',
+    'e', '6', 'e', '7', 'e', '8', 'e', '9', 'e', 'a', 'e', 'b', 'e', 'c', 'e', 'd', 'e', 'e', 'e', 'f', 'f', '0', 'f',
+    '1', 'f', '2', 'f', '3', 'f', '4', 'f', '5', 'f', '6', 'f', '7', 'f', '8', 'f', '9', 'f', 'a', 'f', 'b', 'f', 'c',
+    'f', 'd', 'f', 'e', 'f', 'f'};
+
+//! Write decimal digits of a 32-bit value ending at the given position, returning the number of digits
+static FOUNDATION_FORCEINLINE unsigned int
+string_digits_backward32(char* end, uint32_t value) {
+	char* dst = end;
+	while (value >= 100) {
+		dst -= 2;
+		memcpy(dst, string_digit_pairs + ((value % 100) * 2), 2);
+		value /= 100;
+	}
+	if (value >= 10) {
+		dst -= 2;
+		memcpy(dst, string_digit_pairs + (value * 2), 2);
+	} else {
+		*--dst = (char)('0' + value);
+	}
+	return (unsigned int)(end - dst);
+}
+
+//! Write decimal digits of a value ending at the given position, returning the number of digits
+static FOUNDATION_FORCEINLINE unsigned int
+string_digits_backward(char* end, uint64_t value) {
+	char* dst = end;
+	if (value <= 0xFFFFFFFFULL)
+		return string_digits_backward32(end, (uint32_t)value);
+	// Peel off eight digits at a time so the remaining divisions are 32-bit
+	while (value >= 100000000ULL) {
+		uint32_t chunk = (uint32_t)(value % 100000000ULL);
+		value /= 100000000ULL;
+		for (int pair = 0; pair < 4; ++pair) {
+			dst -= 2;
+			memcpy(dst, string_digit_pairs + ((chunk % 100) * 2), 2);
+			chunk /= 100;
+		}
+	}
+	return (unsigned int)(end - dst) + string_digits_backward32(dst, (uint32_t)value);
+}
+
+//! Write hexadecimal digits of a value ending at the given position, returning the number of digits
+static FOUNDATION_FORCEINLINE unsigned int
+string_hex_digits_backward(char* end, uint64_t value) {
+	char* dst = end;
+	while (value >= 0x100) {
+		dst -= 2;
+		memcpy(dst, string_hex_pairs + ((value & 0xFF) * 2), 2);
+		value >>= 8;
+	}
+	if (value >= 0x10) {
+		dst -= 2;
+		memcpy(dst, string_hex_pairs + (value * 2), 2);
+	} else {
+		*--dst = string_hex_pairs[(value * 2) + 1];
+	}
+	return (unsigned int)(end - dst);
+}
+
+//! Write all 16 hexadecimal digits of a value including leading zeros
+static FOUNDATION_FORCEINLINE void
+string_hex_digits_fixed(char* dst, uint64_t value) {
+	for (int pair = 7; pair >= 0; --pair) {
+		memcpy(dst + (pair * 2), string_hex_pairs + ((value & 0xFF) * 2), 2);
+		value >>= 8;
+	}
+}
+
+//! Copy converted string to buffer, truncating to capacity or padding to field width
+static string_t
+string_convert_output(char* buffer, size_t capacity, const char* str, size_t length, unsigned int width, char fill) {
+	if (length >= capacity) {
+		memcpy(buffer, str, capacity - 1);
+		buffer[capacity - 1] = 0;
+		return (string_t){buffer, capacity - 1};
+	}
+	if (width >= capacity)
+		width = (unsigned int)capacity - 1;
+	if (length < width) {
+		const size_t ofs = width - length;
+		memset(buffer, fill, ofs);
+		memcpy(buffer + ofs, str, length);
+		length = width;
+	} else {
+		memcpy(buffer, str, length);
+	}
+	buffer[length] = 0;
+	return (string_t){buffer, length};
+}
+
+string_t
+string_from_int(char* buffer, size_t capacity, int64_t val, unsigned int width, char fill) {
+	char str[24];
+	char* end = str + sizeof(str);
+	unsigned int length;
+	if (!capacity)
+		return (string_t){buffer, 0};
+	length = string_digits_backward(end, (val < 0) ? (0 - (uint64_t)val) : (uint64_t)val);
+	if (val < 0)
+		*(end - (++length)) = '-';
+	return string_convert_output(buffer, capacity, end - length, length, width, fill);
+}
+
+string_const_t
+string_from_int_static(int64_t val, unsigned int width, char fill) {
+	return string_to_const(string_from_int(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val, width, fill));
+}
+
+string_t
+string_from_uint(char* buffer, size_t capacity, uint64_t val, bool hex, unsigned int width, char fill) {
+	char str[24];
+	char* end = str + sizeof(str);
+	unsigned int length;
+	if (!capacity)
+		return (string_t){buffer, 0};
+	length = hex ? string_hex_digits_backward(end, val) : string_digits_backward(end, val);
+	return string_convert_output(buffer, capacity, end - length, length, width, fill);
+}
+
+string_const_t
+string_from_uint_static(uint64_t val, bool hex, unsigned int width, char fill) {
+	return string_to_const(string_from_uint(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val, hex, width, fill));
+}
+
+string_t
+string_from_uint128(char* buffer, size_t capacity, const uint128_t val) {
+	char str[32];
+	if (!capacity)
+		return (string_t){buffer, 0};
+	for (unsigned int iword = 0; iword < 2; ++iword)
+		string_hex_digits_fixed(str + (iword * 16), val.word[iword]);
+	return string_convert_output(buffer, capacity, str, sizeof(str), 0, 0);
+}
+
+string_const_t
+string_from_uint128_static(const uint128_t val) {
+	return string_to_const(string_from_uint128(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val));
+}
+
+string_t
+string_from_uint256(char* buffer, size_t capacity, const uint256_t val) {
+	char str[64];
+	if (!capacity)
+		return (string_t){buffer, 0};
+	for (unsigned int iword = 0; iword < 4; ++iword)
+		string_hex_digits_fixed(str + (iword * 16), val.word[iword]);
+	return string_convert_output(buffer, capacity, str, sizeof(str), 0, 0);
+}
+
+string_const_t
+string_from_uint256_static(const uint256_t val) {
+	return string_to_const(string_from_uint256(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val));
+}
+
+string_t
+string_from_uint512(char* buffer, size_t capacity, const uint512_t val) {
+	char str[128];
+	if (!capacity)
+		return (string_t){buffer, 0};
+	for (unsigned int iword = 0; iword < 8; ++iword)
+		string_hex_digits_fixed(str + (iword * 16), val.word[iword]);
+	return string_convert_output(buffer, capacity, str, sizeof(str), 0, 0);
+}
+
+string_const_t
+string_from_uint512_static(const uint512_t val) {
+	return string_to_const(string_from_uint512(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val));
+}
+
+/* Floating point conversion. Shortest round trip formatting uses the Ryu algorithm, parsing
+   uses the Eisel-Lemire algorithm. Fixed precision output and parsing of inputs with more
+   significant digits than fit in 64 bits fall back to exact big integer arithmetic when the
+   fast paths cannot decide the rounding. Conversions are locale independent and allocation free */
+
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+//! Exponent range of the table of 128-bit powers of five
+#define STRING_POW5_MIN -342
+#define STRING_POW5_MAX 325
+
+//! Number of bits in the Ryu power of five multipliers
+#define STRING_POW5_BITCOUNT 125
+
+//! Maximum number of significant digits in the exact decimal representation of a 64-bit float
+#define STRING_FLOAT_DIGITS_MAX 767
+
+//! Size of the intermediate formatting buffer, fits sign, maximum number of digits and notation
+#define STRING_FLOAT_BUFFER_SIZE 800
+
+//! Maximum number of significant digits used in exact parsing, digits beyond this only affect
+//! rounding of exact halfway cases
+#define STRING_FLOAT_PARSE_DIGITS 768
+
+//! Big integer capacity in 32-bit words, fits exact comparison of parsed halfway cases
+#define STRING_BIGNUM_WORDS 128
+
+//! 5^q for q in [STRING_POW5_MIN, STRING_POW5_MAX] as 128-bit values normalized to have the most
+//! significant bit set, high word first. Positive powers are truncated, negative powers are the
+//! reciprocal rounded up, exactly for q >= -27 and before truncation for smaller powers
+static const uint64_t string_pow5_128[(STRING_POW5_MAX - STRING_POW5_MIN + 1) * 2] = {
+	0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+	0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL, 0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+	0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+	0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+	0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL, 0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+	0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+	0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+	0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL, 0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+	0x84a57695fe98746dULL, 0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+	0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+	0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL, 0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+	0xfd00b897478238d0ULL, 0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+	0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+	0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL, 0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+	0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+	0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+	0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL, 0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+	0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+	0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+	0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL, 0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+	0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+	0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+	0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL, 0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+	0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+	0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+	0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL, 0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+	0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+	0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+	0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL, 0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+	0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+	0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+	0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL, 0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+	0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+	0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+	0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL, 0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+	0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+	0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+	0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL, 0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+	0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+	0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+	0xc987434744ac874eULL, 0xa327ffb266b56220ULL, 0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+	0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+	0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+	0xc0314325637a1939ULL, 0xfa911155fefb5308ULL, 0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+	0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+	0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+	0xb749faed14125d36ULL, 0xcef980ec671f667bULL, 0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+	0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+	0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+	0xaecc49914078536dULL, 0x58fae9f773886e18ULL, 0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+	0x888f99797a5e012dULL, 0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+	0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+	0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL, 0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+	0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+	0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+	0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL, 0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+	0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+	0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+	0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL, 0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+	0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+	0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+	0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL, 0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+	0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+	0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+	0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL, 0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+	0xd77485cb25823ac7ULL, 0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+	0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+	0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL, 0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+	0xcd795be870516656ULL, 0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+	0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+	0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL, 0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+	0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+	0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+	0xef340a98172aace4ULL, 0x86fb897116c87c34ULL, 0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+	0xbae0a846d2195712ULL, 0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+	0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+	0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL, 0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+	0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+	0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+	0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL, 0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+	0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+	0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+	0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL, 0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+	0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+	0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+	0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL, 0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+	0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+	0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+	0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL, 0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+	0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+	0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+	0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL, 0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+	0x8c974f7383725573ULL, 0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+	0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+	0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL, 0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+	0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+	0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+	0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL, 0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+	0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+	0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+	0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL, 0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+	0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+	0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+	0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL, 0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+	0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+	0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+	0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL, 0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+	0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+	0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+	0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL, 0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+	0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+	0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+	0x811ccc668829b887ULL, 0x0806357d5a3f525fULL, 0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+	0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+	0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+	0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL, 0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+	0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+	0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+	0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL, 0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+	0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+	0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+	0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL, 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+	0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+	0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+	0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL, 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+	0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+	0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+	0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL, 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+	0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+	0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+	0xc24452da229b021bULL, 0xfbe85badce996168ULL, 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+	0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+	0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+	0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL, 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+	0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+	0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+	0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL, 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+	0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+	0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+	0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+	0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+	0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+	0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+	0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+	0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+	0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+	0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+	0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+	0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+	0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+	0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+	0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+	0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+	0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+	0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+	0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+	0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+	0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+	0xc612062576589ddaULL, 0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+	0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+	0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, 0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+	0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+	0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+	0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+	0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+	0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+	0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+	0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+	0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+	0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, 0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+	0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+	0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL, 0x0000000000000000ULL,
+	0xc800000000000000ULL, 0x0000000000000000ULL, 0xfa00000000000000ULL, 0x0000000000000000ULL,
+	0x9c40000000000000ULL, 0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+	0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+	0xbebc200000000000ULL, 0x0000000000000000ULL, 0xee6b280000000000ULL, 0x0000000000000000ULL,
+	0x9502f90000000000ULL, 0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+	0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL, 0x0000000000000000ULL,
+	0xb5e620f480000000ULL, 0x0000000000000000ULL, 0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+	0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+	0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+	0xad78ebc5ac620000ULL, 0x0000000000000000ULL, 0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+	0x878678326eac9000ULL, 0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+	0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL, 0x0000000000000000ULL,
+	0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+	0x813f3978f8940984ULL, 0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+	0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+	0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, 0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+	0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+	0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+	0x96769950b50d88f4ULL, 0x1314448000000000ULL, 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+	0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+	0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+	0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+	0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+	0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+	0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+	0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+	0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+	0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+	0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+	0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+	0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+	0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+	0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+	0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL, 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+	0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+	0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+	0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL, 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+	0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+	0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+	0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL, 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+	0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+	0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+	0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL, 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+	0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+	0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+	0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL, 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+	0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+	0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+	0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL, 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+	0x924d692ca61be758ULL, 0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+	0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+	0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL, 0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+	0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+	0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+	0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL, 0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+	0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+	0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+	0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL, 0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+	0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+	0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+	0x9ae757596946075fULL, 0x3375788de9b06958ULL, 0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+	0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+	0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+	0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL, 0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+	0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+	0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+	0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL, 0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+	0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+	0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+	0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL, 0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+	0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+	0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+	0x802221226be55a64ULL, 0xc2494954da2c9789ULL, 0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+	0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+	0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+	0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL, 0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+	0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+	0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+	0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL, 0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+	0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+	0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+	0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL, 0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+	0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+	0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+	0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL, 0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+	0xa59bc234db398c25ULL, 0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+	0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+	0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL, 0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+	0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+	0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+	0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL, 0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+	0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+	0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+	0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL, 0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+	0x8fa475791a569d10ULL, 0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+	0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+	0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL, 0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+	0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+	0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+	0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL, 0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+	0x82a45b450226b39cULL, 0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+	0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+	0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL, 0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+	0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+	0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+	0x98165af37b2153deULL, 0xc3727a337a8b704aULL, 0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+	0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+	0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+	0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL, 0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+	0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+	0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+	0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL, 0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+	0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+	0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+	0x83ea2b892091e44dULL, 0x934aed0aab460432ULL, 0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+	0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+	0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+	0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL, 0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+	0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+	0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+	0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL, 0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+	0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+	0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+	0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL, 0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+	0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+	0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+	0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL, 0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+	0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+	0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+	0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL, 0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+	0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+	0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+	0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL, 0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+	0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+	0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+	0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL, 0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+	0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+	0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+	0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL, 0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+	0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+	0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+	0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL, 0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+	0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+	0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+	0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL, 0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+	0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+	0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+	0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL, 0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+	0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+	0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+	0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL, 0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+	0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+	0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+	0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL, 0xb201833b35d63f73ULL, 0x2cd2cc6551e513daULL,
+	0xde81e40a034bcf4fULL, 0xf8077f7ea65e58d1ULL, 0x8b112e86420f6191ULL, 0xfb04afaf27faf782ULL,
+	0xadd57a27d29339f6ULL, 0x79c5db9af1f9b563ULL, 0xd94ad8b1c7380874ULL, 0x18375281ae7822bcULL,
+	0x87cec76f1c830548ULL, 0x8f2293910d0b15b5ULL, 0xa9c2794ae3a3c69aULL, 0xb2eb3875504ddb22ULL,
+	0xd433179d9c8cb841ULL, 0x5fa60692a46151ebULL, 0x849feec281d7f328ULL, 0xdbc7c41ba6bcd333ULL,
+	0xa5c7ea73224deff3ULL, 0x12b9b522906c0800ULL, 0xcf39e50feae16befULL, 0xd768226b34870a00ULL,
+	0x81842f29f2cce375ULL, 0xe6a1158300d46640ULL, 0xa1e53af46f801c53ULL, 0x60495ae3c1097fd0ULL,
+	0xca5e89b18b602368ULL, 0x385bb19cb14bdfc4ULL, 0xfcf62c1dee382c42ULL, 0x46729e03dd9ed7b5ULL,
+	0x9e19db92b4e31ba9ULL, 0x6c07a2c26a8346d1ULL, 0xc5a05277621be293ULL, 0xc7098b7305241885ULL,
+};
+
+//! Powers of ten exactly representable as 64-bit floats
+static const float64_t string_pow10_float64[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+//! Floating point format parameters
+typedef struct {
+	//! Number of explicit mantissa bits
+	int mantissa_bits;
+	//! Negated exponent bias
+	int minimum_exponent;
+	//! Biased exponent of infinity
+	int infinite_power;
+	//! Bit position of sign
+	int sign_shift;
+	//! Smallest decimal exponent that can give a nonzero value with a 64-bit decimal mantissa
+	int smallest_power_of_ten;
+	//! Largest decimal exponent that can give a finite value
+	int largest_power_of_ten;
+	//! Decimal exponent range where exact halfway cases can occur for a 64-bit decimal mantissa
+	int min_round_even;
+	int max_round_even;
+} string_binary_format_t;
+
+static const string_binary_format_t string_binary64 = {52, -1023, 0x7FF, 63, -342, 308, -4, 23};
+static const string_binary_format_t string_binary32 = {23, -127, 0xFF, 31, -64, 38, -17, 10};
+
+//! Decimal floating point value, mantissa * 10^exponent
+typedef struct {
+	uint64_t mantissa;
+	int32_t exponent;
+} string_decimal_t;
+
+//! Binary floating point value as mantissa without implicit bit and biased exponent
+typedef struct {
+	uint64_t mantissa;
+	int32_t power2;
+} string_binary_t;
+
+//! Big unsigned integer in little endian 32-bit words
+typedef struct {
+	unsigned int size;
+	uint32_t word[STRING_BIGNUM_WORDS];
+} string_bignum_t;
+
+//! Full 64x64 to 128 bit multiplication, returning low word and storing high word
+static FOUNDATION_FORCEINLINE uint64_t
+string_mul128(uint64_t a, uint64_t b, uint64_t* high) {
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t product = (__uint128_t)a * b;
+	*high = (uint64_t)(product >> 64);
+	return (uint64_t)product;
+#elif FOUNDATION_COMPILER_MSVC && FOUNDATION_ARCH_X86_64
+	return _umul128(a, b, high);
+#else
+	const uint64_t a_low = a & 0xFFFFFFFFULL, a_high = a >> 32;
+	const uint64_t b_low = b & 0xFFFFFFFFULL, b_high = b >> 32;
+	const uint64_t low_low = a_low * b_low;
+	const uint64_t high_low = a_high * b_low;
+	const uint64_t low_high = a_low * b_high;
+	const uint64_t cross = (low_low >> 32) + (high_low & 0xFFFFFFFFULL) + low_high;
+	*high = (a_high * b_high) + (high_low >> 32) + (cross >> 32);
+	return (cross << 32) | (low_low & 0xFFFFFFFFULL);
+#endif
+}
+
+//! Number of leading zero bits in a nonzero value
+static FOUNDATION_FORCEINLINE unsigned int
+string_leading_zeros64(uint64_t value) {
+#if FOUNDATION_COMPILER_MSVC && (FOUNDATION_ARCH_X86_64 || FOUNDATION_ARCH_ARM_64)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return 63U - (unsigned int)index;
+#elif FOUNDATION_COMPILER_MSVC
+	unsigned long index;
+	if (_BitScanReverse(&index, (unsigned long)(value >> 32)))
+		return 31U - (unsigned int)index;
+	_BitScanReverse(&index, (unsigned long)value);
+	return 63U - (unsigned int)index;
+#else
+	return (unsigned int)__builtin_clzll(value);
+#endif
+}
+
+//! Number of bits in 5^e, valid for 0 <= e <= 3528
+static FOUNDATION_FORCEINLINE int32_t
+string_pow5_bits(int32_t e) {
+	return (int32_t)(((uint32_t)e * 1217359U) >> 19) + 1;
+}
+
+//! floor(log10(2^e)), valid for 0 <= e <= 1650
+static FOUNDATION_FORCEINLINE int32_t
+string_log10_pow2(int32_t e) {
+	return (int32_t)(((uint32_t)e * 78913U) >> 18);
+}
+
+//! floor(log10(5^e)), valid for 0 <= e <= 2620
+static FOUNDATION_FORCEINLINE int32_t
+string_log10_pow5(int32_t e) {
+	return (int32_t)(((uint32_t)e * 732923U) >> 20);
+}
+
+//! 5^i truncated to STRING_POW5_BITCOUNT bits, low word first
+static FOUNDATION_FORCEINLINE void
+string_pow5_split(int32_t i, uint64_t* mul) {
+	const uint64_t* pow5 = string_pow5_128 + 2 * (i - STRING_POW5_MIN);
+	mul[0] = (pow5[1] >> 3) | (pow5[0] << 61);
+	mul[1] = pow5[0] >> 3;
+}
+
+//! Reciprocal of 5^i rounded up to STRING_POW5_BITCOUNT bits, low word first
+static FOUNDATION_FORCEINLINE void
+string_pow5_inv_split(int32_t i, uint64_t* mul) {
+	const uint64_t* pow5 = string_pow5_128 + 2 * (-i - STRING_POW5_MIN);
+	if (!i) {
+		mul[0] = 1;
+		mul[1] = 1ULL << 61;
+		return;
+	}
+	// Table values for small powers are exactly rounded up, undo that before truncating
+	const uint64_t low = pow5[1] - ((i <= 27) ? 1 : 0);
+	mul[0] = (low >> 3) | (pow5[0] << 61);
+	mul[1] = pow5[0] >> 3;
+	if (!++mul[0])
+		++mul[1];
+}
+
+//! (m * mul) >> j for a 128-bit multiplier and 64 < j < 128
+static FOUNDATION_FORCEINLINE uint64_t
+string_mul_shift64(uint64_t m, const uint64_t* mul, int32_t j) {
+	uint64_t low_high, high;
+	string_mul128(m, mul[0], &low_high);
+	const uint64_t low = string_mul128(m, mul[1], &high) + low_high;
+	if (low < low_high)
+		++high;
+	return (high << (128 - j)) | (low >> (j - 64));
+}
+
+//! (m * factor) >> shift for a 64-bit multiplier and 32 < shift < 96
+static FOUNDATION_FORCEINLINE uint32_t
+string_mul_shift32(uint32_t m, uint64_t factor, int32_t shift) {
+	const uint64_t low = (uint64_t)m * (uint32_t)factor;
+	const uint64_t high = (uint64_t)m * (uint32_t)(factor >> 32);
+	return (uint32_t)(((low >> 32) + high) >> (shift - 32));
+}
+
+static FOUNDATION_FORCEINLINE bool
+string_multiple_of_pow5(uint64_t value, int32_t power) {
+	int32_t count = 0;
+	while (value && !(value % 5)) {
+		value /= 5;
+		++count;
+	}
+	return count >= power;
+}
+
+static FOUNDATION_FORCEINLINE bool
+string_multiple_of_pow2(uint64_t value, int32_t power) {
+	return !(value & ((1ULL << power) - 1));
+}
+
+//! Remove digits from the scaled interval [vm, vp] around vr while the interval contains a shorter
+//! representation, rounding the result correctly
+static string_decimal_t
+string_decimal_shortest(uint64_t vr, uint64_t vp, uint64_t vm, int32_t e10, bool accept_bounds,
+                        bool vm_trailing_zeros, bool vr_trailing_zeros, uint32_t last_removed) {
+	string_decimal_t decimal;
+	int32_t removed = 0;
+	if (vm_trailing_zeros || vr_trailing_zeros) {
+		while ((vp / 10) > (vm / 10)) {
+			vm_trailing_zeros &= !(vm % 10);
+			vr_trailing_zeros &= !last_removed;
+			last_removed = (uint32_t)(vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++removed;
+		}
+		if (vm_trailing_zeros) {
+			while (!(vm % 10)) {
+				vr_trailing_zeros &= !last_removed;
+				last_removed = (uint32_t)(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				++removed;
+			}
+		}
+		// Round to even if the exact value is ...50...0
+		if (vr_trailing_zeros && (last_removed == 5) && !(vr % 2))
+			last_removed = 4;
+		decimal.mantissa = vr + (((vr == vm) && (!accept_bounds || !vm_trailing_zeros)) || (last_removed >= 5));
+	} else {
+		if ((vp / 100) > (vm / 100)) {
+			last_removed = (uint32_t)((vr % 100) / 10);
+			vr /= 100;
+			vp /= 100;
+			vm /= 100;
+			removed += 2;
+		}
+		while ((vp / 10) > (vm / 10)) {
+			last_removed = (uint32_t)(vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++removed;
+		}
+		decimal.mantissa = vr + ((vr == vm) || (last_removed >= 5));
+	}
+	decimal.exponent = e10 + removed;
+	return decimal;
+}
+
+//! Shortest decimal in the rounding interval of a finite nonzero 64-bit float
+static string_decimal_t
+string_float64_shortest(uint64_t ieee_mantissa, uint32_t ieee_exponent) {
+	int32_t e2, e10;
+	uint64_t m2, vr, vp, vm;
+	uint64_t mul[2];
+	bool vm_trailing_zeros = false;
+	bool vr_trailing_zeros = false;
+	if (!ieee_exponent) {
+		e2 = 1 - 1023 - 52 - 2;
+		m2 = ieee_mantissa;
+	} else {
+		e2 = (int32_t)ieee_exponent - 1023 - 52 - 2;
+		m2 = (1ULL << 52) | ieee_mantissa;
+	}
+	const bool accept_bounds = !(m2 & 1);
+	const uint64_t mv = 4 * m2;
+	const uint64_t mm_shift = (ieee_mantissa || (ieee_exponent <= 1)) ? 1 : 0;
+
+	if (e2 >= 0) {
+		// Keep one extra digit to know the last removed digit
+		const int32_t q = string_log10_pow2(e2) - (e2 > 3);
+		const int32_t k = STRING_POW5_BITCOUNT + string_pow5_bits(q) - 1;
+		const int32_t i = -e2 + q + k;
+		e10 = q;
+		string_pow5_inv_split(q, mul);
+		vr = string_mul_shift64(mv, mul, i);
+		vp = string_mul_shift64(mv + 2, mul, i);
+		vm = string_mul_shift64(mv - 1 - mm_shift, mul, i);
+		if (q <= 21) {
+			if (!(mv % 5))
+				vr_trailing_zeros = string_multiple_of_pow5(mv, q);
+			else if (accept_bounds)
+				vm_trailing_zeros = string_multiple_of_pow5(mv - 1 - mm_shift, q);
+			else
+				vp -= string_multiple_of_pow5(mv + 2, q) ? 1 : 0;
+		}
+	} else {
+		const int32_t q = string_log10_pow5(-e2) - (-e2 > 1);
+		const int32_t i = -e2 - q;
+		const int32_t k = string_pow5_bits(i) - STRING_POW5_BITCOUNT;
+		const int32_t j = q - k;
+		e10 = q + e2;
+		string_pow5_split(i, mul);
+		vr = string_mul_shift64(mv, mul, j);
+		vp = string_mul_shift64(mv + 2, mul, j);
+		vm = string_mul_shift64(mv - 1 - mm_shift, mul, j);
+		if (q <= 1) {
+			vr_trailing_zeros = true;
+			if (accept_bounds)
+				vm_trailing_zeros = (mm_shift == 1);
+			else
+				--vp;
+		} else if (q < 63) {
+			vr_trailing_zeros = string_multiple_of_pow2(mv, q);
+		}
+	}
+
+	return string_decimal_shortest(vr, vp, vm, e10, accept_bounds, vm_trailing_zeros, vr_trailing_zeros, 0);
+}
+
+//! Shortest decimal in the rounding interval of a finite nonzero 32-bit float
+static string_decimal_t
+string_float32_shortest(uint32_t ieee_mantissa, uint32_t ieee_exponent) {
+	int32_t e2, e10;
+	uint32_t m2, vr, vp, vm;
+	uint32_t last_removed = 0;
+	uint64_t mul[2];
+	bool vm_trailing_zeros = false;
+	bool vr_trailing_zeros = false;
+	if (!ieee_exponent) {
+		e2 = 1 - 127 - 23 - 2;
+		m2 = ieee_mantissa;
+	} else {
+		e2 = (int32_t)ieee_exponent - 127 - 23 - 2;
+		m2 = (1U << 23) | ieee_mantissa;
+	}
+	const bool accept_bounds = !(m2 & 1);
+	const uint32_t mv = 4 * m2;
+	const uint32_t mp = 4 * m2 + 2;
+	const uint32_t mm_shift = (ieee_mantissa || (ieee_exponent <= 1)) ? 1 : 0;
+	const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+	// Uses the high word of the 64-bit float multipliers
+	if (e2 >= 0) {
+		const int32_t q = string_log10_pow2(e2);
+		const int32_t k = STRING_POW5_BITCOUNT - 64 + string_pow5_bits(q) - 1;
+		const int32_t i = -e2 + q + k;
+		e10 = q;
+		string_pow5_inv_split(q, mul);
+		vr = string_mul_shift32(mv, mul[1] + 1, i);
+		vp = string_mul_shift32(mp, mul[1] + 1, i);
+		vm = string_mul_shift32(mm, mul[1] + 1, i);
+		if (q && (((vp - 1) / 10) <= (vm / 10))) {
+			// The loop below removes no digits, compute the last removed digit separately
+			const int32_t l = STRING_POW5_BITCOUNT - 64 + string_pow5_bits(q - 1) - 1;
+			string_pow5_inv_split(q - 1, mul);
+			last_removed = string_mul_shift32(mv, mul[1] + 1, -e2 + q - 1 + l) % 10;
+		}
+		if (q <= 9) {
+			if (!(mv % 5))
+				vr_trailing_zeros = string_multiple_of_pow5(mv, q);
+			else if (accept_bounds)
+				vm_trailing_zeros = string_multiple_of_pow5(mm, q);
+			else
+				vp -= string_multiple_of_pow5(mp, q) ? 1 : 0;
+		}
+	} else {
+		const int32_t q = string_log10_pow5(-e2);
+		const int32_t i = -e2 - q;
+		const int32_t k = string_pow5_bits(i) - (STRING_POW5_BITCOUNT - 64);
+		const int32_t j = q - k;
+		e10 = q + e2;
+		string_pow5_split(i, mul);
+		vr = string_mul_shift32(mv, mul[1], j);
+		vp = string_mul_shift32(mp, mul[1], j);
+		vm = string_mul_shift32(mm, mul[1], j);
+		if (q && (((vp - 1) / 10) <= (vm / 10))) {
+			const int32_t l = q - 1 - (string_pow5_bits(i + 1) - (STRING_POW5_BITCOUNT - 64));
+			string_pow5_split(i + 1, mul);
+			last_removed = string_mul_shift32(mv, mul[1], l) % 10;
+		}
+		if (q <= 1) {
+			vr_trailing_zeros = true;
+			if (accept_bounds)
+				vm_trailing_zeros = (mm_shift == 1);
+			else
+				--vp;
+		} else if (q < 31) {
+			vr_trailing_zeros = string_multiple_of_pow2(mv, q - 1);
+		}
+	}
+
+	return string_decimal_shortest(vr, vp, vm, e10, accept_bounds, vm_trailing_zeros, vr_trailing_zeros,
+	                               last_removed);
+}
+
+static void
+string_bignum_set(string_bignum_t* num, uint64_t value) {
+	num->word[0] = (uint32_t)value;
+	num->word[1] = (uint32_t)(value >> 32);
+	num->size = (value >> 32) ? 2 : (value ? 1 : 0);
+}
+
+static void
+string_bignum_mul32(string_bignum_t* num, uint32_t factor) {
+	uint64_t carry = 0;
+	for (unsigned int i = 0; i < num->size; ++i) {
+		const uint64_t product = ((uint64_t)num->word[i] * factor) + carry;
+		num->word[i] = (uint32_t)product;
+		carry = product >> 32;
+	}
+	if (carry) {
+		FOUNDATION_ASSERT(num->size < STRING_BIGNUM_WORDS);
+		num->word[num->size++] = (uint32_t)carry;
+	}
+}
+
+static void
+string_bignum_add32(string_bignum_t* num, uint32_t value) {
+	for (unsigned int i = 0; value && (i < num->size); ++i) {
+		const uint64_t sum = (uint64_t)num->word[i] + value;
+		num->word[i] = (uint32_t)sum;
+		value = (uint32_t)(sum >> 32);
+	}
+	if (value) {
+		FOUNDATION_ASSERT(num->size < STRING_BIGNUM_WORDS);
+		num->word[num->size++] = value;
+	}
+}
+
+static void
+string_bignum_mul_pow5(string_bignum_t* num, unsigned int power) {
+	static const uint32_t pow5[] = {1,       5,        25,        125,        625,      3125,     15625,
+	                                78125,   390625,   1953125,   9765625,    48828125, 244140625};
+	while (power >= 13) {
+		string_bignum_mul32(num, 1220703125U);
+		power -= 13;
+	}
+	if (power)
+		string_bignum_mul32(num, pow5[power]);
+}
+
+static void
+string_bignum_shift_left(string_bignum_t* num, unsigned int bits) {
+	const unsigned int words = bits / 32;
+	const unsigned int shift = bits % 32;
+	unsigned int i = num->size;
+	if (!i)
+		return;
+	FOUNDATION_ASSERT(num->size + words < STRING_BIGNUM_WORDS);
+	if (shift) {
+		num->word[i + words] = num->word[i - 1] >> (32 - shift);
+		while (--i)
+			num->word[i + words] = (num->word[i] << shift) | (num->word[i - 1] >> (32 - shift));
+		num->word[words] = num->word[0] << shift;
+		num->size += words + 1;
+		if (!num->word[num->size - 1])
+			--num->size;
+	} else {
+		while (i--)
+			num->word[i + words] = num->word[i];
+		num->size += words;
+	}
+	memset(num->word, 0, sizeof(uint32_t) * words);
+}
+
+static int
+string_bignum_compare(const string_bignum_t* lhs, const string_bignum_t* rhs) {
+	if (lhs->size != rhs->size)
+		return (lhs->size > rhs->size) ? 1 : -1;
+	for (unsigned int i = lhs->size; i-- > 0;) {
+		if (lhs->word[i] != rhs->word[i])
+			return (lhs->word[i] > rhs->word[i]) ? 1 : -1;
+	}
+	return 0;
+}
+
+static void
+string_bignum_copy(string_bignum_t* dst, const string_bignum_t* src) {
+	dst->size = src->size;
+	memcpy(dst->word, src->word, sizeof(uint32_t) * src->size);
+}
+
+//! Subtract rhs from lhs, which must be greater than or equal to rhs
+static void
+string_bignum_subtract(string_bignum_t* lhs, const string_bignum_t* rhs) {
+	uint64_t borrow = 0;
+	for (unsigned int i = 0; i < lhs->size; ++i) {
+		const uint64_t diff = (uint64_t)lhs->word[i] - ((i < rhs->size) ? rhs->word[i] : 0) - borrow;
+		lhs->word[i] = (uint32_t)diff;
+		borrow = diff >> 63;
+	}
+	while (lhs->size && !lhs->word[lhs->size - 1])
+		--lhs->size;
+}
+
+//! Divide value by scale where value is less than 10 * scale, returning the quotient and storing the
+//! remainder in value. The most significant word of scale must be in [2^27, 2^28) so the quotient
+//! estimate from the most significant words is off by at most one
+static uint32_t
+string_bignum_divide_digit(string_bignum_t* value, const string_bignum_t* scale) {
+	const unsigned int size = scale->size;
+	if (value->size < size)
+		return 0;
+	uint32_t quotient = value->word[size - 1] / (scale->word[size - 1] + 1);
+	if (quotient) {
+		uint64_t carry = 0;
+		uint64_t borrow = 0;
+		for (unsigned int i = 0; i < size; ++i) {
+			const uint64_t product = ((uint64_t)scale->word[i] * quotient) + carry;
+			const uint64_t diff = (uint64_t)value->word[i] - (uint32_t)product - borrow;
+			carry = product >> 32;
+			value->word[i] = (uint32_t)diff;
+			borrow = diff >> 63;
+		}
+		while (value->size && !value->word[value->size - 1])
+			--value->size;
+	}
+	if (string_bignum_compare(value, scale) >= 0) {
+		string_bignum_subtract(value, scale);
+		++quotient;
+	}
+	return quotient;
+}
+
+//! Write decimal digits of a nonzero value without trailing zeros, returning the number of
+//! digits and storing the number of trailing zeros removed
+static unsigned int
+string_float_digits(char* digits, uint64_t value, int32_t* removed) {
+	char buffer[20];
+	unsigned int count;
+	*removed = 0;
+	while (!(value % 10)) {
+		value /= 10;
+		++(*removed);
+	}
+	count = string_digits_backward(buffer + sizeof(buffer), value);
+	memcpy(digits, buffer + sizeof(buffer) - count, count);
+	return count;
+}
+
+//! Increment the last of the given digits with carry, returning new number of digits
+static unsigned int
+string_float_round_up(char* digits, unsigned int count, int32_t* exponent) {
+	unsigned int last = count;
+	while (last && (digits[last - 1] == '9'))
+		--last;
+	if (!last) {
+		digits[0] = '1';
+		++(*exponent);
+		return 1;
+	}
+	++digits[last - 1];
+	return last;
+}
+
+//! Round the digits of the shortest representation to the given precision. Returns zero if
+//! this is not possible and the exact value must be used instead, which is the case if the
+//! precision requires more digits than the type always represents exactly (none for subnormal
+//! values) or if the shortest representation is exactly halfway
+static unsigned int
+string_float_round_shortest(char* digits, unsigned int count, int32_t* exponent, unsigned int precision,
+                            unsigned int exact_digits) {
+	if (count <= precision)
+		return (precision <= exact_digits) ? count : 0;
+	if ((digits[precision] == '5') && (count == precision + 1))
+		return 0;
+	count = precision;
+	if (digits[precision] >= '5')
+		count = string_float_round_up(digits, count, exponent);
+	while ((count > 1) && (digits[count - 1] == '0'))
+		--count;
+	return count;
+}
+
+//! Generate digits of m * 2^e2 correctly rounded to the given precision with round half to even,
+//! returning the number of digits without trailing zeros and storing the decimal exponent of the
+//! first digit
+static unsigned int
+string_float_digits_exact(char* digits, uint64_t mantissa, int32_t e2, unsigned int precision, int32_t* exponent) {
+	string_bignum_t value, scale, scale10;
+	unsigned int count = 0;
+	const int32_t top = e2 + 63 - (int32_t)string_leading_zeros64(mantissa);
+	int32_t k = (top >= 0) ? (int32_t)(((uint32_t)top * 78913U) >> 18) :
+	                         -(int32_t)((((uint32_t)-top * 78913U) + 262143U) >> 18);
+
+	string_bignum_set(&value, mantissa);
+	string_bignum_set(&scale, 1);
+	if (e2 >= 0)
+		string_bignum_shift_left(&value, (unsigned int)e2);
+	else
+		string_bignum_shift_left(&scale, (unsigned int)-e2);
+	if (k >= 0) {
+		string_bignum_mul_pow5(&scale, (unsigned int)k);
+		string_bignum_shift_left(&scale, (unsigned int)k);
+	} else {
+		string_bignum_mul_pow5(&value, (unsigned int)-k);
+		string_bignum_shift_left(&value, (unsigned int)-k);
+	}
+
+	// Adjust the estimated exponent so that 1 <= value / scale < 10
+	while (string_bignum_compare(&value, &scale) < 0) {
+		string_bignum_mul32(&value, 10);
+		--k;
+	}
+	while (true) {
+		string_bignum_copy(&scale10, &scale);
+		string_bignum_mul32(&scale10, 10);
+		if (string_bignum_compare(&value, &scale10) < 0)
+			break;
+		string_bignum_copy(&scale, &scale10);
+		++k;
+	}
+
+	// Normalize the most significant word of scale for the quotient digit estimate
+	const unsigned int top_bit = 63U - string_leading_zeros64(scale.word[scale.size - 1]);
+	const unsigned int normalize = (top_bit <= 27) ? (27 - top_bit) : (59 - top_bit);
+	string_bignum_shift_left(&value, normalize);
+	string_bignum_shift_left(&scale, normalize);
+
+	while (true) {
+		const uint32_t digit = string_bignum_divide_digit(&value, &scale);
+		digits[count++] = (char)('0' + digit);
+		if (!value.size)
+			break;
+		if (count == precision) {
+			int compare;
+			string_bignum_shift_left(&value, 1);
+			compare = string_bignum_compare(&value, &scale);
+			if ((compare > 0) || (!compare && (digit & 1)))
+				count = string_float_round_up(digits, count, &k);
+			break;
+		}
+		string_bignum_mul32(&value, 10);
+	}
+
+	while ((count > 1) && (digits[count - 1] == '0'))
+		--count;
+	*exponent = k;
+	return count;
+}
+
+//! Lay out sign and significant digits with the decimal exponent of the first digit using the
+//! printf %g notation rules for the given precision, returning the length of the string
+static size_t
+string_float_layout(char* out, bool negative, const char* digits, unsigned int count, int32_t exponent,
+                    unsigned int precision) {
+	char* dst = out;
+	if (negative)
+		*dst++ = '-';
+	if ((exponent < -4) || (exponent >= (int32_t)precision)) {
+		*dst++ = digits[0];
+		if (count > 1) {
+			*dst++ = '.';
+			memcpy(dst, digits + 1, count - 1);
+			dst += count - 1;
+		}
+		*dst++ = 'e';
+		*dst++ = (exponent < 0) ? '-' : '+';
+		if (exponent < 0)
+			exponent = -exponent;
+		if (exponent >= 100) {
+			*dst++ = (char)('0' + (exponent / 100));
+			exponent %= 100;
+		}
+		*dst++ = (char)('0' + (exponent / 10));
+		*dst++ = (char)('0' + (exponent % 10));
+	} else if (exponent < 0) {
+		*dst++ = '0';
+		*dst++ = '.';
+		memset(dst, '0', (size_t)(-exponent - 1));
+		dst += -exponent - 1;
+		memcpy(dst, digits, count);
+		dst += count;
+	} else {
+		const unsigned int integer = (unsigned int)exponent + 1;
+		if (count <= integer) {
+			memcpy(dst, digits, count);
+			memset(dst + count, '0', integer - count);
+			dst += integer;
+		} else {
+			memcpy(dst, digits, integer);
+			dst += integer;
+			*dst++ = '.';
+			memcpy(dst, digits + integer, count - integer);
+			dst += count - integer;
+		}
+	}
+	return (size_t)(dst - out);
+}
+
+static size_t
+string_float_special(char* out, bool negative, bool nan) {
+	size_t length = 0;
+	if (negative)
+		out[length++] = '-';
+	memcpy(out + length, nan ? "nan" : "inf", 3);
+	return length + 3;
+}
+
+//! Format in printf %.*g notation, shortest round trip representation if precision is zero
+static size_t
+string_float64_format(char* out, float64_t val, unsigned int precision) {
+	char digits[STRING_FLOAT_DIGITS_MAX];
+	float64_cast_t conv;
+	conv.fval = val;
+	const bool negative = (conv.uival >> 63) != 0;
+	const uint64_t ieee_mantissa = conv.uival & ((1ULL << 52) - 1);
+	const uint32_t ieee_exponent = (uint32_t)(conv.uival >> 52) & 0x7FF;
+	if (ieee_exponent == 0x7FF)
+		return string_float_special(out, negative, ieee_mantissa != 0);
+	if (!ieee_exponent && !ieee_mantissa) {
+		out[0] = '0';
+		return 1;
+	}
+
+	int32_t exponent;
+	const string_decimal_t decimal = string_float64_shortest(ieee_mantissa, ieee_exponent);
+	unsigned int count = string_float_digits(digits, decimal.mantissa, &exponent);
+	exponent += decimal.exponent + (int32_t)count - 1;
+	if (!precision)
+		return string_float_layout(out, negative, digits, count, exponent, DBL_DECIMAL_DIG);
+
+	if (precision > STRING_FLOAT_DIGITS_MAX)
+		precision = STRING_FLOAT_DIGITS_MAX;
+	count = string_float_round_shortest(digits, count, &exponent, precision, ieee_exponent ? DBL_DIG : 0);
+	if (!count) {
+		const uint64_t mantissa = ieee_exponent ? (ieee_mantissa | (1ULL << 52)) : ieee_mantissa;
+		const int32_t e2 = ieee_exponent ? ((int32_t)ieee_exponent - 1075) : -1074;
+		count = string_float_digits_exact(digits, mantissa, e2, precision, &exponent);
+	}
+	return string_float_layout(out, negative, digits, count, exponent, precision);
+}
+
+//! Format in printf %.*g notation, shortest round trip representation if precision is zero
+static size_t
+string_float32_format(char* out, float32_t val, unsigned int precision) {
+	char digits[STRING_FLOAT_DIGITS_MAX];
+	float32_cast_t conv;
+	conv.fval = val;
+	const bool negative = (conv.uival >> 31) != 0;
+	const uint32_t ieee_mantissa = conv.uival & ((1U << 23) - 1);
+	const uint32_t ieee_exponent = (conv.uival >> 23) & 0xFF;
+	if (ieee_exponent == 0xFF)
+		return string_float_special(out, negative, ieee_mantissa != 0);
+	if (!ieee_exponent && !ieee_mantissa) {
+		out[0] = '0';
+		return 1;
+	}
+
+	int32_t exponent;
+	const string_decimal_t decimal = string_float32_shortest(ieee_mantissa, ieee_exponent);
+	unsigned int count = string_float_digits(digits, decimal.mantissa, &exponent);
+	exponent += decimal.exponent + (int32_t)count - 1;
+	if (!precision)
+		return string_float_layout(out, negative, digits, count, exponent, FLT_DECIMAL_DIG);
+
+	if (precision > STRING_FLOAT_DIGITS_MAX)
+		precision = STRING_FLOAT_DIGITS_MAX;
+	count = string_float_round_shortest(digits, count, &exponent, precision, ieee_exponent ? FLT_DIG : 0);
+	if (!count) {
+		const uint64_t mantissa = ieee_exponent ? (ieee_mantissa | (1U << 23)) : ieee_mantissa;
+		const int32_t e2 = ieee_exponent ? ((int32_t)ieee_exponent - 150) : -149;
+		count = string_float_digits_exact(digits, mantissa, e2, precision, &exponent);
+	}
+	return string_float_layout(out, negative, digits, count, exponent, precision);
 }
 
-#if BUILD_MAX_PATHLEN > 132
-#define THREAD_BUFFER_SIZE BUILD_MAX_PATHLEN
-#else
-#define THREAD_BUFFER_SIZE 132
-#endif
-FOUNDATION_DECLARE_THREAD_LOCAL_ARRAY(char, convert_buffer, THREAD_BUFFER_SIZE)
+//! Eisel-Lemire conversion of w * 10^q to the nearest binary float, exact for any nonzero w
+static string_binary_t
+string_float_compute(const string_binary_format_t* format, int64_t q, uint64_t w) {
+	string_binary_t answer;
+	if (!w || (q < format->smallest_power_of_ten)) {
+		answer.mantissa = 0;
+		answer.power2 = 0;
+		return answer;
+	}
+	if (q > format->largest_power_of_ten) {
+		answer.mantissa = 0;
+		answer.power2 = format->infinite_power;
+		return answer;
+	}
 
-string_t
-string_from_int(char* buffer, size_t capacity, int64_t val, unsigned int width, char fill) {
-	int len;
-	if (!capacity)
-		return (string_t){buffer, 0};
-	len = snprintf(buffer, capacity, "%" PRId64, val);
-	if ((unsigned int)len >= capacity) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
+	const int lz = (int)string_leading_zeros64(w);
+	const uint64_t* pow5 = string_pow5_128 + 2 * (q - STRING_POW5_MIN);
+	uint64_t high;
+	w <<= lz;
+	uint64_t low = string_mul128(w, pow5[0], &high);
+	const uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFULL >> (format->mantissa_bits + 3);
+	if ((high & precision_mask) == precision_mask) {
+		// Product might be inexact in the bits that matter, add in the next 64 bits of the power
+		uint64_t second_high;
+		string_mul128(w, pow5[1], &second_high);
+		low += second_high;
+		if (second_high > low)
+			++high;
 	}
-	if (width >= capacity)
-		width = (unsigned int)capacity - 1;
-	if ((unsigned int)len < width) {
-		size_t diff = width - (unsigned int)len;
-		memmove(buffer + diff, buffer, (unsigned int)(len + 1));
-		memset(buffer, fill, diff);
-		return (string_t){buffer, width};
+
+	const int upperbit = (int)(high >> 63);
+	const int shift = upperbit + 64 - format->mantissa_bits - 3;
+	answer.mantissa = high >> shift;
+	answer.power2 = (int32_t)(((217706 * (int32_t)q) >> 16) + 63 + upperbit - lz - format->minimum_exponent);
+	if (answer.power2 <= 0) {
+		// Subnormal, or zero if all bits are below the minimum exponent
+		if (-answer.power2 + 1 >= 64) {
+			answer.mantissa = 0;
+			answer.power2 = 0;
+			return answer;
+		}
+		answer.mantissa >>= -answer.power2 + 1;
+		answer.mantissa += (answer.mantissa & 1);
+		answer.mantissa >>= 1;
+		// Rounding can make the value normal again
+		answer.power2 = (answer.mantissa < (1ULL << format->mantissa_bits)) ? 0 : 1;
+		return answer;
 	}
-	return (string_t){buffer, (unsigned int)len};
-}
 
-string_const_t
-string_from_int_static(int64_t val, unsigned int width, char fill) {
-	return string_to_const(string_from_int(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val, width, fill));
+	// Round half to even if the value is exactly halfway, which requires 5^q to fit in 64 bits
+	if ((low <= 1) && (q >= format->min_round_even) && (q <= format->max_round_even) &&
+	    ((answer.mantissa & 3) == 1)) {
+		if ((answer.mantissa << shift) == high)
+			answer.mantissa &= ~1ULL;
+	}
+	answer.mantissa += (answer.mantissa & 1);
+	answer.mantissa >>= 1;
+	if (answer.mantissa >= (2ULL << format->mantissa_bits)) {
+		answer.mantissa = 1ULL << format->mantissa_bits;
+		++answer.power2;
+	}
+	answer.mantissa &= ~(1ULL << format->mantissa_bits);
+	if (answer.power2 >= format->infinite_power) {
+		answer.mantissa = 0;
+		answer.power2 = format->infinite_power;
+	}
+	return answer;
 }
 
-string_t
-string_from_uint(char* buffer, size_t capacity, uint64_t val, bool hex, unsigned int width, char fill) {
-	int len;
-	if (!capacity)
-		return (string_t){buffer, 0};
-	len = snprintf(buffer, capacity, hex ? "%" PRIx64 : "%" PRIu64, val);
-	if ((unsigned int)len >= capacity) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
+//! Decide rounding between the given value and the next larger value by exact comparison of all
+//! parsed decimal digits scaled by 10^exponent with the halfway point between the two values
+static string_binary_t
+string_float_compare_digits(const string_binary_format_t* format, string_binary_t lower, const char* digits,
+                            const char* digits_end, int64_t exponent) {
+	static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+	string_bignum_t decimal, halfway;
+	uint32_t chunk = 0;
+	unsigned int chunk_digits = 0;
+	unsigned int count = 0;
+	bool fraction = false;
+	bool inexact = false;
+	int compare;
+
+	decimal.size = 0;
+	for (; digits < digits_end; ++digits) {
+		const uint32_t digit = (uint32_t)(*digits - '0');
+		if (*digits == '.') {
+			fraction = true;
+			continue;
+		}
+		if (count < STRING_FLOAT_PARSE_DIGITS) {
+			if (fraction)
+				--exponent;
+			if (!count && !digit)
+				continue;
+			chunk = (chunk * 10) + digit;
+			++count;
+			if (++chunk_digits == 9) {
+				string_bignum_mul32(&decimal, 1000000000U);
+				string_bignum_add32(&decimal, chunk);
+				chunk = 0;
+				chunk_digits = 0;
+			}
+		} else {
+			if (!fraction)
+				++exponent;
+			inexact |= (digit != 0);
+		}
 	}
-	if (width >= capacity)
-		width = (unsigned int)capacity - 1;
-	if ((unsigned int)len < width) {
-		size_t diff = width - (unsigned int)len;
-		memmove(buffer + diff, buffer, (unsigned int)(len + 1));
-		memset(buffer, fill, diff);
-		return (string_t){buffer, width};
+	if (chunk_digits) {
+		string_bignum_mul32(&decimal, pow10[chunk_digits]);
+		string_bignum_add32(&decimal, chunk);
 	}
-	return (string_t){buffer, (unsigned int)len};
-}
 
-string_const_t
-string_from_uint_static(uint64_t val, bool hex, unsigned int width, char fill) {
-	return string_to_const(string_from_uint(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val, hex, width, fill));
+	// Halfway point (2m + 1) * 2^(e - 1) for lower value m * 2^e
+	uint64_t mantissa = lower.mantissa;
+	int64_t binary = lower.power2 + format->minimum_exponent - format->mantissa_bits - 1;
+	if (lower.power2)
+		mantissa |= (1ULL << format->mantissa_bits);
+	else
+		++binary;
+	string_bignum_set(&halfway, (mantissa * 2) + 1);
+
+	// Compare decimal * 5^exponent * 2^exponent with halfway * 2^binary
+	if (exponent >= 0)
+		string_bignum_mul_pow5(&decimal, (unsigned int)exponent);
+	else
+		string_bignum_mul_pow5(&halfway, (unsigned int)-exponent);
+	binary -= exponent;
+	if (binary >= 0)
+		string_bignum_shift_left(&halfway, (unsigned int)binary);
+	else
+		string_bignum_shift_left(&decimal, (unsigned int)-binary);
+
+	compare = string_bignum_compare(&decimal, &halfway);
+	if (!compare && inexact)
+		compare = 1;
+	if ((compare > 0) || (!compare && (mantissa & 1))) {
+		if (++lower.mantissa == (1ULL << format->mantissa_bits)) {
+			lower.mantissa = 0;
+			++lower.power2;
+		}
+	}
+	return lower;
 }
 
-string_t
-string_from_uint128(char* buffer, size_t capacity, const uint128_t val) {
-	int len;
-	if (!capacity)
-		return (string_t){buffer, 0};
-	len = snprintf(buffer, capacity, "%016" PRIx64 "%016" PRIx64, val.word[0], val.word[1]);
-	if ((unsigned int)len >= capacity) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
+//! Round m * 2^e with sticky bits below m to the nearest binary float, m must be nonzero
+static uint64_t
+string_float_from_binary(const string_binary_format_t* format, uint64_t mantissa, int64_t exponent, bool sticky) {
+	const uint64_t infinity = (uint64_t)format->infinite_power << format->mantissa_bits;
+	const unsigned int lz = string_leading_zeros64(mantissa);
+	mantissa <<= lz;
+	exponent -= lz;
+	const int64_t biased = exponent + 63 - format->minimum_exponent;
+	if (biased >= format->infinite_power)
+		return infinity;
+	int64_t shift = 63 - format->mantissa_bits;
+	if (biased <= 0)
+		shift += 1 - biased;
+	if (shift > 64)
+		return 0;
+
+	uint64_t result, remainder, half;
+	if (shift == 64) {
+		result = 0;
+		remainder = mantissa;
+		half = 1ULL << 63;
+	} else {
+		result = mantissa >> shift;
+		remainder = mantissa & ((1ULL << shift) - 1);
+		half = 1ULL << (shift - 1);
 	}
-	return (string_t){buffer, (unsigned int)len};
+	if ((remainder > half) || ((remainder == half) && (sticky || (result & 1))))
+		++result;
+	// Implicit bit of normal values carries into the exponent, as does rounding overflow
+	if (biased > 0)
+		result += (uint64_t)(biased - 1) << format->mantissa_bits;
+	return (result < infinity) ? result : infinity;
 }
 
-string_const_t
-string_from_uint128_static(const uint128_t val) {
-	return string_to_const(string_from_uint128(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val));
+static FOUNDATION_FORCEINLINE bool
+string_float_is_digit(char c) {
+	return (c >= '0') && (c <= '9');
 }
 
-string_t
-string_from_uint256(char* buffer, size_t capacity, const uint256_t val) {
-	int len;
-	if (!capacity)
-		return (string_t){buffer, 0};
-	len = snprintf(buffer, capacity, "%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64, val.word[0], val.word[1],
-	               val.word[2], val.word[3]);
-	if ((unsigned int)len >= capacity) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
-	}
-	return (string_t){buffer, (unsigned int)len};
+static FOUNDATION_FORCEINLINE int
+string_float_hex_digit(char c) {
+	if ((c >= '0') && (c <= '9'))
+		return c - '0';
+	c |= 0x20;
+	if ((c >= 'a') && (c <= 'f'))
+		return c - 'a' + 10;
+	return -1;
 }
 
-string_const_t
-string_from_uint256_static(const uint256_t val) {
-	return string_to_const(string_from_uint256(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val));
+//! Parse optional exponent with the given marker character, saturating large exponents
+static int64_t
+string_float_parse_exponent(const char* cur, const char* end, char marker) {
+	int64_t exponent = 0;
+	bool negative = false;
+	if ((cur >= end) || ((*cur | 0x20) != marker))
+		return 0;
+	++cur;
+	if ((cur < end) && ((*cur == '-') || (*cur == '+')))
+		negative = (*cur++ == '-');
+	for (; (cur < end) && string_float_is_digit(*cur); ++cur) {
+		if (exponent < 0x10000000)
+			exponent = (exponent * 10) + (*cur - '0');
+	}
+	return negative ? -exponent : exponent;
 }
 
-string_t
-string_from_uint512(char* buffer, size_t capacity, const uint512_t val) {
-	int len;
-	if (!capacity)
-		return (string_t){buffer, 0};
-	len = snprintf(
-	    buffer, capacity,
-	    "%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64,
-	    val.word[0], val.word[1], val.word[2], val.word[3], val.word[4], val.word[5], val.word[6], val.word[7]);
-	if ((unsigned int)len >= capacity) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
+//! Parse hexadecimal float digits following the 0x prefix
+static uint64_t
+string_float_parse_hex(const string_binary_format_t* format, const char* cur, const char* end) {
+	uint64_t mantissa = 0;
+	int64_t exponent = 0;
+	bool fraction = false;
+	bool sticky = false;
+	bool any = false;
+	for (; cur < end; ++cur) {
+		const int digit = string_float_hex_digit(*cur);
+		if (digit < 0) {
+			if ((*cur != '.') || fraction)
+				break;
+			fraction = true;
+			continue;
+		}
+		any = true;
+		if (mantissa >> 60) {
+			if (!fraction)
+				exponent += 4;
+			sticky |= (digit != 0);
+		} else {
+			mantissa = (mantissa << 4) | (uint64_t)digit;
+			if (fraction)
+				exponent -= 4;
+		}
 	}
-	return (string_t){buffer, (unsigned int)len};
+	if (!any || !mantissa)
+		return 0;
+	exponent += string_float_parse_exponent(cur, end, 'p');
+	return string_float_from_binary(format, mantissa, exponent, sticky);
 }
 
-string_const_t
-string_from_uint512_static(const uint512_t val) {
-	return string_to_const(string_from_uint512(get_thread_convert_buffer(), THREAD_BUFFER_SIZE, val));
+//! Parse a float with the same syntax as strtod, but locale independent and limited to the given
+//! length, returning the binary representation. Returns zero if no conversion could be made
+static uint64_t
+string_float_parse(const string_binary_format_t* format, const char* str, size_t length) {
+	const char* cur = str;
+	const char* end = str + length;
+	const uint64_t infinity = (uint64_t)format->infinite_power << format->mantissa_bits;
+	uint64_t sign = 0;
+
+	if (!length)
+		return 0;
+	while ((cur < end) && ((*cur == ' ') || ((*cur >= '\t') && (*cur <= '\r'))))
+		++cur;
+	if ((cur < end) && ((*cur == '-') || (*cur == '+'))) {
+		if (*cur++ == '-')
+			sign = 1ULL << format->sign_shift;
+	}
+	if (cur == end)
+		return 0;
+
+	if ((*cur | 0x20) == 'i') {
+		if ((end - cur >= 3) && ((cur[1] | 0x20) == 'n') && ((cur[2] | 0x20) == 'f'))
+			return sign | infinity;
+		return 0;
+	}
+	if ((*cur | 0x20) == 'n') {
+		if ((end - cur >= 3) && ((cur[1] | 0x20) == 'a') && ((cur[2] | 0x20) == 'n'))
+			return sign | infinity | (1ULL << (format->mantissa_bits - 1));
+		return 0;
+	}
+	if ((*cur == '0') && (end - cur >= 2) && ((cur[1] | 0x20) == 'x'))
+		return sign | string_float_parse_hex(format, cur + 2, end);
+
+	// Accumulate the first 19 significant digits, tracking the decimal exponent of the last one
+	const char* digits = cur;
+	uint64_t w = 0;
+	int64_t q = 0;
+	unsigned int significant = 0;
+	bool truncated = false;
+	bool any = false;
+	for (; (cur < end) && string_float_is_digit(*cur); ++cur) {
+		any = true;
+		if (significant < 19) {
+			w = (w * 10) + (uint64_t)(*cur - '0');
+			significant += (w != 0);
+		} else {
+			++q;
+			truncated |= (*cur != '0');
+		}
+	}
+	if ((cur < end) && (*cur == '.')) {
+		for (++cur; (cur < end) && string_float_is_digit(*cur); ++cur) {
+			any = true;
+			if (significant < 19) {
+				w = (w * 10) + (uint64_t)(*cur - '0');
+				significant += (w != 0);
+				--q;
+			} else {
+				truncated |= (*cur != '0');
+			}
+		}
+	}
+	if (!any)
+		return 0;
+	const char* digits_end = cur;
+	const int64_t exponent = string_float_parse_exponent(cur, end, 'e');
+	q += exponent;
+	if (!w)
+		return sign;
+
+	if (!truncated && (format == &string_binary64) && (q >= 0) && (q <= 22) && (w <= (1ULL << 53))) {
+		// Both operands are exact, so the product is correctly rounded
+		float64_cast_t conv;
+		conv.fval = (float64_t)w * string_pow10_float64[q];
+		return sign | conv.uival;
+	}
+
+	string_binary_t answer = string_float_compute(format, q, w);
+	if (truncated) {
+		// Value is between w and w + 1, only ambiguous if they round differently
+		const string_binary_t upper = string_float_compute(format, q, w + 1);
+		if ((answer.mantissa != upper.mantissa) || (answer.power2 != upper.power2))
+			answer = string_float_compare_digits(format, answer, digits, digits_end, exponent);
+	}
+	return sign | answer.mantissa | ((uint64_t)answer.power2 << format->mantissa_bits);
 }
 
 string_t
@@ -1506,101 +4766,19 @@ string_from_real(char* buffer, size_t capacity, real val, unsigned int precision
 string_t
 string_from_float32(char* buffer, size_t capacity, float32_t val, unsigned int precision, unsigned int width,
                     char fill) {
-	unsigned int ulen;
-	size_t end;
-	int len = -1;
+	char str[STRING_FLOAT_BUFFER_SIZE];
 	if (!capacity)
 		return (string_t){buffer, 0};
-	if (precision)
-		len = snprintf(buffer, capacity, "%.*g", precision, (double)val);
-	else
-		len = snprintf(buffer, capacity, "%.*g", FLT_DECIMAL_DIG, (double)val);
-
-	ulen = (unsigned int)len;
-	if ((len < 0) || (ulen >= capacity)) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
-	}
-	if (width >= capacity)
-		width = (unsigned int)capacity - 1;
-
-	end = string_find_last_not_of(buffer, ulen, STRING_CONST("0"), STRING_NPOS);
-	if (end != STRING_NPOS) {
-		if (buffer[end] == '.')
-			--end;
-		if (end != (ulen - 1)) {
-			++end;
-			ulen = (unsigned int)end;
-			buffer[end] = 0;
-		}
-	}
-
-	// Some cleanups
-	if (string_equal(buffer, ulen, "-0", 2) || string_equal(buffer, ulen, "-", 1)) {
-		buffer[0] = '0';
-		buffer[1] = 0;
-		ulen = 1;
-	}
-
-	if (ulen < width) {
-		unsigned int ofs = width - ulen;
-		unsigned int copylen = ulen + 1;
-		memmove(buffer + ofs, buffer, copylen);
-		memset(buffer, fill, ofs);
-		ulen = width;
-	}
-
-	return (string_t){buffer, ulen};
+	return string_convert_output(buffer, capacity, str, string_float32_format(str, val, precision), width, fill);
 }
 
 string_t
 string_from_float64(char* buffer, size_t capacity, float64_t val, unsigned int precision, unsigned int width,
                     char fill) {
-	unsigned int ulen;
-	size_t end;
-	int len = -1;
+	char str[STRING_FLOAT_BUFFER_SIZE];
 	if (!capacity)
 		return (string_t){buffer, 0};
-	if (precision)
-		len = snprintf(buffer, capacity, "%.*lg", precision, val);
-	else
-		len = snprintf(buffer, capacity, "%.*lg", DBL_DECIMAL_DIG, val);
-
-	ulen = (unsigned int)len;
-	if ((len < 0) || (ulen >= capacity)) {
-		buffer[capacity - 1] = 0;
-		return (string_t){buffer, capacity - 1};
-	}
-	if (width >= capacity)
-		width = (unsigned int)capacity - 1;
-
-	end = string_find_last_not_of(buffer, ulen, STRING_CONST("0"), STRING_NPOS);
-	if (end != STRING_NPOS) {
-		if (buffer[end] == '.')
-			--end;
-		if (end != (ulen - 1)) {
-			++end;
-			ulen = (unsigned int)end;
-			buffer[end] = 0;
-		}
-	}
-
-	// Some cleanups
-	if (string_equal(buffer, ulen, "-0", 2) || string_equal(buffer, ulen, "-", 1)) {
-		buffer[0] = '0';
-		buffer[1] = 0;
-		ulen = 1;
-	}
-
-	if (ulen < width) {
-		unsigned int ofs = width - ulen;
-		unsigned int copylen = ulen + 1;
-		memmove(buffer + ofs, buffer, copylen);
-		memset(buffer, fill, ofs);
-		ulen = width;
-	}
-
-	return (string_t){buffer, ulen};
+	return string_convert_output(buffer, capacity, str, string_float64_format(str, val, precision), width, fill);
 }
 
 string_const_t
@@ -1791,24 +4969,16 @@ string_to_uint512(const char* val, size_t length) {
 
 float32_t
 string_to_float32(const char* val, size_t length) {
-	float32_t ret = 0.0f;
-	char buf[32];
-	if (length) {
-		string_copy(buf, sizeof(buf), val, length);
-		ret = (float32_t)strtod(buf, nullptr);
-	}
-	return ret;
+	float32_cast_t conv;
+	conv.uival = (uint32_t)string_float_parse(&string_binary32, val, length);
+	return conv.fval;
 }
 
 float64_t
 string_to_float64(const char* val, size_t length) {
-	float64_t ret = 0.0;
-	char buf[64];
-	if (length) {
-		string_copy(buf, sizeof(buf), val, length);
-		ret = (float64_t)strtod(buf, nullptr);
-	}
-	return ret;
+	float64_cast_t conv;
+	conv.uival = string_float_parse(&string_binary64, val, length);
+	return conv.fval;
 }
 
 ssize_t
@@ -1823,13 +4993,11 @@ string_to_size(const char* val, size_t length, bool hex) {
 
 real
 string_to_real(const char* val, size_t length) {
-	real ret = REAL_C(0.0);
-	char buf[64];
-	if (length) {
-		string_copy(buf, sizeof(buf), val, length);
-		ret = (real)strtod(buf, nullptr);
-	}
-	return ret;
+#if FOUNDATION_SIZE_REAL == 8
+	return string_to_float64(val, length);
+#else
+	return string_to_float32(val, length);
+#endif
 }
 
 version_t
@@ -1861,3 +5029,194 @@ string_thread_buffer(void) {
 	char* buffer = get_thread_convert_buffer();
 	return (string_t){buffer, THREAD_BUFFER_SIZE};
 }
+
+#define STRING_BUILDER_MIN_CAPACITY 256
+
+//! Grow builder storage to hold at least the given capacity including zero terminator
+static void
+string_builder_grow(string_builder_t* builder, size_t required) {
+	size_t capacity = math_max(builder->capacity * 2, STRING_BUILDER_MIN_CAPACITY);
+	while (capacity < required)
+		capacity *= 2;
+	if (builder->str != builder->initial) {
+		builder->str = memory_reallocate(builder->str, capacity, 0, builder->capacity, 0);
+	} else {
+		char* str = memory_allocate(HASH_STRING, capacity, 0, MEMORY_PERSISTENT);
+		memcpy(str, builder->str, builder->length + 1);
+		builder->str = str;
+	}
+	builder->capacity = capacity;
+}
+
+//! Reserve space for the given number of additional characters, returning the write position
+static FOUNDATION_FORCEINLINE char*
+string_builder_extend(string_builder_t* builder, size_t length) {
+	if (builder->length + length >= builder->capacity)
+		string_builder_grow(builder, builder->length + length + 1);
+	return builder->str + builder->length;
+}
+
+//! Append characters right aligned in a field of the given width
+static void
+string_builder_append_field(string_builder_t* builder, const char* str, size_t length, unsigned int width,
+                            char fill) {
+	const size_t pad = (length < width) ? (width - length) : 0;
+	char* dst = string_builder_extend(builder, pad + length);
+	memset(dst, fill, pad);
+	memcpy(dst + pad, str, length);
+	builder->length += pad + length;
+	builder->str[builder->length] = 0;
+}
+
+void
+string_builder_initialize(string_builder_t* builder, char* buffer, size_t capacity) {
+	if (!buffer || !capacity) {
+		string_t thread_buffer = string_thread_buffer();
+		buffer = thread_buffer.str;
+		capacity = thread_buffer.length;
+	}
+	builder->str = buffer;
+	builder->length = 0;
+	builder->capacity = capacity;
+	builder->initial = buffer;
+	builder->initial_capacity = capacity;
+	builder->str[0] = 0;
+}
+
+void
+string_builder_finalize(string_builder_t* builder) {
+	if (builder->str != builder->initial)
+		memory_deallocate(builder->str);
+	builder->str = nullptr;
+	builder->length = 0;
+	builder->capacity = 0;
+	builder->initial = nullptr;
+	builder->initial_capacity = 0;
+}
+
+void
+string_builder_clear(string_builder_t* builder) {
+	builder->length = 0;
+	builder->str[0] = 0;
+}
+
+void
+string_builder_reserve(string_builder_t* builder, size_t length) {
+	if (length >= builder->capacity)
+		string_builder_grow(builder, length + 1);
+}
+
+void
+string_builder_append(string_builder_t* builder, const char* str, size_t length) {
+	char* dst = string_builder_extend(builder, length);
+	memcpy(dst, str, length);
+	builder->length += length;
+	builder->str[builder->length] = 0;
+}
+
+void
+string_builder_append_char(string_builder_t* builder, char c) {
+	char* dst = string_builder_extend(builder, 1);
+	dst[0] = c;
+	dst[1] = 0;
+	++builder->length;
+}
+
+void
+string_builder_append_int(string_builder_t* builder, int64_t val, unsigned int width, char fill) {
+	char str[24];
+	char* end = str + sizeof(str);
+	unsigned int length = string_digits_backward(end, (val < 0) ? (0 - (uint64_t)val) : (uint64_t)val);
+	if (val < 0)
+		*(end - (++length)) = '-';
+	string_builder_append_field(builder, end - length, length, width, fill);
+}
+
+void
+string_builder_append_uint(string_builder_t* builder, uint64_t val, bool hex, unsigned int width, char fill) {
+	char str[24];
+	char* end = str + sizeof(str);
+	unsigned int length = hex ? string_hex_digits_backward(end, val) : string_digits_backward(end, val);
+	string_builder_append_field(builder, end - length, length, width, fill);
+}
+
+void
+string_builder_append_real(string_builder_t* builder, real val, unsigned int precision, unsigned int width,
+                           char fill) {
+	char str[STRING_FLOAT_BUFFER_SIZE];
+#if FOUNDATION_SIZE_REAL == 8
+	size_t length = string_float64_format(str, val, precision);
+#else
+	size_t length = string_float32_format(str, val, precision);
+#endif
+	string_builder_append_field(builder, str, length, width, fill);
+}
+
+void
+string_builder_append_float64(string_builder_t* builder, float64_t val, unsigned int precision, unsigned int width,
+                              char fill) {
+	char str[STRING_FLOAT_BUFFER_SIZE];
+	size_t length = string_float64_format(str, val, precision);
+	string_builder_append_field(builder, str, length, width, fill);
+}
+
+void
+string_builder_append_format(string_builder_t* builder, const char* format, size_t length, ...) {
+	va_list list;
+	va_start(list, length);
+	string_builder_append_vformat(builder, format, length, list);
+	va_end(list);
+}
+
+void
+string_builder_append_vformat(string_builder_t* builder, const char* format, size_t length, va_list list) {
+	int n;
+	va_list copy_list;
+
+	if (!length)
+		return;
+
+	// Format into the remaining space, grow and retry once if it did not fit
+	while (true) {
+		const size_t remain = builder->capacity - builder->length;
+		va_copy(copy_list, list);
+		n = vsnprintf(builder->str + builder->length, remain, format, copy_list);
+		va_end(copy_list);
+
+		if ((n > -1) && ((size_t)n < remain)) {
+			builder->length += (size_t)n;
+			break;
+		}
+
+		// Discard any partial output, an encoding error will not go away by growing
+		builder->str[builder->length] = 0;
+		if (n < 0)
+			break;
+		string_builder_grow(builder, builder->length + (size_t)n + 1);
+	}
+}
+
+string_const_t
+string_builder_string(const string_builder_t* builder) {
+	return (string_const_t){builder->str, builder->length};
+}
+
+string_t
+string_builder_finish(string_builder_t* builder) {
+	string_t str;
+	if (builder->str != builder->initial) {
+		str = (string_t){builder->str, builder->length};
+		string_builder_initialize(builder, builder->initial, builder->initial_capacity);
+		return str;
+	}
+	str = string_clone(builder->str, builder->length);
+	string_builder_clear(builder);
+	return str;
+}
+
+string_t
+string_builder_finish_buffer(string_builder_t* builder, char* buffer, size_t capacity) {
+	string_t str = string_copy(buffer, capacity, builder->str, builder->length);
+	string_builder_clear(builder);
+	return str;
+}
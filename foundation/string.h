@@ -157,7 +157,8 @@ FOUNDATION_API size_t
 string_length(const char* str);
 
 /*! Get number of unicode glyphs stored in utf-8 string. This method is safe to call with
-invalid utf-8 sequences, even with incomplete sequences at end of string.
+invalid utf-8 sequences, even with incomplete sequences at end of string, and counts them the
+same way as stepping through the string with #string_glyph.
 \param str String in utf-8 encoding
 \param length Length of string
 \return Number of unicode glyphs in string */
@@ -180,6 +181,16 @@ string_glyph_length(const char* str, size_t length);
 FOUNDATION_API hash_t
 string_hash(const char* str, size_t length);
 
+/*! Calculate case insensitive hash of string. ASCII letters are folded to lower case, giving
+the same hash as #string_hash of the string in lower case. Other bytes, including UTF-8
+encoded glyphs, are hashed unmodified. Strings equal according to #string_equal_nocase have
+equal hashes, which allows case insensitive keys in hash maps and tables
+\param str String
+\param length Length of string
+\return Case insensitive hash of string */
+FOUNDATION_API hash_t
+string_hash_nocase(const char* str, size_t length);
+
 /*! Copy one string to another. Like strlcpy in that dst will always be zero terminated,
 i.e copies at most (capacity-1) characters from source string. Safe to pass null
 pointers in both pointer arguments.
@@ -516,7 +527,8 @@ string_ends_with(const char* str, size_t length, const char* suffix, size_t suff
 FOUNDATION_API bool
 string_equal(const char* lhs, size_t lhs_length, const char* rhs, size_t rhs_length);
 
-/*! Query if strings are equal (case insensitive)
+/*! Query if strings are equal (case insensitive). Only ASCII letters are compared case
+insensitively, other bytes including UTF-8 encoded glyphs must be equal
 \param lhs First string
 \param lhs_length Length of first string
 \param rhs Second string
@@ -591,6 +603,28 @@ FOUNDATION_API size_t
 string_explode(const char* str, size_t length, const char* delimiters, size_t delim_length, string_const_t* arr,
                size_t arrsize, bool allow_empty);
 
+/*! Initialize a tokenizer iterating over tokens in a string separated by any of the given
+delimiter characters, without allocating memory. Tokens are views into the source string,
+which must stay valid while tokenizing. A string ending with a delimiter has a final empty
+token unless empty tokens are skipped. With #STRING_TOKENIZE_QUOTES the token view excludes
+the quotes and escaped (doubled) quotes inside are left as is.
+\param tokenizer Tokenizer
+\param str Source string
+\param length Length of source string
+\param delimiters Delimiter characters
+\param delim_length Length of delimiter characters
+\param flags Flags (STRING_TOKENIZE_*) */
+FOUNDATION_API void
+string_tokenizer_initialize(string_tokenizer_t* tokenizer, const char* str, size_t length, const char* delimiters,
+                            size_t delim_length, unsigned int flags);
+
+/*! Get the next token from a tokenizer
+\param tokenizer Tokenizer
+\param token Pointer to string receiving the next token
+\return true if a token was stored, false if there are no more tokens */
+FOUNDATION_API bool
+string_tokenizer_next(string_tokenizer_t* tokenizer, string_const_t* token);
+
 /*! Merge a string array using the given separator string
 \param dst Destination string buffer
 \param capacity Capacity of the destination buffer
@@ -737,6 +771,34 @@ zero terminated (included in capacity).
 FOUNDATION_API string_t
 string_convert_utf32(char* dst, size_t capacity, const uint32_t* src, size_t length);
 
+/*! Check if a string is valid utf-8, rejecting overlong encodings, surrogate code points,
+glyphs above 0x10FFFF and truncated sequences
+\param str String
+\param length Length of string in bytes
+\return true if string is valid utf-8, false if not */
+FOUNDATION_API bool
+string_validate_utf8(const char* str, size_t length);
+
+/*! Convert an utf-8 string into a preallocated utf-16 string. Returned string will be
+zero terminated (included in capacity). Surrogate code points are skipped.
+\param dst Destination utf-16 string
+\param capacity Capacity of destination buffer in 16-bit characters
+\param src Source utf-8 string
+\param length Length of source string in bytes
+\return Number of 16-bit characters stored, not including terminating zero */
+FOUNDATION_API size_t
+string_encode_utf16(uint16_t* dst, size_t capacity, const char* src, size_t length);
+
+/*! Convert an utf-8 string into a preallocated utf-32 string. Returned string will be
+zero terminated (included in capacity).
+\param dst Destination utf-32 string
+\param capacity Capacity of destination buffer in 32-bit characters
+\param src Source utf-8 string
+\param length Length of source string in bytes
+\return Number of 32-bit characters stored, not including terminating zero */
+FOUNDATION_API size_t
+string_encode_utf32(uint32_t* dst, size_t capacity, const char* src, size_t length);
+
 /*! Convert an integer to a string, with optional field width and fill character. String buffer
 should be at least 12 bytes (11 characters + terminating zero). String will be zero
 terminated.
@@ -1066,6 +1128,130 @@ string_to_uuid(const char* str, size_t length);
 FOUNDATION_API version_t
 string_to_version(const char* str, size_t length);
 
+/*! Initialize a string builder. The given buffer is used as initial storage, or the thread
+local string buffer if buffer is null or capacity is zero (in which case no string_from_*_static
+function or other user of #string_thread_buffer may be called until the builder is finalized or
+has grown out of it). Once the content no longer fits the builder moves it to a heap buffer and
+keeps doubling the capacity, so building a string of n characters does O(n) copying in total.
+\param builder String builder
+\param buffer Initial storage, null to use the thread local string buffer
+\param capacity Capacity of initial storage */
+FOUNDATION_API void
+string_builder_initialize(string_builder_t* builder, char* buffer, size_t capacity);
+
+/*! Finalize a string builder, releasing any heap buffer it owns
+\param builder String builder */
+FOUNDATION_API void
+string_builder_finalize(string_builder_t* builder);
+
+/*! Reset the length of the built string to zero, keeping the current storage
+\param builder String builder */
+FOUNDATION_API void
+string_builder_clear(string_builder_t* builder);
+
+/*! Make sure the builder can hold a string of the given length without growing
+\param builder String builder
+\param length Length of string */
+FOUNDATION_API void
+string_builder_reserve(string_builder_t* builder, size_t length);
+
+/*! Append a string
+\param builder String builder
+\param str String
+\param length Length of string */
+FOUNDATION_API void
+string_builder_append(string_builder_t* builder, const char* str, size_t length);
+
+/*! Append a single character
+\param builder String builder
+\param c Character */
+FOUNDATION_API void
+string_builder_append_char(string_builder_t* builder, char c);
+
+/*! Append a signed integer, see #string_from_int
+\param builder String builder
+\param val Integer value
+\param width Field width
+\param fill Fill character */
+FOUNDATION_API void
+string_builder_append_int(string_builder_t* builder, int64_t val, unsigned int width, char fill);
+
+/*! Append an unsigned integer, see #string_from_uint
+\param builder String builder
+\param val Integer value
+\param hex Hexadecimal flag
+\param width Field width
+\param fill Fill character */
+FOUNDATION_API void
+string_builder_append_uint(string_builder_t* builder, uint64_t val, bool hex, unsigned int width, char fill);
+
+/*! Append a real number, see #string_from_real
+\param builder String builder
+\param val Real value
+\param precision Precision, zero for shortest round trip representation
+\param width Field width
+\param fill Fill character */
+FOUNDATION_API void
+string_builder_append_real(string_builder_t* builder, real val, unsigned int precision, unsigned int width,
+                           char fill);
+
+/*! Append a 64-bit float, see #string_from_float64
+\param builder String builder
+\param val Float value
+\param precision Precision, zero for shortest round trip representation
+\param width Field width
+\param fill Fill character */
+FOUNDATION_API void
+string_builder_append_float64(string_builder_t* builder, float64_t val, unsigned int precision, unsigned int width,
+                              char fill);
+
+/*! \fn void string_builder_append_format(string_builder_t* builder, const char* format, size_t length, ...)
+Append formatted data, printf style. The format specifier must be a string literal of
+specified length, zero terminated.
+\param builder String builder
+\param format Format specifier
+\param length Length of format specifier */
+FOUNDATION_API void
+string_builder_append_format(string_builder_t* builder, const char* format, size_t length, ...)
+    FOUNDATION_PRINTFCALL(2, 4);
+
+/*! \fn void string_builder_append_vformat(string_builder_t* builder, const char* format, size_t length,
+va_list list) Append formatted data given as a va_list, printf style. The format specifier must be
+a string literal of specified length, zero terminated. If formatting fails the builder is left
+unchanged.
+\param builder String builder
+\param format Format specifier
+\param length Length of format specifier
+\param list Variable argument list */
+FOUNDATION_API void
+string_builder_append_vformat(string_builder_t* builder, const char* format, size_t length, va_list list)
+    FOUNDATION_PRINTFCALL(2, 0);
+
+/*! Get the built string. The string is zero terminated and only valid until the next
+modification of the builder.
+\param builder String builder
+\return Built string */
+FOUNDATION_API string_const_t
+string_builder_string(const string_builder_t* builder);
+
+/*! Finish the builder into a newly allocated string which must be deallocated with a call to
+#string_deallocate. A heap buffer owned by the builder is handed over without copying. The
+builder is reset to an empty string in its initial state and must still be finalized.
+\param builder String builder
+\return Zero terminated built string in a new memory block */
+FOUNDATION_API string_t
+string_builder_finish(string_builder_t* builder);
+
+/*! Finish the builder by copying the built string to the given buffer, for example memory
+owned by an arena or frame allocator. Will copy at most (capacity-1) characters and always
+zero terminate. The builder is reset to an empty string and must still be finalized.
+\param builder String builder
+\param buffer Destination buffer
+\param capacity Capacity of destination buffer
+\return Zero terminated built string in given buffer */
+FOUNDATION_API string_t
+string_builder_finish_buffer(string_builder_t* builder, char* buffer, size_t capacity);
+
 /*! Thread local buffer for string operations and conversions.
 \return String thread local buffer with size indicating capacity */
 FOUNDATION_API string_t
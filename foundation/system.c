@@ -40,6 +40,22 @@ system_show_alert(const char*, size_t, const char*, size_t, int);
 
 #endif
 
+#if (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64) && \
+    (FOUNDATION_COMPILER_MSVC || FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG)
+#define SYSTEM_CPU_X86 1
+#if FOUNDATION_COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define SYSTEM_CPU_X86 0
+#endif
+
+#if FOUNDATION_ARCH_ARM_64 && (FOUNDATION_PLATFORM_LINUX || FOUNDATION_PLATFORM_ANDROID)
+#include <sys/auxv.h>
+#endif
+
 #define SYSTEM_BUFFER_SIZE 511
 FOUNDATION_DECLARE_THREAD_LOCAL(char*, system_buffer, 0)
 
@@ -800,3 +816,365 @@ system_thread_finalize(void) {
 	memory_deallocate(buffer);
 	set_thread_system_buffer(0);
 }
+
+// Cache types, matching the x86 cpuid deterministic cache parameter encoding
+#define SYSTEM_CACHE_DATA 1
+#define SYSTEM_CACHE_INSTRUCTION 2
+#define SYSTEM_CACHE_UNIFIED 3
+
+static cpu_features_t system_cpu;
+static uint64_t system_cpu_detected_flags;
+static bool system_cpu_detected;
+
+static void
+system_cpu_set_cache(cpu_features_t* cpu, unsigned int level, unsigned int type, size_t size, size_t line) {
+	size_t* target = 0;
+	if (level == 1)
+		target = (type == SYSTEM_CACHE_INSTRUCTION) ? &cpu->cache_l1i_size : &cpu->cache_l1d_size;
+	else if ((level == 2) && (type != SYSTEM_CACHE_INSTRUCTION))
+		target = &cpu->cache_l2_size;
+	else if ((level == 3) && (type != SYSTEM_CACHE_INSTRUCTION))
+		target = &cpu->cache_l3_size;
+	// Values from the operating system take precedence over cpuid fallback values
+	if (target && !*target)
+		*target = size;
+	if ((level == 1) && (type != SYSTEM_CACHE_INSTRUCTION) && line && !cpu->cache_line_size)
+		cpu->cache_line_size = line;
+}
+
+#if SYSTEM_CPU_X86
+
+static void
+system_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int* info) {
+#if FOUNDATION_COMPILER_MSVC
+	__cpuidex((int*)info, (int)leaf, (int)subleaf);
+#else
+	__cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#endif
+}
+
+static uint64_t
+system_xgetbv(void) {
+#if FOUNDATION_COMPILER_MSVC
+	return _xgetbv(0);
+#else
+	uint32_t eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+static uint64_t
+system_cpu_detect_features(void) {
+	unsigned int info[4] = {0};
+	unsigned int max_leaf, features, legacy;
+	unsigned int extended = 0;
+	uint64_t xcr0 = 0;
+	uint64_t flags = 0;
+
+	system_cpuid(0, 0, info);
+	max_leaf = info[0];
+	if (max_leaf < 1)
+		return 0;
+	system_cpuid(1, 0, info);
+	features = info[2];
+	legacy = info[3];
+	if (max_leaf >= 7) {
+		system_cpuid(7, 0, info);
+		extended = info[1];
+	}
+	// AVX register state must also be enabled by the OS (OSXSAVE and XCR0 YMM bits), and
+	// AVX-512 additionally the opmask and ZMM bits
+	if ((features & (1U << 27)) && (features & (1U << 28)))
+		xcr0 = system_xgetbv();
+
+	if (legacy & (1U << 26))
+		flags |= CPU_FEATURE_SSE2;
+	if (features & (1U << 9))
+		flags |= CPU_FEATURE_SSSE3;
+	if (features & (1U << 19))
+		flags |= CPU_FEATURE_SSE41;
+	if (features & (1U << 20))
+		flags |= CPU_FEATURE_SSE42 | CPU_FEATURE_CRC32;
+	if (features & (1U << 23))
+		flags |= CPU_FEATURE_POPCNT;
+	if (features & (1U << 25))
+		flags |= CPU_FEATURE_AES;
+	if (features & (1U << 1))
+		flags |= CPU_FEATURE_PCLMUL;
+	if (extended & (1U << 3))
+		flags |= CPU_FEATURE_BMI1;
+	if (extended & (1U << 8))
+		flags |= CPU_FEATURE_BMI2;
+	if (extended & (1U << 29))
+		flags |= CPU_FEATURE_SHA;
+	if ((xcr0 & 0x6) == 0x6) {
+		flags |= CPU_FEATURE_AVX;
+		if (features & (1U << 12))
+			flags |= CPU_FEATURE_FMA;
+		if (extended & (1U << 5))
+			flags |= CPU_FEATURE_AVX2;
+	}
+	if (((xcr0 & 0xE6) == 0xE6) && (extended & (1U << 16))) {
+		flags |= CPU_FEATURE_AVX512F;
+		if (extended & (1U << 30))
+			flags |= CPU_FEATURE_AVX512BW;
+		if (extended & (1U << 31))
+			flags |= CPU_FEATURE_AVX512VL;
+	}
+	return flags;
+}
+
+static void
+system_cpu_detect_cache_cpuid(cpu_features_t* cpu) {
+	unsigned int info[4] = {0};
+	unsigned int leaf = 0;
+	unsigned int subleaf;
+
+	// Deterministic cache parameters, leaf 4 on Intel and leaf 0x8000001D on AMD
+	system_cpuid(0, 0, info);
+	if (info[0] >= 4) {
+		system_cpuid(4, 0, info);
+		if (info[0] & 0x1F)
+			leaf = 4;
+	}
+	if (!leaf) {
+		system_cpuid(0x80000000U, 0, info);
+		if (info[0] >= 0x8000001DU)
+			leaf = 0x8000001DU;
+	}
+
+	for (subleaf = 0; leaf && (subleaf < 16); ++subleaf) {
+		size_t ways, partitions, line, sets;
+		unsigned int type;
+		system_cpuid(leaf, subleaf, info);
+		type = info[0] & 0x1F;
+		if (!type)
+			break;
+		ways = ((info[1] >> 22) & 0x3FF) + 1;
+		partitions = ((info[1] >> 12) & 0x3FF) + 1;
+		line = (info[1] & 0xFFF) + 1;
+		sets = (size_t)info[2] + 1;
+		system_cpu_set_cache(cpu, (info[0] >> 5) & 0x7, type, ways * partitions * line * sets, line);
+	}
+
+	if (!cpu->cache_line_size) {
+		// CLFLUSH line size in units of 8 bytes
+		system_cpuid(1, 0, info);
+		cpu->cache_line_size = ((info[1] >> 8) & 0xFF) * 8;
+	}
+}
+
+#else
+
+static uint64_t
+system_cpu_detect_features(void) {
+	uint64_t flags = 0;
+#if FOUNDATION_ARCH_ARM && defined(__ARM_NEON)
+	flags |= CPU_FEATURE_NEON;
+#endif
+#if FOUNDATION_ARCH_ARM_64
+#if FOUNDATION_PLATFORM_LINUX || FOUNDATION_PLATFORM_ANDROID
+	unsigned long hwcap = getauxval(AT_HWCAP);
+	if (hwcap & (1UL << 3))
+		flags |= CPU_FEATURE_AES;
+	if (hwcap & (1UL << 4))
+		flags |= CPU_FEATURE_PCLMUL;
+	if (hwcap & (1UL << 6))
+		flags |= CPU_FEATURE_SHA;
+	if (hwcap & (1UL << 7))
+		flags |= CPU_FEATURE_CRC32;
+	if (hwcap & (1UL << 21))
+		flags |= CPU_FEATURE_SHA512;
+#elif FOUNDATION_PLATFORM_WINDOWS
+	if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE))
+		flags |= CPU_FEATURE_AES | CPU_FEATURE_PCLMUL | CPU_FEATURE_SHA;
+	if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE))
+		flags |= CPU_FEATURE_CRC32;
+#elif FOUNDATION_PLATFORM_APPLE
+	int value = 0;
+	size_t size = sizeof(value);
+	// Cryptography and CRC32 extensions are supported by all Apple 64-bit ARM devices
+	flags |= CPU_FEATURE_AES | CPU_FEATURE_PCLMUL | CPU_FEATURE_SHA | CPU_FEATURE_CRC32;
+	if ((sysctlbyname("hw.optional.armv8_2_sha512", &value, &size, 0, 0) == 0) && value)
+		flags |= CPU_FEATURE_SHA512;
+#endif
+#endif
+	return flags;
+}
+
+#endif
+
+#if FOUNDATION_PLATFORM_LINUX || FOUNDATION_PLATFORM_ANDROID
+
+static string_const_t
+system_cpu_read_sysfs(char* buffer, size_t capacity, unsigned int index, const char* name, size_t length) {
+	char path[128];
+	string_t pathstr = string_format(path, sizeof(path), STRING_CONST("/sys/devices/system/cpu/cpu0/cache/index%u/%.*s"),
+	                                 index, (int)length, name);
+	ssize_t read = 0;
+	int fd = open(pathstr.str, O_RDONLY);
+	if (fd >= 0) {
+		read = (ssize_t)pread(fd, buffer, capacity - 1, 0);
+		close(fd);
+	}
+	if (read < 0)
+		read = 0;
+	buffer[read] = 0;
+	return string_strip(buffer, (size_t)read, STRING_CONST(" \n\r\t"));
+}
+
+static void
+system_cpu_detect_cache(cpu_features_t* cpu) {
+	char buffer[64];
+	unsigned int index;
+	for (index = 0; index < 16; ++index) {
+		unsigned int level, type;
+		size_t size, line;
+		string_const_t value = system_cpu_read_sysfs(buffer, sizeof(buffer), index, STRING_CONST("level"));
+		if (!value.length)
+			break;
+		level = string_to_uint(STRING_ARGS(value), false);
+
+		value = system_cpu_read_sysfs(buffer, sizeof(buffer), index, STRING_CONST("type"));
+		if (string_equal(STRING_ARGS(value), STRING_CONST("Data")))
+			type = SYSTEM_CACHE_DATA;
+		else if (string_equal(STRING_ARGS(value), STRING_CONST("Instruction")))
+			type = SYSTEM_CACHE_INSTRUCTION;
+		else
+			type = SYSTEM_CACHE_UNIFIED;
+
+		// Size is given with a K or M suffix
+		value = system_cpu_read_sysfs(buffer, sizeof(buffer), index, STRING_CONST("size"));
+		size = string_to_size(STRING_ARGS(value), false);
+		if (value.length && ((value.str[value.length - 1] == 'K') || (value.str[value.length - 1] == 'k')))
+			size *= 1024;
+		else if (value.length && (value.str[value.length - 1] == 'M'))
+			size *= 1024 * 1024;
+
+		value = system_cpu_read_sysfs(buffer, sizeof(buffer), index, STRING_CONST("coherency_line_size"));
+		line = string_to_size(STRING_ARGS(value), false);
+
+		system_cpu_set_cache(cpu, level, type, size, line);
+	}
+}
+
+#elif FOUNDATION_PLATFORM_APPLE
+
+static size_t
+system_cpu_sysctl_size(const char* name) {
+	int64_t value = 0;
+	size_t size = sizeof(value);
+	if (sysctlbyname(name, &value, &size, 0, 0) != 0)
+		return 0;
+	return (value > 0) ? (size_t)value : 0;
+}
+
+static void
+system_cpu_detect_cache(cpu_features_t* cpu) {
+	cpu->cache_line_size = system_cpu_sysctl_size("hw.cachelinesize");
+	cpu->cache_l1d_size = system_cpu_sysctl_size("hw.l1dcachesize");
+	cpu->cache_l1i_size = system_cpu_sysctl_size("hw.l1icachesize");
+	cpu->cache_l2_size = system_cpu_sysctl_size("hw.l2cachesize");
+	cpu->cache_l3_size = system_cpu_sysctl_size("hw.l3cachesize");
+}
+
+#elif FOUNDATION_PLATFORM_WINDOWS
+
+static void
+system_cpu_detect_cache(cpu_features_t* cpu) {
+	// Fixed buffer to allow detection before the memory system is initialized, on failure
+	// the cpuid fallback is used
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION info[256];
+	DWORD size = (DWORD)sizeof(info);
+	DWORD count, i;
+	if (!GetLogicalProcessorInformation(info, &size))
+		return;
+	count = size / (DWORD)sizeof(info[0]);
+	for (i = 0; i < count; ++i) {
+		const CACHE_DESCRIPTOR* cache = &info[i].Cache;
+		unsigned int type;
+		if (info[i].Relationship != RelationCache)
+			continue;
+		if (cache->Type == CacheData)
+			type = SYSTEM_CACHE_DATA;
+		else if (cache->Type == CacheInstruction)
+			type = SYSTEM_CACHE_INSTRUCTION;
+		else
+			type = SYSTEM_CACHE_UNIFIED;
+		system_cpu_set_cache(cpu, cache->Level, type, cache->Size, cache->LineSize);
+	}
+}
+
+#else
+
+static void
+system_cpu_detect_cache(cpu_features_t* cpu) {
+	FOUNDATION_UNUSED(cpu);
+}
+
+#endif
+
+const cpu_features_t*
+system_cpu_features(void) {
+	// Detection is idempotent, concurrent calls before initialization store the same values
+	if (!system_cpu_detected) {
+		cpu_features_t cpu;
+		memset(&cpu, 0, sizeof(cpu));
+		cpu.flags = system_cpu_detect_features();
+		system_cpu_detect_cache(&cpu);
+#if SYSTEM_CPU_X86
+		system_cpu_detect_cache_cpuid(&cpu);
+#endif
+		if (!cpu.cache_line_size)
+			cpu.cache_line_size = 64;
+		system_cpu = cpu;
+		system_cpu_detected_flags = cpu.flags;
+		system_cpu_detected = true;
+	}
+	return &system_cpu;
+}
+
+bool
+system_cpu_has_feature(uint64_t features) {
+	return (system_cpu_features()->flags & features) == features;
+}
+
+cpu_dispatch_fn
+system_cpu_dispatch(const cpu_dispatch_t* candidates, size_t count) {
+	uint64_t flags = system_cpu_features()->flags;
+	size_t icand;
+	for (icand = 0; icand < count; ++icand) {
+		if ((flags & candidates[icand].features) == candidates[icand].features)
+			return candidates[icand].function;
+	}
+	return 0;
+}
+
+static void
+system_cpu_resolve(void) {
+	internal_aes_resolve();
+	internal_base64_resolve();
+	internal_crc32c_resolve();
+	internal_matcher_resolve();
+	internal_md5_resolve();
+	internal_sha_resolve();
+	internal_string_resolve();
+}
+
+void
+system_cpu_mask_features(uint64_t mask) {
+	system_cpu_features();
+	system_cpu.flags = system_cpu_detected_flags & mask;
+	system_cpu_resolve();
+}
+
+int
+internal_cpu_initialize(void) {
+	system_cpu_features();
+
+	// Select accelerated implementations once up front
+	system_cpu_resolve();
+
+	return 0;
+}
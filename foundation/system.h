@@ -58,6 +58,39 @@ system_byteorder(void);
 FOUNDATION_API size_t
 system_hardware_threads(void);
 
+/*! Get features and cache topology of the processor. Features are detected with cpuid on
+x86 and from the operating system on ARM, cache sizes are queried from the operating system
+(sysfs, sysctl or processor information) with cpuid as fallback. Detection is done once during
+library initialization, or on first call if called before initialization.
+\return CPU features and cache topology */
+FOUNDATION_API const cpu_features_t*
+system_cpu_features(void);
+
+/*! Query if all the given CPU features are supported by the processor and operating system
+\param features CPU feature flags (CPU_FEATURE_*)
+\return true if all given features are supported, false if not */
+FOUNDATION_API bool
+system_cpu_has_feature(uint64_t features);
+
+/*! Select an implementation from a list of candidates ordered by preference, returning the
+first candidate for which all required CPU features are supported. Intended to be called once
+at startup to store the selected function pointer. End the list with a fallback candidate
+without required features to always select an implementation.
+\param candidates Candidate implementations, fastest first
+\param count Number of candidates
+\return Selected implementation, 0 if no candidate is supported */
+FOUNDATION_API cpu_dispatch_fn
+system_cpu_dispatch(const cpu_dispatch_t* candidates, size_t count);
+
+/*! Restrict the CPU features reported and used for selecting accelerated implementations to
+the given mask, and select all implementations again. Intended for testing the fallback
+implementations on processors supporting the accelerated ones, must not be called while other
+threads are using the library.
+\param mask CPU feature flags (CPU_FEATURE_*) allowed, 0 to force fallback implementations
+and ~0 to restore all detected features */
+FOUNDATION_API void
+system_cpu_mask_features(uint64_t mask);
+
 /*! Get current host name of system in the given buffer
 \param buffer Buffer
 \param capacity Capacity of buffer
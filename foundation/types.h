@@ -213,6 +213,10 @@ typedef enum {
 	STREAMTYPE_STDSTREAM,
 	/*! Custom unknown stream type */
 	STREAMTYPE_CUSTOM,
+	/*! CRC32C checksumming pass-through stream */
+	STREAMTYPE_CRC32C,
+	/*! Base64 encoding/decoding pass-through stream */
+	STREAMTYPE_BASE64,
 	/*! Last reserved built-in stream type, not a valid type */
 	STREAMTYPE_LAST_RESERVED = 0x0FFF
 } stream_type_t;
@@ -286,9 +290,35 @@ typedef enum {
 	/*! Cipher feedback */
 	BLOCKCIPHER_CFB,
 	/*! Output feedback */
-	BLOCKCIPHER_OFB
+	BLOCKCIPHER_OFB,
+	/*! Counter, blocks are independent and can be processed in parallel */
+	BLOCKCIPHER_CTR
 } blockcipher_mode_t;
 
+/*! Digest algorithms for tree mode file digests, see #fs_digest_parallel */
+typedef enum {
+	/*! MD5, 128-bit digest */
+	FS_DIGEST_MD5 = 0,
+	/*! SHA-256, 256-bit digest */
+	FS_DIGEST_SHA256,
+	/*! SHA-512, 512-bit digest */
+	FS_DIGEST_SHA512,
+	/*! 128-bit non-cryptographic hash, see #hash128 */
+	FS_DIGEST_HASH128
+} fs_digest_t;
+
+/*! Pseudorandom number generator engines */
+typedef enum {
+	/*! Maximally equidistributed WELL generator with a large state, default engine for the
+	thread local generator used by the global random functions. Not available for explicit
+	random states */
+	RANDOM_ENGINE_WELL = 0,
+	/*! xoshiro256** generator with a 256-bit state and a period of 2^256-1 */
+	RANDOM_ENGINE_XOSHIRO256,
+	/*! PCG64 (XSL-RR 128/64) generator with a 128-bit state and a period of 2^128 */
+	RANDOM_ENGINE_PCG64
+} random_engine_t;
+
 /*! Radix sort data types */
 typedef enum {
 	/*! 32-bit signed integer */
@@ -305,6 +335,8 @@ typedef enum {
 	RADIXSORT_FLOAT64,
 	/*! Custom opaque data type */
 	RADIXSORT_CUSTOM,
+	/*! Strings (string_const_t), sorted by byte values with shorter strings first */
+	RADIXSORT_STRING
 } radixsort_data_t;
 
 /*! Radix sort index types */
@@ -312,7 +344,9 @@ typedef enum {
 	/*! 16-bit indices */
 	RADIXSORT_INDEX16 = 2,
 	/*! 32-bit indices */
-	RADIXSORT_INDEX32 = 4
+	RADIXSORT_INDEX32 = 4,
+	/*! 64-bit indices */
+	RADIXSORT_INDEX64 = 8
 } radixsort_indextype_t;
 
 /*! Device orientation */
@@ -389,6 +423,12 @@ a normal windowing system interaction loop */
 /*! Stream flag, create exclusively, fail if file already exists */
 #define STREAM_CREATE_EXCLUSIVE (STREAM_CREATE | (1U << 7))
 
+/*! String tokenizer flag, skip empty tokens between consecutive delimiters */
+#define STRING_TOKENIZE_SKIP_EMPTY 1U
+/*! String tokenizer flag, tokens starting with a double quote extend to the closing quote
+and may contain delimiters, with two consecutive quotes escaping a quote */
+#define STRING_TOKENIZE_QUOTES (1U << 1)
+
 /*! Process flag, spawn method will block until process ends and then return
 process exit code */
 #define PROCESS_ATTACHED 0
@@ -424,6 +464,46 @@ an error occurs during spawning */
 /*! Virtual array flag for normal memory allocated storage */
 #define VIRTUALARRAY_MEMORY_ALLOCATED 1
 
+/*! CPU feature flag, x86 SSE2 instructions */
+#define CPU_FEATURE_SSE2 (1ULL << 0)
+/*! CPU feature flag, x86 SSSE3 instructions */
+#define CPU_FEATURE_SSSE3 (1ULL << 1)
+/*! CPU feature flag, x86 SSE 4.1 instructions */
+#define CPU_FEATURE_SSE41 (1ULL << 2)
+/*! CPU feature flag, x86 SSE 4.2 instructions */
+#define CPU_FEATURE_SSE42 (1ULL << 3)
+/*! CPU feature flag, x86 POPCNT instruction */
+#define CPU_FEATURE_POPCNT (1ULL << 4)
+/*! CPU feature flag, x86 AVX instructions with register state enabled by the OS */
+#define CPU_FEATURE_AVX (1ULL << 5)
+/*! CPU feature flag, x86 AVX2 instructions */
+#define CPU_FEATURE_AVX2 (1ULL << 6)
+/*! CPU feature flag, x86 FMA3 instructions */
+#define CPU_FEATURE_FMA (1ULL << 7)
+/*! CPU feature flag, x86 BMI1 instructions */
+#define CPU_FEATURE_BMI1 (1ULL << 8)
+/*! CPU feature flag, x86 BMI2 instructions */
+#define CPU_FEATURE_BMI2 (1ULL << 9)
+/*! CPU feature flag, x86 AVX-512 foundation instructions with register state enabled by the OS */
+#define CPU_FEATURE_AVX512F (1ULL << 10)
+/*! CPU feature flag, x86 AVX-512 byte and word instructions */
+#define CPU_FEATURE_AVX512BW (1ULL << 11)
+/*! CPU feature flag, x86 AVX-512 vector length extensions */
+#define CPU_FEATURE_AVX512VL (1ULL << 12)
+/*! CPU feature flag, ARM NEON (Advanced SIMD) instructions */
+#define CPU_FEATURE_NEON (1ULL << 13)
+/*! CPU feature flag, AES round instructions (x86 AES-NI or ARMv8 cryptography extensions) */
+#define CPU_FEATURE_AES (1ULL << 14)
+/*! CPU feature flag, carry-less multiplication instructions (x86 PCLMULQDQ or ARMv8 PMULL) */
+#define CPU_FEATURE_PCLMUL (1ULL << 15)
+/*! CPU feature flag, SHA-1 and SHA-256 instructions (x86 SHA extensions or ARMv8 cryptography
+extensions) */
+#define CPU_FEATURE_SHA (1ULL << 16)
+/*! CPU feature flag, SHA-512 instructions (ARMv8.2 SHA-512 extensions) */
+#define CPU_FEATURE_SHA512 (1ULL << 17)
+/*! CPU feature flag, CRC32C instructions (x86 SSE 4.2 or ARMv8 CRC32 extensions) */
+#define CPU_FEATURE_CRC32 (1ULL << 18)
+
 #if FOUNDATION_PLATFORM_WINDOWS
 #if FOUNDATION_ARCH_X86
 typedef int ssize_t;
@@ -477,8 +557,16 @@ typedef union float32_cast_t real_cast_t;
 typedef struct string_t string_t;
 /*! Constant immutable string */
 typedef struct string_const_t string_const_t;
+/*! Amortized string builder */
+typedef struct string_builder_t string_builder_t;
+/*! Byte class for character set scanning */
+typedef struct string_class_t string_class_t;
+/*! Allocation free string tokenizer */
+typedef struct string_tokenizer_t string_tokenizer_t;
 /*! Application declaration and configuration */
 typedef struct application_t application_t;
+/*! AES cipher instance */
+typedef struct aes_t aes_t;
 /*! Beacon for waiting */
 typedef struct beacon_t beacon_t;
 /*! Bit buffer instance */
@@ -489,6 +577,10 @@ typedef struct blowfish_t blowfish_t;
 typedef struct bucketarray_t bucketarray_t;
 /*! Virtualized array for POD types */
 typedef struct virtualarray_t virtualarray_t;
+/*! Candidate implementation for runtime CPU feature dispatch */
+typedef struct cpu_dispatch_t cpu_dispatch_t;
+/*! CPU features and cache topology */
+typedef struct cpu_features_t cpu_features_t;
 /*! Error frame holding debug data for an entry in the frame stack in the error context */
 typedef struct error_frame_t error_frame_t;
 /*! Error context holding error frame stack for a thread */
@@ -503,6 +595,8 @@ typedef struct event_stream_t event_stream_t;
 typedef struct fs_stat_t fs_stat_t;
 /*! Payload for a file system event */
 typedef struct fs_event_payload_t fs_event_payload_t;
+/*! Incremental hash state */
+typedef struct hash_state_t hash_state_t;
 /*! Node in a hash map */
 typedef struct hashmap_node_t hashmap_node_t;
 /*! Hash map mapping hash value keys to pointer values */
@@ -523,6 +617,10 @@ typedef struct hashtable64_entry_t hashtable64_entry_t;
 typedef struct hashtable32_t hashtable32_t;
 /*! Hash table mapping 64-bit keys to 64-bit values */
 typedef struct hashtable64_t hashtable64_t;
+/*! Multi-pattern literal string matcher */
+typedef struct matcher_t matcher_t;
+/*! Incremental scanning state for multi-pattern matcher */
+typedef struct matcher_state_t matcher_state_t;
 /*! MD5 control block */
 typedef struct md5_t md5_t;
 /*! Memory context holding the allocation context stack */
@@ -543,6 +641,8 @@ typedef struct objectmap_entry_t objectmap_entry_t;
 typedef struct process_t process_t;
 /*! Radix sorter control block */
 typedef struct radixsort_t radixsort_t;
+/*! Explicit pseudorandom number generator state */
+typedef struct random_state_t random_state_t;
 /*! Compiled regex */
 typedef struct regex_t regex_t;
 /*! Memory ring buffer */
@@ -553,8 +653,12 @@ typedef struct sha256_t sha256_t;
 typedef struct sha512_t sha512_t;
 /*! Base stream type all stream types are based on */
 typedef struct stream_t stream_t;
+/*! Base64 encoding/decoding pass-through stream */
+typedef struct stream_base64_t stream_base64_t;
 /*! Memory buffer stream */
 typedef struct stream_buffer_t stream_buffer_t;
+/*! CRC32C checksumming pass-through stream */
+typedef struct stream_crc32c_t stream_crc32c_t;
 /*! Pipe stream */
 typedef struct stream_pipe_t stream_pipe_t;
 /*! Ring buffer stream */
@@ -641,6 +745,10 @@ typedef int (*system_initialize_fn)(void);
 initialized subsystem on global finalization */
 typedef void (*system_finalize_fn)(void);
 
+/*! Generic function pointer prototype for implementations selected by runtime CPU feature
+dispatch. Cast to and from the actual function pointer type of the implementation */
+typedef void (*cpu_dispatch_fn)(void);
+
 /*! Memory system allocation function prototype. Implementation of a memory system must
 provide an implementation with this prototype for allocating memory
 \param context Memory context
@@ -738,6 +846,14 @@ typedef void (*exception_handler_fn)(const char* file, size_t length);
 \param object Object pointer */
 typedef void (*object_deallocate_fn)(void* object);
 
+/*! Match callback for the multi-pattern matcher, called for each pattern occurrence found
+\param pattern Index of matched pattern
+\param offset Offset of first byte of the occurrence in the scanned data
+\param length Length of matched pattern
+\param context User context
+\return Zero to continue scanning, non-zero to stop */
+typedef int (*matcher_match_fn)(size_t pattern, size_t offset, size_t length, void* context);
+
 /*! Generic function to open a stream with the given path and mode
 \param path Path, optionally including protocol
 \param length Length of path
@@ -861,6 +977,9 @@ struct foundation_config_t {
 	size_t thread_stack_size;
 	/*! Number of random state blocks to preallocate on thread startup. Zero for default (0) */
 	size_t random_state_prealloc;
+	/*! Engine used by the thread local generator for the global random functions. Zero for
+	default (RANDOM_ENGINE_WELL) */
+	random_engine_t random_engine;
 };
 
 /*! String tuple holding string data pointer and length. This is used to avoid extra calls
@@ -881,6 +1000,64 @@ struct string_const_t {
 	size_t length;
 };
 
+/*! String builder appending into caller or thread local storage, moving to a geometrically
+grown heap buffer once the content outgrows it */
+struct string_builder_t {
+	/*! String buffer, always zero terminated */
+	char* str;
+	/*! Length of string, not including zero terminator */
+	size_t length;
+	/*! Capacity of buffer, including zero terminator */
+	size_t capacity;
+	/*! Initial storage given at initialization, buffer is a heap allocation owned by the
+	builder if it differs from this */
+	char* initial;
+	/*! Capacity of initial storage */
+	size_t initial_capacity;
+};
+
+/*! Byte class as nibble lookup tables. Bit (high nibble & 7) of table[low nibble] is set if
+the byte is in the class, with separate tables for bytes below and above 128 */
+struct string_class_t {
+	/*! Table for bytes below 128 */
+	uint8_t low[16];
+	/*! Table for bytes 128 and above */
+	uint8_t high[16];
+};
+
+/*! String tokenizer yielding views of tokens separated by a set of delimiter characters */
+struct string_tokenizer_t {
+	/*! String being tokenized */
+	const char* str;
+	/*! Length of string */
+	size_t length;
+	/*! Offset of next token, larger than length when done */
+	size_t offset;
+	/*! Flags (STRING_TOKENIZE_*) */
+	unsigned int flags;
+	/*! Delimiter characters */
+	string_class_t delimiters;
+};
+
+/*! Incremental hash state, producing the same hash as a single call to hash() over
+all data passed to hash_update */
+struct hash_state_t {
+	/*! Internal hash state */
+	uint64_t h1;
+	/*! Internal hash state */
+	uint64_t h2;
+	/*! Internal mixing constant */
+	uint64_t c1;
+	/*! Internal mixing constant */
+	uint64_t c2;
+	/*! Number of bytes hashed in total */
+	uint64_t length;
+	/*! Number of bytes currently buffered */
+	size_t current;
+	/*! Buffered data */
+	unsigned char buffer[16];
+};
+
 /*! MD5 state */
 struct md5_t {
 	/*! Flag indicating the md5 state has been initialized and ready for digestion of data */
@@ -923,6 +1100,15 @@ struct sha512_t {
 	unsigned char buffer[128];
 };
 
+/*! Explicit pseudorandom number generator state, see #random_state_initialize */
+struct random_state_t {
+	/*! Engine */
+	random_engine_t engine;
+	/*! Engine state. Four words for xoshiro256**, low and high words of the state
+	followed by low and high words of the stream increment for PCG64 */
+	uint64_t state[4];
+};
+
 /*! Memory management system declaration with function pointers for all memory system
 entry points. */
 struct memory_system_t {
@@ -977,6 +1163,30 @@ struct memory_statistics_t {
 	uint64_t allocated_current;
 };
 
+/*! CPU features and cache topology of the processor running the process */
+struct cpu_features_t {
+	/*! Supported CPU features (CPU_FEATURE_* flags) */
+	uint64_t flags;
+	/*! Cache line size in bytes */
+	size_t cache_line_size;
+	/*! Level 1 data cache size in bytes per core, zero if unknown */
+	size_t cache_l1d_size;
+	/*! Level 1 instruction cache size in bytes per core, zero if unknown */
+	size_t cache_l1i_size;
+	/*! Level 2 cache size in bytes, zero if unknown */
+	size_t cache_l2_size;
+	/*! Level 3 cache size in bytes, zero if unknown or not present */
+	size_t cache_l3_size;
+};
+
+/*! Candidate implementation for runtime CPU feature dispatch, see #system_cpu_dispatch */
+struct cpu_dispatch_t {
+	/*! Required CPU features (CPU_FEATURE_* flags), zero for a fallback without requirements */
+	uint64_t features;
+	/*! Implementation */
+	cpu_dispatch_fn function;
+};
+
 /*! Version identifier expressed as an 128-bit integer with major, minor,
 revision, build and control version number components */
 union version_t {
@@ -1017,6 +1227,21 @@ struct application_t {
 	uuid_t instance;
 };
 
+#define AES_BLOCKSIZE 16U
+#define AES_MAXROUNDS 14U
+
+/*! State for an AES encryption block */
+struct aes_t {
+	/*! Number of rounds, 10, 12 or 14 depending on key size */
+	unsigned int rounds;
+	/*! Encryption round keys */
+	uint8_t encrypt_key[AES_BLOCKSIZE * (AES_MAXROUNDS + 1)];
+	/*! Decryption round keys for the equivalent inverse cipher */
+	uint8_t decrypt_key[AES_BLOCKSIZE * (AES_MAXROUNDS + 1)];
+	/*! Bitsliced encryption round keys for the constant time implementation */
+	uint64_t bitsliced_key[8 * (AES_MAXROUNDS + 1)];
+};
+
 #define BLOWFISH_SUBKEYS 18U
 #define BLOWFISH_SBOXES 4U
 #define BLOWFISH_SBOXENTRIES 256U
@@ -1317,6 +1542,45 @@ FOUNDATION_ALIGNED_STRUCT(hashtable64_t, 8) {
 	FOUNDATION_DECLARE_HASHTABLE64(FOUNDATION_FLEXIBLE_ARRAY);
 };
 
+/*! Multi-pattern literal matcher, an Aho-Corasick automaton compiled to a deterministic
+transition table over byte equivalence classes, with a vectorized candidate prefilter
+for small pattern sets */
+struct matcher_t {
+	/*! Number of patterns */
+	size_t pattern_count;
+	/*! Pattern lengths */
+	uint32_t* pattern_length;
+	/*! Number of automaton states, state zero is the root */
+	unsigned int state_count;
+	/*! Number of byte equivalence classes, the size of a transition table row */
+	unsigned int class_count;
+	/*! Transition table, one row of class_count entries per state. Entries hold the target
+	state premultiplied by class_count */
+	uint32_t* transition;
+	/*! First state with matches premultiplied by class_count, states with matches are last */
+	uint32_t match_state;
+	/*! Offset of first match of each state with matches in the match list, one entry per
+	state with matches plus one */
+	uint32_t* match_offset;
+	/*! Match list holding pattern indices, longest pattern first for each state */
+	uint32_t* match;
+	/*! Flag if the prefilter tables are valid */
+	bool prefilter;
+	/*! Byte equivalence class of each byte value */
+	uint8_t byte_class[256];
+	/*! Prefilter nibble tables, bucket bits for low and high nibble of the first and second
+	byte of candidate positions */
+	uint8_t prefilter_mask[4][16];
+};
+
+/*! Incremental scanning state for a multi-pattern matcher */
+struct matcher_state_t {
+	/*! Current automaton state, premultiplied by the class count */
+	uint32_t state;
+	/*! Total number of bytes scanned */
+	size_t offset;
+};
+
 /*! Memory context stack */
 struct memory_context_t {
 	/*! Current depth of memory context stack */
@@ -1380,6 +1644,13 @@ struct radixsort_t {
 	void* histogram;
 	/*! Offset table */
 	void* offset;
+	/*! Flag indicating histogram and offset buffers are sized for wide digits */
+	bool wide;
+	/*! Payload size in bytes for key-value sorts */
+	size_t value_size;
+	/*! Scratch buffers for keys and payloads in key-value sorts, or cached string prefixes
+	in string sorts, null for other index sorts */
+	void* scratch[2];
 };
 
 /*! Compiled regular expression */
@@ -1390,6 +1661,8 @@ struct regex_t {
 	size_t code_length;
 	/*! Capacity of the code array (number of bytes) */
 	size_t code_allocated;
+	/*! Lazy DFA used for matching without captures, null if not available */
+	void* dfa;
 	/*! Compiled regex code */
 	uint8_t code[FOUNDATION_FLEXIBLE_ARRAY];
 };
@@ -1668,6 +1941,50 @@ FOUNDATION_ALIGNED_STRUCT(stream_buffer_t, 8) {
 	tick_t lastmod;
 };
 
+/*! Stream interface encoding data written as base64 text to a wrapped stream, and decoding
+base64 text read from a wrapped stream. This struct is also a stream_t (stream struct type
+declared at start of struct) and can be used in all functions operating on a stream_t. */
+FOUNDATION_ALIGNED_STRUCT(stream_base64_t, 8) {
+	FOUNDATION_DECLARE_STREAM;
+	/*! Wrapped stream */
+	stream_t* source;
+	/*! If this flag is set the wrapped stream is owned by the base64 stream and will be
+	deallocated together with the base64 stream. */
+	bool own;
+	/*! Number of bytes pending encoding in write group */
+	unsigned int write_count;
+	/*! Number of valid characters pending decoding in read group */
+	unsigned int read_count;
+	/*! Number of decoded bytes pending read */
+	unsigned int decoded_count;
+	/*! Offset of first decoded byte pending read */
+	unsigned int decoded_offset;
+	/*! Bytes pending encoding, written when a group of three bytes is complete */
+	unsigned char write_group[3];
+	/*! Decoded 6-bit values of characters pending decoding */
+	unsigned char read_group[4];
+	/*! Decoded bytes pending read */
+	unsigned char decoded[3];
+	/*! Number of decoded bytes read and unencoded bytes written through the stream */
+	size_t offset;
+};
+
+/*! Stream interface computing CRC32C checksums of data passing through to a wrapped stream.
+This struct is also a stream_t (stream struct type declared at start of struct) and can be
+used in all functions operating on a stream_t. */
+FOUNDATION_ALIGNED_STRUCT(stream_crc32c_t, 8) {
+	FOUNDATION_DECLARE_STREAM;
+	/*! Wrapped stream */
+	stream_t* source;
+	/*! If this flag is set the wrapped stream is owned by the CRC32C stream and will be
+	deallocated together with the CRC32C stream. */
+	bool own;
+	/*! Checksum of data read */
+	uint32_t crc_read;
+	/*! Checksum of data written */
+	uint32_t crc_write;
+};
+
 /*! Stream interface for read/write to a pipe. This struct is also a stream_t
 (stream struct type declared at start of struct) and can be used in all functions
 operating on a stream_t. Pipe streams are sequential. */
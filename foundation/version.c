@@ -0,0 +1,11 @@
+/* ****** AUTOMATICALLY GENERATED, DO NOT EDIT ******
+   This file is generated from the git describe command.
+   Run the configure script to regenerate this file */
+
+#include <foundation/version.h>
+#include <foundation/foundation.h>
+
+version_t
+foundation_version(void) {
+	return version_make(0, 0, 1, 0, 0x0);
+}
@@ -0,0 +1,313 @@
+/* main.c  -  Foundation aes test  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+static application_t
+test_aes_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Foundation aes tests"));
+	app.short_name = string_const(STRING_CONST("test_aes"));
+	app.company = string_const(STRING_CONST(""));
+	app.flags = APPLICATION_UTILITY;
+	app.exception_handler = test_exception_handler;
+	return app;
+}
+
+static memory_system_t
+test_aes_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_aes_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_aes_initialize(void) {
+	return 0;
+}
+
+static void
+test_aes_finalize(void) {
+}
+
+static size_t
+test_aes_from_hex(unsigned char* dest, const char* hex) {
+	size_t size = 0;
+	while (hex[0] && hex[1]) {
+		unsigned int high = (unsigned int)((hex[0] <= '9') ? (hex[0] - '0') : (hex[0] - 'a' + 10));
+		unsigned int low = (unsigned int)((hex[1] <= '9') ? (hex[1] - '0') : (hex[1] - 'a' + 10));
+		dest[size++] = (unsigned char)((high << 4) | low);
+		hex += 2;
+	}
+	return size;
+}
+
+typedef struct {
+	const char* key;
+	blockcipher_mode_t mode;
+	uint128_t vec;
+	const char* plaintext;
+	const char* ciphertext;
+} test_aes_vector_t;
+
+static void*
+test_aes_known_data(void) {
+	unsigned char key[32];
+	unsigned char plaintext[64];
+	unsigned char ciphertext[64];
+	unsigned char data[64];
+	size_t keysize, size;
+	aes_t aes;
+
+	// NIST SP 800-38A test vectors, plus counter carry into the high word
+	const char* sp800_plaintext = "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+	                              "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+	const char* key128 = "2b7e151628aed2a6abf7158809cf4f3c";
+	const char* key256 = "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4";
+	const uint128_t iv = uint128_make(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+	const uint128_t counter = uint128_make(0xf0f1f2f3f4f5f6f7ULL, 0xf8f9fafbfcfdfeffULL);
+	const test_aes_vector_t vectors[] = {
+	    // FIPS-197 appendix C
+	    {"000102030405060708090a0b0c0d0e0f", BLOCKCIPHER_ECB, {{0, 0}}, "00112233445566778899aabbccddeeff",
+	     "69c4e0d86a7b0430d8cdb78070b4c55a"},
+	    {"000102030405060708090a0b0c0d0e0f1011121314151617", BLOCKCIPHER_ECB, {{0, 0}},
+	     "00112233445566778899aabbccddeeff", "dda97ca4864cdfe06eaf70a0ec0d7191"},
+	    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", BLOCKCIPHER_ECB, {{0, 0}},
+	     "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089"},
+	    {key128, BLOCKCIPHER_ECB, {{0, 0}}, sp800_plaintext,
+	     "3ad77bb40d7a3660a89ecaf32466ef97f5d3d58503b9699de785895a96fdbaaf"
+	     "43b1cd7f598ece23881b00e3ed0306887b0c785e27e8ad3f8223207104725dd4"},
+	    {key128, BLOCKCIPHER_CBC, iv, sp800_plaintext,
+	     "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+	     "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7"},
+	    {key128, BLOCKCIPHER_CFB, iv, sp800_plaintext,
+	     "3b3fd92eb72dad20333449f8e83cfb4ac8a64537a0b3a93fcde3cdad9f1ce58b"
+	     "26751f67a3cbb140b1808cf187a4f4dfc04b05357c5d1c0eeac4c66f9ff7f2e6"},
+	    {key128, BLOCKCIPHER_OFB, iv, sp800_plaintext,
+	     "3b3fd92eb72dad20333449f8e83cfb4a7789508d16918f03f53c52dac54ed825"
+	     "9740051e9c5fecf64344f7a82260edcc304c6528f659c77866a510d9c1d6ae5e"},
+	    {key128, BLOCKCIPHER_CTR, counter, sp800_plaintext,
+	     "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+	     "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"},
+	    {key128, BLOCKCIPHER_CTR, {{0xffULL, 0xffffffffffffffffULL}}, sp800_plaintext,
+	     "b10d2faad0fb6075abe8fe44447902755869dc3afe2cfe063bcaf5cc210384e7"
+	     "b174ba2e83fe915b1fb5ba0a46a485460b59a696b6ffa2f0dfa23302e040361e"},
+	    {key256, BLOCKCIPHER_ECB, {{0, 0}}, sp800_plaintext,
+	     "f3eed1bdb5d2a03c064b5a7e3db181f8591ccb10d410ed26dc5ba74a31362870"
+	     "b6ed21b99ca6f4f9f153e7b1beafed1d23304b7a39f9f3ff067d8d8f9e24ecc7"},
+	    {key256, BLOCKCIPHER_CTR, counter, sp800_plaintext,
+	     "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+	     "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"}};
+
+	for (size_t ivec = 0; ivec < sizeof(vectors) / sizeof(vectors[0]); ++ivec) {
+		keysize = test_aes_from_hex(key, vectors[ivec].key);
+		size = test_aes_from_hex(plaintext, vectors[ivec].plaintext);
+		EXPECT_SIZEEQ(test_aes_from_hex(ciphertext, vectors[ivec].ciphertext), size);
+
+		aes_initialize(&aes, key, keysize);
+		EXPECT_UINTEQ(aes.rounds, (unsigned int)(keysize / 4) + 6);
+
+		memcpy(data, plaintext, size);
+		aes_encrypt(&aes, data, size, vectors[ivec].mode, vectors[ivec].vec);
+		EXPECT_EQ(memcmp(data, ciphertext, size), 0);
+
+		aes_decrypt(&aes, data, size, vectors[ivec].mode, vectors[ivec].vec);
+		EXPECT_EQ(memcmp(data, plaintext, size), 0);
+
+		aes_finalize(&aes);
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(aes, known_data) {
+	return test_aes_known_data();
+}
+
+DECLARE_TEST(aes, random_data) {
+	const size_t size = 64 * 1024 + 16;
+	unsigned char* plaintext = memory_allocate(0, size + 16, 0, MEMORY_PERSISTENT);
+	unsigned char* data = memory_allocate(0, size + 16, 0, MEMORY_PERSISTENT);
+	unsigned char key[32];
+	aes_t* aes = aes_allocate();
+	blockcipher_mode_t mode;
+
+	for (size_t i = 0; i < size + 16; ++i)
+		plaintext[i] = (unsigned char)random32();
+
+	for (unsigned int iloop = 0; iloop < 48; ++iloop) {
+		size_t keysize = 16 + (8 * (iloop % 3));
+		// Cover unaligned buffers and all block counts around the parallel chunk sizes
+		size_t offset = iloop % 16;
+		size_t length = (iloop < 40) ? (iloop * 16) : (size - (iloop % 8) * 16);
+		uint128_t vec = uint128_make(random64(), random64());
+
+		for (size_t i = 0; i < sizeof(key); ++i)
+			key[i] = (unsigned char)random32();
+		aes_initialize(aes, key, keysize);
+
+		for (mode = BLOCKCIPHER_ECB; mode <= BLOCKCIPHER_CTR; ++mode) {
+			memcpy(data + offset, plaintext, length);
+			aes_encrypt(aes, data + offset, length, mode, vec);
+			if (length)
+				EXPECT_NE(memcmp(data + offset, plaintext, length), 0);
+			aes_decrypt(aes, data + offset, length, mode, vec);
+			EXPECT_EQ(memcmp(data + offset, plaintext, length), 0);
+		}
+	}
+
+	// Trailing partial block is left untouched in block modes
+	memcpy(data, plaintext, 37);
+	aes_encrypt(aes, data, 37, BLOCKCIPHER_CBC, uint128_null());
+	EXPECT_EQ(memcmp(data + 32, plaintext + 32, 5), 0);
+	aes_decrypt(aes, data, 37, BLOCKCIPHER_CBC, uint128_null());
+	EXPECT_EQ(memcmp(data, plaintext, 37), 0);
+
+	aes_deallocate(aes);
+	memory_deallocate(plaintext);
+	memory_deallocate(data);
+
+	return 0;
+}
+
+static void*
+test_aes_counter(void) {
+	const size_t size = 4096 + 7;
+	unsigned char* plaintext = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	unsigned char* reference = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	unsigned char* data = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	unsigned char key[16];
+	uint128_t vec = uint128_make(0x0123456789abcdefULL, 0xfffffffffffffff0ULL);
+	aes_t aes;
+
+	for (size_t i = 0; i < size; ++i)
+		plaintext[i] = (unsigned char)random32();
+	for (size_t i = 0; i < sizeof(key); ++i)
+		key[i] = (unsigned char)random32();
+	aes_initialize(&aes, key, sizeof(key));
+
+	memcpy(reference, plaintext, size);
+	aes_encrypt(&aes, reference, size, BLOCKCIPHER_CTR, vec);
+
+	// Any block aligned range can be processed independently with an offset counter
+	for (unsigned int iloop = 0; iloop < 64; ++iloop) {
+		size_t block = random32_range(0, (uint32_t)(size / 16));
+		size_t offset = block * 16;
+		size_t length = random32_range(0, (uint32_t)(size - offset) + 1);
+		uint128_t blockvec = vec;
+		blockvec.word[1] += block;
+		if (blockvec.word[1] < vec.word[1])
+			++blockvec.word[0];
+
+		memcpy(data, plaintext + offset, length);
+		aes_encrypt(&aes, data, length, BLOCKCIPHER_CTR, blockvec);
+		EXPECT_EQ(memcmp(data, reference + offset, length), 0);
+	}
+
+	aes_finalize(&aes);
+	memory_deallocate(plaintext);
+	memory_deallocate(reference);
+	memory_deallocate(data);
+
+	return 0;
+}
+
+DECLARE_TEST(aes, counter) {
+	return test_aes_counter();
+}
+
+DECLARE_TEST(aes, generic) {
+	const size_t size = 4096 + 16 * 7;
+	unsigned char* plaintext = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	unsigned char* data = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	unsigned char key[32];
+	uint128_t vec = uint128_make(random64(), random64());
+	blockcipher_mode_t mode;
+	aes_t aes;
+
+	for (size_t i = 0; i < size; ++i)
+		plaintext[i] = (unsigned char)random32();
+	for (size_t i = 0; i < sizeof(key); ++i)
+		key[i] = (unsigned char)random32();
+	aes_initialize(&aes, key, sizeof(key));
+
+	// Data encrypted with the implementation selected for the host must decrypt with the
+	// bitsliced implementation and vice versa
+	for (mode = BLOCKCIPHER_ECB; mode <= BLOCKCIPHER_CTR; ++mode) {
+		memcpy(data, plaintext, size);
+		aes_encrypt(&aes, data, size, mode, vec);
+		system_cpu_mask_features(0);
+		aes_decrypt(&aes, data, size, mode, vec);
+		aes_encrypt(&aes, data, size, mode, vec);
+		system_cpu_mask_features(~0ULL);
+		aes_decrypt(&aes, data, size, mode, vec);
+		EXPECT_EQ(memcmp(data, plaintext, size), 0);
+	}
+
+	aes_finalize(&aes);
+	memory_deallocate(plaintext);
+	memory_deallocate(data);
+
+	// Run the vectors through the bitsliced implementation even if AES instructions are supported
+	system_cpu_mask_features(0);
+	void* result = test_aes_known_data();
+	if (!result)
+		result = test_aes_counter();
+	system_cpu_mask_features(~0ULL);
+	return result;
+}
+
+static void
+test_aes_declare(void) {
+	ADD_TEST(aes, known_data);
+	ADD_TEST(aes, random_data);
+	ADD_TEST(aes, counter);
+	ADD_TEST(aes, generic);
+}
+
+static test_suite_t test_aes_suite = {test_aes_application,
+                                      test_aes_memory_system,
+                                      test_aes_config,
+                                      test_aes_declare,
+                                      test_aes_initialize,
+                                      test_aes_finalize,
+                                      0};
+
+#if BUILD_MONOLITHIC
+
+int
+test_aes_run(void);
+
+int
+test_aes_run(void) {
+	test_suite = test_aes_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_aes_suite;
+}
+
+#endif
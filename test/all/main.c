@@ -214,6 +214,8 @@ main_initialize(void) {
 
 #if BUILD_MONOLITHIC
 extern int
+test_aes_run(void);
+extern int
 test_app_run(void);
 extern int
 test_array_run(void);
@@ -230,6 +232,8 @@ test_blowfish_run(void);
 extern int
 test_bufferstream_run(void);
 extern int
+test_crc_run(void);
+extern int
 test_exception_run(void);
 extern int
 test_environment_run(void);
@@ -252,6 +256,8 @@ test_library_run(void);
 extern int
 test_math_run(void);
 extern int
+test_matcher_run(void);
+extern int
 test_md5_run(void);
 extern int
 test_mutex_run(void);
@@ -400,15 +406,16 @@ main_run(void* main_arg) {
 #if BUILD_MONOLITHIC
 
 	test_run_fn tests[] = {
-	    test_app_run,       test_array_run,     test_atomic_run,       test_base64_run,    test_beacon_run,
-	    test_bitbuffer_run, test_blowfish_run,  test_bufferstream_run, test_exception_run, test_environment_run,
-	    test_error_run,     test_event_run,     test_fs_run,           test_hash_run,      test_hashmap_run,
-	    test_hashtable_run, test_json_run,      test_library_run,      test_math_run,      test_md5_run,
-	    test_mutex_run,     test_objectmap_run, test_path_run,         test_pipe_run,      test_process_run,
-	    test_profile_run,   test_radixsort_run, test_random_run,       test_regex_run,     test_ringbuffer_run,
-	    test_semaphore_run, test_sha_run,       test_stacktrace_run,
+	    test_aes_run,        test_app_run,         test_array_run,      test_atomic_run,       test_base64_run,
+	    test_beacon_run,     test_bitbuffer_run,   test_blowfish_run,   test_bufferstream_run, test_crc_run,
+	    test_exception_run,  test_environment_run, test_error_run,      test_event_run,        test_fs_run,
+	    test_hash_run,       test_hashmap_run,     test_hashtable_run,  test_json_run,         test_library_run,
+	    test_math_run,       test_matcher_run,     test_md5_run,        test_mutex_run,        test_objectmap_run,
+	    test_path_run,       test_pipe_run,        test_process_run,    test_profile_run,      test_radixsort_run,
+	    test_random_run,     test_regex_run,       test_ringbuffer_run, test_semaphore_run,    test_sha_run,
+	    test_stacktrace_run,
 	    test_stream_run,  // stream test closes stdin
-	    test_string_run,    test_system_run,    test_time_run,         test_uuid_run,      0};
+	    test_string_run,     test_system_run,      test_time_run,       test_uuid_run,         0};
 
 #if FOUNDATION_PLATFORM_ANDROID
 
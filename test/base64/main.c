@@ -315,9 +315,227 @@ DECLARE_TEST(base64, encode_decode) {
 	return 0;
 }
 
+static const char test_base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Plain scalar reference implementations
+static size_t
+test_base64_reference_encode(const unsigned char* source, size_t size, char* destination) {
+	char* ptr = destination;
+	for (; size > 2; size -= 3, source += 3) {
+		*ptr++ = test_base64_table[source[0] >> 2];
+		*ptr++ = test_base64_table[((source[0] & 0x3) << 4) | (source[1] >> 4)];
+		*ptr++ = test_base64_table[((source[1] & 0xF) << 2) | (source[2] >> 6)];
+		*ptr++ = test_base64_table[source[2] & 0x3F];
+	}
+	if (size) {
+		*ptr++ = test_base64_table[source[0] >> 2];
+		*ptr++ = test_base64_table[((source[0] & 0x3) << 4) | ((size > 1) ? (source[1] >> 4) : 0)];
+		*ptr++ = (size > 1) ? test_base64_table[(source[1] & 0xF) << 2] : '=';
+		*ptr++ = '=';
+	}
+	*ptr++ = 0;
+	return (size_t)pointer_diff(ptr, destination);
+}
+
+static size_t
+test_base64_reference_decode(const char* source, size_t size, unsigned char* destination, size_t capacity) {
+	unsigned char in[4];
+	size_t count = 0;
+	size_t written = 0;
+	size_t i;
+	for (i = 0; (i < size) && (written < capacity); ++i) {
+		const char* found = source[i] ? strchr(test_base64_table, source[i]) : 0;
+		if (!found)
+			continue;
+		in[count++] = (unsigned char)(found - test_base64_table);
+		if (count == 4) {
+			unsigned char out[3];
+			size_t iout;
+			out[0] = (unsigned char)((in[0] << 2) | (in[1] >> 4));
+			out[1] = (unsigned char)((in[1] << 4) | (in[2] >> 2));
+			out[2] = (unsigned char)((in[2] << 6) | in[3]);
+			for (iout = 0; (iout < 3) && (written < capacity); ++iout)
+				destination[written++] = out[iout];
+			count = 0;
+		}
+	}
+	if ((count > 1) && (written < capacity)) {
+		unsigned char out[2];
+		size_t iout;
+		out[0] = (unsigned char)((in[0] << 2) | (in[1] >> 4));
+		out[1] = (unsigned char)((in[1] << 4) | ((count > 2) ? (in[2] >> 2) : 0));
+		for (iout = 0; (iout < count - 1) && (written < capacity); ++iout)
+			destination[written++] = out[iout];
+	}
+	return written;
+}
+
+DECLARE_TEST(base64, vector) {
+	unsigned char data[1024 + 16];
+	unsigned char verify[1024 + 16];
+	char text[1400 + 32];
+	char reference[1400 + 32];
+	size_t size, offset, written, expected;
+
+	for (size = 0; size < sizeof(data); ++size)
+		data[size] = (unsigned char)random32();
+
+	// Encode and decode all lengths across the vector block sizes at all alignments
+	for (offset = 0; offset < 16; ++offset) {
+		for (size = 0; size < 1024; size += (size < 200) ? 1 : 37) {
+			expected = test_base64_reference_encode(data + offset, size, reference);
+			written = base64_encode(data + offset, size, text + offset, sizeof(text) - offset);
+			EXPECT_SIZEEQ(written, expected);
+			EXPECT_EQ(memcmp(text + offset, reference, expected), 0);
+
+			memset(verify, 0, sizeof(verify));
+			written = base64_decode(text + offset, expected - 1, verify + offset, size);
+			EXPECT_SIZEEQ(written, size);
+			EXPECT_EQ(memcmp(verify + offset, data + offset, size), 0);
+		}
+	}
+
+	// Decode in place
+	for (size = 1; size < 1024; size += 13) {
+		char* inplace = reference;
+		expected = base64_encode(data, size, text, sizeof(text));
+		memcpy(inplace, text, expected);
+		written = base64_decode(inplace, expected - 1, inplace, size);
+		EXPECT_SIZEEQ(written, size);
+		EXPECT_EQ(memcmp(inplace, data, size), 0);
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(base64, noise) {
+	unsigned char data[1024];
+	unsigned char verify[1024];
+	unsigned char reference[1024];
+	char text[4096];
+	size_t size, length, iloop, capacity, written, expected;
+
+	// All byte values as noise, including padding characters in the middle of data
+	for (iloop = 0; iloop < 512; ++iloop) {
+		size = random32_range(0, sizeof(data));
+		for (length = 0; length < size; ++length)
+			data[length] = (unsigned char)random32();
+		length = base64_encode(data, size, text, sizeof(text)) - 1;
+		while (length < sizeof(text)) {
+			size_t pos;
+			if (random32_range(0, 8) == 0)
+				break;
+			pos = random32_range(0, (uint32_t)length + 1);
+			memmove(text + pos + 1, text + pos, length - pos);
+			text[pos] = (char)random32_range(0, 256);
+			++length;
+		}
+		capacity = (iloop & 1) ? sizeof(verify) : random32_range(0, sizeof(verify));
+		expected = test_base64_reference_decode(text, length, reference, capacity);
+		written = base64_decode(text, length, verify, capacity);
+		EXPECT_SIZEEQ(written, expected);
+		EXPECT_EQ(memcmp(verify, reference, written), 0);
+	}
+
+	// Invalid characters at every position of a vector block
+	size = 96;
+	for (length = 0; length < size; ++length)
+		data[length] = (unsigned char)random32();
+	length = base64_encode(data, size, text, sizeof(text)) - 1;
+	for (iloop = 0; iloop < length; ++iloop) {
+		char noise[] = {'=', '\n', ' ', (char)0x80, (char)0xFF, '-', '_', 0};
+		size_t inoise;
+		for (inoise = 0; inoise < sizeof(noise); ++inoise) {
+			char prev = text[iloop];
+			text[iloop] = noise[inoise];
+			expected = test_base64_reference_decode(text, length, reference, sizeof(reference));
+			written = base64_decode(text, length, verify, sizeof(verify));
+			EXPECT_SIZEEQ(written, expected);
+			EXPECT_EQ(memcmp(verify, reference, written), 0);
+			text[iloop] = prev;
+		}
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(base64, stream) {
+	unsigned char data[8000];
+	unsigned char verify[8000];
+	char text[12000];
+	char reference[12000];
+	stream_t* memstream;
+	stream_t* b64stream;
+	size_t length, size, offset, iloop;
+
+	for (length = 0; length < sizeof(data); ++length)
+		data[length] = (unsigned char)random32();
+
+	for (iloop = 0; iloop < 16; ++iloop) {
+		size = (iloop < 4) ? iloop : random32_range(4, sizeof(data));
+		length = base64_encode(data, size, reference, sizeof(reference)) - 1;
+
+		// Encode in random chunk sizes
+		memstream = buffer_stream_allocate(text, STREAM_IN | STREAM_OUT | STREAM_BINARY, 0, sizeof(text), false, false);
+		b64stream = base64_stream_allocate(memstream, false);
+		EXPECT_EQ(stream_is_sequential(b64stream), true);
+		for (offset = 0; offset < size;) {
+			size_t chunk = random32_range(1, 600);
+			chunk = math_min(size - offset, chunk);
+			EXPECT_SIZEEQ(stream_write(b64stream, data + offset, chunk), chunk);
+			offset += chunk;
+		}
+		EXPECT_SIZEEQ(stream_tell(b64stream), size);
+		base64_stream_finish(b64stream);
+		EXPECT_SIZEEQ(stream_tell(memstream), length);
+		EXPECT_EQ(memcmp(text, reference, length), 0);
+		stream_deallocate(b64stream);
+		EXPECT_SIZEEQ(stream_tell(memstream), length);
+
+		// Decode in random chunk sizes with line breaks inserted
+		for (offset = 0; offset < length; offset += 77)
+			reference[offset] = '\n';
+		stream_seek(memstream, 0, STREAM_SEEK_BEGIN);
+		stream_write(memstream, reference, length);
+		stream_truncate(memstream, length);
+		stream_seek(memstream, 0, STREAM_SEEK_BEGIN);
+		size = base64_decode(reference, length, data, sizeof(data));
+		b64stream = base64_stream_allocate(memstream, true);
+		memset(verify, 0, sizeof(verify));
+		for (offset = 0; !stream_eos(b64stream);) {
+			size_t chunk = random32_range(1, 900);
+			chunk = math_min(chunk, sizeof(verify) - offset);
+			offset += stream_read(b64stream, verify + offset, chunk);
+		}
+		EXPECT_SIZEEQ(offset, size);
+		EXPECT_SIZEEQ(stream_tell(b64stream), size);
+		EXPECT_EQ(memcmp(verify, data, size), 0);
+		EXPECT_SIZEEQ(stream_read(b64stream, verify, 1), 0);
+		stream_deallocate(b64stream);
+	}
+
+	// Failing writes to the source stream are reported as short writes, for buffered groups too
+	memstream = buffer_stream_allocate(text, STREAM_OUT | STREAM_BINARY, 0, 4, false, false);
+	b64stream = base64_stream_allocate(memstream, false);
+	EXPECT_SIZEEQ(stream_write(b64stream, data, 2), 2);
+	EXPECT_SIZEEQ(stream_write(b64stream, data + 2, 1), 1);
+	EXPECT_SIZEEQ(stream_write(b64stream, data + 3, 3), 0);
+	EXPECT_SIZEEQ(stream_write(b64stream, data + 3, 2), 2);
+	EXPECT_SIZEEQ(stream_write(b64stream, data + 5, 1), 0);
+	EXPECT_SIZEEQ(stream_tell(b64stream), 5);
+	EXPECT_SIZEEQ(stream_tell(memstream), 4);
+	stream_deallocate(b64stream);
+	stream_deallocate(memstream);
+
+	return 0;
+}
+
 static void
 test_base64_declare(void) {
 	ADD_TEST(base64, encode_decode);
+	ADD_TEST(base64, vector);
+	ADD_TEST(base64, noise);
+	ADD_TEST(base64, stream);
 }
 
 static test_suite_t test_base64_suite = {test_base64_application,
@@ -238,6 +238,51 @@ DECLARE_TEST(blowfish, random_data) {
 		blowfish_encrypt(blowfish, plaintext[0], 1024 * 8, BLOCKCIPHER_OFB, init_vector);
 		blowfish_decrypt(blowfish, plaintext[0], 1024 * 8, BLOCKCIPHER_OFB, init_vector);
 		EXPECT_EQ(memcmp(plaintext[0], plaintext[1], 1024 * 8), 0);
+
+		j = random32_range(0, 1024 * 8);
+		blowfish_encrypt(blowfish, plaintext[0], j, BLOCKCIPHER_CTR, init_vector);
+		blowfish_decrypt(blowfish, plaintext[0], j, BLOCKCIPHER_CTR, init_vector);
+		EXPECT_EQ(memcmp(plaintext[0], plaintext[1], 1024 * 8), 0);
+	}
+
+	blowfish_deallocate(blowfish);
+
+	return 0;
+}
+
+DECLARE_TEST(blowfish, counter) {
+	uint64_t plaintext[3][512];
+	uint64_t keytext[4];
+	unsigned int i, j;
+	blowfish_t* blowfish;
+	uint64_t init_vector;
+	size_t offset, length;
+
+	blowfish = blowfish_allocate();
+
+	for (j = 0; j < 4; ++j)
+		keytext[j] = random64();
+	for (j = 0; j < 512; ++j)
+		plaintext[0][j] = random64();
+	blowfish_initialize(blowfish, keytext, sizeof(keytext));
+
+	// Counter for the first block is the initialization vector, same keystream as output feedback
+	init_vector = 0xFFFFFFFFFFFFFF00ULL;
+	memcpy(plaintext[1], plaintext[0], 8);
+	memcpy(plaintext[2], plaintext[0], 8);
+	blowfish_encrypt(blowfish, plaintext[1], 8, BLOCKCIPHER_CTR, init_vector);
+	blowfish_encrypt(blowfish, plaintext[2], 8, BLOCKCIPHER_OFB, init_vector);
+	EXPECT_EQ(plaintext[1][0], plaintext[2][0]);
+
+	// Counter wraps around, any block aligned range can be processed independently
+	memcpy(plaintext[1], plaintext[0], sizeof(plaintext[0]));
+	blowfish_encrypt(blowfish, plaintext[1], sizeof(plaintext[0]), BLOCKCIPHER_CTR, init_vector);
+	for (i = 0; i < 256; ++i) {
+		offset = random32_range(0, 512);
+		length = random32_range(0, (uint32_t)((512 - offset) * 8) + 1);
+		memcpy(plaintext[2], plaintext[0] + offset, length);
+		blowfish_encrypt(blowfish, plaintext[2], length, BLOCKCIPHER_CTR, init_vector + offset);
+		EXPECT_EQ(memcmp(plaintext[2], plaintext[1] + offset, length), 0);
 	}
 
 	blowfish_deallocate(blowfish);
@@ -245,11 +290,52 @@ DECLARE_TEST(blowfish, random_data) {
 	return 0;
 }
 
+DECLARE_TEST(blowfish, parallel) {
+	const size_t size = 1024 * 1024 + 13;
+	unsigned char* plaintext = memory_allocate(0, size, 8, MEMORY_PERSISTENT);
+	unsigned char* reference = memory_allocate(0, size, 8, MEMORY_PERSISTENT);
+	unsigned char* data = memory_allocate(0, size, 8, MEMORY_PERSISTENT);
+	uint64_t keytext[4];
+	blowfish_t blowfish;
+	blockcipher_mode_t mode;
+	uint64_t init_vector = random64();
+	size_t threads;
+
+	for (size_t i = 0; i < size; ++i)
+		plaintext[i] = (unsigned char)random32();
+	for (unsigned int j = 0; j < 4; ++j)
+		keytext[j] = random64();
+	blowfish_initialize(&blowfish, keytext, sizeof(keytext));
+
+	for (mode = BLOCKCIPHER_ECB; mode <= BLOCKCIPHER_CTR; ++mode) {
+		for (threads = 0; threads < 6; threads += 3) {
+			memcpy(reference, plaintext, size);
+			blowfish_encrypt(&blowfish, reference, size, mode, init_vector);
+
+			memcpy(data, plaintext, size);
+			blowfish_encrypt_parallel(&blowfish, data, size, mode, init_vector, threads);
+			EXPECT_EQ(memcmp(data, reference, size), 0);
+
+			blowfish_decrypt_parallel(&blowfish, data, size, mode, init_vector, threads + 1);
+			EXPECT_EQ(memcmp(data, plaintext, size), 0);
+		}
+	}
+
+	blowfish_finalize(&blowfish);
+	memory_deallocate(plaintext);
+	memory_deallocate(reference);
+	memory_deallocate(data);
+
+	return 0;
+}
+
 static void
 test_blowfish_declare(void) {
 	ADD_TEST(blowfish, initialize);
 	ADD_TEST(blowfish, known_data);
 	ADD_TEST(blowfish, random_data);
+	ADD_TEST(blowfish, counter);
+	ADD_TEST(blowfish, parallel);
 }
 
 static test_suite_t test_blowfish_suite = {test_blowfish_application,
@@ -0,0 +1,262 @@
+/* main.c  -  Foundation crc test  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+static application_t
+test_crc_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Foundation crc tests"));
+	app.short_name = string_const(STRING_CONST("test_crc"));
+	app.company = string_const(STRING_CONST(""));
+	app.flags = APPLICATION_UTILITY;
+	app.exception_handler = test_exception_handler;
+	return app;
+}
+
+static memory_system_t
+test_crc_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_crc_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_crc_initialize(void) {
+	return 0;
+}
+
+static void
+test_crc_finalize(void) {
+}
+
+static uint32_t
+test_crc_bitwise(uint32_t crc, const unsigned char* data, size_t size) {
+	crc = ~crc;
+	while (size--) {
+		crc ^= *data++;
+		for (int ibit = 0; ibit < 8; ++ibit)
+			crc = (crc & 1) ? ((crc >> 1) ^ 0x82F63B78U) : (crc >> 1);
+	}
+	return ~crc;
+}
+
+DECLARE_TEST(crc, reference) {
+	unsigned char data[32];
+
+	EXPECT_UINTEQ(crc32c(0, 0), 0);
+	EXPECT_UINTEQ(crc32c(STRING_CONST("123456789")), 0xE3069283U);
+
+	// Test vectors from RFC 3720 (iSCSI), appendix B.4
+	memset(data, 0, sizeof(data));
+	EXPECT_UINTEQ(crc32c(data, sizeof(data)), 0x8A9136AAU);
+	memset(data, 0xFF, sizeof(data));
+	EXPECT_UINTEQ(crc32c(data, sizeof(data)), 0x62A8AB43U);
+	for (unsigned int i = 0; i < 32; ++i)
+		data[i] = (unsigned char)i;
+	EXPECT_UINTEQ(crc32c(data, sizeof(data)), 0x46DD794EU);
+	for (unsigned int i = 0; i < 32; ++i)
+		data[i] = (unsigned char)(31 - i);
+	EXPECT_UINTEQ(crc32c(data, sizeof(data)), 0x113FDB5CU);
+
+	return 0;
+}
+
+DECLARE_TEST(crc, incremental) {
+	const size_t size = 256 * 1024 + 17;
+	unsigned char* data = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	uint32_t reference;
+	uint32_t crc;
+	size_t offset, ichunk;
+
+	for (size_t i = 0; i < size; ++i)
+		data[i] = (unsigned char)random32();
+
+	// Cover unaligned starts and all block paths of the interleaved implementation
+	reference = test_crc_bitwise(0, data, size);
+	EXPECT_UINTEQ(crc32c(data, size), reference);
+	for (size_t start = 1; start < 16; ++start)
+		EXPECT_UINTEQ(crc32c(data + start, size - start), test_crc_bitwise(0, data + start, size - start));
+
+	for (ichunk = 0; ichunk < 64; ++ichunk) {
+		crc = 0;
+		offset = 0;
+		while (offset < size) {
+			size_t chunk = random32_range(0, (uint32_t)(ichunk * 1024) + 64);
+			if (chunk > size - offset)
+				chunk = size - offset;
+			crc = crc32c_update(crc, data + offset, chunk);
+			offset += chunk;
+		}
+		EXPECT_UINTEQ(crc, reference);
+	}
+
+	memory_deallocate(data);
+
+	return 0;
+}
+
+DECLARE_TEST(crc, combine) {
+	const size_t size = 64 * 1024;
+	unsigned char* data = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	uint32_t reference;
+
+	for (size_t i = 0; i < size; ++i)
+		data[i] = (unsigned char)random32();
+
+	reference = crc32c(data, size);
+	EXPECT_UINTEQ(crc32c_combine(reference, 0, 0), reference);
+	EXPECT_UINTEQ(crc32c_combine(0, reference, size), reference);
+
+	for (size_t i = 0; i < 256; ++i) {
+		size_t split = (i < 16) ? i : random32_range(0, (uint32_t)size + 1);
+		uint32_t crc0 = crc32c(data, split);
+		uint32_t crc1 = crc32c(data + split, size - split);
+		EXPECT_UINTEQ(crc32c_combine(crc0, crc1, size - split), reference);
+	}
+
+	memory_deallocate(data);
+
+	return 0;
+}
+
+DECLARE_TEST(crc, stream) {
+	char buffer[1024];
+	char record[256];
+	stream_t* memstream;
+	stream_t* crcstream;
+	uint32_t crc;
+
+	for (size_t i = 0; i < sizeof(record); ++i)
+		record[i] = (char)random32();
+
+	memstream = buffer_stream_allocate(buffer, STREAM_IN | STREAM_OUT | STREAM_BINARY, 0, sizeof(buffer), false, false);
+	crcstream = crc32c_stream_allocate(memstream, true);
+	EXPECT_NE(crcstream, 0);
+	EXPECT_UINTEQ(crc32c_stream_read_checksum(crcstream), 0);
+	EXPECT_UINTEQ(crc32c_stream_write_checksum(crcstream), 0);
+
+	// Records with trailing checksum, reset at each record boundary
+	for (int irecord = 0; irecord < 3; ++irecord) {
+		EXPECT_SIZEEQ(stream_write(crcstream, record, sizeof(record)), sizeof(record));
+		stream_write_uint32(crcstream, (uint32_t)irecord);
+		crc = crc32c_stream_write_checksum(crcstream);
+		stream_write_uint32(memstream, crc);
+		crc32c_stream_reset(crcstream);
+	}
+	EXPECT_SIZEEQ(stream_size(crcstream), 3 * (sizeof(record) + 8));
+	EXPECT_SIZEEQ(stream_tell(crcstream), 3 * (sizeof(record) + 8));
+	EXPECT_UINTEQ(crc32c_stream_read_checksum(crcstream), 0);
+
+	stream_seek(crcstream, 0, STREAM_SEEK_BEGIN);
+	for (int irecord = 0; irecord < 3; ++irecord) {
+		char readrecord[256];
+		EXPECT_SIZEEQ(stream_read(crcstream, readrecord, sizeof(readrecord)), sizeof(readrecord));
+		EXPECT_EQ(memcmp(readrecord, record, sizeof(record)), 0);
+		EXPECT_UINTEQ(stream_read_uint32(crcstream), (uint32_t)irecord);
+		crc = crc32c_stream_read_checksum(crcstream);
+		EXPECT_UINTEQ(stream_read_uint32(memstream), crc);
+		crc32c_stream_reset(crcstream);
+	}
+	EXPECT_TRUE(stream_eos(crcstream));
+	EXPECT_UINTEQ(crc32c_stream_write_checksum(crcstream), 0);
+
+	// Checksum covers all data written
+	stream_seek(crcstream, 0, STREAM_SEEK_BEGIN);
+	stream_read(crcstream, buffer, sizeof(record) + 4);
+	EXPECT_UINTEQ(crc32c_stream_read_checksum(crcstream), crc32c(buffer, sizeof(record) + 4));
+
+	stream_deallocate(crcstream);
+
+	return 0;
+}
+
+DECLARE_TEST(crc, bitbuffer) {
+	uint32_t buffer[64];
+	stream_t* memstream;
+	stream_t* crcstream;
+	bitbuffer_t bitbuffer;
+
+	memstream = buffer_stream_allocate(buffer, STREAM_IN | STREAM_OUT, 0, sizeof(buffer), false, false);
+	crcstream = crc32c_stream_allocate(memstream, false);
+
+	bitbuffer_initialize_stream(&bitbuffer, crcstream);
+	for (unsigned int i = 0; i < 100; ++i)
+		bitbuffer_write32(&bitbuffer, i, 1 + (i % 32));
+	bitbuffer_write64(&bitbuffer, 0x123456789ABCDEF0ULL, 64);
+	bitbuffer_align_write(&bitbuffer, true);
+	bitbuffer_finalize(&bitbuffer);
+
+	EXPECT_SIZEGT(stream_size(memstream), 0);
+	EXPECT_UINTEQ(crc32c_stream_write_checksum(crcstream), crc32c(buffer, stream_size(memstream)));
+
+	stream_seek(crcstream, 0, STREAM_SEEK_BEGIN);
+	bitbuffer_initialize_stream(&bitbuffer, crcstream);
+	for (unsigned int i = 0; i < 100; ++i)
+		EXPECT_UINTEQ(bitbuffer_read32(&bitbuffer, 1 + (i % 32)), i & (uint32_t)((1ULL << (1 + (i % 32))) - 1));
+	EXPECT_EQ(bitbuffer_read64(&bitbuffer, 64), 0x123456789ABCDEF0ULL);
+	bitbuffer_finalize(&bitbuffer);
+
+	EXPECT_UINTEQ(crc32c_stream_read_checksum(crcstream), crc32c_stream_write_checksum(crcstream));
+
+	stream_deallocate(crcstream);
+	stream_deallocate(memstream);
+
+	return 0;
+}
+
+static void
+test_crc_declare(void) {
+	ADD_TEST(crc, reference);
+	ADD_TEST(crc, incremental);
+	ADD_TEST(crc, combine);
+	ADD_TEST(crc, stream);
+	ADD_TEST(crc, bitbuffer);
+}
+
+static test_suite_t test_crc_suite = {test_crc_application,
+                                      test_crc_memory_system,
+                                      test_crc_config,
+                                      test_crc_declare,
+                                      test_crc_initialize,
+                                      test_crc_finalize,
+                                      0};
+
+#if BUILD_MONOLITHIC
+
+int
+test_crc_run(void);
+
+int
+test_crc_run(void) {
+	test_suite = test_crc_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_crc_suite;
+}
+
+#endif
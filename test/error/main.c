@@ -246,13 +246,15 @@ static hash_t last_log_context;
 static error_level_t last_log_severity;
 static const char* last_log_msg;
 static size_t last_log_length;
+static char last_log_buffer[512];
 
 static void
 log_verify_handler(hash_t context, error_level_t severity, const char* msg, size_t length) {
+	// Message is in a temporary buffer only valid during the call, keep a copy
 	last_log_context = context;
 	last_log_severity = severity;
-	last_log_msg = msg;
-	last_log_length = length;
+	last_log_msg = string_copy(last_log_buffer, sizeof(last_log_buffer), msg, length).str;
+	last_log_length = math_min(length, sizeof(last_log_buffer) - 1);
 }
 
 #endif
@@ -556,6 +556,86 @@ DECLARE_TEST(fs, query) {
 	return 0;
 }
 
+static uint256_t
+test_fs_digest_sha256(unsigned char prefix, const void* data, size_t size) {
+	sha256_t sha;
+	sha256_initialize(&sha);
+	sha256_digest(&sha, &prefix, 1);
+	sha256_digest(&sha, data, size);
+	sha256_digest_finalize(&sha);
+	uint256_t raw = sha256_get_digest_raw(&sha);
+	sha256_finalize(&sha);
+	return raw;
+}
+
+static uint256_t
+test_fs_digest_sha256_pair(uint256_t left, uint256_t right) {
+	unsigned char pair[64];
+	for (size_t iword = 0; iword < 4; ++iword) {
+		uint64_t lword = byteorder_bigendian64(left.word[iword]);
+		uint64_t rword = byteorder_bigendian64(right.word[iword]);
+		memcpy(pair + (iword * 8), &lword, 8);
+		memcpy(pair + 32 + (iword * 8), &rword, 8);
+	}
+	return test_fs_digest_sha256(1, pair, sizeof(pair));
+}
+
+DECLARE_TEST(fs, digest) {
+	char buf[BUILD_MAX_PATHLEN];
+	const size_t size = (3 * FS_DIGEST_LEAF_SIZE) + 123;
+	unsigned char* data = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	const fs_digest_t algorithm[] = {FS_DIGEST_MD5, FS_DIGEST_SHA256, FS_DIGEST_SHA512, FS_DIGEST_HASH128};
+	string_const_t fname = string_from_uint_static(random64(), true, 0, 0);
+	string_t testpath =
+	    path_concat(buf, BUILD_MAX_PATHLEN, STRING_ARGS(environment_temporary_directory()), STRING_ARGS(fname));
+	stream_t* teststream;
+	size_t i, ialg;
+
+	if (!fs_is_directory(STRING_ARGS(environment_temporary_directory())))
+		fs_make_directory(STRING_ARGS(environment_temporary_directory()));
+
+	EXPECT_TRUE(uint512_is_null(fs_digest_parallel(STRING_ARGS(testpath), FS_DIGEST_MD5, 0)));
+
+	// Empty file is a single empty leaf
+	stream_deallocate(fs_open_file(STRING_ARGS(testpath), STREAM_OUT | STREAM_CREATE | STREAM_TRUNCATE));
+	uint512_t digest = fs_digest_parallel(STRING_ARGS(testpath), FS_DIGEST_MD5, 0);
+	EXPECT_EQ(digest.word[0], 0x93b885adfe0da089ULL);
+	EXPECT_EQ(digest.word[1], 0xcdf634904fd59f71ULL);
+	EXPECT_EQ(digest.word[2], 0);
+
+	for (i = 0; i < size; ++i)
+		data[i] = (unsigned char)random32();
+	teststream = fs_open_file(STRING_ARGS(testpath), STREAM_OUT | STREAM_BINARY | STREAM_TRUNCATE);
+	EXPECT_NE(teststream, 0);
+	EXPECT_SIZEEQ(stream_write(teststream, data, size), size);
+	stream_deallocate(teststream);
+
+	// Four leaves, root is ((leaf0, leaf1), (leaf2, leaf3))
+	uint256_t leaf[4];
+	for (i = 0; i < 4; ++i)
+		leaf[i] = test_fs_digest_sha256(0, data + (i * FS_DIGEST_LEAF_SIZE),
+		                                math_min(size - (i * FS_DIGEST_LEAF_SIZE), (size_t)FS_DIGEST_LEAF_SIZE));
+	uint256_t root = test_fs_digest_sha256_pair(test_fs_digest_sha256_pair(leaf[0], leaf[1]),
+	                                            test_fs_digest_sha256_pair(leaf[2], leaf[3]));
+
+	digest = fs_digest_parallel(STRING_ARGS(testpath), FS_DIGEST_SHA256, 0);
+	for (i = 0; i < 4; ++i)
+		EXPECT_EQ(digest.word[i], root.word[i]);
+	EXPECT_EQ(digest.word[4], 0);
+
+	for (ialg = 0; ialg < sizeof(algorithm) / sizeof(algorithm[0]); ++ialg) {
+		uint512_t ref = fs_digest_parallel(STRING_ARGS(testpath), algorithm[ialg], 1);
+		EXPECT_FALSE(uint512_is_null(ref));
+		EXPECT_TRUE(uint512_equal(ref, fs_digest_parallel(STRING_ARGS(testpath), algorithm[ialg], 3)));
+		EXPECT_TRUE(uint512_equal(ref, fs_digest_parallel(STRING_ARGS(testpath), algorithm[ialg], 16)));
+	}
+
+	fs_remove_file(STRING_ARGS(testpath));
+	memory_deallocate(data);
+
+	return 0;
+}
+
 DECLARE_TEST(fs, event) {
 	event_stream_t* stream;
 	event_block_t* block;
@@ -921,6 +1001,7 @@ test_fs_declare(void) {
 	ADD_TEST(fs, file);
 	ADD_TEST(fs, util);
 	ADD_TEST(fs, query);
+	ADD_TEST(fs, digest);
 	ADD_TEST(fs, event);
 #if !FOUNDATION_PLATFORM_IOS && !FOUNDATION_PLATFORM_ANDROID && !FOUNDATION_PLATFORM_BSD
 	ADD_TEST(fs, monitor);
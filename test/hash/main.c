@@ -139,11 +139,69 @@ DECLARE_TEST(hash, stability) {
 	return 0;
 }
 
+DECLARE_TEST(hash, incremental) {
+	uint64_t data[65];
+	unsigned char* buffer = (unsigned char*)data;
+	size_t len, offset, chunk, iloop;
+	hash_state_t state;
+
+	for (len = 0; len < sizeof(uint64_t) * 64; ++len) {
+		for (offset = 0; offset < (len + 7) / 8; ++offset)
+			data[offset] = random64();
+
+		hash_t ref = hash(data, len);
+		uint128_t ref128 = hash128(data, len);
+		EXPECT_EQ(ref128.word[0], ref);
+
+		for (iloop = 0; iloop < 4; ++iloop) {
+			hash_initialize(&state);
+			for (offset = 0; offset < len; offset += chunk) {
+				chunk = (iloop == 0) ? 1 : random32_range(0, 40);
+				if (chunk > len - offset)
+					chunk = len - offset;
+				hash_update(&state, buffer + offset, chunk);
+			}
+			EXPECT_EQ(hash_finalize(&state), ref);
+			EXPECT_TRUE(uint128_equal(hash_finalize128(&state), ref128));
+		}
+
+		// Unaligned input
+		if (len) {
+			memmove(buffer + 1, buffer, len);
+			EXPECT_TRUE(uint128_equal(hash128(buffer + 1, len), ref128));
+		}
+	}
+
+	hash_initialize(&state);
+	EXPECT_EQ(hash_finalize(&state), HASH_EMPTY_STRING);
+	hash_update(hash_update(&state, STRING_CONST("cache_")), STRING_CONST("directory"));
+	EXPECT_EQ(hash_finalize(&state), 0x3e7b4931a3841da8ULL);
+
+	return 0;
+}
+
+DECLARE_TEST(hash, stream) {
+	char text[] = "server_address";
+	stream_t* stream = buffer_stream_allocate(text, STREAM_IN | STREAM_BINARY, sizeof(text) - 1, sizeof(text), false, false);
+	EXPECT_EQ(stream_hash(stream), 0x64fcf494cf8072f5ULL);
+	EXPECT_TRUE(uint128_equal(stream_hash128(stream), hash128(STRING_CONST("server_address"))));
+	stream_deallocate(stream);
+
+	char crlf[] = "engine\r\nport\r\n";
+	stream = buffer_stream_allocate(crlf, STREAM_IN, sizeof(crlf) - 1, sizeof(crlf), false, false);
+	EXPECT_EQ(stream_hash(stream), hash(STRING_CONST("engine\nport\n")));
+	stream_deallocate(stream);
+
+	return 0;
+}
+
 static void
 test_hash_declare(void) {
 	ADD_TEST(hash, known);
 	ADD_TEST(hash, store);
 	ADD_TEST(hash, stability);
+	ADD_TEST(hash, incremental);
+	ADD_TEST(hash, stream);
 }
 
 static test_suite_t test_hash_suite = {test_hash_application,
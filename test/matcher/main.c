@@ -0,0 +1,365 @@
+/* main.c  -  Foundation matcher test  -  Public Domain  -  2026 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+static application_t
+test_matcher_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Foundation matcher tests"));
+	app.short_name = string_const(STRING_CONST("test_matcher"));
+	app.company = string_const(STRING_CONST(""));
+	app.flags = APPLICATION_UTILITY;
+	app.exception_handler = test_exception_handler;
+	return app;
+}
+
+static memory_system_t
+test_matcher_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_matcher_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_matcher_initialize(void) {
+	return 0;
+}
+
+static void
+test_matcher_finalize(void) {
+}
+
+typedef struct {
+	size_t pattern;
+	size_t offset;
+	size_t length;
+} test_match_t;
+
+typedef struct {
+	test_match_t* match;
+	size_t count;
+	size_t capacity;
+	size_t stop;
+} test_match_list_t;
+
+static int
+test_matcher_collect(size_t pattern, size_t offset, size_t length, void* context) {
+	test_match_list_t* list = context;
+	if (list->count < list->capacity) {
+		list->match[list->count].pattern = pattern;
+		list->match[list->count].offset = offset;
+		list->match[list->count].length = length;
+	}
+	++list->count;
+	return (list->stop && (list->count >= list->stop)) ? 1 : 0;
+}
+
+static int
+test_matcher_compare(const void* lhs, const void* rhs) {
+	const test_match_t* first = lhs;
+	const test_match_t* second = rhs;
+	const size_t first_end = first->offset + first->length;
+	const size_t second_end = second->offset + second->length;
+	if (first_end != second_end)
+		return (first_end < second_end) ? -1 : 1;
+	if (first->length != second->length)
+		return (first->length > second->length) ? -1 : 1;
+	if (first->pattern != second->pattern)
+		return (first->pattern < second->pattern) ? -1 : 1;
+	return 0;
+}
+
+//! Find all occurrences with one substring search per pattern, sorted in matcher report order
+static size_t
+test_matcher_naive(const string_const_t* patterns, size_t count, const char* text, size_t length,
+                   test_match_list_t* list) {
+	list->count = 0;
+	for (size_t ipattern = 0; ipattern < count; ++ipattern) {
+		size_t offset = 0;
+		if (!patterns[ipattern].length)
+			continue;
+		while ((offset = string_find_string(text, length, STRING_ARGS(patterns[ipattern]), offset)) !=
+		       STRING_NPOS) {
+			test_matcher_collect(ipattern, offset, patterns[ipattern].length, list);
+			++offset;
+		}
+	}
+	if (list->count <= list->capacity)
+		qsort(list->match, list->count, sizeof(test_match_t), test_matcher_compare);
+	return list->count;
+}
+
+static bool
+test_matcher_equal(const test_match_list_t* lhs, const test_match_list_t* rhs) {
+	if (lhs->count != rhs->count)
+		return false;
+	return memcmp(lhs->match, rhs->match, sizeof(test_match_t) * lhs->count) == 0;
+}
+
+DECLARE_TEST(matcher, basic) {
+	string_const_t patterns[] = {string_const(STRING_CONST("he")), string_const(STRING_CONST("she")),
+	                             string_const(STRING_CONST("his")), string_const(STRING_CONST("hers"))};
+	test_match_t match[16];
+	test_match_list_t list = {match, 0, 16, 0};
+	matcher_t* matcher;
+
+	matcher = matcher_allocate(patterns, sizeof(patterns) / sizeof(patterns[0]));
+	EXPECT_NE(matcher, 0);
+
+	EXPECT_SIZEEQ(matcher_scan(matcher, STRING_CONST("ushers"), test_matcher_collect, &list), 3);
+	EXPECT_SIZEEQ(list.count, 3);
+	EXPECT_SIZEEQ(match[0].pattern, 1);
+	EXPECT_SIZEEQ(match[0].offset, 1);
+	EXPECT_SIZEEQ(match[0].length, 3);
+	EXPECT_SIZEEQ(match[1].pattern, 0);
+	EXPECT_SIZEEQ(match[1].offset, 2);
+	EXPECT_SIZEEQ(match[1].length, 2);
+	EXPECT_SIZEEQ(match[2].pattern, 3);
+	EXPECT_SIZEEQ(match[2].offset, 2);
+	EXPECT_SIZEEQ(match[2].length, 4);
+
+	list.count = 0;
+	EXPECT_SIZEEQ(matcher_scan(matcher, STRING_CONST("this is his history"), test_matcher_collect, &list), 3);
+	EXPECT_SIZEEQ(match[0].pattern, 2);
+	EXPECT_SIZEEQ(match[0].offset, 1);
+	EXPECT_SIZEEQ(match[1].pattern, 2);
+	EXPECT_SIZEEQ(match[1].offset, 8);
+	EXPECT_SIZEEQ(match[2].pattern, 2);
+	EXPECT_SIZEEQ(match[2].offset, 12);
+
+	list.count = 0;
+	EXPECT_SIZEEQ(matcher_scan(matcher, STRING_CONST("nothing to find"), test_matcher_collect, &list), 0);
+	EXPECT_SIZEEQ(matcher_scan(matcher, 0, 0, test_matcher_collect, &list), 0);
+	EXPECT_SIZEEQ(list.count, 0);
+
+	// Stop at second match
+	list.stop = 2;
+	EXPECT_SIZEEQ(matcher_scan(matcher, STRING_CONST("ushers"), test_matcher_collect, &list), 2);
+	EXPECT_SIZEEQ(list.count, 2);
+
+	matcher_deallocate(matcher);
+
+	return 0;
+}
+
+DECLARE_TEST(matcher, overlap) {
+	string_const_t patterns[] = {string_const(STRING_CONST("aa")), string_empty(),
+	                             string_const(STRING_CONST("a")), string_const(STRING_CONST("aaa")),
+	                             string_const(STRING_CONST("aa"))};
+	string_const_t binary[256];
+	char bytes[256];
+	test_match_t match[512];
+	test_match_list_t list = {match, 0, 512, 0};
+	matcher_t matcher;
+
+	matcher_initialize(&matcher, patterns, sizeof(patterns) / sizeof(patterns[0]));
+	// Each position ends an occurrence of "a", positions after the first end "aa" twice
+	// and positions after the second end "aaa"
+	EXPECT_SIZEEQ(matcher_scan(&matcher, STRING_CONST("aaaa"), test_matcher_collect, &list), 4 + 3 * 2 + 2);
+	EXPECT_SIZEEQ(match[0].pattern, 2);
+	EXPECT_SIZEEQ(match[1].pattern, 0);
+	EXPECT_SIZEEQ(match[2].pattern, 4);
+	EXPECT_SIZEEQ(match[3].pattern, 2);
+	EXPECT_SIZEEQ(match[4].pattern, 3);
+	EXPECT_SIZEEQ(match[4].offset, 0);
+	EXPECT_SIZEEQ(match[5].pattern, 0);
+	EXPECT_SIZEEQ(match[5].offset, 1);
+	matcher_finalize(&matcher);
+
+	// No patterns, or only empty patterns
+	list.count = 0;
+	matcher_initialize(&matcher, 0, 0);
+	EXPECT_SIZEEQ(matcher_scan(&matcher, STRING_CONST("aaaa"), test_matcher_collect, &list), 0);
+	matcher_finalize(&matcher);
+	matcher_initialize(&matcher, patterns + 1, 1);
+	EXPECT_SIZEEQ(matcher_scan(&matcher, STRING_CONST("aaaa"), test_matcher_collect, &list), 0);
+	matcher_finalize(&matcher);
+
+	// Patterns using all byte values
+	for (int ibyte = 0; ibyte < 256; ++ibyte) {
+		bytes[ibyte] = (char)ibyte;
+		binary[ibyte] = string_const(bytes + ibyte, (ibyte & 1) ? 1 : 2);
+	}
+	matcher_initialize(&matcher, binary, 256);
+	EXPECT_SIZEEQ(matcher_scan(&matcher, bytes, sizeof(bytes), test_matcher_collect, &list), 256);
+	EXPECT_SIZEEQ(match[0].pattern, 0);
+	EXPECT_SIZEEQ(match[1].pattern, 1);
+	EXPECT_SIZEEQ(match[1].offset, 1);
+	EXPECT_SIZEEQ(match[2].pattern, 2);
+	EXPECT_SIZEEQ(match[2].offset, 2);
+	EXPECT_SIZEEQ(match[255].pattern, 255);
+	matcher_finalize(&matcher);
+
+	return 0;
+}
+
+DECLARE_TEST(matcher, reference) {
+	const size_t pattern_counts[] = {1, 3, 16, 32, 33, 1000};
+	const size_t text_length = 64 * 1024;
+	const size_t capacity = 128 * 1024;
+	char* text = memory_allocate(0, text_length, 0, MEMORY_PERSISTENT);
+	char* storage = memory_allocate(0, 1000 * 8, 0, MEMORY_PERSISTENT);
+	string_const_t* patterns = memory_allocate(0, sizeof(string_const_t) * 1000, 0, MEMORY_PERSISTENT);
+	test_match_list_t expect = {memory_allocate(0, sizeof(test_match_t) * capacity, 0, MEMORY_PERSISTENT), 0,
+	                            capacity, 0};
+	test_match_list_t result = {memory_allocate(0, sizeof(test_match_t) * capacity, 0, MEMORY_PERSISTENT), 0,
+	                            capacity, 0};
+
+	for (size_t iset = 0; iset < sizeof(pattern_counts) / sizeof(pattern_counts[0]); ++iset) {
+		const size_t count = pattern_counts[iset];
+		// Larger pattern sets draw from a larger alphabet to keep the number of matches reasonable
+		const uint32_t alphabet = (count > 32) ? 16 : 6;
+		matcher_t* matcher;
+		matcher_state_t state;
+		size_t offset;
+
+		for (size_t ichar = 0; ichar < text_length; ++ichar)
+			text[ichar] = (char)('a' + random32_range(0, alphabet));
+		for (size_t ipattern = 0; ipattern < count; ++ipattern) {
+			const size_t length = random32_range(1, 9);
+			char* pattern = storage + (ipattern * 8);
+			// Short patterns are rare, otherwise single characters match almost everywhere
+			const size_t pattern_length = ((length < 3) && random32_range(0, (uint32_t)count)) ? 5 : length;
+			for (size_t ichar = 0; ichar < pattern_length; ++ichar)
+				pattern[ichar] = (char)('a' + random32_range(0, alphabet));
+			patterns[ipattern] = string_const(pattern, pattern_length);
+		}
+
+		test_matcher_naive(patterns, count, text, text_length, &expect);
+		EXPECT_SIZELT(expect.count, capacity);
+
+		matcher = matcher_allocate(patterns, count);
+
+		result.count = 0;
+		EXPECT_SIZEEQ(matcher_scan(matcher, text, text_length, test_matcher_collect, &result), expect.count);
+		EXPECT_TRUE(test_matcher_equal(&result, &expect));
+
+		// Incremental scanning in random size chunks reports the same matches
+		result.count = 0;
+		matcher_state_initialize(&state);
+		for (offset = 0; offset < text_length;) {
+			size_t chunk = random32_range(0, 200);
+			if (chunk > text_length - offset)
+				chunk = text_length - offset;
+			matcher_scan_chunk(matcher, &state, text + offset, chunk, test_matcher_collect, &result);
+			offset += chunk;
+		}
+		EXPECT_SIZEEQ(state.offset, text_length);
+		EXPECT_SIZEEQ(result.count, expect.count);
+		EXPECT_TRUE(test_matcher_equal(&result, &expect));
+
+		matcher_deallocate(matcher);
+	}
+
+	memory_deallocate(result.match);
+	memory_deallocate(expect.match);
+	memory_deallocate(patterns);
+	memory_deallocate(storage);
+	memory_deallocate(text);
+
+	return 0;
+}
+
+DECLARE_TEST(matcher, stream) {
+	const size_t text_length = 200 * 1024;
+	const size_t capacity = 16 * 1024;
+	char* text = memory_allocate(0, text_length, 0, MEMORY_PERSISTENT);
+	string_const_t patterns[] = {string_const(STRING_CONST("needle")), string_const(STRING_CONST("pin")),
+	                             string_const(STRING_CONST("haystack"))};
+	test_match_list_t expect = {memory_allocate(0, sizeof(test_match_t) * capacity, 0, MEMORY_PERSISTENT), 0,
+	                            capacity, 0};
+	test_match_list_t result = {memory_allocate(0, sizeof(test_match_t) * capacity, 0, MEMORY_PERSISTENT), 0,
+	                            capacity, 0};
+	matcher_t* matcher;
+	stream_t* stream;
+
+	// Occurrences spread over the text, including across stream buffer boundaries
+	for (size_t ichar = 0; ichar < text_length; ++ichar)
+		text[ichar] = (char)('a' + random32_range(0, 26));
+	for (size_t offset = 5; offset + 8 < text_length; offset += 997 + random32_range(0, 64)) {
+		const string_const_t pattern = patterns[random32_range(0, 3)];
+		memcpy(text + offset, pattern.str, pattern.length);
+	}
+	memcpy(text + 65536 - 3, "needle", 6);
+
+	test_matcher_naive(patterns, 3, text, text_length, &expect);
+	EXPECT_SIZEGT(expect.count, 100);
+
+	matcher = matcher_allocate(patterns, 3);
+	stream = buffer_stream_allocate(text, STREAM_IN | STREAM_BINARY, text_length, text_length, false, false);
+	EXPECT_SIZEEQ(matcher_scan_stream(matcher, stream, test_matcher_collect, &result), expect.count);
+	EXPECT_TRUE(stream_eos(stream));
+	EXPECT_TRUE(test_matcher_equal(&result, &expect));
+
+	// Stopping leaves the stream at the end of the chunk holding the stopping match
+	stream_seek(stream, 0, STREAM_SEEK_BEGIN);
+	result.count = 0;
+	result.stop = 5;
+	EXPECT_SIZEEQ(matcher_scan_stream(matcher, stream, test_matcher_collect, &result), 5);
+	EXPECT_FALSE(stream_eos(stream));
+
+	stream_deallocate(stream);
+	matcher_deallocate(matcher);
+
+	memory_deallocate(result.match);
+	memory_deallocate(expect.match);
+	memory_deallocate(text);
+
+	return 0;
+}
+
+static void
+test_matcher_declare(void) {
+	ADD_TEST(matcher, basic);
+	ADD_TEST(matcher, overlap);
+	ADD_TEST(matcher, reference);
+	ADD_TEST(matcher, stream);
+}
+
+static test_suite_t test_matcher_suite = {test_matcher_application,
+                                          test_matcher_memory_system,
+                                          test_matcher_config,
+                                          test_matcher_declare,
+                                          test_matcher_initialize,
+                                          test_matcher_finalize,
+                                          0};
+
+#if BUILD_MONOLITHIC
+
+int
+test_matcher_run(void);
+
+int
+test_matcher_run(void) {
+	test_suite = test_matcher_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_matcher_suite;
+}
+
+#endif
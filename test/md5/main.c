@@ -12,6 +12,7 @@
 
 #include <foundation/foundation.h>
 #include <test/test.h>
+#include <test/digest.h>
 
 static application_t
 test_md5_application(void) {
@@ -243,11 +244,32 @@ DECLARE_TEST(md5, streams) {
 	return 0;
 }
 
+static void
+test_md5_multi(const void* const* buffers, const size_t* sizes, size_t count, void* digests) {
+	md5_digest_multi(buffers, sizes, count, digests);
+}
+
+static void
+test_md5_single(const void* buffer, size_t size, void* digest) {
+	md5_t md5;
+	md5_initialize(&md5);
+	md5_digest(&md5, buffer, size);
+	md5_digest_finalize(&md5);
+	uint128_t raw = md5_get_digest_raw(&md5);
+	md5_finalize(&md5);
+	memcpy(digest, &raw, sizeof(raw));
+}
+
+DECLARE_TEST(md5, multi) {
+	return test_digest_multi(test_md5_multi, test_md5_single, sizeof(uint128_t));
+}
+
 static void
 test_md5_declare(void) {
 	ADD_TEST(md5, empty);
 	ADD_TEST(md5, reference);
 	ADD_TEST(md5, streams);
+	ADD_TEST(md5, multi);
 }
 
 static test_suite_t test_md5_suite = {test_md5_application,
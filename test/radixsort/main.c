@@ -1077,6 +1077,514 @@ DECLARE_TEST(radixsort, sort_custom_index32) {
 	return 0;
 }
 
+DECLARE_TEST(radixsort, sort_keyvalue) {
+	const size_t num = 0x1FFFF;
+	radixsort_t* sort_int32 = radixsort_allocate_keyvalue(RADIXSORT_INT32, sizeof(uint32_t), num);
+	radixsort_t* sort_uint64 = radixsort_allocate_keyvalue(RADIXSORT_UINT64, sizeof(uint32_t), num);
+	radixsort_t* sort_float32 = radixsort_allocate_keyvalue(RADIXSORT_FLOAT32, sizeof(uint32_t), num);
+	radixsort_t* sort_float64 = radixsort_allocate_keyvalue(RADIXSORT_FLOAT64, sizeof(uint32_t), num);
+	int32_t* key_int32 = memory_allocate(0, sizeof(int32_t) * num, 0, MEMORY_PERSISTENT);
+	uint64_t* key_uint64 = memory_allocate(0, sizeof(uint64_t) * num, 0, MEMORY_PERSISTENT);
+	float32_t* key_float32 = memory_allocate(0, sizeof(float32_t) * num, 0, MEMORY_PERSISTENT);
+	float64_t* key_float64 = memory_allocate(0, sizeof(float64_t) * num, 0, MEMORY_PERSISTENT);
+	int32_t* src_int32 = memory_allocate(0, sizeof(int32_t) * num, 0, MEMORY_PERSISTENT);
+	uint64_t* src_uint64 = memory_allocate(0, sizeof(uint64_t) * num, 0, MEMORY_PERSISTENT);
+	float32_t* src_float32 = memory_allocate(0, sizeof(float32_t) * num, 0, MEMORY_PERSISTENT);
+	float64_t* src_float64 = memory_allocate(0, sizeof(float64_t) * num, 0, MEMORY_PERSISTENT);
+	uint32_t* value[4];
+	size_t ival, iloop;
+
+	for (iloop = 0; iloop < 4; ++iloop)
+		value[iloop] = memory_allocate(0, sizeof(uint32_t) * num, 0, MEMORY_PERSISTENT);
+
+	for (iloop = 0; iloop < 3; ++iloop) {
+		for (ival = 0; ival < num; ++ival) {
+			if (iloop == 1) {
+				// Low entropy keys, most passes skipped and many equal keys
+				src_int32[ival] = (int32_t)(random32() & 0xFF) - 0x80;
+				src_uint64[ival] = random64() & 0xFF00;
+			} else {
+				src_int32[ival] = (int32_t)random32();
+				src_uint64[ival] = random64();
+			}
+			src_float32[ival] = (float32_t)random_range(-(real)(1 << 30), (real)(1 << 30));
+			src_float64[ival] = (iloop == 2) ? -(float64_t)ival : random_range(-(real)(1 << 30), (real)(1 << 30));
+			for (size_t isort = 0; isort < 4; ++isort)
+				value[isort][ival] = (uint32_t)ival;
+		}
+		memcpy(key_int32, src_int32, sizeof(int32_t) * num);
+		memcpy(key_uint64, src_uint64, sizeof(uint64_t) * num);
+		memcpy(key_float32, src_float32, sizeof(float32_t) * num);
+		memcpy(key_float64, src_float64, sizeof(float64_t) * num);
+
+		radixsort_sort_keyvalue(sort_int32, key_int32, value[0], num);
+		radixsort_sort_keyvalue(sort_uint64, key_uint64, value[1], num);
+		radixsort_sort_keyvalue(sort_float32, key_float32, value[2], num);
+		radixsort_sort_keyvalue(sort_float64, key_float64, value[3], num);
+
+		for (ival = 0; ival < num; ++ival) {
+			EXPECT_INTEQ(key_int32[ival], src_int32[value[0][ival]]);
+			EXPECT_EQ(key_uint64[ival], src_uint64[value[1][ival]]);
+			EXPECT_REALEQ(key_float32[ival], src_float32[value[2][ival]]);
+			EXPECT_REALEQ((real)key_float64[ival], (real)src_float64[value[3][ival]]);
+			if (ival) {
+				EXPECT_LE(key_int32[ival - 1], key_int32[ival]);
+				EXPECT_LE(key_uint64[ival - 1], key_uint64[ival]);
+				EXPECT_LE(key_float32[ival - 1], key_float32[ival]);
+				EXPECT_LE(key_float64[ival - 1], key_float64[ival]);
+				// Sort is stable
+				if (key_int32[ival - 1] == key_int32[ival])
+					EXPECT_LT(value[0][ival - 1], value[0][ival]);
+				if (key_uint64[ival - 1] == key_uint64[ival])
+					EXPECT_LT(value[1][ival - 1], value[1][ival]);
+			}
+		}
+	}
+
+	for (iloop = 0; iloop < 4; ++iloop)
+		memory_deallocate(value[iloop]);
+	memory_deallocate(key_int32);
+	memory_deallocate(key_uint64);
+	memory_deallocate(key_float32);
+	memory_deallocate(key_float64);
+	memory_deallocate(src_int32);
+	memory_deallocate(src_uint64);
+	memory_deallocate(src_float32);
+	memory_deallocate(src_float64);
+	radixsort_deallocate(sort_int32);
+	radixsort_deallocate(sort_uint64);
+	radixsort_deallocate(sort_float32);
+	radixsort_deallocate(sort_float64);
+
+	return 0;
+}
+
+DECLARE_TEST(radixsort, sort_keyvalue_custom) {
+	const size_t num = 0xFFFF;
+	radixsort_t* sort = radixsort_allocate_keyvalue_custom(sizeof(uint128_t), sizeof(uint256_t), num);
+	uint128_t* key = memory_allocate(0, sizeof(uint128_t) * num, 0, MEMORY_PERSISTENT);
+	uint256_t* value = memory_allocate(0, sizeof(uint256_t) * num, 0, MEMORY_PERSISTENT);
+	size_t ival;
+
+	for (ival = 0; ival < num; ++ival) {
+		key[ival] = uint128_make(random64(), random64() & 0xFFFF);
+		value[ival] = uint256_make(key[ival].word[0], key[ival].word[1], ival, ~ival);
+	}
+
+	radixsort_sort_keyvalue(sort, key, value, num);
+
+	for (ival = 0; ival < num; ++ival) {
+		EXPECT_EQ(key[ival].word[0], value[ival].word[0]);
+		EXPECT_EQ(key[ival].word[1], value[ival].word[1]);
+		EXPECT_EQ(value[ival].word[2], ~value[ival].word[3]);
+		if (ival) {
+			bool ordered = (key[ival - 1].word[1] < key[ival].word[1]) ||
+			               ((key[ival - 1].word[1] == key[ival].word[1]) && (key[ival - 1].word[0] <= key[ival].word[0]));
+			EXPECT_TRUE(ordered);
+		}
+	}
+
+	memory_deallocate(key);
+	memory_deallocate(value);
+	radixsort_deallocate(sort);
+
+	return 0;
+}
+
+DECLARE_TEST(radixsort, sort_wide) {
+	// Allocated sort objects use wide digits for large inputs, compare with the byte digit passes
+	// of a caller initialized sort object using the minimal buffer sizes
+	const size_t num = 0x30000;
+	const radixsort_data_t types[] = {RADIXSORT_INT32,  RADIXSORT_UINT32,  RADIXSORT_INT64,
+	                                  RADIXSORT_UINT64, RADIXSORT_FLOAT32, RADIXSORT_FLOAT64};
+	unsigned char* arr = memory_allocate(0, sizeof(uint64_t) * num, 0, MEMORY_PERSISTENT);
+	uint32_t* index_count = memory_allocate(0, sizeof(uint32_t) * num, 0, MEMORY_PERSISTENT);
+	void* buffer = memory_allocate(0, sizeof(uint32_t) * ((2 * num) + (256 * 8) + 256), 0, MEMORY_PERSISTENT);
+	radixsort_t sort_byte;
+	size_t itype, ival;
+	int iloop;
+
+	for (itype = 0; itype < sizeof(types) / sizeof(types[0]); ++itype) {
+		const radixsort_data_t type = types[itype];
+		const bool is_float = (type == RADIXSORT_FLOAT32) || (type == RADIXSORT_FLOAT64);
+		const size_t data_size =
+		    ((type == RADIXSORT_INT64) || (type == RADIXSORT_UINT64) || (type == RADIXSORT_FLOAT64)) ? 8 : 4;
+		radixsort_t* sort_wide = radixsort_allocate(type, num);
+
+		sort_byte.indices[0] = buffer;
+		sort_byte.indices[1] = pointer_offset(buffer, sizeof(uint32_t) * num);
+		sort_byte.histogram = pointer_offset(buffer, sizeof(uint32_t) * 2 * num);
+		sort_byte.offset = pointer_offset(sort_byte.histogram, sizeof(uint32_t) * 256 * 8);
+		radixsort_initialize(&sort_byte, type, num);
+
+		EXPECT_TRUE(sort_wide->wide);
+		EXPECT_FALSE(sort_byte.wide);
+		EXPECT_EQ(sort_wide->indextype, RADIXSORT_INDEX32);
+
+		for (iloop = 0; iloop < 3; ++iloop) {
+			// Random keys, low entropy keys with many equal values and skipped passes, then the same
+			// low entropy keys again to exercise the already sorted check
+			for (ival = 0; (iloop < 2) && (ival < num); ++ival) {
+				unsigned char* value = arr + (ival * data_size);
+				if (is_float) {
+					real rval = iloop ? (real)((int)random32_range(0, 64) - 32) :
+					                    random_range(-(real)(1 << 30), (real)(1 << 30));
+					float32_t fval = (float32_t)rval;
+					float64_t dval = (float64_t)rval;
+					if (data_size == 4)
+						memcpy(value, &fval, sizeof(fval));
+					else
+						memcpy(value, &dval, sizeof(dval));
+				} else {
+					uint64_t ivalue = iloop ? (random64() & 0xFF0000FF000000FFULL) : random64();
+					if (data_size == 4) {
+						uint32_t lvalue = (uint32_t)(ivalue ^ (ivalue >> 32));
+						memcpy(value, &lvalue, sizeof(lvalue));
+					} else {
+						memcpy(value, &ivalue, sizeof(ivalue));
+					}
+				}
+			}
+
+			const uint32_t* sindex_wide = radixsort_sort(sort_wide, arr, num);
+			const uint32_t* sindex_byte = radixsort_sort(&sort_byte, arr, num);
+
+			memset(index_count, 0, sizeof(uint32_t) * num);
+			for (ival = 0; ival < num; ++ival) {
+				EXPECT_LT(sindex_wide[ival], num);
+				++index_count[sindex_wide[ival]];
+				EXPECT_EQ(memcmp(arr + (sindex_wide[ival] * data_size), arr + (sindex_byte[ival] * data_size), data_size),
+				          0);
+			}
+			for (ival = 0; ival < num; ++ival)
+				EXPECT_EQ(index_count[ival], 1);
+		}
+
+		radixsort_finalize(&sort_byte);
+		radixsort_deallocate(sort_wide);
+	}
+
+	memory_deallocate(buffer);
+	memory_deallocate(index_count);
+	memory_deallocate(arr);
+
+	return 0;
+}
+
+DECLARE_TEST(radixsort, sort_keyvalue_initialize) {
+	// Caller initialized key-value sort objects only provide byte digit buffers, compare with allocated
+	// objects using wide digits for large inputs and byte digits for small inputs
+	const size_t num = 0x1FFFF;
+	const size_t counts[] = {999, num};
+	radixsort_t sort;
+	radixsort_t* sort_alloc = radixsort_allocate_keyvalue(RADIXSORT_INT64, sizeof(uint32_t), num);
+	int64_t* key[2];
+	uint32_t* value[2];
+	size_t icount, ival;
+
+	sort.indices[0] = nullptr;
+	sort.indices[1] = nullptr;
+	sort.histogram = memory_allocate(0, sizeof(size_t) * 256 * sizeof(int64_t), 0, MEMORY_PERSISTENT);
+	sort.offset = memory_allocate(0, sizeof(size_t) * 256, 0, MEMORY_PERSISTENT);
+	sort.scratch[0] = memory_allocate(0, sizeof(int64_t) * num, 0, MEMORY_PERSISTENT);
+	sort.scratch[1] = memory_allocate(0, sizeof(uint32_t) * num, 0, MEMORY_PERSISTENT);
+	radixsort_initialize_keyvalue(&sort, RADIXSORT_INT64, sizeof(uint32_t), num);
+
+	EXPECT_FALSE(sort.wide);
+	EXPECT_TRUE(sort_alloc->wide);
+
+	for (ival = 0; ival < 2; ++ival) {
+		key[ival] = memory_allocate(0, sizeof(int64_t) * num, 0, MEMORY_PERSISTENT);
+		value[ival] = memory_allocate(0, sizeof(uint32_t) * num, 0, MEMORY_PERSISTENT);
+	}
+
+	for (icount = 0; icount < sizeof(counts) / sizeof(counts[0]); ++icount) {
+		const size_t count = counts[icount];
+		for (ival = 0; ival < count; ++ival) {
+			key[0][ival] = key[1][ival] = (int64_t)(random64() & 0xFFFF0000FFFFFFFFULL);
+			value[0][ival] = value[1][ival] = (uint32_t)ival;
+		}
+
+		radixsort_sort_keyvalue(&sort, key[0], value[0], count);
+		radixsort_sort_keyvalue(sort_alloc, key[1], value[1], count);
+
+		for (ival = 0; ival < count; ++ival) {
+			EXPECT_INTEQ(key[0][ival], key[1][ival]);
+			EXPECT_EQ(value[0][ival], value[1][ival]);
+			if (ival)
+				EXPECT_LE(key[0][ival - 1], key[0][ival]);
+		}
+	}
+
+	for (ival = 0; ival < 2; ++ival) {
+		memory_deallocate(key[ival]);
+		memory_deallocate(value[ival]);
+	}
+	memory_deallocate(sort.histogram);
+	memory_deallocate(sort.offset);
+	memory_deallocate(sort.scratch[0]);
+	memory_deallocate(sort.scratch[1]);
+	radixsort_finalize(&sort);
+	radixsort_deallocate(sort_alloc);
+
+	return 0;
+}
+
+DECLARE_TEST(radixsort, sort_signed_zero) {
+	// Negative zero sorts before positive zero for all input sizes, both in the insertion sort used
+	// for small inputs and in the byte and wide digit radix passes
+	const size_t counts[] = {2, 7, 32, 1000, 0x20000};
+	const float32_t values32[] = {0.0f, 1.0f, -0.0f, -1.0f};
+	const float64_t values64[] = {0.0, 1.0, -0.0, -1.0};
+	size_t icount, ival;
+
+	for (icount = 0; icount < sizeof(counts) / sizeof(counts[0]); ++icount) {
+		const size_t num = counts[icount];
+		radixsort_t* sort32 = radixsort_allocate(RADIXSORT_FLOAT32, num);
+		radixsort_t* sort64 = radixsort_allocate(RADIXSORT_FLOAT64, num);
+		float32_t* arr32 = memory_allocate(0, sizeof(float32_t) * num, 0, MEMORY_PERSISTENT);
+		float64_t* arr64 = memory_allocate(0, sizeof(float64_t) * num, 0, MEMORY_PERSISTENT);
+
+		for (ival = 0; ival < num; ++ival) {
+			arr32[ival] = values32[ival % 4];
+			arr64[ival] = values64[ival % 4];
+		}
+
+		const void* sindex32 = radixsort_sort(sort32, arr32, num);
+		const void* sindex64 = radixsort_sort(sort64, arr64, num);
+
+		for (ival = 1; ival < num; ++ival) {
+			size_t prev32, cur32, prev64, cur64;
+			if (sort32->indextype == RADIXSORT_INDEX16) {
+				prev32 = ((const uint16_t*)sindex32)[ival - 1];
+				cur32 = ((const uint16_t*)sindex32)[ival];
+				prev64 = ((const uint16_t*)sindex64)[ival - 1];
+				cur64 = ((const uint16_t*)sindex64)[ival];
+			} else {
+				prev32 = ((const uint32_t*)sindex32)[ival - 1];
+				cur32 = ((const uint32_t*)sindex32)[ival];
+				prev64 = ((const uint32_t*)sindex64)[ival - 1];
+				cur64 = ((const uint32_t*)sindex64)[ival];
+			}
+			// Positive zero is at input index 0 modulo 4 and negative zero at input index 2 modulo 4
+			EXPECT_LE(arr32[prev32], arr32[cur32]);
+			EXPECT_LE(arr64[prev64], arr64[cur64]);
+			EXPECT_FALSE(((prev32 % 4) == 0) && ((cur32 % 4) == 2));
+			EXPECT_FALSE(((prev64 % 4) == 0) && ((cur64 % 4) == 2));
+		}
+
+		memory_deallocate(arr32);
+		memory_deallocate(arr64);
+		radixsort_deallocate(sort32);
+		radixsort_deallocate(sort64);
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(radixsort, sort_partial) {
+	const size_t num = 0x1FFFF;
+	const size_t kval[] = {0, 1, 7, 31, 100, 4097, 0x1FFFF};
+	radixsort_t* sort_int32 = radixsort_allocate(RADIXSORT_INT32, num);
+	radixsort_t* sort_float64 = radixsort_allocate(RADIXSORT_FLOAT64, num);
+	radixsort_t* full_int32 = radixsort_allocate(RADIXSORT_INT32, num);
+	radixsort_t* full_float64 = radixsort_allocate(RADIXSORT_FLOAT64, num);
+	int32_t* arr_int32 = memory_allocate(0, sizeof(int32_t) * num, 0, MEMORY_PERSISTENT);
+	float64_t* arr_float64 = memory_allocate(0, sizeof(float64_t) * num, 0, MEMORY_PERSISTENT);
+	size_t ival, iloop, ik;
+
+	for (iloop = 0; iloop < 4; ++iloop) {
+		// Odd loops have many equal keys, last loops use 16-bit indices
+		size_t count = (iloop < 2) ? num : 999;
+		for (ival = 0; ival < count; ++ival) {
+			if (iloop % 2) {
+				arr_int32[ival] = (int32_t)(random32() & 0xF) - 0x8;
+				arr_float64[ival] = (float64_t)((int)(random32() & 0xF) - 0x8);
+			} else {
+				arr_int32[ival] = (int32_t)random32();
+				arr_float64[ival] = random_range(-(real)(1 << 30), (real)(1 << 30));
+			}
+		}
+
+		const uint32_t* full_index_int32 = radixsort_sort(full_int32, arr_int32, count);
+		const uint32_t* full_index_float64 = radixsort_sort(full_float64, arr_float64, count);
+		const uint16_t* full_index16_int32 = (const uint16_t*)full_index_int32;
+		const uint16_t* full_index16_float64 = (const uint16_t*)full_index_float64;
+		bool index16 = (sort_int32->indextype == RADIXSORT_INDEX16);
+
+		for (ik = 0; ik < sizeof(kval) / sizeof(kval[0]); ++ik) {
+			size_t k = (kval[ik] > count) ? count : kval[ik];
+			const void* smallest_int32 = radixsort_sort_smallest(sort_int32, arr_int32, count, k);
+			const void* smallest_float64 = radixsort_sort_smallest(sort_float64, arr_float64, count, k);
+			for (ival = 0; ival < k; ++ival) {
+				size_t ifull = index16 ? full_index16_int32[ival] : full_index_int32[ival];
+				size_t isel = index16 ? ((const uint16_t*)smallest_int32)[ival] : ((const uint32_t*)smallest_int32)[ival];
+				EXPECT_INTEQ(arr_int32[isel], arr_int32[ifull]);
+				ifull = index16 ? full_index16_float64[ival] : full_index_float64[ival];
+				isel = index16 ? ((const uint16_t*)smallest_float64)[ival] : ((const uint32_t*)smallest_float64)[ival];
+				EXPECT_REALEQ((real)arr_float64[isel], (real)arr_float64[ifull]);
+			}
+
+			const void* largest_int32 = radixsort_sort_largest(sort_int32, arr_int32, count, k);
+			const void* largest_float64 = radixsort_sort_largest(sort_float64, arr_float64, count, k);
+			for (ival = 0; ival < k; ++ival) {
+				size_t ifull = index16 ? full_index16_int32[count - ival - 1] : full_index_int32[count - ival - 1];
+				size_t isel = index16 ? ((const uint16_t*)largest_int32)[ival] : ((const uint32_t*)largest_int32)[ival];
+				EXPECT_INTEQ(arr_int32[isel], arr_int32[ifull]);
+				ifull = index16 ? full_index16_float64[count - ival - 1] : full_index_float64[count - ival - 1];
+				isel = index16 ? ((const uint16_t*)largest_float64)[ival] : ((const uint32_t*)largest_float64)[ival];
+				EXPECT_REALEQ((real)arr_float64[isel], (real)arr_float64[ifull]);
+			}
+		}
+
+		// Full sort after partial sort must not rely on previous order
+		const void* index = radixsort_sort(sort_int32, arr_int32, count);
+		for (ival = 1; ival < count; ++ival) {
+			size_t iprev = index16 ? ((const uint16_t*)index)[ival - 1] : ((const uint32_t*)index)[ival - 1];
+			size_t icur = index16 ? ((const uint16_t*)index)[ival] : ((const uint32_t*)index)[ival];
+			EXPECT_LE(arr_int32[iprev], arr_int32[icur]);
+		}
+
+		if (iloop == 1) {
+			radixsort_deallocate(sort_int32);
+			radixsort_deallocate(sort_float64);
+			radixsort_deallocate(full_int32);
+			radixsort_deallocate(full_float64);
+			sort_int32 = radixsort_allocate(RADIXSORT_INT32, 999);
+			sort_float64 = radixsort_allocate(RADIXSORT_FLOAT64, 999);
+			full_int32 = radixsort_allocate(RADIXSORT_INT32, 999);
+			full_float64 = radixsort_allocate(RADIXSORT_FLOAT64, 999);
+		}
+	}
+
+	radixsort_deallocate(sort_int32);
+	radixsort_deallocate(sort_float64);
+	radixsort_deallocate(full_int32);
+	radixsort_deallocate(full_float64);
+	memory_deallocate(arr_int32);
+	memory_deallocate(arr_float64);
+
+	return 0;
+}
+
+static int
+test_radixsort_string_compare(string_const_t lhs, string_const_t rhs) {
+	size_t common = (lhs.length < rhs.length) ? lhs.length : rhs.length;
+	int diff = memcmp(lhs.str, rhs.str, common);
+	if (diff)
+		return diff;
+	return (lhs.length < rhs.length) ? -1 : ((lhs.length > rhs.length) ? 1 : 0);
+}
+
+DECLARE_TEST(radixsort, sort_string) {
+	const size_t counts[] = {1, 2, 17, 31, 1000, 0x1FFFF};
+	const char prefix[] = "/usr/share/foundation/";
+	const char alphabet[] = {'a', 'b', 'c', '/', '.', '\0', (char)0xE4};
+	const size_t max_length = 40;
+	size_t icount, ival;
+
+	for (icount = 0; icount < sizeof(counts) / sizeof(counts[0]); ++icount) {
+		size_t num = counts[icount];
+		radixsort_t* sort = radixsort_allocate(RADIXSORT_STRING, num);
+		string_const_t* arr = memory_allocate(0, sizeof(string_const_t) * num, 0, MEMORY_PERSISTENT);
+		char* buffer = memory_allocate(0, max_length * num, 0, MEMORY_PERSISTENT);
+		uint32_t* index_count = memory_allocate(0, sizeof(uint32_t) * num, 0, MEMORY_PERSISTENT);
+
+		if (num > 0xFFFF)
+			EXPECT_EQ(sort->indextype, RADIXSORT_INDEX32);
+		else
+			EXPECT_EQ(sort->indextype, RADIXSORT_INDEX16);
+
+		for (ival = 0; ival < num; ++ival) {
+			char* str = buffer + (ival * max_length);
+			size_t length = random32_range(0, (uint32_t)max_length);
+			size_t ichar = 0;
+			// Long shared prefixes, short strings and embedded zero bytes
+			if (random32_range(0, 4) && (length > sizeof(prefix))) {
+				memcpy(str, prefix, sizeof(prefix) - 1);
+				ichar = sizeof(prefix) - 1;
+			}
+			for (; ichar < length; ++ichar)
+				str[ichar] = alphabet[random32_range(0, sizeof(alphabet))];
+			arr[ival] = string_const(str, length);
+		}
+
+		{
+			// Sort object initialized with caller provided memory must give the same order
+			const size_t indexsize = (num > 0xFFFF) ? sizeof(uint32_t) : sizeof(uint16_t);
+			const size_t scratch_size = radixsort_string_scratch_size(num);
+			uint64_t* memory = memory_allocate(0, (2 * scratch_size) + (2 * indexsize * num), 16, MEMORY_PERSISTENT);
+			radixsort_t sort_init;
+			memset(&sort_init, 0, sizeof(sort_init));
+			sort_init.scratch[0] = memory;
+			sort_init.scratch[1] = pointer_offset(memory, scratch_size);
+			sort_init.indices[0] = pointer_offset(memory, 2 * scratch_size);
+			sort_init.indices[1] = pointer_offset(sort_init.indices[0], indexsize * num);
+			radixsort_initialize(&sort_init, RADIXSORT_STRING, num);
+			EXPECT_EQ(sort_init.indextype, sort->indextype);
+			EXPECT_EQ(memcmp(radixsort_sort(&sort_init, arr, num), radixsort_sort(sort, arr, num), indexsize * num), 0);
+			radixsort_finalize(&sort_init);
+			memory_deallocate(memory);
+		}
+
+		for (int iloop = 0; iloop < 2; ++iloop) {
+			const void* sindex = radixsort_sort(sort, arr, num);
+			memset(index_count, 0, sizeof(uint32_t) * num);
+			for (ival = 0; ival < num; ++ival) {
+				size_t idx = (sort->indextype == RADIXSORT_INDEX16) ? ((const uint16_t*)sindex)[ival] :
+				                                                        ((const uint32_t*)sindex)[ival];
+				EXPECT_LT(idx, num);
+				++index_count[idx];
+				if (ival) {
+					size_t prev = (sort->indextype == RADIXSORT_INDEX16) ? ((const uint16_t*)sindex)[ival - 1] :
+					                                                         ((const uint32_t*)sindex)[ival - 1];
+					EXPECT_LE(test_radixsort_string_compare(arr[prev], arr[idx]), 0);
+				}
+			}
+			for (ival = 0; ival < num; ++ival)
+				EXPECT_EQ(index_count[ival], 1);
+		}
+
+		memory_deallocate(index_count);
+		memory_deallocate(buffer);
+		memory_deallocate(arr);
+		radixsort_deallocate(sort);
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(radixsort, sort_string_shared_prefix) {
+	// Strings sharing a long prefix, with one string ending at each position so every byte of the
+	// prefix is distributed by a radix pass. Sorting must not recurse once per shared byte
+	const size_t length = 0x2000;
+	const size_t num = length * 2;
+	radixsort_t* sort = radixsort_allocate(RADIXSORT_STRING, num);
+	string_const_t* arr = memory_allocate(0, sizeof(string_const_t) * num, 0, MEMORY_PERSISTENT);
+	char* buffer = memory_allocate(0, length, 0, MEMORY_PERSISTENT);
+	size_t ival;
+
+	memset(buffer, 'a', length);
+	for (ival = 0; ival < num; ++ival)
+		arr[ival] = string_const(buffer, (ival & 1) ? length : (length - (ival / 2) - 1));
+
+	const uint16_t* sindex = radixsort_sort(sort, arr, num);
+	EXPECT_EQ(sort->indextype, RADIXSORT_INDEX16);
+	for (ival = 0; ival < num; ++ival) {
+		EXPECT_LT(sindex[ival], num);
+		if (ival)
+			EXPECT_LE(arr[sindex[ival - 1]].length, arr[sindex[ival]].length);
+	}
+	for (ival = 0; ival < length; ++ival)
+		EXPECT_EQ(arr[sindex[ival]].length, ival);
+
+	memory_deallocate(buffer);
+	memory_deallocate(arr);
+	radixsort_deallocate(sort);
+
+	return 0;
+}
+
 static void
 test_radixsort_declare(void) {
 	ADD_TEST(radixsort, allocation);
@@ -1088,6 +1596,14 @@ test_radixsort_declare(void) {
 	ADD_TEST(radixsort, sort_int64_index32);
 	ADD_TEST(radixsort, sort_real_index16);
 	ADD_TEST(radixsort, sort_real_index32);
+	ADD_TEST(radixsort, sort_keyvalue);
+	ADD_TEST(radixsort, sort_keyvalue_custom);
+	ADD_TEST(radixsort, sort_keyvalue_initialize);
+	ADD_TEST(radixsort, sort_wide);
+	ADD_TEST(radixsort, sort_signed_zero);
+	ADD_TEST(radixsort, sort_partial);
+	ADD_TEST(radixsort, sort_string);
+	ADD_TEST(radixsort, sort_string_shared_prefix);
 }
 
 static test_suite_t test_radixsort_suite = {test_radixsort_application,
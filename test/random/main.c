@@ -41,6 +41,10 @@ static foundation_config_t
 test_random_config(void) {
 	foundation_config_t config;
 	memset(&config, 0, sizeof(config));
+#ifdef TEST_RANDOM_ENGINE
+	// Run the global random functions on an explicit state engine
+	config.random_engine = TEST_RANDOM_ENGINE;
+#endif
 	return config;
 }
 
@@ -53,6 +57,18 @@ static void
 test_random_finalize(void) {
 }
 
+static real
+test_random_spread(const unsigned int* count, unsigned int buckets) {
+	unsigned int max_num = 0, min_num = 0xFFFFFFFF;
+	for (unsigned int j = 0; j < buckets; ++j) {
+		if (count[j] < min_num)
+			min_num = count[j];
+		if (count[j] > max_num)
+			max_num = count[j];
+	}
+	return (real)(max_num - min_num) / ((real)min_num + ((real)(max_num - min_num) / REAL_C(2.0)));
+}
+
 DECLARE_TEST(random, distribution32) {
 	unsigned int pass_count = 512000 * 16;
 	unsigned int max_num = 0, min_num = 0xFFFFFFFF;
@@ -438,6 +454,371 @@ DECLARE_TEST(random, util) {
 	return 0;
 }
 
+DECLARE_TEST(random, fill) {
+	unsigned int pass_count = 512000 * 16;
+	unsigned int max_num = 0, min_num = 0xFFFFFFFF;
+	unsigned int batch_count = 1000;
+	uint32_t* buffer32 = memory_allocate(0, sizeof(uint32_t) * batch_count, 0, MEMORY_PERSISTENT);
+	uint64_t* buffer64 = memory_allocate(0, sizeof(uint64_t) * batch_count, 0, MEMORY_PERSISTENT);
+	real* buffer = memory_allocate(0, sizeof(real) * batch_count, 0, MEMORY_PERSISTENT);
+	unsigned int num;
+	unsigned int i, j, ibatch;
+	size_t count;
+	real diff;
+
+	memset(test_bits, 0, sizeof(unsigned int) * 32);
+	memset(test_hist, 0, sizeof(unsigned int) * 32);
+	for (i = 0; i < pass_count; i += batch_count) {
+		random_fill32(buffer32, batch_count);
+		for (ibatch = 0; ibatch < batch_count; ++ibatch) {
+			num = buffer32[ibatch];
+			for (j = 0; j < 32; ++j) {
+				if (num & (1 << j))
+					++test_bits[j];
+				if ((num >= (test_slice32 * j)) && ((j == 31) || (num < (test_slice32 * (j + 1)))))
+					++test_hist[j];
+			}
+		}
+	}
+
+	for (j = 0; j < 32; ++j) {
+		if (test_bits[j] < min_num)
+			min_num = test_bits[j];
+		if (test_bits[j] > max_num)
+			max_num = test_bits[j];
+	}
+	diff = (real)(max_num - min_num) / ((real)min_num + ((real)(max_num - min_num) / REAL_C(2.0)));
+
+	for (j = 0; j < 32; ++j)
+		EXPECT_GT(test_bits[j], 0U);
+	EXPECT_LT(diff, 0.004);
+
+	max_num = 0;
+	min_num = 0xFFFFFFFF;
+	for (j = 0; j < 32; ++j) {
+		if (test_hist[j] < min_num)
+			min_num = test_hist[j];
+		if (test_hist[j] > max_num)
+			max_num = test_hist[j];
+	}
+	diff = (real)(max_num - min_num) / ((real)min_num + ((real)(max_num - min_num) / REAL_C(2.0)));
+
+	for (j = 0; j < 32; ++j)
+		EXPECT_GT(test_hist[j], 0U);
+	EXPECT_LT(diff, 0.02);
+
+	// Verify high bits of 64-bit values are populated
+	memset(test_bits, 0, sizeof(unsigned int) * 64);
+	for (i = 0; i < pass_count / 16; i += batch_count) {
+		random_fill64(buffer64, batch_count);
+		for (ibatch = 0; ibatch < batch_count; ++ibatch) {
+			for (j = 0; j < 64; ++j) {
+				if (buffer64[ibatch] & (1ULL << j))
+					++test_bits[j];
+			}
+		}
+	}
+	for (j = 0; j < 64; ++j)
+		EXPECT_GT(test_bits[j], 0U);
+
+	// Odd and degenerate sizes must only touch the requested elements
+	for (count = 0; count < 70; ++count) {
+		for (ibatch = 0; ibatch < 80; ++ibatch) {
+			buffer32[ibatch] = 0xDEADBEEF;
+			buffer64[ibatch] = 0xDEADBEEFDEADBEEFULL;
+			buffer[ibatch] = REAL_C(-1.0);
+		}
+		random_fill32(buffer32, count);
+		random_fill64(buffer64, count);
+		random_fill_normalized(buffer, count);
+		for (ibatch = (unsigned int)count; ibatch < 80; ++ibatch) {
+			EXPECT_UINTEQ(buffer32[ibatch], 0xDEADBEEF);
+			EXPECT_TRUE(buffer64[ibatch] == 0xDEADBEEFDEADBEEFULL);
+			EXPECT_REALEQ(buffer[ibatch], REAL_C(-1.0));
+		}
+		for (ibatch = 0; ibatch < count; ++ibatch) {
+			EXPECT_GE(buffer[ibatch], REAL_C(0.0));
+			EXPECT_LT(buffer[ibatch], REAL_C(1.0));
+		}
+	}
+	random_fill32(nullptr, 0);
+
+	// Same seed gives the same sequence from fills as from single calls, with odd counts
+	// ending in partial batches and interleaved 32 and 64 bit values
+	for (count = 1; count < batch_count; count = (count * 3) + 1) {
+		random_thread_seed(0x1234567890ULL + count);
+		random_fill32(buffer32, count);
+		random_fill64(buffer64, count);
+		random_fill_normalized(buffer, count);
+		random_thread_seed(0x1234567890ULL + count);
+		for (ibatch = 0; ibatch < count; ++ibatch)
+			EXPECT_UINTEQ(buffer32[ibatch], random32());
+		for (ibatch = 0; ibatch < count; ++ibatch)
+			EXPECT_TYPEEQ(buffer64[ibatch], random64(), uint64_t, PRIx64);
+		for (ibatch = 0; ibatch < count; ++ibatch)
+			EXPECT_REALEQ(buffer[ibatch], random_normalized());
+	}
+	random_thread_seed(0x1234567890ULL);
+	num = random32();
+	random_thread_seed(0x1234567891ULL);
+	EXPECT_UINTNE(num, random32());
+	if (foundation_config().random_engine != RANDOM_ENGINE_WELL) {
+		// Global functions on an explicit state engine follow the state functions
+		random_state_t state;
+		random_thread_seed(0x1234567890ULL);
+		random_state_initialize(&state, foundation_config().random_engine, 0x1234567890ULL);
+		for (ibatch = 0; ibatch < batch_count; ++ibatch)
+			EXPECT_UINTEQ(random32(), random_state32(&state));
+		random_fill64(buffer64, batch_count);
+		for (ibatch = 0; ibatch < batch_count; ++ibatch)
+			EXPECT_TYPEEQ(buffer64[ibatch], random_state64(&state), uint64_t, PRIx64);
+	}
+
+	// Verify range and distribution of real values
+	memset(test_bits, 0, sizeof(unsigned int) * 32);
+	for (i = 0; i < pass_count; i += batch_count) {
+		random_fill_range(buffer, batch_count, REAL_C(32.0), REAL_C(-32.0));
+		for (ibatch = 0; ibatch < batch_count; ++ibatch) {
+			EXPECT_GE(buffer[ibatch], REAL_C(-32.0));
+			EXPECT_LT(buffer[ibatch], REAL_C(32.0));
+			++test_bits[(unsigned int)((buffer[ibatch] + REAL_C(32.0)) / REAL_C(2.0)) % 32];
+		}
+	}
+
+	max_num = 0;
+	min_num = 0xFFFFFFFF;
+	for (j = 0; j < 32; ++j) {
+		if (test_bits[j] < min_num)
+			min_num = test_bits[j];
+		if (test_bits[j] > max_num)
+			max_num = test_bits[j];
+	}
+	diff = (real)(max_num - min_num) / ((real)min_num + ((real)(max_num - min_num) / REAL_C(2.0)));
+
+	for (j = 0; j < 32; ++j)
+		EXPECT_GT(test_bits[j], 0U);
+	EXPECT_LT(diff, 0.02);
+
+	memory_deallocate(buffer32);
+	memory_deallocate(buffer64);
+	memory_deallocate(buffer);
+
+	return 0;
+}
+
+DECLARE_TEST(random, engine) {
+	random_state_t state, other;
+	int iengine;
+	uint64_t values[256];
+	uint32_t values32[256];
+	unsigned int bits[64];
+	unsigned int i, j;
+	real val;
+
+	// Known answers for seed 12345
+	random_state_initialize(&state, RANDOM_ENGINE_XOSHIRO256, 12345);
+	EXPECT_TYPEEQ(random_state64(&state), 0xbe6a36374160d49bULL, uint64_t, PRIx64);
+	EXPECT_TYPEEQ(random_state64(&state), 0x214aaa0637a688c6ULL, uint64_t, PRIx64);
+	EXPECT_TYPEEQ(random_state64(&state), 0xf69d16de9954d388ULL, uint64_t, PRIx64);
+	random_state_jump(&state);
+	EXPECT_TYPEEQ(random_state64(&state), 0xe668c1b68171d10dULL, uint64_t, PRIx64);
+	random_state_long_jump(&state);
+	EXPECT_TYPEEQ(random_state64(&state), 0x40deef3ae3bf51cfULL, uint64_t, PRIx64);
+
+	random_state_initialize(&state, RANDOM_ENGINE_PCG64, 12345);
+	EXPECT_TYPEEQ(random_state64(&state), 0x9907831d6f2e626aULL, uint64_t, PRIx64);
+	EXPECT_TYPEEQ(random_state64(&state), 0x7087d6feae1b5cd9ULL, uint64_t, PRIx64);
+	EXPECT_TYPEEQ(random_state64(&state), 0x545a25a5303b2a13ULL, uint64_t, PRIx64);
+	random_state_jump(&state);
+	EXPECT_TYPEEQ(random_state64(&state), 0xdc0744544a28645cULL, uint64_t, PRIx64);
+	random_state_long_jump(&state);
+	EXPECT_TYPEEQ(random_state64(&state), 0x1de2eab6382ac8f5ULL, uint64_t, PRIx64);
+
+	random_state_initialize(&state, RANDOM_ENGINE_WELL, 12345);
+	EXPECT_INTEQ(state.engine, RANDOM_ENGINE_XOSHIRO256);
+
+	for (iengine = RANDOM_ENGINE_XOSHIRO256; iengine <= RANDOM_ENGINE_PCG64; ++iengine) {
+		random_engine_t engine = (random_engine_t)iengine;
+		// Same seed gives same sequence, fill gives same sequence as single calls
+		random_state_initialize(&state, engine, 0x1234567890ULL);
+		random_state_initialize(&other, engine, 0x1234567890ULL);
+		random_state_fill64(&state, values, 256);
+		for (i = 0; i < 256; ++i)
+			EXPECT_TYPEEQ(values[i], random_state64(&other), uint64_t, PRIx64);
+		random_state_fill32(&state, values32, 256);
+		for (i = 0; i < 256; ++i)
+			EXPECT_UINTEQ(values32[i], random_state32(&other));
+
+		// Different seeds and jumped states give different sequences
+		random_state_initialize(&other, engine, 0x1234567891ULL);
+		EXPECT_TYPENE(random_state64(&state), random_state64(&other), uint64_t, PRIx64);
+		other = state;
+		random_state_jump(&other);
+		EXPECT_TYPENE(random_state64(&state), random_state64(&other), uint64_t, PRIx64);
+		other = state;
+		random_state_long_jump(&other);
+		EXPECT_TYPENE(random_state64(&state), random_state64(&other), uint64_t, PRIx64);
+
+		// Bit distribution
+		memset(bits, 0, sizeof(bits));
+		for (i = 0; i < 512000; ++i) {
+			uint64_t num = random_state64(&state);
+			for (j = 0; j < 64; ++j) {
+				if (num & (1ULL << j))
+					++bits[j];
+			}
+		}
+		for (j = 0; j < 64; ++j) {
+			EXPECT_GT(bits[j], 254000U);
+			EXPECT_LT(bits[j], 258000U);
+		}
+
+		// Value and range distribution with the same tolerance as for the global functions
+		memset(test_hist, 0, sizeof(unsigned int) * 32);
+		memset(test_bits, 0, sizeof(unsigned int) * 32);
+		for (i = 0; i < 512000 * 16; ++i) {
+			++test_hist[random_state32(&state) / test_slice32];
+			++test_bits[random_state32_range(&state, 0, 32)];
+		}
+		for (j = 0; j < 32; ++j) {
+			EXPECT_GT(test_hist[j], 0U);
+			EXPECT_GT(test_bits[j], 0U);
+		}
+		EXPECT_LT(test_random_spread(test_hist, 32), 0.02);
+		EXPECT_LT(test_random_spread(test_bits, 32), 0.02);
+
+		for (i = 0; i < 512000; ++i) {
+			val = random_state_normalized(&state);
+			EXPECT_GE(val, REAL_C(0.0));
+			EXPECT_LT(val, REAL_C(1.0));
+
+			val = random_state_range(&state, REAL_C(100.0), REAL_C(-100.0));
+			EXPECT_GE(val, REAL_C(-100.0));
+			EXPECT_LT(val, REAL_C(100.0));
+
+			j = random_state32_range(&state, 100, 10);
+			EXPECT_GE(j, 10U);
+			EXPECT_LT(j, 100U);
+
+			EXPECT_TYPEEQ(random_state64_range(&state, i, i + 1), (uint64_t)i, uint64_t, PRIu64);
+		}
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(random, normal) {
+	unsigned int pass_count = 512000;
+	unsigned int batch_count = 1000;
+	real* buffer = memory_allocate(0, sizeof(real) * batch_count, 0, MEMORY_PERSISTENT);
+	real* other = memory_allocate(0, sizeof(real) * batch_count, 0, MEMORY_PERSISTENT);
+	random_state_t state, state_copy;
+	unsigned int i, ibatch, ipass;
+	double sum, sum_squared, mean, variance;
+	unsigned int within_stddev;
+	real val;
+
+	// Single calls, mean 10 and standard deviation 2
+	sum = sum_squared = 0;
+	within_stddev = 0;
+	for (i = 0; i < pass_count; ++i) {
+		val = random_normal(REAL_C(10.0), REAL_C(2.0));
+		EXPECT_TRUE(math_real_is_finite(val));
+		sum += (double)val;
+		sum_squared += (double)val * (double)val;
+		if ((val >= REAL_C(8.0)) && (val < REAL_C(12.0)))
+			++within_stddev;
+	}
+	mean = sum / (double)pass_count;
+	variance = (sum_squared / (double)pass_count) - (mean * mean);
+	EXPECT_GT(mean, 9.98);
+	EXPECT_LT(mean, 10.02);
+	EXPECT_GT(variance, 3.95);
+	EXPECT_LT(variance, 4.05);
+	// 68.27% within one standard deviation
+	EXPECT_GT(within_stddev, (unsigned int)(0.676 * pass_count));
+	EXPECT_LT(within_stddev, (unsigned int)(0.690 * pass_count));
+
+	// Batch fill, standard normal
+	sum = sum_squared = 0;
+	within_stddev = 0;
+	for (ipass = 0; ipass < pass_count; ipass += batch_count) {
+		random_fill_normal(buffer, batch_count, REAL_C(0.0), REAL_C(1.0));
+		for (ibatch = 0; ibatch < batch_count; ++ibatch) {
+			sum += (double)buffer[ibatch];
+			sum_squared += (double)buffer[ibatch] * (double)buffer[ibatch];
+			if ((buffer[ibatch] >= REAL_C(-1.0)) && (buffer[ibatch] < REAL_C(1.0)))
+				++within_stddev;
+		}
+	}
+	mean = sum / (double)pass_count;
+	variance = (sum_squared / (double)pass_count) - (mean * mean);
+	EXPECT_GT(mean, -0.01);
+	EXPECT_LT(mean, 0.01);
+	EXPECT_GT(variance, 0.985);
+	EXPECT_LT(variance, 1.015);
+	EXPECT_GT(within_stddev, (unsigned int)(0.676 * pass_count));
+	EXPECT_LT(within_stddev, (unsigned int)(0.690 * pass_count));
+
+	// Exponential with rate 4, mean 1/4 and variance 1/16
+	sum = sum_squared = 0;
+	for (i = 0; i < pass_count; ++i) {
+		val = random_exponential(REAL_C(4.0));
+		EXPECT_GE(val, REAL_C(0.0));
+		sum += (double)val;
+		sum_squared += (double)val * (double)val;
+	}
+	mean = sum / (double)pass_count;
+	variance = (sum_squared / (double)pass_count) - (mean * mean);
+	EXPECT_GT(mean, 0.248);
+	EXPECT_LT(mean, 0.252);
+	EXPECT_GT(variance, 0.0605);
+	EXPECT_LT(variance, 0.0645);
+
+	sum = sum_squared = 0;
+	for (ipass = 0; ipass < pass_count; ipass += batch_count) {
+		random_fill_exponential(buffer, batch_count, REAL_C(1.0));
+		for (ibatch = 0; ibatch < batch_count; ++ibatch) {
+			EXPECT_GE(buffer[ibatch], REAL_C(0.0));
+			sum += (double)buffer[ibatch];
+			sum_squared += (double)buffer[ibatch] * (double)buffer[ibatch];
+		}
+	}
+	mean = sum / (double)pass_count;
+	variance = (sum_squared / (double)pass_count) - (mean * mean);
+	EXPECT_GT(mean, 0.99);
+	EXPECT_LT(mean, 1.01);
+	EXPECT_GT(variance, 0.96);
+	EXPECT_LT(variance, 1.04);
+
+	// Explicit states are deterministic
+	random_state_initialize(&state, RANDOM_ENGINE_PCG64, 1234);
+	state_copy = state;
+	for (i = 0; i < batch_count; ++i)
+		buffer[i] = random_state_normal(&state, REAL_C(-1.0), REAL_C(0.5));
+	for (i = 0; i < batch_count; ++i)
+		EXPECT_REALEQ(random_state_normal(&state_copy, REAL_C(-1.0), REAL_C(0.5)), buffer[i]);
+
+	random_state_initialize(&state, RANDOM_ENGINE_XOSHIRO256, 1234);
+	state_copy = state;
+	random_state_fill_normal(&state, buffer, batch_count, REAL_C(0.0), REAL_C(1.0));
+	random_state_fill_normal(&state_copy, other, batch_count, REAL_C(0.0), REAL_C(1.0));
+	for (i = 0; i < batch_count; ++i)
+		EXPECT_REALEQ(buffer[i], other[i]);
+	random_state_fill_exponential(&state, buffer, batch_count, REAL_C(2.0));
+	random_state_fill_exponential(&state_copy, other, batch_count, REAL_C(2.0));
+	for (i = 0; i < batch_count; ++i) {
+		EXPECT_REALEQ(buffer[i], other[i]);
+		EXPECT_GE(buffer[i], REAL_C(0.0));
+		EXPECT_REALEQ(random_state_exponential(&state, REAL_C(2.0)), random_state_exponential(&state_copy, REAL_C(2.0)));
+	}
+
+	memory_deallocate(buffer);
+	memory_deallocate(other);
+
+	return 0;
+}
+
 static void
 test_random_declare(void) {
 	ADD_TEST(random, distribution32);
@@ -445,6 +826,9 @@ test_random_declare(void) {
 	ADD_TEST(random, distribution_real);
 	ADD_TEST(random, threads);
 	ADD_TEST(random, util);
+	ADD_TEST(random, fill);
+	ADD_TEST(random, engine);
+	ADD_TEST(random, normal);
 }
 
 static test_suite_t test_random_suite = {test_random_application,
@@ -347,6 +347,242 @@ DECLARE_TEST(regex, captures) {
 	return 0;
 }
 
+// Expression parsed into a caller buffer, which is always matched by the backtracking engine
+static regex_t*
+test_regex_parse(const char* pattern, size_t length) {
+	regex_t* regex = memory_allocate(0, sizeof(regex_t) + (length * 2) + 16, 0,
+	                                 MEMORY_PERSISTENT | MEMORY_ZERO_INITIALIZED);
+	regex->code_allocated = (length * 2) + 16;
+	if (!regex_parse(regex, pattern, length)) {
+		memory_deallocate(regex);
+		return 0;
+	}
+	return regex;
+}
+
+static size_t
+test_regex_generate(char* pattern, unsigned int level) {
+	static const char* atoms[] = {"a", "b", "ab", ".", "[ab]", "[^a]", "\\s", "\\S", "\\d", "[\\sa]", "\\61", "\\0"};
+	static const char* quantifiers[] = {"", "", "", "*", "+", "?", "*?", "+?"};
+	size_t length = 0;
+	size_t count = random32_range(1, 5);
+	for (size_t ielement = 0; ielement < count; ++ielement) {
+		const unsigned int kind = random32_range(0, 16);
+		if ((kind == 0) && (level < 2)) {
+			pattern[length++] = '(';
+			length += test_regex_generate(pattern + length, level + 1);
+			while (random32_range(0, 2)) {
+				pattern[length++] = '|';
+				length += test_regex_generate(pattern + length, level + 1);
+			}
+			pattern[length++] = ')';
+		} else if (kind == 1) {
+			pattern[length++] = random32_range(0, 2) ? '^' : '$';
+		} else {
+			const char* atom = atoms[random32_range(0, sizeof(atoms) / sizeof(atoms[0]))];
+			const char* quantifier = quantifiers[random32_range(0, sizeof(quantifiers) / sizeof(quantifiers[0]))];
+			memcpy(pattern + length, atom, string_length(atom));
+			length += string_length(atom);
+			memcpy(pattern + length, quantifier, string_length(quantifier));
+			length += string_length(quantifier);
+		}
+	}
+	return length;
+}
+
+DECLARE_TEST(regex, dfa) {
+	string_const_t captures[16];
+	char pattern[512];
+	char input[128];
+	const char characters[] = "ab 1\0";
+	regex_t* regex;
+	regex_t* reference;
+	size_t length;
+
+	// Exponential for a backtracking engine
+	regex = regex_compile(STRING_CONST("a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaaaaaab"));
+	EXPECT_NE(regex, 0);
+	EXPECT_FALSE(regex_match(regex, STRING_CONST("aaaaaaaaaaaaaaaaaaaaaaaa"), 0, 0));
+	EXPECT_TRUE(regex_match(regex, STRING_CONST("aaaaaaaaaaaaaaaaaaaaaaaab"), 0, 0));
+	EXPECT_FALSE(regex_match(regex, STRING_CONST("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"), captures, 16));
+	regex_deallocate(regex);
+
+	// Captures are extracted by the backtracking engine after the DFA matched
+	regex = regex_compile(STRING_CONST("^\\s*([^\\s]+)\\s*=\\s*([^\\s]*)\\s*$"));
+	EXPECT_NE(regex, 0);
+	EXPECT_FALSE(regex_match(regex, STRING_CONST("  key value "), captures, 16));
+	EXPECT_TRUE(regex_match(regex, STRING_CONST("  key = value "), 0, 0));
+	memset(captures, 0, sizeof(captures));
+	EXPECT_TRUE(regex_match(regex, STRING_CONST("  key = value "), captures, 16));
+	EXPECT_CONSTSTRINGEQ(captures[0], string_const(STRING_CONST("key")));
+	EXPECT_CONSTSTRINGEQ(captures[1], string_const(STRING_CONST("value")));
+	regex_deallocate(regex);
+
+	// Exhaust the state cache, the number of states is exponential in the number of trailing sets
+	regex = regex_compile(STRING_CONST("[ab]*a[ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab]c"));
+	reference = test_regex_parse(STRING_CONST("[ab]*a[ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab]c"));
+	EXPECT_NE(regex, 0);
+	EXPECT_NE(reference, 0);
+	for (size_t ipass = 0; ipass < 256; ++ipass) {
+		length = random32_range(0, sizeof(input));
+		for (size_t ichar = 0; ichar < length; ++ichar)
+			input[ichar] = (char)("abc"[random32_range(0, (ichar + 1 < length) ? 2 : 3)]);
+		EXPECT_EQ_MSGFORMAT(regex_match(regex, input, length, 0, 0), regex_match(reference, input, length, 0, 0),
+		                    "Mismatch for input \"%.*s\"", (int)length, input);
+	}
+	memory_deallocate(reference);
+	regex_deallocate(regex);
+
+	// Both engines must agree on random expressions and input
+	for (size_t ipass = 0; ipass < 1000; ++ipass) {
+		size_t pattern_length = 0;
+		if (random32_range(0, 3) == 0)
+			pattern[pattern_length++] = '^';
+		pattern_length += test_regex_generate(pattern + pattern_length, 0);
+		if (random32_range(0, 3) == 0)
+			pattern[pattern_length++] = '$';
+
+		regex = regex_compile(pattern, pattern_length);
+		if (!regex)
+			continue;
+		reference = test_regex_parse(pattern, pattern_length);
+		EXPECT_NE(reference, 0);
+
+		for (size_t iinput = 0; iinput < 32; ++iinput) {
+			bool matched, expected;
+			length = random32_range(0, 12);
+			for (size_t ichar = 0; ichar < length; ++ichar)
+				input[ichar] = characters[random32_range(0, sizeof(characters) - 1)];
+
+			expected = regex_match(reference, input, length, 0, 0);
+			matched = regex_match(regex, input, length, 0, 0);
+			EXPECT_EQ_MSGFORMAT(matched, expected, "Mismatch for pattern \"%.*s\" input \"%.*s\"",
+			                    (int)pattern_length, pattern, (int)length, input);
+			matched = regex_match(regex, input, length, captures, 16);
+			EXPECT_EQ_MSGFORMAT(matched, expected, "Mismatch for pattern \"%.*s\" input \"%.*s\" with captures",
+			                    (int)pattern_length, pattern, (int)length, input);
+		}
+
+		memory_deallocate(reference);
+		regex_deallocate(regex);
+	}
+
+	return 0;
+}
+
+typedef struct {
+	regex_t* regex;
+	const char* input;
+	const size_t* length;
+	const bool* expected;
+	size_t count;
+} test_regex_shared_t;
+
+static void*
+test_regex_shared_thread(void* arg) {
+	test_regex_shared_t* shared = arg;
+	size_t mismatch = 0;
+	for (size_t ipass = 0; ipass < 64; ++ipass) {
+		for (size_t iinput = 0; iinput < shared->count; ++iinput) {
+			if (regex_match(shared->regex, shared->input + (iinput * 64), shared->length[iinput], 0, 0) !=
+			    shared->expected[iinput])
+				++mismatch;
+		}
+	}
+	return (void*)(uintptr_t)mismatch;
+}
+
+DECLARE_TEST(regex, shared) {
+	char input[64 * 64];
+	size_t length[64];
+	bool expected[64];
+	thread_t thread[4];
+	test_regex_shared_t shared;
+	regex_t* reference;
+
+	// Threads matching the same expression concurrently share one state cache,
+	// threads finding it in use fall back to the backtracking engine
+	shared.regex = regex_compile(STRING_CONST("[ab]*a[ab][ab][ab][ab]c"));
+	reference = test_regex_parse(STRING_CONST("[ab]*a[ab][ab][ab][ab]c"));
+	EXPECT_NE(shared.regex, 0);
+	EXPECT_NE(reference, 0);
+	for (size_t iinput = 0; iinput < 64; ++iinput) {
+		length[iinput] = random32_range(0, 64);
+		for (size_t ichar = 0; ichar < length[iinput]; ++ichar)
+			input[(iinput * 64) + ichar] = (char)("abc"[random32_range(0, (ichar + 1 < length[iinput]) ? 2 : 3)]);
+		expected[iinput] = regex_match(reference, input + (iinput * 64), length[iinput], 0, 0);
+	}
+	shared.input = input;
+	shared.length = length;
+	shared.expected = expected;
+	shared.count = 64;
+
+	for (size_t ithread = 0; ithread < 4; ++ithread) {
+		thread_initialize(&thread[ithread], test_regex_shared_thread, &shared, STRING_CONST("regex_shared"),
+		                  THREAD_PRIORITY_NORMAL, 0);
+		thread_start(&thread[ithread]);
+	}
+	test_wait_for_threads_startup(thread, 4);
+	for (size_t ithread = 0; ithread < 4; ++ithread) {
+		EXPECT_EQ(thread_join(&thread[ithread]), 0);
+		thread_finalize(&thread[ithread]);
+	}
+
+	memory_deallocate(reference);
+	regex_deallocate(shared.regex);
+
+	return 0;
+}
+
+DECLARE_TEST(regex, throughput) {
+	const char* patterns[] = {"matchthis(\\s+|\\S+)!", "[0123456789]+x", "a.*z.*q\\d", "^[^\\d]*$"};
+#if BUILD_DEBUG
+	const size_t text_length = 16 * 1024;
+#else
+	const size_t text_length = 256 * 1024;
+#endif
+	// Backtracking is quadratic or worse in input length for some patterns, limit input size
+	const size_t reference_length = 2048;
+	char* text = memory_allocate(0, text_length, 0, MEMORY_PERSISTENT);
+	const char words[] = "the quick brown fox jumps over the lazy dog and keeps running through the field ";
+	tick_t start;
+	real elapsed;
+
+	for (size_t ichar = 0; ichar < text_length; ++ichar)
+		text[ichar] = words[(ichar * 7 + ichar / 61) % (sizeof(words) - 1)];
+
+	for (size_t ipattern = 0; ipattern < sizeof(patterns) / sizeof(patterns[0]); ++ipattern) {
+		const size_t pattern_length = string_length(patterns[ipattern]);
+		regex_t* regex = regex_compile(patterns[ipattern], pattern_length);
+		regex_t* reference = test_regex_parse(patterns[ipattern], pattern_length);
+		bool matched, expected;
+		EXPECT_NE(regex, 0);
+		EXPECT_NE(reference, 0);
+
+		start = time_current();
+		matched = regex_match(regex, text, text_length, 0, 0);
+		elapsed = time_elapsed(start);
+		log_infof(HASH_TEST, STRING_CONST("regex_match dfa \"%s\": %.2f MB/s"), patterns[ipattern],
+		          (double)((real)text_length / (math_max(elapsed, REAL_C(0.000001)) * REAL_C(1000000.0))));
+
+		start = time_current();
+		expected = regex_match(reference, text, reference_length, 0, 0);
+		elapsed = time_elapsed(start);
+		log_infof(HASH_TEST, STRING_CONST("regex_match backtracking \"%s\": %.2f MB/s"), patterns[ipattern],
+		          (double)((real)reference_length / (math_max(elapsed, REAL_C(0.000001)) * REAL_C(1000000.0))));
+
+		EXPECT_EQ(matched, regex_match(regex, text, text_length, 0, 0));
+		EXPECT_EQ(expected, regex_match(regex, text, reference_length, 0, 0));
+
+		memory_deallocate(reference);
+		regex_deallocate(regex);
+	}
+
+	memory_deallocate(text);
+
+	return 0;
+}
+
 FOUNDATION_ALIGNED_STRUCT(regexbuffer_t, 8) {
 	char buffer[sizeof(regex_t) + 8];
 };
@@ -476,6 +712,9 @@ test_regex_declare(void) {
 	ADD_TEST(regex, branch);
 	ADD_TEST(regex, noanchor);
 	ADD_TEST(regex, captures);
+	ADD_TEST(regex, dfa);
+	ADD_TEST(regex, shared);
+	ADD_TEST(regex, throughput);
 	ADD_TEST(regex, invalid);
 }
 
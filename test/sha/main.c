@@ -12,6 +12,7 @@
 
 #include <foundation/foundation.h>
 #include <test/test.h>
+#include <test/digest.h>
 
 static application_t
 test_sha_application(void) {
@@ -124,7 +125,8 @@ static const char* digest_test_string =
     "47hgL4"
     "QLd6uVg78HZXW68Yf6ZJp8EKN7eRsPcUZDNTOsJXp96CXORuhKOw1ZsCmXZVgmj9AUUAriR9YCVbmSPm";
 
-DECLARE_TEST(sha, reference) {
+static void*
+test_sha_reference(void) {
 	sha256_t* sha256;
 	sha512_t* sha512;
 	char shastr[129];
@@ -252,10 +254,97 @@ DECLARE_TEST(sha, reference) {
 	return 0;
 }
 
+static void*
+test_sha_large(void) {
+	const size_t size = (1024 * 1024) + 317;
+	const size_t chunk_size[] = {0, 1000, 63, 4096 + 5};
+	unsigned char* buffer = memory_allocate(0, size, 0, MEMORY_PERSISTENT);
+	sha256_t sha256;
+	sha512_t sha512;
+	char shastr[129];
+	string_t digest;
+	size_t i, ichunk, offset;
+
+	// Large buffers are digested in multi-block calls to the compression functions
+	for (i = 0; i < size; ++i)
+		buffer[i] = (unsigned char)((i * 7) + (i >> 8));
+
+	for (ichunk = 0; ichunk < sizeof(chunk_size) / sizeof(chunk_size[0]); ++ichunk) {
+		size_t chunk = chunk_size[ichunk] ? chunk_size[ichunk] : size;
+
+		sha256_initialize(&sha256);
+		sha512_initialize(&sha512);
+		for (offset = 0; offset < size; offset += chunk) {
+			size_t remain = math_min(chunk, size - offset);
+			sha256_digest(&sha256, buffer + offset, remain);
+			sha512_digest(&sha512, buffer + offset, remain);
+		}
+		sha256_digest_finalize(&sha256);
+		sha512_digest_finalize(&sha512);
+
+		digest = sha256_get_digest(&sha256, shastr, sizeof(shastr));
+		EXPECT_STRINGEQ(digest,
+		                string_const(STRING_CONST("5679275cb54d2f9b9a0524f7b8f4cd3fa1493ae11b898d17df83b19836af2591")));
+
+		digest = sha512_get_digest(&sha512, shastr, sizeof(shastr));
+		EXPECT_STRINGEQ(digest,
+		                string_const(STRING_CONST("433a9602a660e950d6c39b92ea810caa51c1708693b7a364189d7f1aa7b3acae"
+		                                          "b942a736923885ca1b513c932ee30ac51f4b9f4363211893eb890d067fb7dd43")));
+
+		sha256_finalize(&sha256);
+		sha512_finalize(&sha512);
+	}
+
+	memory_deallocate(buffer);
+
+	return 0;
+}
+
+DECLARE_TEST(sha, reference) {
+	return test_sha_reference();
+}
+
+DECLARE_TEST(sha, large) {
+	return test_sha_large();
+}
+
+DECLARE_TEST(sha, generic) {
+	// Run the vectors through the generic compression functions even if accelerated ones are supported
+	system_cpu_mask_features(0);
+	void* result = test_sha_reference();
+	if (!result)
+		result = test_sha_large();
+	system_cpu_mask_features(~0ULL);
+	return result;
+}
+
+static void
+test_sha256_multi(const void* const* buffers, const size_t* sizes, size_t count, void* digests) {
+	sha256_digest_multi(buffers, sizes, count, digests);
+}
+
+static void
+test_sha256_single(const void* buffer, size_t size, void* digest) {
+	sha256_t sha256;
+	sha256_initialize(&sha256);
+	sha256_digest(&sha256, buffer, size);
+	sha256_digest_finalize(&sha256);
+	uint256_t raw = sha256_get_digest_raw(&sha256);
+	sha256_finalize(&sha256);
+	memcpy(digest, &raw, sizeof(raw));
+}
+
+DECLARE_TEST(sha, multi) {
+	return test_digest_multi(test_sha256_multi, test_sha256_single, sizeof(uint256_t));
+}
+
 static void
 test_sha_declare(void) {
 	ADD_TEST(sha, empty);
 	ADD_TEST(sha, reference);
+	ADD_TEST(sha, large);
+	ADD_TEST(sha, generic);
+	ADD_TEST(sha, multi);
 }
 
 static test_suite_t test_sha_suite = {test_sha_application,
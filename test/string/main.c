@@ -14,6 +14,9 @@
 #include <test/test.h>
 
 #include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 static application_t
 test_string_application(void) {
@@ -2529,6 +2532,664 @@ DECLARE_TEST(string, locale) {
 }
 */
 
+static size_t
+test_scan_find_of(const char* str, size_t length, const char* tokens, size_t token_length, size_t offset,
+                  bool invert) {
+	for (; offset < length; ++offset) {
+		if ((memchr(tokens, str[offset], token_length) != nullptr) != invert)
+			return offset;
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+test_scan_rfind_of(const char* str, size_t length, const char* tokens, size_t token_length, size_t offset,
+                   bool invert) {
+	if (offset >= length)
+		offset = length - 1;
+	for (; offset != STRING_NPOS; --offset) {
+		if ((memchr(tokens, str[offset], token_length) != nullptr) != invert)
+			return offset;
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+test_scan_find_string(const char* str, size_t length, const char* key, size_t key_length, size_t offset) {
+	if (!key_length)
+		return offset;
+	if (key_length > length)
+		return STRING_NPOS;
+	for (; offset <= length - key_length; ++offset) {
+		if (memcmp(str + offset, key, key_length) == 0)
+			return offset;
+	}
+	return STRING_NPOS;
+}
+
+static size_t
+test_scan_rfind_string(const char* str, size_t length, const char* key, size_t key_length, size_t offset) {
+	if (key_length > length)
+		return STRING_NPOS;
+	if (!key_length)
+		return offset > length ? length : offset;
+	if (offset > length - key_length)
+		offset = length - key_length;
+	for (; offset != STRING_NPOS; --offset) {
+		if (memcmp(str + offset, key, key_length) == 0)
+			return offset;
+	}
+	return STRING_NPOS;
+}
+
+//! Fill with characters from a small alphabet including bytes above 127 to get frequent matches
+static void
+test_scan_fill(char* buffer, size_t length, unsigned int alphabet) {
+	static const unsigned char characters[] = {'a', 'b', 'c', '/', '\\', 0xC3, 0xA5, 0x80, 0xFF, 0, ' ', 'z'};
+	for (size_t ichar = 0; ichar < length; ++ichar)
+		buffer[ichar] = (char)characters[random32_range(0, alphabet)];
+}
+
+DECLARE_TEST(string, scan) {
+	char buffer[512];
+	char tokens[24];
+	char key[24];
+	size_t length, token_length, key_length, offset;
+	unsigned int ipass, ioffset;
+
+	for (ipass = 0; ipass < 20000; ++ipass) {
+		const unsigned int alphabet = random32_range(2, 13);
+		// Skew towards short strings around the vector widths
+		length = (ipass & 1) ? random32_range(0, 80) : random32_range(0, 500);
+		token_length = random32_range(0, 20);
+		test_scan_fill(buffer, length, alphabet);
+		test_scan_fill(tokens, token_length, alphabet);
+
+		for (ioffset = 0; ioffset < 4; ++ioffset) {
+			char c = tokens[0];
+			if (ioffset == 0)
+				offset = 0;
+			else if (ioffset == 1)
+				offset = length ? random32_range(0, (uint32_t)length) : 0;
+			else if (ioffset == 2)
+				offset = length + random32_range(0, 4);
+			else
+				offset = STRING_NPOS;
+
+			EXPECT_SIZEEQ(string_find_first_of(buffer, length, tokens, token_length, offset),
+			              token_length ? test_scan_find_of(buffer, length, tokens, token_length, offset, false) :
+			                             STRING_NPOS);
+			EXPECT_SIZEEQ(string_find_last_of(buffer, length, tokens, token_length, offset),
+			              token_length ? test_scan_rfind_of(buffer, length, tokens, token_length, offset, false) :
+			                             STRING_NPOS);
+			if (token_length) {
+				EXPECT_SIZEEQ(string_find_first_not_of(buffer, length, tokens, token_length, offset),
+				              test_scan_find_of(buffer, length, tokens, token_length, offset, true));
+				EXPECT_SIZEEQ(string_find_last_not_of(buffer, length, tokens, token_length, offset),
+				              test_scan_rfind_of(buffer, length, tokens, token_length, offset, true));
+				EXPECT_SIZEEQ(string_rfind(buffer, length, c, offset),
+				              test_scan_rfind_of(buffer, length, &c, 1, offset, false));
+			}
+
+			// Keys taken from the string to guarantee matches, or random
+			key_length = random32_range(0, 20);
+			if (key_length > length)
+				key_length = length;
+			if ((ipass & 2) && length)
+				memcpy(key, buffer + random32_range(0, (uint32_t)(length - key_length + 1)), key_length);
+			else
+				test_scan_fill(key, key_length, alphabet);
+			EXPECT_SIZEEQ(string_find_string(buffer, length, key, key_length, offset),
+			              test_scan_find_string(buffer, length, key, key_length, offset));
+			EXPECT_SIZEEQ(string_rfind_string(buffer, length, key, key_length, offset),
+			              test_scan_rfind_string(buffer, length, key, key_length, offset));
+		}
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(string, int_convert) {
+	char buffer[64];
+	char expect[64];
+	string_t str;
+	int len;
+	size_t iter;
+	const int64_t limits[] = {0, 1, -1, 9, 10, 99, 100, 4294967295LL, 4294967296LL, INT64_MAX, INT64_MIN};
+#if BUILD_DEBUG
+	const size_t iterations = 64 * 1024;
+#else
+	const size_t iterations = 1024 * 1024;
+#endif
+
+	for (iter = 0; iter < sizeof(limits) / sizeof(limits[0]); ++iter) {
+		str = string_from_int(buffer, sizeof(buffer), limits[iter], 0, 0);
+		len = snprintf(expect, sizeof(expect), "%" PRId64, limits[iter]);
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+		str = string_from_uint(buffer, sizeof(buffer), (uint64_t)limits[iter], true, 0, 0);
+		len = snprintf(expect, sizeof(expect), "%" PRIx64, (uint64_t)limits[iter]);
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+	}
+
+	// Compare against the C library for random values of all magnitudes and field widths
+	for (iter = 0; iter < iterations; ++iter) {
+		const uint64_t value = random64() >> random32_range(0, 64);
+		const unsigned int width = random32_range(0, 24);
+
+		str = string_from_uint(buffer, sizeof(buffer), value, false, width, '0');
+		len = snprintf(expect, sizeof(expect), "%0*" PRIu64, (int)width, value);
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+
+		str = string_from_uint(buffer, sizeof(buffer), value, true, width, ' ');
+		len = snprintf(expect, sizeof(expect), "%*" PRIx64, (int)width, value);
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+
+		str = string_from_int(buffer, sizeof(buffer), -(int64_t)(value >> 1), width, ' ');
+		len = snprintf(expect, sizeof(expect), "%*" PRId64, (int)width, -(int64_t)(value >> 1));
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+	}
+
+	return 0;
+}
+
+//! Widen a float32 exactly from its bits, a plain conversion flushes denormals to zero when built with fast math
+static double
+test_float32_widen(float32_cast_t value) {
+	const uint32_t mantissa = value.uival & 0x7FFFFF;
+	if (!(value.uival & 0x7F800000) && mantissa) {
+		const double magnitude = ldexp((double)mantissa, -149);
+		return (value.uival & 0x80000000) ? -magnitude : magnitude;
+	}
+	return (double)value.fval;
+}
+
+DECLARE_TEST(string, float_convert) {
+	char buffer[128];
+	char expect[128];
+	float64_cast_t value64, parsed64;
+	float32_cast_t value32, parsed32;
+	string_t str;
+	int len;
+	unsigned int precision;
+#if BUILD_DEBUG
+	const size_t iterations = 16 * 1024;
+#else
+	const size_t iterations = 256 * 1024;
+#endif
+
+	str = string_from_float64(buffer, sizeof(buffer), 0.1, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("0.1")));
+	str = string_from_float64(buffer, sizeof(buffer), 1e100, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("1e+100")));
+	str = string_from_float64(buffer, sizeof(buffer), 1e16, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("10000000000000000")));
+	str = string_from_float64(buffer, sizeof(buffer), 1e-5, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("1e-05")));
+	str = string_from_float64(buffer, sizeof(buffer), 5e-324, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("5e-324")));
+	str = string_from_float64(buffer, sizeof(buffer), 1.7976931348623157e308, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("1.7976931348623157e+308")));
+	str = string_from_float64(buffer, sizeof(buffer), 0.3, 3, 8, '-');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("-----0.3")));
+	str = string_from_float64(buffer, sizeof(buffer), 2.0 / 3.0, 25, 0, 0);
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("0.6666666666666666296592325")));
+	str = string_from_float32(buffer, sizeof(buffer), 0.1f, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("0.1")));
+	str = string_from_float32(buffer, sizeof(buffer), 16777216.0f, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("16777216")));
+	str = string_from_float32(buffer, sizeof(buffer), 1e-45f, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("1e-45")));
+
+	value64.uival = 0x7FF0000000000000ULL;
+	str = string_from_float64(buffer, sizeof(buffer), value64.fval, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("inf")));
+	value64.uival = 0xFFF0000000000000ULL;
+	str = string_from_float64(buffer, sizeof(buffer), value64.fval, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("-inf")));
+	value64.uival = 0x7FF8000000000000ULL;
+	str = string_from_float64(buffer, sizeof(buffer), value64.fval, 0, 0, '=');
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("nan")));
+
+	parsed64.fval = string_to_float64(STRING_CONST("0x1.8p1"));
+	EXPECT_DBLEQ(parsed64.fval, 3.0);
+	parsed64.fval = string_to_float64(STRING_CONST("9007199254740993"));
+	EXPECT_DBLEQ(parsed64.fval, 9007199254740992.0);
+	parsed64.fval = string_to_float64(STRING_CONST("  -1.25e-2xyz"));
+	EXPECT_DBLEQ(parsed64.fval, -0.0125);
+	parsed64.fval = string_to_float64(STRING_CONST("2.4703282292062328e-324"));
+	EXPECT_UINT64EQ(parsed64.uival, 1);
+	parsed64.fval = string_to_float64(STRING_CONST("1e400"));
+	EXPECT_UINT64EQ(parsed64.uival, 0x7FF0000000000000ULL);
+	parsed64.fval = string_to_float64(STRING_CONST("-infinity"));
+	EXPECT_UINT64EQ(parsed64.uival, 0xFFF0000000000000ULL);
+	parsed32.fval = string_to_float32(STRING_CONST("3.4028235e38"));
+	EXPECT_UINTEQ(parsed32.uival, 0x7F7FFFFF);
+	parsed32.fval = string_to_float32(STRING_CONST("16777217"));
+	EXPECT_REALEQ(parsed32.fval, 16777216.0f);
+
+	// Compare against the C library, shortest output must round trip and fixed precision must match %g
+	for (size_t iter = 0; iter < iterations; ++iter) {
+		do {
+			value64.uival = random64();
+		} while ((value64.uival & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL);
+
+		str = string_from_float64(buffer, sizeof(buffer), value64.fval, 0, 0, 0);
+		parsed64.fval = string_to_float64(STRING_ARGS(str));
+		EXPECT_EQ_MSG(parsed64.uival, value64.uival, buffer);
+		parsed64.fval = strtod(buffer, 0);
+		EXPECT_EQ_MSG(parsed64.uival, value64.uival, buffer);
+		len = snprintf(expect, sizeof(expect), "%.17g", value64.fval);
+		EXPECT_SIZELE(str.length, (size_t)len);
+
+		precision = random32_range(1, 26);
+		str = string_from_float64(buffer, sizeof(buffer), value64.fval, precision, 0, 0);
+		len = snprintf(expect, sizeof(expect), "%.*g", (int)precision, value64.fval);
+		if ((value64.uival << 1) == 0)
+			len = snprintf(expect, sizeof(expect), "0");
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+
+		parsed64.fval = string_to_float64(expect, (size_t)len);
+		value64.fval = strtod(expect, 0);
+		EXPECT_EQ_MSG(parsed64.uival, value64.uival, expect);
+
+		len = snprintf(expect, sizeof(expect), "%u.%ue%d", random32_range(0, 1000000000),
+		               random32_range(0, 1000000000), (int)random32_range(0, 700) - 350);
+		parsed64.fval = string_to_float64(expect, (size_t)len);
+		value64.fval = strtod(expect, 0);
+		EXPECT_EQ_MSG(parsed64.uival, value64.uival, expect);
+
+		do {
+			value32.uival = random32();
+		} while ((value32.uival & 0x7F800000) == 0x7F800000);
+
+		str = string_from_float32(buffer, sizeof(buffer), value32.fval, 0, 0, 0);
+		parsed32.fval = string_to_float32(STRING_ARGS(str));
+		EXPECT_EQ_MSG(parsed32.uival, value32.uival, buffer);
+		parsed32.fval = strtof(buffer, 0);
+		EXPECT_EQ_MSG(parsed32.uival, value32.uival, buffer);
+
+		precision = random32_range(1, 12);
+		str = string_from_float32(buffer, sizeof(buffer), value32.fval, precision, 0, 0);
+		len = snprintf(expect, sizeof(expect), "%.*g", (int)precision, test_float32_widen(value32));
+		if ((value32.uival << 1) == 0)
+			len = snprintf(expect, sizeof(expect), "0");
+		EXPECT_STRINGEQ(str, string_const(expect, (size_t)len));
+
+		len = snprintf(expect, sizeof(expect), "%u.%ue%d", random32_range(0, 1000000000),
+		               random32_range(0, 1000000000), (int)random32_range(0, 100) - 60);
+		parsed32.fval = string_to_float32(expect, (size_t)len);
+		value32.fval = strtof(expect, 0);
+		EXPECT_EQ_MSG(parsed32.uival, value32.uival, expect);
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(string, builder) {
+	char buffer[16];
+	char target[8];
+	string_builder_t builder;
+	string_const_t conststr;
+	string_t str;
+	string_t reference;
+	size_t iter;
+	size_t capacity;
+#if BUILD_DEBUG
+	const size_t count = 32 * 1024;
+#else
+	const size_t count = 1024 * 1024;
+#endif
+
+	string_builder_initialize(&builder, buffer, sizeof(buffer));
+	EXPECT_CONSTSTRINGEQ(string_builder_string(&builder), string_empty());
+	string_builder_append(&builder, STRING_CONST("value="));
+	string_builder_append_int(&builder, -42, 0, 0);
+	EXPECT_EQ(builder.str, buffer);
+	EXPECT_CONSTSTRINGEQ(string_builder_string(&builder), string_const(STRING_CONST("value=-42")));
+	string_builder_append_char(&builder, ' ');
+	string_builder_append_uint(&builder, 0xbeef, true, 8, '0');
+	string_builder_append_char(&builder, ' ');
+	string_builder_append_float64(&builder, 0.1, 0, 6, '_');
+	string_builder_append_format(&builder, STRING_CONST(" [%s:%d]"), "format", 7);
+	string_builder_append_real(&builder, REAL_C(1.5), 0, 0, 0);
+	EXPECT_NE(builder.str, buffer);
+	EXPECT_CONSTSTRINGEQ(string_builder_string(&builder),
+	                     string_const(STRING_CONST("value=-42 0000beef ___0.1 [format:7]1.5")));
+	EXPECT_EQ(builder.str[builder.length], 0);
+
+	str = string_builder_finish_buffer(&builder, target, sizeof(target));
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("value=-")));
+	EXPECT_SIZEEQ(builder.length, 0);
+
+	string_builder_append(&builder, STRING_CONST("heap"));
+	str = string_builder_finish(&builder);
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("heap")));
+	EXPECT_EQ(builder.str, buffer);
+	string_deallocate(str.str);
+
+	string_builder_append(&builder, STRING_CONST("stack"));
+	str = string_builder_finish(&builder);
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST("stack")));
+	EXPECT_NE(str.str, buffer);
+	string_deallocate(str.str);
+	string_builder_finalize(&builder);
+
+	string_builder_initialize(&builder, nullptr, 0);
+	EXPECT_EQ(builder.str, string_thread_buffer().str);
+	string_builder_reserve(&builder, 4096);
+	EXPECT_SIZEGT(builder.capacity, 4096);
+	for (iter = 0; iter < 1000; ++iter) {
+		string_builder_append_uint(&builder, iter, false, 4, ' ');
+		string_builder_append_char(&builder, '\n');
+	}
+	EXPECT_SIZEEQ(builder.length, 5000);
+	conststr = string_builder_string(&builder);
+	EXPECT_CONSTSTRINGEQ(string_substr(STRING_ARGS(conststr), 4995, 5), string_const(STRING_CONST(" 999\n")));
+	string_builder_clear(&builder);
+	string_builder_append_format(&builder, STRING_CONST("%0*d"), 5000, 1);
+	EXPECT_SIZEEQ(builder.length, 5000);
+	EXPECT_EQ(builder.str[4999], '1');
+	string_builder_finalize(&builder);
+
+	// Zero capacity storage is treated as no storage
+	string_builder_initialize(&builder, buffer, 0);
+	EXPECT_EQ(builder.str, string_thread_buffer().str);
+	string_builder_append(&builder, STRING_CONST("empty"));
+	EXPECT_CONSTSTRINGEQ(string_builder_string(&builder), string_const(STRING_CONST("empty")));
+	string_builder_finalize(&builder);
+
+#if FOUNDATION_PLATFORM_LINUX
+	{
+		// Wide character conversion fails in the C locale, builder should be left unchanged
+		const wchar_t wide[] = {0x20AC, 0};
+		string_builder_initialize(&builder, buffer, sizeof(buffer));
+		string_builder_append(&builder, STRING_CONST("keep"));
+		string_builder_append_format(&builder, STRING_CONST("%ls"), wide);
+		EXPECT_CONSTSTRINGEQ(string_builder_string(&builder), string_const(STRING_CONST("keep")));
+		string_builder_finalize(&builder);
+	}
+#endif
+
+	// Build a large report growing out of the initial storage and compare with plain appends
+	string_builder_initialize(&builder, buffer, sizeof(buffer));
+	for (iter = 0; iter < count; ++iter) {
+		string_builder_append(&builder, STRING_CONST("line "));
+		string_builder_append_uint(&builder, iter, false, 0, 0);
+		string_builder_append_char(&builder, '\n');
+	}
+	str = string_builder_finish(&builder);
+	string_builder_finalize(&builder);
+
+	capacity = 256;
+	reference = string_allocate(0, capacity);
+	for (iter = 0; iter < count; ++iter) {
+		char line[32];
+		string_t linestr = string_from_uint(line, sizeof(line), iter, false, 0, 0);
+		const size_t required = reference.length + 5 + linestr.length + 2;
+		if (required > capacity) {
+			const size_t grown = math_max(capacity * 2, required);
+			reference.str = memory_reallocate(reference.str, grown, 0, reference.length + 1, 0);
+			capacity = grown;
+		}
+		reference = string_append_varg(reference.str, reference.length, capacity, STRING_CONST("line "),
+		                               STRING_ARGS(linestr), STRING_CONST("\n"), nullptr);
+	}
+	EXPECT_STRINGEQ(str, string_const(STRING_ARGS(reference)));
+	string_deallocate(reference.str);
+	string_deallocate(str.str);
+
+	return 0;
+}
+
+DECLARE_TEST(string, utf8) {
+	const char mixed[] = "ascii text \xc3\xa5\xc3\xa4\xc3\xb6 \xe2\x82\xac \xf0\x9f\x98\x80 and more ascii text";
+	const size_t mixed_glyphs = 38;
+#if BUILD_DEBUG
+	const size_t size = 256 * 1024;
+#else
+	const size_t size = 4 * 1024 * 1024;
+#endif
+	char* text = memory_allocate(0, size + 1, 0, MEMORY_PERSISTENT);
+	uint16_t* utf16 = memory_allocate(0, sizeof(uint16_t) * (size + 1), 0, MEMORY_PERSISTENT);
+	uint32_t* utf32 = memory_allocate(0, sizeof(uint32_t) * (size + 1), 0, MEMORY_PERSISTENT);
+	char* back = memory_allocate(0, size + 1, 0, MEMORY_PERSISTENT);
+	size_t length, count, glyphs, offset;
+	string_t str;
+
+	EXPECT_TRUE(string_validate_utf8(STRING_CONST(mixed)));
+	EXPECT_TRUE(string_validate_utf8(STRING_CONST("")));
+	EXPECT_TRUE(string_validate_utf8(STRING_CONST("\xf4\x8f\xbf\xbf")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("\xc0\xaf")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("\xe0\x80\xaf")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("\xed\xa0\x80")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("\xf4\x90\x80\x80")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("\xf8\x88\x80\x80\x80")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("\x80")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("abc\xe2\x82")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("0123456789abcdef0123456789abcde\xe2")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("0123456789abcdef0123456789abcd\xe2\x82")));
+	EXPECT_FALSE(string_validate_utf8(STRING_CONST("0123456789abcde\xf0\x9f\x98 0123456789abcdef0123456789abcdef")));
+	EXPECT_SIZEEQ(string_glyphs(STRING_CONST(mixed)), mixed_glyphs);
+
+	count = string_encode_utf16(utf16, size, STRING_CONST(mixed));
+	EXPECT_SIZEEQ(count, mixed_glyphs + 1);
+	EXPECT_UINTEQ(utf16[11], 0xe5);
+	EXPECT_UINTEQ(utf16[17], 0xd83d);
+	EXPECT_UINTEQ(utf16[18], 0xde00);
+	str = string_convert_utf16(back, size, utf16, count);
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST(mixed)));
+	count = string_encode_utf16(utf16, 19, STRING_CONST(mixed));
+	EXPECT_SIZEEQ(count, 17);
+
+	count = string_encode_utf32(utf32, size, STRING_CONST(mixed));
+	EXPECT_SIZEEQ(count, mixed_glyphs);
+	EXPECT_UINTEQ(utf32[15], 0x20ac);
+	EXPECT_UINTEQ(utf32[17], 0x1f600);
+	str = string_convert_utf32(back, size, utf32, count);
+	EXPECT_STRINGEQ(str, string_const(STRING_CONST(mixed)));
+
+	{
+		// Stray continuation bytes in legacy encoded text are decoded as separate glyphs
+		const char legacy[] = "23\xB0" "C and 5\xA3 more text here";
+		wchar_t* wstr = wstring_allocate_from_string(STRING_CONST(legacy));
+		EXPECT_SIZEEQ(wstring_length(wstr), sizeof(legacy) - 1);
+		EXPECT_EQ(wstr[sizeof(legacy) - 2], L'e');
+		wstring_deallocate(wstr);
+
+		// Glyph count must match stepping through the string glyph by glyph
+		EXPECT_SIZEEQ(string_glyphs(STRING_CONST(legacy)), sizeof(legacy) - 1);
+		EXPECT_SIZEEQ(string_glyphs(STRING_CONST("\x80" "abc")), 4);
+		for (offset = 0, count = 0; offset < sizeof(legacy) - 1; ++count) {
+			size_t consumed = 0;
+			string_glyph(legacy, sizeof(legacy) - 1, offset, &consumed);
+			offset += consumed;
+		}
+		EXPECT_SIZEEQ(count, string_glyphs(STRING_CONST(legacy)));
+
+		wstr = wstring_allocate_from_string(STRING_CONST(mixed));
+		EXPECT_SIZEEQ(wstring_length(wstr), (sizeof(wchar_t) == 2) ? mixed_glyphs + 1 : mixed_glyphs);
+		wstring_deallocate(wstr);
+	}
+
+	// Large text mostly ASCII with some multibyte glyphs, round trip through UTF-16 and UTF-32
+	glyphs = 0;
+	for (length = 0; length + sizeof(mixed) < size; length += sizeof(mixed) - 1, glyphs += mixed_glyphs)
+		memcpy(text + length, mixed, sizeof(mixed) - 1);
+	text[length] = 0;
+
+	EXPECT_TRUE(string_validate_utf8(text, length));
+	EXPECT_SIZEEQ(string_glyphs(text, length), glyphs);
+	offset = length / 3;
+	while ((text[offset] & 0xC0) != 0xC0)
+		++offset;
+	text[offset + 1] = 'x';
+	EXPECT_FALSE(string_validate_utf8(text, length));
+	text[offset + 1] = mixed[(offset + 1) % (sizeof(mixed) - 1)];
+	EXPECT_TRUE(string_validate_utf8(text, length));
+
+	count = string_encode_utf16(utf16, size + 1, text, length);
+	str = string_convert_utf16(back, size + 1, utf16, count);
+	EXPECT_STRINGEQ(str, string_const(text, length));
+	count = string_encode_utf32(utf32, size + 1, text, length);
+	EXPECT_SIZEEQ(count, glyphs);
+	str = string_convert_utf32(back, size + 1, utf32, count);
+	EXPECT_STRINGEQ(str, string_const(text, length));
+
+	memory_deallocate(back);
+	memory_deallocate(utf32);
+	memory_deallocate(utf16);
+	memory_deallocate(text);
+
+	return 0;
+}
+
+DECLARE_TEST(string, tokenizer) {
+	string_tokenizer_t tokenizer;
+	string_tokenizer_t fields;
+	string_const_t token;
+	string_const_t line;
+	string_const_t expect[8];
+	size_t count, lines, total, iter;
+	char* text;
+	const char csv[] = "1,\"quoted, with delimiter\",3.5,\"say \"\"hi\"\"\",,last";
+	const size_t line_count = 16 * 1024;
+
+	string_tokenizer_initialize(&tokenizer, STRING_CONST("a,,b,"), STRING_CONST(","), 0);
+	expect[0] = string_const(STRING_CONST("a"));
+	expect[1] = string_empty();
+	expect[2] = string_const(STRING_CONST("b"));
+	expect[3] = string_empty();
+	for (count = 0; string_tokenizer_next(&tokenizer, &token); ++count) {
+		EXPECT_SIZELT(count, 4);
+		EXPECT_CONSTSTRINGEQ(token, expect[count]);
+	}
+	EXPECT_SIZEEQ(count, 4);
+	EXPECT_FALSE(string_tokenizer_next(&tokenizer, &token));
+
+	string_tokenizer_initialize(&tokenizer, STRING_CONST(" \t this  is\t\ta test  "), STRING_CONST(" \t"),
+	                            STRING_TOKENIZE_SKIP_EMPTY);
+	expect[0] = string_const(STRING_CONST("this"));
+	expect[1] = string_const(STRING_CONST("is"));
+	expect[2] = string_const(STRING_CONST("a"));
+	expect[3] = string_const(STRING_CONST("test"));
+	for (count = 0; string_tokenizer_next(&tokenizer, &token); ++count) {
+		EXPECT_SIZELT(count, 4);
+		EXPECT_CONSTSTRINGEQ(token, expect[count]);
+	}
+	EXPECT_SIZEEQ(count, 4);
+
+	string_tokenizer_initialize(&tokenizer, STRING_CONST(csv), STRING_CONST(","), STRING_TOKENIZE_QUOTES);
+	expect[0] = string_const(STRING_CONST("1"));
+	expect[1] = string_const(STRING_CONST("quoted, with delimiter"));
+	expect[2] = string_const(STRING_CONST("3.5"));
+	expect[3] = string_const(STRING_CONST("say \"\"hi\"\""));
+	expect[4] = string_empty();
+	expect[5] = string_const(STRING_CONST("last"));
+	for (count = 0; string_tokenizer_next(&tokenizer, &token); ++count) {
+		EXPECT_SIZELT(count, 6);
+		EXPECT_CONSTSTRINGEQ(token, expect[count]);
+	}
+	EXPECT_SIZEEQ(count, 6);
+
+	string_tokenizer_initialize(&tokenizer, STRING_CONST("\"unterminated,quote"), STRING_CONST(","),
+	                            STRING_TOKENIZE_QUOTES);
+	EXPECT_TRUE(string_tokenizer_next(&tokenizer, &token));
+	EXPECT_CONSTSTRINGEQ(token, string_const(STRING_CONST("unterminated,quote")));
+	EXPECT_FALSE(string_tokenizer_next(&tokenizer, &token));
+
+	string_tokenizer_initialize(&tokenizer, STRING_CONST(""), STRING_CONST(","), 0);
+	EXPECT_FALSE(string_tokenizer_next(&tokenizer, &token));
+	string_tokenizer_initialize(&tokenizer, STRING_CONST(",,,"), STRING_CONST(","), STRING_TOKENIZE_SKIP_EMPTY);
+	EXPECT_FALSE(string_tokenizer_next(&tokenizer, &token));
+	string_tokenizer_initialize(&tokenizer, STRING_CONST("no delimiters"), nullptr, 0, 0);
+	EXPECT_TRUE(string_tokenizer_next(&tokenizer, &token));
+	EXPECT_CONSTSTRINGEQ(token, string_const(STRING_CONST("no delimiters")));
+	EXPECT_FALSE(string_tokenizer_next(&tokenizer, &token));
+
+	// Split lines and then fields of CSV data
+	text = memory_allocate(0, line_count * sizeof(csv), 0, MEMORY_PERSISTENT);
+	for (iter = 0; iter < line_count; ++iter) {
+		memcpy(text + (iter * sizeof(csv)), csv, sizeof(csv) - 1);
+		text[(iter * sizeof(csv)) + sizeof(csv) - 1] = '\n';
+	}
+
+	lines = 0;
+	total = 0;
+	string_tokenizer_initialize(&tokenizer, text, line_count * sizeof(csv), STRING_CONST("\n"),
+	                            STRING_TOKENIZE_SKIP_EMPTY);
+	while (string_tokenizer_next(&tokenizer, &line)) {
+		string_tokenizer_initialize(&fields, STRING_ARGS(line), STRING_CONST(","), STRING_TOKENIZE_QUOTES);
+		while (string_tokenizer_next(&fields, &token))
+			total += token.length;
+		++lines;
+	}
+	EXPECT_SIZEEQ(lines, line_count);
+	EXPECT_SIZEEQ(total, line_count * 40);
+
+	memory_deallocate(text);
+
+	return 0;
+}
+
+static char
+test_string_fold(char c) {
+	return ((c >= 'A') && (c <= 'Z')) ? (char)(c + ('a' - 'A')) : c;
+}
+
+DECLARE_TEST(string, nocase) {
+	char mixed[608];
+	char lower[608];
+	char other[608];
+	size_t length, ichar;
+
+	// All byte pairs, only ASCII letters compare case insensitively
+	for (ichar = 0; ichar < 256; ++ichar) {
+		const char c = (char)ichar;
+		const char folded = test_string_fold(c);
+		EXPECT_EQ(string_hash_nocase(&c, 1), string_hash(&folded, 1));
+		for (size_t iother = 0; iother < 256; ++iother) {
+			const char o = (char)iother;
+			EXPECT_EQ(string_equal_nocase(&c, 1, &o, 1), folded == test_string_fold(o));
+		}
+	}
+	EXPECT_EQ(string_hash_nocase(0, 0), HASH_EMPTY_STRING);
+	EXPECT_EQ(string_hash_nocase(STRING_CONST("Content-Type")), string_hash(STRING_CONST("content-type")));
+	EXPECT_EQ(string_hash_nocase(STRING_CONST("C:\\Windows\\System32")),
+	          string_hash(STRING_CONST("c:\\windows\\system32")));
+	EXPECT_NE(string_hash_nocase(STRING_CONST("Foo")), string_hash(STRING_CONST("Foo")));
+	EXPECT_TRUE(string_equal_nocase(STRING_CONST("\xc3\x85ngstr\xc3\xb6m"), STRING_CONST("\xc3\x85NGSTR\xc3\xb6M")));
+	EXPECT_FALSE(string_equal_nocase(STRING_CONST("\xc3\xa5"), STRING_CONST("\xc3\x85")));
+	EXPECT_FALSE(string_equal_nocase(STRING_CONST("foo\0bar"), STRING_CONST("foo\0baz")));
+
+	// All lengths and alignments of mixed case text with non-ASCII bytes, with a single
+	// difference at a random position
+	for (length = 0; length < 600; ++length) {
+		const size_t offset = length % 8;
+		for (ichar = 0; ichar < length; ++ichar) {
+			const uint32_t value = random32_range(0, 64);
+			char c = (char)((value < 52) ? ('A' + (value % 26) + ((value / 26) * 32)) : (0xC0 + value));
+			mixed[offset + ichar] = c;
+			lower[ichar] = test_string_fold(c);
+			other[ichar] = lower[ichar];
+		}
+		EXPECT_TRUE(string_equal_nocase(mixed + offset, length, lower, length));
+		EXPECT_TRUE(string_equal_nocase(lower, length, mixed + offset, length));
+		EXPECT_EQ(string_hash_nocase(mixed + offset, length), length ? string_hash(lower, length) : HASH_EMPTY_STRING);
+		EXPECT_EQ(string_hash_nocase(lower, length), string_hash_nocase(mixed + offset, length));
+		if (length) {
+			const size_t diff = random32_range(0, (uint32_t)length);
+			// Changing case bit of a non-letter, or changing a letter to another letter
+			other[diff] = (char)((other[diff] >= 'a') && (other[diff] <= 'z') ? ('a' + ((other[diff] - 'a' + 1) % 26)) :
+			                                                                       (other[diff] ^ 0x20));
+			EXPECT_FALSE(string_equal_nocase(mixed + offset, length, other, length));
+			EXPECT_NE(string_hash_nocase(mixed + offset, length), string_hash_nocase(other, length));
+			EXPECT_FALSE(string_equal_nocase(mixed + offset, length, lower, length - 1));
+		}
+	}
+
+	return 0;
+}
+
 static void
 test_string_declare(void) {
 	ADD_TEST(string, allocate);
@@ -2538,6 +3199,13 @@ test_string_declare(void) {
 	ADD_TEST(string, prepend);
 	ADD_TEST(string, format);
 	ADD_TEST(string, convert);
+	ADD_TEST(string, scan);
+	ADD_TEST(string, int_convert);
+	ADD_TEST(string, float_convert);
+	ADD_TEST(string, builder);
+	ADD_TEST(string, utf8);
+	ADD_TEST(string, tokenizer);
+	ADD_TEST(string, nocase);
 	// ADD_TEST(string, locale);
 }
 
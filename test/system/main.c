@@ -213,11 +213,102 @@ DECLARE_TEST(system, thread) {
 	return 0;
 }
 
+static int
+test_system_dispatch_generic(void) {
+	return 1;
+}
+
+static int
+test_system_dispatch_avx2(void) {
+	return 2;
+}
+
+static int
+test_system_dispatch_neon(void) {
+	return 3;
+}
+
+static int
+test_system_dispatch_unsupported(void) {
+	return 4;
+}
+
+typedef int (*test_system_dispatch_fn)(void);
+
+DECLARE_TEST(system, cpu) {
+	const cpu_features_t* cpu = system_cpu_features();
+	cpu_dispatch_t candidates[4];
+	test_system_dispatch_fn selected;
+
+	EXPECT_NE(cpu, nullptr);
+	EXPECT_EQ(cpu, system_cpu_features());
+	EXPECT_SIZEEQ(cpu->cache_line_size & (cpu->cache_line_size - 1), 0);
+	EXPECT_SIZEGE(cpu->cache_line_size, 16);
+	EXPECT_SIZELE(cpu->cache_line_size, 1024);
+	if (cpu->cache_l1d_size && cpu->cache_l2_size)
+		EXPECT_SIZEGE(cpu->cache_l2_size, cpu->cache_l1d_size);
+
+	EXPECT_TRUE(system_cpu_has_feature(0));
+	EXPECT_EQ(system_cpu_has_feature(cpu->flags), true);
+#if FOUNDATION_ARCH_X86_64
+	EXPECT_TRUE(system_cpu_has_feature(CPU_FEATURE_SSE2));
+#endif
+#if FOUNDATION_ARCH_ARM_64
+	EXPECT_TRUE(system_cpu_has_feature(CPU_FEATURE_NEON));
+#endif
+	// Wider vector extensions imply the narrower ones
+	if (system_cpu_has_feature(CPU_FEATURE_AVX2))
+		EXPECT_TRUE(system_cpu_has_feature(CPU_FEATURE_AVX | CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE2));
+	if (system_cpu_has_feature(CPU_FEATURE_AVX512BW))
+		EXPECT_TRUE(system_cpu_has_feature(CPU_FEATURE_AVX512F | CPU_FEATURE_AVX));
+	EXPECT_FALSE(system_cpu_has_feature(CPU_FEATURE_AVX2 | CPU_FEATURE_NEON));
+
+	candidates[0].features = CPU_FEATURE_AVX2 | CPU_FEATURE_NEON;
+	candidates[0].function = (cpu_dispatch_fn)test_system_dispatch_unsupported;
+	candidates[1].features = CPU_FEATURE_AVX2;
+	candidates[1].function = (cpu_dispatch_fn)test_system_dispatch_avx2;
+	candidates[2].features = CPU_FEATURE_NEON;
+	candidates[2].function = (cpu_dispatch_fn)test_system_dispatch_neon;
+	candidates[3].features = 0;
+	candidates[3].function = (cpu_dispatch_fn)test_system_dispatch_generic;
+
+	selected = (test_system_dispatch_fn)system_cpu_dispatch(candidates, 4);
+	EXPECT_NE(selected, nullptr);
+	if (system_cpu_has_feature(CPU_FEATURE_AVX2))
+		EXPECT_INTEQ(selected(), 2);
+	else if (system_cpu_has_feature(CPU_FEATURE_NEON))
+		EXPECT_INTEQ(selected(), 3);
+	else
+		EXPECT_INTEQ(selected(), 1);
+
+	EXPECT_EQ(system_cpu_dispatch(candidates, 1), nullptr);
+	EXPECT_EQ(system_cpu_dispatch(candidates, 0), nullptr);
+	EXPECT_EQ(system_cpu_dispatch(candidates + 3, 1), (cpu_dispatch_fn)test_system_dispatch_generic);
+
+	// Masking features selects the fallback candidates until restored
+	uint64_t flags = cpu->flags;
+	system_cpu_mask_features(0);
+	EXPECT_EQ(cpu->flags, 0);
+	EXPECT_EQ(system_cpu_dispatch(candidates, 4), (cpu_dispatch_fn)test_system_dispatch_generic);
+	system_cpu_mask_features(~0ULL);
+	EXPECT_EQ(cpu->flags, flags);
+	EXPECT_EQ(system_cpu_dispatch(candidates, 4), (cpu_dispatch_fn)selected);
+
+	log_infof(HASH_TEST,
+	          STRING_CONST("CPU features 0x%" PRIx64 ", cache line %" PRIsize ", L1d %" PRIsize ", L1i %" PRIsize
+	                       ", L2 %" PRIsize ", L3 %" PRIsize),
+	          cpu->flags, cpu->cache_line_size, cpu->cache_l1d_size, cpu->cache_l1i_size, cpu->cache_l2_size,
+	          cpu->cache_l3_size);
+
+	return 0;
+}
+
 static void
 test_system_declare(void) {
 	ADD_TEST(system, align);
 	ADD_TEST(system, builtin);
 	ADD_TEST(system, thread);
+	ADD_TEST(system, cpu);
 }
 
 static test_suite_t test_system_suite = {test_system_application,
@@ -0,0 +1,76 @@
+/* digest.h  -  Foundation test library  -  Public Domain  -  2013 Mattias Jansson
+ *
+ * This library provides a cross-platform foundation library in C11 providing basic support
+ * data types and functions to write applications and games in a platform-independent fashion.
+ * The latest source code is always available at
+ *
+ * https://github.com/mjansson/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without
+ * any restrictions.
+ */
+
+#pragma once
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+// Multi-buffer digest comparison shared by the md5 and sha tests
+
+typedef void (*test_digest_multi_fn)(const void* const* buffers, const size_t* sizes, size_t count, void* digests);
+typedef void (*test_digest_fn)(const void* buffer, size_t size, void* digest);
+
+static void*
+test_digest_multi_compare(test_digest_multi_fn multi, test_digest_fn single, size_t digest_size) {
+	const size_t max_count = 67;
+	const size_t max_size = 300;
+	const void* buffers[67];
+	size_t sizes[67];
+	// Digests up to 512 bits, aligned for the digest types
+	uint64_t digests[67 * 8];
+	uint64_t digest[8];
+	unsigned char* data = memory_allocate(0, max_count * max_size, 0, MEMORY_PERSISTENT);
+	size_t count, imsg, i;
+
+	FOUNDATION_ASSERT(digest_size <= sizeof(digest));
+	for (i = 0; i < max_count * max_size; ++i)
+		data[i] = (unsigned char)random32();
+
+	// Cover idle lanes, lanes finishing at different blocks and all padding edge cases
+	for (count = 0; count <= max_count; count += (count < 20) ? 1 : 23) {
+		for (imsg = 0; imsg < count; ++imsg) {
+			sizes[imsg] = (imsg < 10) ? (55 + imsg) : random32_range(0, (uint32_t)max_size);
+			buffers[imsg] = data + (imsg * max_size) + (imsg % 3);
+			if (sizes[imsg] + (imsg % 3) > max_size)
+				sizes[imsg] = max_size - (imsg % 3);
+		}
+
+		multi(buffers, sizes, count, digests);
+
+		for (imsg = 0; imsg < count; ++imsg) {
+			single(buffers[imsg], sizes[imsg], digest);
+			EXPECT_TRUE_MSGFORMAT(!memcmp(pointer_offset(digests, imsg * digest_size), digest, digest_size),
+			                      "message %" PRIsize " of %" PRIsize, imsg, count);
+		}
+	}
+
+	memory_deallocate(data);
+
+	return 0;
+}
+
+// Compare multi-buffer digests with single buffer digests for each implementation selectable by CPU features
+static void*
+test_digest_multi(test_digest_multi_fn multi, test_digest_fn single, size_t digest_size) {
+	// Each mask disables the widest remaining multi-buffer implementation, ending with the fallback
+	const uint64_t masks[] = {~0ULL, ~(CPU_FEATURE_AVX512F | CPU_FEATURE_SHA),
+	                          ~(CPU_FEATURE_AVX512F | CPU_FEATURE_AVX2 | CPU_FEATURE_SHA), 0};
+	void* result = 0;
+	size_t imask;
+	for (imask = 0; !result && (imask < sizeof(masks) / sizeof(masks[0])); ++imask) {
+		system_cpu_mask_features(masks[imask]);
+		result = test_digest_multi_compare(multi, single, digest_size);
+	}
+	system_cpu_mask_features(~0ULL);
+	return result;
+}